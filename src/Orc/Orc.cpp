@@ -51,6 +51,9 @@
 #ifdef ORC_COMMAND_DD
 #    include "Command/DD/DD.h"
 #endif
+#ifdef ORC_COMMAND_DECRYPT
+#    include "Command/Decrypt/Decrypt.h"
+#endif
 
 #include "Mothership.h"
 #include "Console.h"
@@ -127,6 +130,9 @@ ToolDescription g_Tools[] = {
 #endif
 #ifdef ORC_COMMAND_DD
     ToolDescription::Get<DD::Main>(),
+#endif
+#ifdef ORC_COMMAND_DECRYPT
+    ToolDescription::Get<Decrypt::Main>(),
 #endif
     {nullptr, nullptr, nullptr}
 };
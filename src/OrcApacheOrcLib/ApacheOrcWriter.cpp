@@ -18,6 +18,7 @@
 #include "Buffer.h"
 #include "BinaryBuffer.h"
 #include "Convert.h"
+#include "Text/Utf16ToUtf8.h"
 
 #include <WideAnsi.h>
 
@@ -429,148 +430,50 @@ HRESULT Orc::TableOutput::ApacheOrc::Writer::WriteEndOfLine()
     return S_OK;
 }
 
-STDMETHODIMP Orc::TableOutput::ApacheOrc::Writer::WriteString(const std::wstring& strString)
+HRESULT Orc::TableOutput::ApacheOrc::Writer::WriteUtf16(std::wstring_view value)
 {
     auto root = dynamic_cast<orc::StructVectorBatch*>(m_Batch.get());
     if (root)
     {
         auto col = dynamic_cast<orc::StringVectorBatch*>(root->fields[m_dwColumnCounter]);
-        auto data = (char*)m_BatchPool->malloc(strString.size());
-        if (data == nullptr)
-        {
-            AbandonColumn();
-            return E_OUTOFMEMORY;
-        }
 
-        Buffer<CHAR, MAX_PATH> ansiString;
+        m_utf8.resize(Text::GetUtf8MaxLength(value.size()));
+        m_utf8.resize(Text::Utf16ToUtf8(value, m_utf8.data()));
 
-        if (auto hr = WideToAnsi(strString, ansiString); FAILED(hr))
-        {
-            AbandonColumn();
-            return hr;
-        }
-        auto pStr = m_BatchPool->malloc(ansiString.size());
+        auto pStr = m_BatchPool->malloc(m_utf8.size());
         if (pStr == nullptr)
         {
             AbandonColumn();
             return E_OUTOFMEMORY;
         }
 
-        memcpy_s(pStr, ansiString.size(), ansiString.get(), ansiString.size());
+        memcpy_s(pStr, m_utf8.size(), m_utf8.data(), m_utf8.size());
 
         col->data[m_dwBatchRow] = pStr;
-        col->length[m_dwBatchRow] = strString.size();
+        col->length[m_dwBatchRow] = m_utf8.size();
     }
     AddColumnAndCheckNumbers();
     return S_OK;
 }
 
-STDMETHODIMP Orc::TableOutput::ApacheOrc::Writer::WriteString(const std::wstring_view& strString)
+STDMETHODIMP Orc::TableOutput::ApacheOrc::Writer::WriteString(const std::wstring& strString)
 {
-    auto root = dynamic_cast<orc::StructVectorBatch*>(m_Batch.get());
-    if (root)
-    {
-        auto col = dynamic_cast<orc::StringVectorBatch*>(root->fields[m_dwColumnCounter]);
-        auto data = (char*)m_BatchPool->malloc(strString.size());
-        if (data == nullptr)
-        {
-            AbandonColumn();
-            return E_OUTOFMEMORY;
-        }
-        Buffer<CHAR, MAX_PATH> ansiString;
-
-        if (auto hr = WideToAnsi(strString, ansiString); FAILED(hr))
-        {
-            AbandonColumn();
-            return hr;
-        }
-        auto pStr = m_BatchPool->malloc(ansiString.size());
-        if (pStr == nullptr)
-        {
-            AbandonColumn();
-            return E_OUTOFMEMORY;
-        }
-
-        memcpy_s(pStr, ansiString.size(), ansiString.get(), ansiString.size());
+    return WriteUtf16(strString);
+}
 
-        col->data[m_dwBatchRow] = pStr;
-        col->length[m_dwBatchRow] = strString.size();
-    }
-    AddColumnAndCheckNumbers();
-    return S_OK;
+STDMETHODIMP Orc::TableOutput::ApacheOrc::Writer::WriteString(const std::wstring_view& strString)
+{
+    return WriteUtf16(strString);
 }
 
 STDMETHODIMP Orc::TableOutput::ApacheOrc::Writer::WriteString(const WCHAR* szString)
 {
-    auto root = dynamic_cast<orc::StructVectorBatch*>(m_Batch.get());
-    if (root)
-    {
-        auto strSize = wcslen(szString);
-
-        auto col = dynamic_cast<orc::StringVectorBatch*>(root->fields[m_dwColumnCounter]);
-        auto data = (char*)m_BatchPool->malloc(strSize);
-        if (data == nullptr)
-        {
-            AbandonColumn();
-            return E_OUTOFMEMORY;
-        }
-        Buffer<CHAR, MAX_PATH> ansiString;
-
-        if (auto hr = WideToAnsi(szString, static_cast<DWORD>(strSize), ansiString); FAILED(hr))
-        {
-            AbandonColumn();
-            return hr;
-        }
-
-        auto pStr = m_BatchPool->malloc(ansiString.size());
-        if (pStr == nullptr)
-        {
-            AbandonColumn();
-            return E_OUTOFMEMORY;
-        }
-        memcpy_s(pStr, ansiString.size(), ansiString.get(), ansiString.size());
-
-        col->data[m_dwBatchRow] = pStr;
-        col->length[m_dwBatchRow] = strSize;
-    }
-    AddColumnAndCheckNumbers();
-    return S_OK;
+    return WriteUtf16(std::wstring_view(szString, wcslen(szString)));
 }
 
 STDMETHODIMP Orc::TableOutput::ApacheOrc::Writer::WriteCharArray(const WCHAR* szString, DWORD dwCharCount)
 {
-    auto root = dynamic_cast<orc::StructVectorBatch*>(m_Batch.get());
-    if (root)
-    {
-        auto col = dynamic_cast<orc::StringVectorBatch*>(root->fields[m_dwColumnCounter]);
-        auto data = (char*)m_BatchPool->malloc(dwCharCount);
-        if (data == nullptr)
-        {
-            AbandonColumn();
-            return E_OUTOFMEMORY;
-        }
-        Buffer<CHAR, MAX_PATH> ansiString;
-
-        if (auto hr = WideToAnsi(szString, dwCharCount, ansiString); FAILED(hr))
-        {
-            AbandonColumn();
-            return hr;
-        }
-
-        auto pStr = m_BatchPool->malloc(ansiString.size());
-        if (pStr == nullptr)
-        {
-            AbandonColumn();
-            return E_OUTOFMEMORY;
-        }
-
-        memcpy_s(pStr, ansiString.size(), ansiString.get(), ansiString.size());
-
-        col->data[m_dwBatchRow] = pStr;
-        col->length[m_dwBatchRow] = dwCharCount;
-    }
-    AddColumnAndCheckNumbers();
-    return S_OK;
+    return WriteUtf16(std::wstring_view(szString, dwCharCount));
 }
 
 HRESULT
@@ -127,6 +127,8 @@ protected:
 
     HRESULT AddColumnAndCheckNumbers();
 
+    HRESULT WriteUtf16(std::wstring_view value);
+
     std::unique_ptr<Options> m_Options;
     std::shared_ptr<WriterTermination> m_pTermination;
 
@@ -146,6 +148,9 @@ protected:
 
     std::unique_ptr<MemoryPool> m_BatchPool;
 
+    // Transcoding buffer reused across string cells
+    std::string m_utf8;
+
     std::shared_ptr<ByteStream> m_pByteStream = nullptr;
     bool m_bCloseStream = true;
 
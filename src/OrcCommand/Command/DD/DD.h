@@ -37,6 +37,10 @@ public:
 
         bool NoError = false;
         bool NoTrunc = false;
+        bool Sparse = false;
+
+        // Number of blocks in flight between the read, hash and write stages
+        DWORD Buffers = 8L;
 
         ULARGE_INTEGER BlockSize = {512L};
         ULARGE_INTEGER Count = {0L};
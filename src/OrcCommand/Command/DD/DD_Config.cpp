@@ -67,6 +67,10 @@ HRESULT Main::GetConfigurationFromArgcArgv(int argc, LPCWSTR argv[])
                     ;
                 else if (BooleanOption(argv[i] + 1, L"noerror", config.NoError))
                     ;
+                else if (BooleanOption(argv[i] + 1, L"sparse", config.Sparse))
+                    ;
+                else if (ParameterOption(argv[i] + 1, L"buffers", config.Buffers))
+                    ;
                 else if (ProcessPriorityOption(argv[i] + 1))
                     ;
                 else if (UsageOption(argv[i] + 1))
@@ -115,5 +119,16 @@ HRESULT Main::CheckConfiguration()
         config.BlockSize.QuadPart = 512;
     }
 
+    if (config.Buffers < 2)
+    {
+        config.Buffers = 2;
+    }
+
+    if (config.Sparse && config.NoTrunc)
+    {
+        Log::Warn("Sparse output is not supported with /notrunc: zero blocks will be written");
+        config.Sparse = false;
+    }
+
     return S_OK;
 }
@@ -29,7 +29,7 @@ void Main::PrintUsage()
         usageNode,
         "Usage: DFIR-Orc.exe DD [/out=<Folder|Outfile.csv|Archive.7z>] /if=<InputLocation> /of=<OutputLocation> "
         "/bs=<BlockSize> /count=<BlockCount> [/skip=<BlockCount>] [/seek=<BlockCount>] [/hash=<Hashes>] [/noerror] "
-        "[/notrunc]",
+        "[/notrunc] [/sparse] [/buffers=<Count>]",
         "Dump tool inspired from linux 'dd' command");
 
     constexpr std::array kSpecificParameters = {
@@ -42,6 +42,8 @@ void Main::PrintUsage()
         Usage::Parameter {"/Hash=<Hashes>", ""},
         Usage::Parameter {"/NoError", ""},
         Usage::Parameter {"/NoTrunc", ""},
+        Usage::Parameter {"/Sparse", "Do not write blocks filled with zeroes, output files are created sparse"},
+        Usage::Parameter {"/Buffers=<Count>", "Number of blocks read, hashed and written concurrently (default: 8)"},
     };
 
     Usage::PrintParameters(usageNode, "PARAMETERS", kSpecificParameters);
@@ -89,6 +91,8 @@ void Main::PrintParameters()
 
     PrintValue(node, L"No Error", config.NoError);
     PrintValue(node, L"No Truncation", config.NoTrunc);
+    PrintValue(node, L"Sparse", config.Sparse);
+    PrintValue(node, L"Buffers", config.Buffers);
     PrintValue(node, L"Hashs", config.Hash);
 }
 
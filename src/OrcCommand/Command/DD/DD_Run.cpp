@@ -9,6 +9,7 @@
 #include "stdafx.h"
 
 #include "FileStream.h"
+#include "SparseStream.h"
 #include "CryptoHashStream.h"
 
 #include "SystemDetails.h"
@@ -16,14 +17,244 @@
 
 #include "DD.h"
 
+#include <algorithm>
 #include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 using namespace Orc;
 using namespace Orc::Command::DD;
 
+namespace {
+
+// Ring of blocks shared by the reading stage (producer) and the hashing and writing stages (consumers). A block is
+// reused once every consumer is done with it, consumers work on the same block concurrently.
+class BlockPipeline
+{
+public:
+    struct Block
+    {
+        Block()
+            : buffer(true)
+        {
+        }
+
+        CBinaryBuffer buffer;
+        ULONGLONG ullSize = 0LL;
+        bool bZero = false;
+    };
+
+    BlockPipeline(size_t slots, size_t blockSize, size_t consumers)
+        : m_blocks(slots)
+        , m_consumed(consumers, 0LL)
+    {
+        for (auto& block : m_blocks)
+        {
+            block.buffer.SetCount(blockSize);
+        }
+    }
+
+    // Wait for a block to be available to the producer
+    Block& BeginWrite()
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+        m_cv.wait(lock, [this]() { return m_ullProduced - MinConsumed() < m_blocks.size(); });
+        return m_blocks[m_ullProduced % m_blocks.size()];
+    }
+
+    // Make the block returned by BeginWrite available to the consumers
+    void EndWrite()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_ullProduced++;
+        }
+        m_cv.notify_all();
+    }
+
+    // Signal the consumers that no more blocks will be produced
+    void Close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_bClosed = true;
+        }
+        m_cv.notify_all();
+    }
+
+    // Wait for the next block of a consumer, nullptr when every block has been consumed
+    const Block* BeginRead(size_t consumer)
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+        m_cv.wait(lock, [this, consumer]() { return m_consumed[consumer] < m_ullProduced || m_bClosed; });
+        if (m_consumed[consumer] == m_ullProduced)
+        {
+            return nullptr;
+        }
+
+        return &m_blocks[m_consumed[consumer] % m_blocks.size()];
+    }
+
+    void EndRead(size_t consumer)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_consumed[consumer]++;
+        }
+        m_cv.notify_all();
+    }
+
+private:
+    ULONGLONG MinConsumed() const
+    {
+        if (m_consumed.empty())
+        {
+            return m_ullProduced;
+        }
+
+        return *std::min_element(std::cbegin(m_consumed), std::cend(m_consumed));
+    }
+
+    std::mutex m_lock;
+    std::condition_variable m_cv;
+    std::vector<Block> m_blocks;
+    std::vector<ULONGLONG> m_consumed;
+    ULONGLONG m_ullProduced = 0LL;
+    bool m_bClosed = false;
+};
+
+struct Output
+{
+    std::wstring path;
+    std::shared_ptr<FileStream> file;
+    std::shared_ptr<CryptoHashStream> hash;
+    std::shared_ptr<ByteStream> stream;  // 'hash' if any, 'file' otherwise
+    bool bFailed = false;
+    bool bPendingSize = false;  // last blocks were skipped, file size must be adjusted
+};
+
+bool IsZeroBlock(const BYTE* pData, size_t size)
+{
+    size_t i = 0;
+    for (; i + sizeof(ULONGLONG) <= size; i += sizeof(ULONGLONG))
+    {
+        ULONGLONG value;
+        memcpy(&value, pData + i, sizeof(value));
+        if (value != 0LL)
+        {
+            return false;
+        }
+    }
+
+    for (; i < size; ++i)
+    {
+        if (pData[i] != 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void WriteStage(BlockPipeline& pipeline, size_t consumer, Output& output, bool bSparse)
+{
+    while (const auto block = pipeline.BeginRead(consumer))
+    {
+        if (!output.bFailed && bSparse && block->bZero)
+        {
+            // Zero blocks are not allocated in the sparse output, the hash must still account for them
+            if (output.hash)
+            {
+                if (auto hr = output.hash->HashWithoutWriting(
+                        block->buffer.GetData(), static_cast<DWORD>(block->ullSize));
+                    FAILED(hr))
+                {
+                    Log::Error(
+                        L"Failed to hash {} bytes for output stream '{}' [{}]",
+                        block->ullSize,
+                        output.path,
+                        SystemError(hr));
+                    output.bFailed = true;
+                }
+            }
+
+            if (!output.bFailed)
+            {
+                if (auto hr = output.file->SetFilePointer(block->ullSize, FILE_CURRENT, nullptr); FAILED(hr))
+                {
+                    Log::Error(
+                        L"Failed to skip {} bytes in output stream '{}' [{}]",
+                        block->ullSize,
+                        output.path,
+                        SystemError(hr));
+                    output.bFailed = true;
+                }
+            }
+
+            output.bPendingSize = true;
+        }
+        else if (!output.bFailed)
+        {
+            ULONGLONG ullWritten = 0LL;
+            if (auto hr = output.stream->Write(block->buffer.GetData(), block->ullSize, &ullWritten); FAILED(hr))
+            {
+                Log::Error(
+                    L"Failed to write {} bytes to output stream '{}' [{}]",
+                    block->ullSize,
+                    output.path,
+                    SystemError(hr));
+                output.bFailed = true;
+            }
+
+            output.bPendingSize = false;
+        }
+
+        pipeline.EndRead(consumer);
+    }
+
+    if (output.bPendingSize && !output.bFailed)
+    {
+        ULONG64 ullPosition = 0LL;
+        if (auto hr = output.file->SetFilePointer(0LL, FILE_CURRENT, &ullPosition); SUCCEEDED(hr))
+        {
+            if (auto hr = output.file->SetSize(ullPosition); FAILED(hr))
+            {
+                Log::Error(L"Failed to set size of output stream '{}' [{}]", output.path, SystemError(hr));
+            }
+        }
+    }
+}
+
+void HashStage(BlockPipeline& pipeline, size_t consumer, CryptoHashStream& hash)
+{
+    while (const auto block = pipeline.BeginRead(consumer))
+    {
+        ULONGLONG ullWritten = 0LL;
+        if (auto hr = hash.Write(block->buffer.GetData(), block->ullSize, &ullWritten); FAILED(hr))
+        {
+            Log::Error(L"Failed to hash {} bytes of input stream [{}]", block->ullSize, SystemError(hr));
+        }
+
+        pipeline.EndRead(consumer);
+    }
+}
+
+double ToMBPerSecond(ULONGLONG ullBytes, std::chrono::nanoseconds duration)
+{
+    if (duration.count() == 0)
+    {
+        return 0.0;
+    }
+
+    return (static_cast<double>(ullBytes) / (1024 * 1024)) / std::chrono::duration<double>(duration).count();
+}
+
+}  // namespace
+
 HRESULT Main::Run()
 {
-    std::shared_ptr<ByteStream> input_stream;
     std::shared_ptr<FileStream> input_file_stream = std::make_shared<FileStream>();
 
     HRESULT hr = loc_set.EnumerateLocations();
@@ -69,59 +300,65 @@ HRESULT Main::Run()
             ullMaxBytes - (config.Skip.QuadPart * config.BlockSize.QuadPart));
     }
 
+    // Input is hashed by its own stage of the pipeline
+    std::shared_ptr<CryptoHashStream> input_hash_stream;
     if (config.Hash != CryptoHashStream::Algorithm::Undefined)
     {
-        auto hash_stream = std::make_shared<CryptoHashStream>();
-        auto hr = hash_stream->OpenToRead(config.Hash, input_file_stream);
+        input_hash_stream = std::make_shared<CryptoHashStream>();
+        auto hr = input_hash_stream->OpenToWrite(config.Hash, nullptr);
         if (FAILED(hr))
         {
             Log::Critical("Failed to open hash stream for input [{}]", SystemError(hr));
             return hr;
         }
-
-        input_stream = hash_stream;
-    }
-    else
-    {
-        input_stream = input_file_stream;
     }
 
-    std::vector<std::pair<std::wstring, std::shared_ptr<ByteStream>>> output_streams;
+    std::vector<Output> output_streams;
     bool bValidOutput = false;
     for (const auto& out : config.OF)
     {
-        std::shared_ptr<ByteStream> out_stream;
+        Output output;
+        output.path = out;
 
-        auto out_file_stream = std::make_shared<FileStream>();
+        std::shared_ptr<FileStream> out_file_stream;
+        if (config.Sparse)
+        {
+            out_file_stream = std::make_shared<SparseStream>();
+        }
+        else
+        {
+            out_file_stream = std::make_shared<FileStream>();
+        }
 
         if (auto hr = out_file_stream->OpenFile(
                 out.c_str(), GENERIC_WRITE, 0L, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
             FAILED(hr))
         {
             Log::Warn(L"Failed to open '{}' for write [{}]", config.strIF, SystemError(hr));
-            out_stream = out_file_stream = nullptr;
         }
         else
         {
+            output.file = out_file_stream;
+
             if (config.Hash != CryptoHashStream::Algorithm::Undefined)
             {
-                auto hash_stream = std::make_shared<CryptoHashStream>();
+                output.hash = std::make_shared<CryptoHashStream>();
 
-                if (auto hr = hash_stream->OpenToWrite(config.Hash, out_file_stream); FAILED(hr))
+                if (auto hr = output.hash->OpenToWrite(config.Hash, out_file_stream); FAILED(hr))
                 {
                     Log::Error(L"Failed to open hash stream '{}' for input [{}]", out, SystemError(hr));
                     return hr;
                 }
-                out_stream = hash_stream;
+                output.stream = output.hash;
             }
             else
             {
-                out_stream = out_file_stream;
+                output.stream = out_file_stream;
             }
             bValidOutput = true;
         }
 
-        output_streams.push_back(std::make_pair(out, out_stream));
+        output_streams.push_back(std::move(output));
     }
 
     if (!bValidOutput)
@@ -134,7 +371,7 @@ HRESULT Main::Run()
 
     if (config.Skip.QuadPart > 0LL)
     {
-        if (auto hr = input_stream->SetFilePointer(
+        if (auto hr = input_file_stream->SetFilePointer(
                 config.BlockSize.QuadPart * config.Skip.QuadPart, FILE_BEGIN, &ullCurrentCursor);
             FAILED(hr))
         {
@@ -146,33 +383,34 @@ HRESULT Main::Run()
             return hr;
         }
     }
-    if (config.Seek.QuadPart > 0LL)
+    // Skipped zero blocks must land on unallocated ranges: sparse outputs are always truncated
+    if (config.Seek.QuadPart > 0LL || config.Sparse)
     {
         for (const auto& out : output_streams)
         {
-            if (out.second != nullptr)
+            if (out.stream != nullptr)
             {
                 if (config.NoTrunc)
                 {
-                    if (auto hr = out.second->SetFilePointer(
+                    if (auto hr = out.stream->SetFilePointer(
                             config.BlockSize.QuadPart * config.Seek.QuadPart, FILE_BEGIN, nullptr);
                         FAILED(hr))
                     {
                         Log::Warn(
                             L"Failed to seek {} bytes in output stream '{}' [{}]",
                             config.BlockSize.QuadPart * config.Seek.QuadPart,
-                            out.first,
+                            out.path,
                             SystemError(hr));
                     }
                 }
                 else
                 {
-                    if (auto hr = out.second->SetSize(config.BlockSize.QuadPart * config.Seek.QuadPart); FAILED(hr))
+                    if (auto hr = out.stream->SetSize(config.BlockSize.QuadPart * config.Seek.QuadPart); FAILED(hr))
                     {
                         Log::Warn(
                             L"Failed to truncate {} in bytesoutput stream '{}' [{}]",
                             config.BlockSize.QuadPart * config.Seek.QuadPart,
-                            out.first,
+                            out.path,
                             SystemError(hr));
                     }
                 }
@@ -180,36 +418,60 @@ HRESULT Main::Run()
         }
     }
 
-    CBinaryBuffer buffer(true);
-    buffer.SetCount(config.BlockSize.LowPart);
+    // Read, hash and write stages run concurrently on a ring of blocks: one consumer per valid output, plus the input
+    // hash if any
+    std::vector<size_t> writers;
+    for (size_t i = 0; i < output_streams.size(); ++i)
+    {
+        if (output_streams[i].stream != nullptr)
+        {
+            writers.push_back(i);
+        }
+    }
+
+    const size_t consumers = writers.size() + (input_hash_stream ? 1 : 0);
+    BlockPipeline pipeline(config.Buffers, config.BlockSize.LowPart, consumers);
+
+    std::vector<std::thread> stages;
+    for (size_t i = 0; i < writers.size(); ++i)
+    {
+        stages.emplace_back(WriteStage, std::ref(pipeline), i, std::ref(output_streams[writers[i]]), config.Sparse);
+    }
+
+    if (input_hash_stream)
+    {
+        stages.emplace_back(HashStage, std::ref(pipeline), writers.size(), std::ref(*input_hash_stream));
+    }
 
     auto ullBlockCount = 0LLU;
     auto ullProgressBytes = 0LLU;
+    auto ullZeroBlockCount = 0LLU;
     auto ullAbsoluteOffset = config.Skip.QuadPart;
-    SHORT Progress = 0;
 
+    auto ullLastProgressBytes = 0LLU;
     auto start = std::chrono::system_clock::now();
+    auto lastProgress = start;
 
     FILETIME theStartTime;
     GetSystemTimeAsFileTime(&theStartTime);
 
-    while (1)
+    while (config.Count.QuadPart == 0LL || ullBlockCount < config.Count.QuadPart)
     {
-        auto blockStart = std::chrono::system_clock::now();
+        auto& block = pipeline.BeginWrite();
 
         ULONGLONG ullRead = 0LL;
-        if (auto hr = input_stream->Read(buffer.GetData(), buffer.GetCount(), &ullRead); FAILED(hr))
+        if (auto hr = input_file_stream->Read(block.buffer.GetData(), block.buffer.GetCount(), &ullRead); FAILED(hr))
         {
             if (config.NoError)
             {
-                ZeroMemory(buffer.GetData(), buffer.GetCount());
+                ZeroMemory(block.buffer.GetData(), block.buffer.GetCount());
                 ullRead = config.BlockSize.QuadPart;
                 if (auto hr = input_file_stream->SetFilePointer(config.BlockSize.QuadPart, FILE_CURRENT, NULL);
                     FAILED(hr))
                 {
                     Log::Error(
                         L"Failed to seek to {} bytes offset after error with '{}' (absolute offset {})",
-                        buffer.GetCount(),
+                        block.buffer.GetCount(),
                         config.strIF,
                         ullAbsoluteOffset);
                     break;
@@ -219,7 +481,7 @@ HRESULT Main::Run()
             {
                 Log::Error(
                     L"Failed to read {} bytes from input stream {} (absolute offset {})",
-                    buffer.GetCount(),
+                    block.buffer.GetCount(),
                     config.strIF,
                     ullAbsoluteOffset);
                 break;
@@ -231,63 +493,67 @@ HRESULT Main::Run()
             Log::Debug("Done reading from input stream");
             break;
         }
-        else
-        {
-            ullCurrentCursor += ullRead;
-            auto ullNewCursor = 0LLU;
-            if (auto hr = input_stream->SetFilePointer(ullCurrentCursor, FILE_BEGIN, &ullNewCursor); FAILED(hr))
-            {
-                Log::Error("Failed to seek to {} offset", ullCurrentCursor);
-            }
-            assert(ullNewCursor == ullCurrentCursor);
-        }
-
-        for (const auto& output : output_streams)
-        {
-            ULONGLONG ullWritten = 0LL;
-            auto hr = E_FAIL;
-            if (output.second != nullptr && FAILED(hr = output.second->Write(buffer.GetData(), ullRead, &ullWritten)))
-            {
-                Log::Error(L"Failed to write {} bytes to output stream '{}'", buffer.GetCount(), output.first);
-            }
-        }
 
-        auto nowEnd = std::chrono::system_clock::now();
-        std::chrono::nanoseconds blockDuration(nowEnd - blockStart);
-        std::chrono::nanoseconds totalDuration(nowEnd - start);
+        block.ullSize = ullRead;
+        block.bZero = config.Sparse && IsZeroBlock(block.buffer.GetData(), static_cast<size_t>(ullRead));
+        pipeline.EndWrite();
 
         ullBlockCount++;
         ullProgressBytes += ullRead;
         ullAbsoluteOffset += ullRead;
-
-        double dblTXnow = (((double)config.BlockSize.QuadPart) / blockDuration.count()) * 1000;
-        double dblTXaverage = (((double)(config.BlockSize.QuadPart * ullBlockCount)) / totalDuration.count()) * 1000;
-
-        WCHAR szProgress[10];
-        if (ullTotalBytes > 0)
+        if (block.bZero)
         {
-            swprintf_s(szProgress, 10, L"%2.0f%% : ", ((double)ullProgressBytes / ullTotalBytes) * 100);
+            ullZeroBlockCount++;
         }
-        else
-            szProgress[0] = L'\0';
-
-        m_console.Print(
-            L"{}% {} blocks of {} bytes copied ({} Mbytes) (now: {} MB/sec, average: {} MB/sec)",
-            szProgress,
-            ullBlockCount,
-            std::min(config.BlockSize.QuadPart, ullRead),
-            ullProgressBytes / (1024 * 1024),
-            dblTXnow,
-            dblTXaverage);
-
-        if (config.Count.QuadPart > 0LL && ullBlockCount >= config.Count.QuadPart)
+
+        auto now = std::chrono::system_clock::now();
+        if (now - lastProgress >= std::chrono::seconds(1))
         {
-            Log::Debug("Read accounted blocks from input stream");
-            break;
+            WCHAR szProgress[10];
+            if (ullTotalBytes > 0)
+            {
+                swprintf_s(szProgress, 10, L"%2.0f%% : ", ((double)ullProgressBytes / ullTotalBytes) * 100);
+            }
+            else
+                szProgress[0] = L'\0';
+
+            m_console.Print(
+                L"{}{} blocks of {} bytes read ({} Mbytes) (now: {:.1f} MB/sec, average: {:.1f} MB/sec)",
+                szProgress,
+                ullBlockCount,
+                config.BlockSize.QuadPart,
+                ullProgressBytes / (1024 * 1024),
+                ToMBPerSecond(ullProgressBytes - ullLastProgressBytes, now - lastProgress),
+                ToMBPerSecond(ullProgressBytes, now - start));
+
+            lastProgress = now;
+            ullLastProgressBytes = ullProgressBytes;
         }
     }
 
-    if (auto hr = input_stream->Close(); FAILED(hr))
+    if (config.Count.QuadPart > 0LL && ullBlockCount >= config.Count.QuadPart)
+    {
+        Log::Debug("Read accounted blocks from input stream");
+    }
+
+    // Wait for the hash and write stages to drain the pipeline
+    pipeline.Close();
+    for (auto& stage : stages)
+    {
+        stage.join();
+    }
+
+    const auto duration = std::chrono::system_clock::now() - start;
+    m_console.Print(
+        L"{} blocks of {} bytes copied ({} Mbytes, {} zero blocks) in {} ms (sustained: {:.1f} MB/sec)",
+        ullBlockCount,
+        config.BlockSize.QuadPart,
+        ullProgressBytes / (1024 * 1024),
+        ullZeroBlockCount,
+        std::chrono::duration_cast<std::chrono::milliseconds>(duration).count(),
+        ToMBPerSecond(ullProgressBytes, duration));
+
+    if (auto hr = input_file_stream->Close(); FAILED(hr))
     {
         Log::Error(L"Failed to close input stream '{}' [{}]", config.strIF, SystemError(hr));
         return hr;
@@ -296,9 +562,9 @@ HRESULT Main::Run()
     for (const auto& output : output_streams)
     {
         auto hr = E_FAIL;
-        if (output.second != nullptr && FAILED(hr = output.second->Close()))
+        if (output.stream != nullptr && FAILED(hr = output.stream->Close()))
         {
-            Log::Error(L"Failed to close input stream '{}'", output.first);
+            Log::Error(L"Failed to close input stream '{}'", output.path);
         }
     }
 
@@ -311,20 +577,19 @@ HRESULT Main::Run()
     {
         auto& output = *writer;
 
-        auto input_hashstream = std::dynamic_pointer_cast<CryptoHashStream>(ByteStream::GetHashStream(input_stream));
         CBinaryBuffer inMD5, inSHA1, inSHA256;
-        if (input_hashstream)
+        if (input_hash_stream)
         {
-            input_hashstream->GetMD5(inMD5);
-            input_hashstream->GetSHA1(inSHA1);
-            input_hashstream->GetSHA256(inSHA256);
+            input_hash_stream->GetMD5(inMD5);
+            input_hash_stream->GetSHA1(inSHA1);
+            input_hash_stream->GetSHA256(inSHA256);
         }
 
         for (const auto& out : output_streams)
         {
             SystemDetails::WriteComputerName(output);
             output.WriteString(config.strIF.c_str());
-            output.WriteString(out.first.c_str());
+            output.WriteString(out.path.c_str());
             output.WriteInteger(config.BlockSize.QuadPart);
             output.WriteInteger(config.Skip.QuadPart);
             output.WriteInteger(config.Seek.QuadPart);
@@ -351,13 +616,12 @@ HRESULT Main::Run()
             else
                 output.WriteNothing();
 
-            auto hashstream = std::dynamic_pointer_cast<CryptoHashStream>(ByteStream::GetHashStream(out.second));
-            if (hashstream)
+            if (out.hash && !out.bFailed)
             {
                 CBinaryBuffer MD5, SHA1, SHA256;
-                hashstream->GetMD5(MD5);
-                hashstream->GetSHA1(SHA1);
-                hashstream->GetSHA256(SHA256);
+                out.hash->GetMD5(MD5);
+                out.hash->GetSHA1(SHA1);
+                out.hash->GetSHA256(SHA256);
 
                 output.WriteBytes(MD5);
                 output.WriteBytes(SHA1);
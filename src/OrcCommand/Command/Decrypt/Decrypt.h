@@ -0,0 +1,79 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#pragma once
+
+#include "OrcCommand.h"
+
+#include "UtilitiesMain.h"
+
+#pragma managed(push, off)
+
+namespace Orc {
+
+namespace Command::Decrypt {
+
+class ORCUTILS_API Main : public UtilitiesMain
+{
+
+public:
+    class Configuration : public UtilitiesMain::Configuration
+    {
+    public:
+        std::wstring strInputFile;
+        std::wstring strOutputFile;
+
+        // PKCS#12 file with the recipient private key, the current user 'MY' store is used when empty
+        std::wstring strKeyFile;
+        std::wstring strPassword;
+    };
+
+private:
+    Configuration config;
+
+    ULONGLONG m_ullDecrypted = 0LL;
+
+public:
+    static LPCWSTR ToolName() { return L"Decrypt"; }
+    static LPCWSTR ToolDescription() { return L"Decrypt archives encrypted with authenticated encryption"; }
+
+    static ConfigItem::InitFunction GetXmlConfigBuilder() { return nullptr; }
+    static LPCWSTR DefaultConfiguration() { return nullptr; }
+    static LPCWSTR ConfigurationExtension() { return nullptr; }
+
+    static ConfigItem::InitFunction GetXmlLocalConfigBuilder() { return nullptr; }
+    static LPCWSTR LocalConfiguration() { return nullptr; }
+    static LPCWSTR LocalConfigurationExtension() { return nullptr; }
+
+    static LPCWSTR DefaultSchema() { return nullptr; }
+
+    Main()
+        : UtilitiesMain()
+    {
+    }
+
+    void PrintUsage();
+    void PrintParameters();
+    void PrintFooter();
+
+    HRESULT CheckConfiguration();
+
+    HRESULT GetSchemaFromConfig(const ConfigItem& schemaitem) { return S_OK; };  // No Schema support
+    HRESULT GetConfigurationFromConfig(const ConfigItem& configitem) { return S_OK; };  // No Configuration support
+    HRESULT GetLocalConfigurationFromConfig(const ConfigItem& configitem)
+    {
+        return S_OK;
+    };  // No Local Configuration support
+
+    HRESULT GetConfigurationFromArgcArgv(int argc, const WCHAR* argv[]);
+
+    HRESULT Run();
+};
+}  // namespace Command::Decrypt
+}  // namespace Orc
+
+#pragma managed(pop)
@@ -0,0 +1,88 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+
+#include "stdafx.h"
+
+#include "Decrypt.h"
+
+#include "AeadStream.h"
+
+#include <filesystem>
+
+#include <boost/algorithm/string.hpp>
+
+using namespace Orc;
+using namespace Orc::Command::Decrypt;
+
+HRESULT Main::GetConfigurationFromArgcArgv(int argc, LPCWSTR argv[])
+{
+    UtilitiesLoggerConfiguration::Parse(argc, argv, m_utilitiesConfig.log);
+
+    for (int i = 1; i < argc; i++)
+    {
+        switch (argv[i][0])
+        {
+            case L'/':
+            case L'-':
+                if (InputFileOption(argv[i] + 1, L"In", config.strInputFile))
+                    ;
+                else if (OutputFileOption(argv[i] + 1, L"Out", config.strOutputFile))
+                    ;
+                else if (InputFileOption(argv[i] + 1, L"Key", config.strKeyFile))
+                    ;
+                else if (ParameterOption(argv[i] + 1, L"Password", config.strPassword))
+                    ;
+                else if (UsageOption(argv[i] + 1))
+                    ;
+                else if (IgnoreCommonOptions(argv[i] + 1))
+                    ;
+                else
+                {
+                    Log::Error(L"Failed to parse command line item: '{}'", argv[i] + 1);
+                    PrintUsage();
+                    return E_INVALIDARG;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return S_OK;
+}
+
+HRESULT Main::CheckConfiguration()
+{
+    UtilitiesLoggerConfiguration::Apply(m_logging, m_utilitiesConfig.log);
+
+    if (config.strInputFile.empty())
+    {
+        Log::Error("No input file passed");
+        return E_INVALIDARG;
+    }
+
+    const std::filesystem::path input(config.strInputFile);
+    const bool bHasExtension = boost::iequals(input.extension().c_str(), AeadStream::kFileExtension);
+    if (!bHasExtension)
+    {
+        Log::Warn(L"Input file '{}' has no '{}' extension", config.strInputFile, AeadStream::kFileExtension);
+    }
+
+    if (config.strOutputFile.empty())
+    {
+        if (!bHasExtension)
+        {
+            Log::Error("No output file passed");
+            return E_INVALIDARG;
+        }
+
+        // WolfLauncher appends the extension to the archive name
+        config.strOutputFile = std::filesystem::path(input).replace_extension().wstring();
+    }
+
+    return S_OK;
+}
@@ -0,0 +1,70 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+
+#include "stdafx.h"
+
+#include "Decrypt.h"
+
+#include "ToolVersion.h"
+
+#include "Usage.h"
+
+#include "Text/Fmt/formatter.h"
+#include "Text/Fmt/ByteQuantity.h"
+
+using namespace Orc;
+using namespace Orc::Command::Decrypt;
+
+void Main::PrintUsage()
+{
+    auto usageNode = m_console.OutputTree();
+
+    Usage::PrintHeader(
+        usageNode,
+        "Usage: DFIR-Orc.exe Decrypt /In=<Archive.aead> [/Out=<File>] [/Key=<Key.pfx>] [/Password=<Password>]",
+        "Decrypt an archive encrypted by WolfLauncher with '/aead_encryption'");
+
+    constexpr std::array kSpecificParameters = {
+        Usage::Parameter {"/In=<Archive.aead>", "Encrypted archive"},
+        Usage::Parameter {"/Out=<File>", "Decrypted archive (default: input file without its '.aead' extension)"},
+        Usage::Parameter {
+            "/Key=<Key.pfx>", "PKCS#12 file with a recipient private key (default: current user certificate store)"},
+        Usage::Parameter {"/Password=<Password>", "Password of the PKCS#12 file"},
+    };
+
+    Usage::PrintParameters(usageNode, "PARAMETERS", kSpecificParameters);
+
+    Usage::PrintLoggingParameters(usageNode);
+}
+
+void Main::PrintParameters()
+{
+    auto root = m_console.OutputTree();
+    auto node = root.AddNode("Parameters");
+
+    PrintCommonParameters(node);
+
+    PrintValue(node, L"Input", config.strInputFile);
+    PrintValue(node, L"Output", config.strOutputFile);
+    PrintValue(node, L"Key", config.strKeyFile.empty() ? L"<current user store>" : config.strKeyFile);
+
+    m_console.PrintNewLine();
+}
+
+void Main::PrintFooter()
+{
+    m_console.PrintNewLine();
+
+    auto root = m_console.OutputTree();
+    auto node = root.AddNode("Statistics");
+    PrintCommonFooter(node);
+
+    PrintValue(node, L"Decrypted", Traits::ByteQuantity(m_ullDecrypted));
+
+    m_console.PrintNewLine();
+}
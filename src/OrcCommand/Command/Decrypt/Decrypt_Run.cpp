@@ -0,0 +1,184 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+
+#include "stdafx.h"
+
+#include "Decrypt.h"
+
+#include "AeadStream.h"
+#include "FileStream.h"
+#include "Utils/MapFile.h"
+
+#include <boost/scope_exit.hpp>
+
+using namespace Orc;
+using namespace Orc::Command::Decrypt;
+
+namespace {
+
+constexpr DWORD kReadBufferSize = 4 * 1024 * 1024;
+
+HCERTSTORE OpenKeyStore(const std::wstring& keyFile, const std::wstring& password)
+{
+    if (keyFile.empty())
+    {
+        HCERTSTORE hStore = CertOpenStore(
+            CERT_STORE_PROV_SYSTEM_W,
+            0L,
+            NULL,
+            CERT_SYSTEM_STORE_CURRENT_USER | CERT_STORE_READONLY_FLAG,
+            L"MY");
+        if (hStore == NULL)
+        {
+            Log::Error("Failed to open current user certificate store [{}]", LastWin32Error());
+        }
+        return hStore;
+    }
+
+    auto pfx = MapFile(keyFile);
+    if (pfx.has_error())
+    {
+        Log::Error(L"Failed to read key file '{}' [{}]", keyFile, pfx.error());
+        return NULL;
+    }
+
+    CRYPT_DATA_BLOB blob;
+    blob.cbData = static_cast<DWORD>(pfx->size());
+    blob.pbData = pfx->data();
+
+    HCERTSTORE hStore = PFXImportCertStore(&blob, password.c_str(), CRYPT_USER_KEYSET);
+    if (hStore == NULL)
+    {
+        Log::Error(L"Failed to import key file '{}' [{}]", keyFile, LastWin32Error());
+    }
+    return hStore;
+}
+
+// PFXImportCertStore saves the imported private keys in the user profile: they must not outlive the decryption
+void DeleteImportedKeys(HCERTSTORE hStore)
+{
+    PCCERT_CONTEXT pCertContext = NULL;
+    while ((pCertContext = CertEnumCertificatesInStore(hStore, pCertContext)) != NULL)
+    {
+        DWORD cbData = 0L;
+        if (!CertGetCertificateContextProperty(pCertContext, CERT_KEY_PROV_INFO_PROP_ID, NULL, &cbData))
+            continue;
+
+        std::vector<BYTE> info(cbData);
+        if (!CertGetCertificateContextProperty(pCertContext, CERT_KEY_PROV_INFO_PROP_ID, info.data(), &cbData))
+            continue;
+
+        const auto pInfo = reinterpret_cast<const CRYPT_KEY_PROV_INFO*>(info.data());
+
+        HCRYPTPROV hProv = NULL;
+        if (!CryptAcquireContextW(
+                &hProv,
+                pInfo->pwszContainerName,
+                pInfo->pwszProvName,
+                pInfo->dwProvType,
+                CRYPT_DELETEKEYSET | (pInfo->dwFlags & CRYPT_MACHINE_KEYSET)))
+        {
+            Log::Error(
+                L"Failed to delete imported key container '{}' [{}]", pInfo->pwszContainerName, LastWin32Error());
+        }
+    }
+}
+
+}  // namespace
+
+HRESULT Main::Run()
+{
+    HRESULT hr = E_FAIL;
+
+    HCERTSTORE hKeyStore = ::OpenKeyStore(config.strKeyFile, config.strPassword);
+    if (hKeyStore == NULL)
+        return E_FAIL;
+
+    const bool bImportedKeys = !config.strKeyFile.empty();
+    BOOST_SCOPE_EXIT(hKeyStore, bImportedKeys)
+    {
+        if (bImportedKeys)
+            ::DeleteImportedKeys(hKeyStore);
+        CertCloseStore(hKeyStore, 0L);
+    }
+    BOOST_SCOPE_EXIT_END;
+
+    auto inputStream = std::make_shared<FileStream>();
+    if (FAILED(hr = inputStream->ReadFrom(config.strInputFile.c_str())))
+    {
+        Log::Critical(L"Failed to open '{}' to read data [{}]", config.strInputFile, SystemError(hr));
+        return hr;
+    }
+
+    auto outputStream = std::make_shared<FileStream>();
+    if (FAILED(hr = outputStream->WriteTo(config.strOutputFile.c_str())))
+    {
+        Log::Critical(L"Failed to open '{}' to write data [{}]", config.strOutputFile, SystemError(hr));
+        return hr;
+    }
+
+    // Plain text is only authenticated once the whole archive is decrypted: nothing is left behind on failure
+    bool bDecrypted = false;
+    const auto& outputFile = config.strOutputFile;
+    BOOST_SCOPE_EXIT(&bDecrypted, &outputStream, &outputFile)
+    {
+        if (!bDecrypted)
+        {
+            outputStream->Close();
+            if (!DeleteFile(outputFile.c_str()))
+            {
+                Log::Error(L"Failed to delete partially decrypted file '{}' [{}]", outputFile, LastWin32Error());
+            }
+        }
+    }
+    BOOST_SCOPE_EXIT_END;
+
+    auto decryptStream = std::make_shared<AeadDecryptStream>();
+    if (FAILED(hr = decryptStream->Initialize(hKeyStore, outputStream)))
+    {
+        Log::Critical(L"Failed to initialize decryption [{}]", SystemError(hr));
+        return hr;
+    }
+
+    CBinaryBuffer buffer;
+    if (!buffer.SetCount(kReadBufferSize))
+        return E_OUTOFMEMORY;
+
+    for (;;)
+    {
+        ULONGLONG ullRead = 0LL;
+        if (FAILED(hr = inputStream->Read(buffer.GetData(), kReadBufferSize, &ullRead)))
+        {
+            Log::Critical(L"Failed to read from '{}' [{}]", config.strInputFile, SystemError(hr));
+            return hr;
+        }
+
+        if (ullRead == 0LL)
+            break;
+
+        ULONGLONG ullWritten = 0LL;
+        if (FAILED(hr = decryptStream->Write(buffer.GetData(), ullRead, &ullWritten)))
+        {
+            Log::Critical(L"Failed to decrypt '{}' [{}]", config.strInputFile, SystemError(hr));
+            return hr;
+        }
+    }
+
+    if (FAILED(hr = decryptStream->Close()))
+    {
+        Log::Critical(L"Failed to decrypt '{}' [{}]", config.strInputFile, SystemError(hr));
+        return hr;
+    }
+
+    bDecrypted = true;
+    inputStream->Close();
+
+    std::error_code ec;
+    m_ullDecrypted = std::filesystem::file_size(config.strOutputFile, ec);
+    return S_OK;
+}
@@ -260,6 +260,8 @@ public:
 
         std::wstring YaraSource;
         std::unique_ptr<YaraConfig> Yara;
+
+        std::wstring strMFTIndexDirectory;
         std::vector<std::wstring> inputFilesystemLocations;
 
         Configuration()
@@ -419,6 +419,10 @@ HRESULT Main::GetConfigurationFromArgcArgv(int argc, LPCWSTR argv[])
                                  OutputSpec::Kind::Directory | OutputSpec::Kind::StructuredFile),
                              config.outStructured))
                     ;
+                else if (ParameterOption(argv[i] + 1, L"MFTIndex", config.strMFTIndexDirectory))
+                {
+                    config.FileSystem.Files.SetIndexDirectory(config.strMFTIndexDirectory);
+                }
                 else if (ParameterOption(argv[i] + 1, L"Yara", config.YaraSource))
                 {
                     if (!config.Yara)
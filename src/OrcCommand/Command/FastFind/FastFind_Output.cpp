@@ -40,7 +40,10 @@ void Main::PrintUsage()
             "/Names=<Name>", "Add additional names to search terms (Kernel32.dll,nt*.sys,:ADSName,*.txt#EAName)"},
         Usage::Parameter {"/Version=<Description>", "Add a custom version description to the output"},
         Usage::Parameter {"/SkipDeleted", "Do not attempt to match against deleted records"},
-        Usage::Parameter {"/Yara", "Add rules files for Yara scan"}};
+        Usage::Parameter {"/Yara", "Add rules files for Yara scan"},
+        Usage::Parameter {
+            "/MFTIndex=<Directory>",
+            "Keep an index of each volume MFT in this directory to speed up later name and size searches"}};
 
     Usage::PrintParameters(usageNode, "PARAMETERS", kSpecificParameters);
 
@@ -147,6 +147,8 @@ public:
         std::wstring YaraSource;
         std::unique_ptr<YaraConfig> Yara;
 
+        std::wstring strMFTIndexDirectory;
+
         CryptoHashStream::Algorithm CryptoHashAlgs =
             CryptoHashStream::Algorithm::MD5 | CryptoHashStream::Algorithm::SHA1;
         FuzzyHashStream::Algorithm FuzzyHashAlgs = FuzzyHashStream::Algorithm::Undefined;
@@ -468,6 +468,8 @@ HRESULT Main::GetConfigurationFromArgcArgv(int argc, LPCWSTR argv[])
                             config.Yara = std::make_unique<YaraConfig>();
                         boost::split(config.Yara->Sources(), config.YaraSource, boost::is_any_of(";,"));
                     }
+                    else if (ParameterOption(argv[i] + 1, L"MFTIndex", config.strMFTIndexDirectory))
+                        ;
                     else if (EncodingOption(argv[i] + 1, config.Output.OutputEncoding))
                         ;
                     else if (ProcessPriorityOption(argv[i] + 1))
@@ -578,6 +580,11 @@ HRESULT Main::CheckConfiguration()
         end(config.listOfExclusions),
         [this](const std::shared_ptr<FileFind::SearchTerm>& aTerm) { FileFinder.AddExcludeTerm(aTerm); });
 
+    if (!config.strMFTIndexDirectory.empty())
+    {
+        FileFinder.SetIndexDirectory(config.strMFTIndexDirectory);
+    }
+
     // TODO: make a function to use also in GetSamples_config.cpp
     if (!config.limits.bIgnoreLimits
         && (!config.limits.dwlMaxTotalBytes.has_value() && !config.limits.dwMaxSampleCount.has_value()))
@@ -9,7 +9,10 @@
 
 #include "UtilitiesMain.h"
 
+#include <atomic>
+#include <mutex>
 #include <optional>
+#include <unordered_set>
 
 #include <boost/logic/tribool.hpp>
 
@@ -18,6 +21,7 @@
 #include "LocationOutput.h"
 #include "VolumeReader.h"
 #include "MFTWalker.h"
+#include "MFTIndex.h"
 #include "NtfsFileInfo.h"
 #include "Authenticode.h"
 #include "Configuration/ShadowsParserOption.h"
@@ -57,6 +61,17 @@ public:
         std::optional<std::wstring> secDescr;
     };
 
+    // Record of the previous incremental run deleted since then
+    struct Tombstone
+    {
+        ULONGLONG VolumeSerialNumber;
+        ULONGLONG FRN;
+        ULONGLONG ParentFRN;
+        USN Usn;
+        DWORD Reason;
+        std::wstring FileName;
+    };
+
     class Configuration : public UtilitiesMain::Configuration
     {
     public:
@@ -74,6 +89,8 @@ public:
                 OutputSpec::Kind::TableFile | OutputSpec::Kind::Directory | OutputSpec::Kind::Archive);
             volumesStatsOutput.supportedTypes = static_cast<OutputSpec::Kind>(
                 OutputSpec::Kind::Directory | OutputSpec::Kind::TableFile | OutputSpec::Kind::Archive);
+            tombstonesOutput.supportedTypes = static_cast<OutputSpec::Kind>(
+                OutputSpec::Kind::Directory | OutputSpec::Kind::TableFile | OutputSpec::Kind::Archive);
             outTimeLine.supportedTypes = static_cast<OutputSpec::Kind>(
                 OutputSpec::Kind::TableFile | OutputSpec::Kind::Directory | OutputSpec::Kind::Archive);
             outAttrInfo.supportedTypes = static_cast<OutputSpec::Kind>(
@@ -82,6 +99,12 @@ public:
                 OutputSpec::Kind::TableFile | OutputSpec::Kind::Directory | OutputSpec::Kind::Archive);
             outSecDescrInfo.supportedTypes = static_cast<OutputSpec::Kind>(
                 OutputSpec::Kind::TableFile | OutputSpec::Kind::Directory | OutputSpec::Kind::Archive);
+
+            // Rows are written by an I/O thread so that the MFT walk does not wait on the output files
+            for (auto output : {&outFileInfo, &outTimeLine, &outAttrInfo, &outI30Info, &outSecDescrInfo})
+            {
+                output->dwAsyncBufferCount = 2;
+            }
         };
 
         std::wstring strWalker;
@@ -89,6 +112,7 @@ public:
         // Output Specification
         OutputSpec outFileInfo;
         OutputSpec volumesStatsOutput;
+        OutputSpec tombstonesOutput;
 
         OutputSpec outTimeLine;
         OutputSpec outAttrInfo;
@@ -110,6 +134,18 @@ public:
         Intentions DefaultIntentions;
         std::vector<Filter> Filters;
         std::vector<std::wstring> InputLocations;
+
+        // Maximum number of physical drives parsed concurrently
+        DWORD dwMaxLocationThreads = 1L;
+
+        // Soft limit of each MFT walk beyond which pending record cells spill to a temporary file (0: no limit)
+        DWORDLONG ullMemoryLimit = 0LL;
+
+        // Where the MFT index of each mounted volume is kept between incremental runs
+        std::wstring strIncrementalDirectory;
+
+        // CatRoot directory whose catalogs resolve catalog signatures (ex: of an offline image)
+        std::wstring strCatRootDirectory;
     };
 
 private:
@@ -123,13 +159,16 @@ private:
     MultipleOutput<LocationOutput> m_I30Output;
     MultipleOutput<LocationOutput> m_SecDescrOutput;
 
-    MFTWalker::FullNameBuilder m_FullNameBuilder;
-    DWORD dwTotalFileTreated;
+    std::atomic<DWORD> dwTotalFileTreated;
     DWORD m_dwProgress;
+    std::mutex m_consoleLock;
 
     std::shared_ptr<AuthenticodeCache> m_authenticodeCache;
     Authenticode m_codeVerifier;
 
+    std::mutex m_tombstonesLock;
+    std::vector<Tombstone> m_tombstones;
+
     HRESULT Prepare();
     HRESULT GetWriters(std::vector<std::shared_ptr<Location>>& locs);
 
@@ -142,6 +181,18 @@ private:
         const std::vector<std::shared_ptr<Location>>& locations,
         std::shared_ptr<TableOutput::IWriter>& newWriter);
 
+    HRESULT WriteTombstones(const OutputSpec& tombstonesSpec, std::shared_ptr<TableOutput::IWriter>& newWriter);
+
+    // Segment numbers changed since the previous incremental run and the ones to walk to build their names.
+    // S_FALSE when the journal no longer holds these changes or when a complete walk costs less.
+    HRESULT GetChangedRecords(
+        const std::shared_ptr<VolumeReader>& volreader,
+        const MFTIndex& previous,
+        const MFTIndex::VolumeState& state,
+        std::unordered_set<ULONGLONG>& changed,
+        std::unordered_set<ULONGLONG>& walked,
+        std::vector<Tombstone>& tombstones);
+
     HRESULT WriteTimeLineEntry(
         ITableOutput& pTimelineOutput,
         const std::shared_ptr<VolumeReader>& volreader,
@@ -165,6 +216,7 @@ private:
 
     HRESULT RunThroughUSNJournal();
     HRESULT RunThroughMFT();
+    HRESULT WalkLocation(const std::shared_ptr<Location>& loc, size_t index, bool bParallel);
 
     // USN Walkercallback
     void USNInformation(
@@ -178,12 +230,18 @@ private:
     void ElementInformation(ITableOutput& output, const std::shared_ptr<VolumeReader>& volreader, MFTRecord* pElt);
     void DirectoryInformation(
         ITableOutput& output,
+        const MFTWalker::FullNameBuilder& fullNameBuilder,
+        Authenticode& codeVerifier,
+        const std::shared_ptr<SecurityDescriptorTable>& securityDescriptors,
         const std::shared_ptr<VolumeReader>& volreader,
         MFTRecord* pElt,
         const PFILE_NAME pFileName,
         const std::shared_ptr<IndexAllocationAttribute>& pAttr);
     void FileAndDataInformation(
         ITableOutput& output,
+        const MFTWalker::FullNameBuilder& fullNameBuilder,
+        Authenticode& codeVerifier,
+        const std::shared_ptr<SecurityDescriptorTable>& securityDescriptors,
         const std::shared_ptr<VolumeReader>& volreader,
         MFTRecord* pElt,
         const PFILE_NAME pFileName,
@@ -273,6 +273,9 @@ HRESULT Main::GetSchemaFromConfig(const ConfigItem& schemaitem)
     config.volumesStatsOutput.Schema = TableOutput::GetColumnsFromConfig(
         config.volumesStatsOutput.TableKey.empty() ? L"volstats" : config.volumesStatsOutput.TableKey.c_str(),
         schemaitem);
+    config.tombstonesOutput.Schema = TableOutput::GetColumnsFromConfig(
+        config.tombstonesOutput.TableKey.empty() ? L"tombstones" : config.tombstonesOutput.TableKey.c_str(),
+        schemaitem);
     config.outAttrInfo.Schema = TableOutput::GetColumnsFromConfig(
         config.outAttrInfo.TableKey.empty() ? L"attrinfo" : config.outAttrInfo.TableKey.c_str(), schemaitem);
     config.outI30Info.Schema = TableOutput::GetColumnsFromConfig(
@@ -306,6 +309,14 @@ HRESULT Main::GetConfigurationFromArgcArgv(int argc, LPCWSTR argv[])
                             return E_INVALIDARG;
                         }
                     }
+                    else if (ParameterOption(argv[i] + 1, L"Parallel", config.dwMaxLocationThreads))
+                        ;
+                    else if (FileSizeOption(argv[i] + 1, L"MemoryLimit", config.ullMemoryLimit))
+                        ;
+                    else if (ParameterOption(argv[i] + 1, L"Incremental", config.strIncrementalDirectory))
+                        ;
+                    else if (ParameterOption(argv[i] + 1, L"CatRoot", config.strCatRootDirectory))
+                        ;
                     else if (ParameterOption(argv[i] + 1, L"Computer", m_utilitiesConfig.strComputerName))
                         ;
                     else if (OutputOption(argv[i] + 1, L"FileInfo", config.outFileInfo))
@@ -459,6 +470,16 @@ HRESULT Main::CheckConfiguration()
         config.volumesStatsOutput.Path = config.outFileInfo.Path;
         config.volumesStatsOutput.Type = config.outFileInfo.Type;
         config.volumesStatsOutput.OutputEncoding = config.outFileInfo.OutputEncoding;
+
+        config.tombstonesOutput.Path = config.outFileInfo.Path;
+        config.tombstonesOutput.Type = config.outFileInfo.Type;
+        config.tombstonesOutput.OutputEncoding = config.outFileInfo.OutputEncoding;
+    }
+
+    if (!config.strIncrementalDirectory.empty() && config.strWalker.compare(L"MFT") && !config.strWalker.empty())
+    {
+        Log::Error("Option /Incremental requires the MFT walker");
+        return E_INVALIDARG;
     }
 
     if (config.DefaultIntentions == Intentions::FILEINFO_NONE)
@@ -21,6 +21,7 @@
 #include "Text/Print/Filter.h"
 #include "Text/Print/LocationSet.h"
 #include "Text/Print/Location.h"
+#include "Text/Fmt/ByteQuantity.h"
 
 #include "Usage.h"
 
@@ -57,6 +58,20 @@ void Main::PrintUsage()
         constexpr std::array kCustomMiscParameters = {
             Usage::kMiscParameterComputer,
             Usage::kMiscParameterResurrectRecords,
+            Usage::kMiscParameterParallelLocations,
+            Usage::Parameter {
+                "/MemoryLimit=<Size>",
+                "Soft memory limit of the MFT walk of each volume: beyond it, records waiting for their extension "
+                "records or parents spill to a temporary file and directory paths are rebuilt on demand (ex: 512M). "
+                "Parsed attributes and directory names are not bounded: peak memory can exceed it"},
+            Usage::Parameter {
+                "/Incremental=<Directory>",
+                "Only output the records changed since the previous run using this directory, deleted records are "
+                "listed in tombstones.csv (mounted volumes with a USN journal, directory or archive output)"},
+            Usage::Parameter {
+                "/CatRoot=<Directory>",
+                "Resolve catalog signatures with the catalogs of this directory instead of the ones of the running "
+                "system (ex: Windows\\System32\\CatRoot of an offline image)"},
             Usage::Parameter {"/SecDecr=<FilePath>", "Security Descriptor information for the volume"}};
         Usage::PrintMiscellaneousParameters(usageNode, kCustomMiscParameters);
     }
@@ -80,6 +95,19 @@ void Main::PrintParameters()
     PrintValue(node, L"SecDescr", config.outSecDescrInfo);
 
     PrintValues(node, L"Parsed locations", config.locs.GetParsedLocations());
+    PrintValue(node, L"Parallel", config.dwMaxLocationThreads);
+    if (config.ullMemoryLimit)
+    {
+        PrintValue(node, L"MemoryLimit", Traits::ByteQuantity(config.ullMemoryLimit));
+    }
+    if (!config.strIncrementalDirectory.empty())
+    {
+        PrintValue(node, L"Incremental", config.strIncrementalDirectory);
+    }
+    if (!config.strCatRootDirectory.empty())
+    {
+        PrintValue(node, L"CatRoot", config.strCatRootDirectory);
+    }
 
     PrintValue(node, L"Output columns", config.ColumnIntentions, NtfsFileInfo::g_NtfsColumnNames);
     PrintValue(node, L"Default columns", config.DefaultIntentions, NtfsFileInfo::g_NtfsColumnNames);
@@ -94,7 +122,7 @@ void Main::PrintFooter()
 
     auto root = m_console.OutputTree();
     auto node = root.AddNode("Statistics");
-    PrintValue(node, L"Lines processed", dwTotalFileTreated);
+    PrintValue(node, L"Lines processed", dwTotalFileTreated.load());
     PrintCommonFooter(node);
 
     m_console.PrintNewLine();
@@ -11,6 +11,10 @@
 
 #include <strsafe.h>
 
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+
 #include <boost/scope_exit.hpp>
 #include <boost/algorithm/string/join.hpp>
 
@@ -23,6 +27,7 @@
 #include "MFTRecordFileInfo.h"
 #include "MountedVolumeReader.h"
 #include "MFTWalker.h"
+#include "CatalogIndex.h"
 #include "SystemDetails.h"
 #include "SnapshotVolumeReader.h"
 #include "ParameterCheck.h"
@@ -198,6 +203,9 @@ void Main::DisplayProgress(const ULONG dwProgress)
 
 void Main::FileAndDataInformation(
     ITableOutput& output,
+    const MFTWalker::FullNameBuilder& fullNameBuilder,
+    Authenticode& codeVerifier,
+    const std::shared_ptr<SecurityDescriptorTable>& securityDescriptors,
     const std::shared_ptr<VolumeReader>& volreader,
     MFTRecord* pElt,
     const PFILE_NAME pFileName,
@@ -205,7 +213,7 @@ void Main::FileAndDataInformation(
 {
     try
     {
-        const WCHAR* szFullName = m_FullNameBuilder(pFileName, pDataAttr);
+        const WCHAR* szFullName = fullNameBuilder(pFileName, pDataAttr);
 
         MFTRecordFileInfo fi(
             m_utilitiesConfig.strComputerName,
@@ -216,7 +224,8 @@ void Main::FileAndDataInformation(
             pElt,
             pFileName,
             pDataAttr,
-            m_codeVerifier);
+            codeVerifier,
+            securityDescriptors);
 
         HRESULT hr = fi.WriteFileInformation(NtfsFileInfo::g_NtfsColumnNames, output, config.Filters);
         ++dwTotalFileTreated;
@@ -229,6 +238,9 @@ void Main::FileAndDataInformation(
 
 void Main::DirectoryInformation(
     ITableOutput& output,
+    const MFTWalker::FullNameBuilder& fullNameBuilder,
+    Authenticode& codeVerifier,
+    const std::shared_ptr<SecurityDescriptorTable>& securityDescriptors,
     const std::shared_ptr<VolumeReader>& volreader,
     MFTRecord* pElt,
     const PFILE_NAME pFileName,
@@ -236,7 +248,7 @@ void Main::DirectoryInformation(
 {
     try
     {
-        const WCHAR* szFullName = m_FullNameBuilder(pFileName, nullptr);
+        const WCHAR* szFullName = fullNameBuilder(pFileName, nullptr);
 
         MFTRecordFileInfo fi(
             m_utilitiesConfig.strComputerName,
@@ -247,7 +259,8 @@ void Main::DirectoryInformation(
             pElt,
             pFileName,
             nullptr,
-            m_codeVerifier);
+            codeVerifier,
+            securityDescriptors);
 
         HRESULT hr = fi.WriteFileInformation(NtfsFileInfo::g_NtfsColumnNames, output, config.Filters);
         ++dwTotalFileTreated;
@@ -744,9 +757,439 @@ HRESULT Main::WriteVolStats(
     return S_OK;
 }
 
+HRESULT Main::WriteTombstones(const OutputSpec& tombstonesSpec, std::shared_ptr<TableOutput::IWriter>& newWriter)
+{
+    if (tombstonesSpec.Type == OutputSpec::Kind::Archive || tombstonesSpec.Type == OutputSpec::Kind::Directory)
+        newWriter = Orc::TableOutput::GetWriter(L"tombstones.csv", tombstonesSpec);
+    else
+        return S_OK;
+
+    if (newWriter == nullptr)
+    {
+        return E_FAIL;
+    }
+
+    std::lock_guard<std::mutex> lock(m_tombstonesLock);
+
+    auto& output = *newWriter;
+    for (const auto& tombstone : m_tombstones)
+    {
+        output.WriteString(m_utilitiesConfig.strComputerName.c_str());
+        output.WriteInteger(tombstone.VolumeSerialNumber);
+        output.WriteInteger(tombstone.FRN);
+        output.WriteInteger(tombstone.ParentFRN);
+        output.WriteString(tombstone.FileName);
+        output.WriteInteger(static_cast<ULONGLONG>(tombstone.Usn));
+        output.WriteFlags(tombstone.Reason);
+        output.WriteEndOfLine();
+    }
+
+    return S_OK;
+}
+
+HRESULT Main::GetChangedRecords(
+    const std::shared_ptr<VolumeReader>& volreader,
+    const MFTIndex& previous,
+    const MFTIndex::VolumeState& state,
+    std::unordered_set<ULONGLONG>& changed,
+    std::unordered_set<ULONGLONG>& walked,
+    std::vector<Tombstone>& tombstones)
+{
+    HRESULT hr = E_FAIL;
+
+    std::vector<MFTIndex::JournalChange> changes;
+    if (FAILED(
+            hr = MFTIndex::ReadJournalChanges(volreader, *state.Journal, previous.State().Journal->NextUsn, changes)))
+    {
+        Log::Warn(L"Failed to read the changes since the previous run [{}]", SystemError(hr));
+        return S_FALSE;
+    }
+
+    // Past this point a complete walk costs less
+    constexpr size_t kMaxChangedRecordsRatio = 4;
+    if (changes.size() * kMaxChangedRecordsRatio > previous.RecordCount())
+    {
+        Log::Debug("Too many changes since the previous run ({}/{})", changes.size(), previous.RecordCount());
+        return S_FALSE;
+    }
+
+    // The last change of a record tells whether it still exists, directories may have moved
+    std::unordered_map<ULONGLONG, MFTIndex::JournalChange> lastChanges;
+    MFTIndex::MovedDirectories moved;
+    for (const auto& change : changes)
+    {
+        lastChanges[change.FRN] = change;
+
+        if (change.FileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+        {
+            moved[MFTIndex::SegmentNumber(change.FRN)] = change.ParentFRN;
+        }
+    }
+
+    for (const auto& [frn, change] : lastChanges)
+    {
+        const auto segment = MFTIndex::SegmentNumber(frn);
+        const auto pRecord = previous.FindRecord(segment);
+
+        // The segment is walked again anyway: it may have been reused by a new record
+        walked.insert(segment);
+
+        if (change.Reason & USN_REASON_FILE_DELETE)
+        {
+            // Records created and deleted between two runs were never reported
+            if (pRecord == nullptr || pRecord->FRN != frn)
+            {
+                continue;
+            }
+
+            Tombstone tombstone {state.VolumeSerialNumber, frn, change.ParentFRN, change.Usn, change.Reason};
+
+            const auto [first, last] = previous.GetLinks(*pRecord);
+            for (auto pLink = first; pLink != last; ++pLink)
+            {
+                if (tombstone.FileName.empty() || pLink->Flags != FILE_NAME_DOS83)
+                {
+                    tombstone.FileName = previous.GetName(*pLink);
+                }
+            }
+
+            tombstones.push_back(std::move(tombstone));
+            continue;
+        }
+
+        changed.insert(segment);
+        previous.AddAncestors(change.ParentFRN, moved, walked);
+
+        // Other hard links of the record need their parent directories too
+        if (pRecord != nullptr)
+        {
+            const auto [first, last] = previous.GetLinks(*pRecord);
+            for (auto pLink = first; pLink != last; ++pLink)
+            {
+                previous.AddAncestors(pLink->ParentFRN, moved, walked);
+            }
+        }
+    }
+
+    return S_OK;
+}
+
+HRESULT Main::WalkLocation(const std::shared_ptr<Location>& loc, size_t index, bool bParallel)
+{
+    // Writers are index aligned with the locations they were created for
+    auto& fileinfo = m_FileInfoOutput.Outputs()[index];
+    auto& attr = m_AttrOutput.Outputs()[index];
+    auto& i30 = m_I30Output.Outputs()[index];
+    auto& timeline = m_TimeLineOutput.Outputs()[index];
+    auto& secdescr = m_SecDescrOutput.Outputs()[index];
+
+    BOOST_SCOPE_EXIT(
+        &config,
+        &m_FileInfoOutput,
+        &fileinfo,
+        &m_AttrOutput,
+        &attr,
+        &m_I30Output,
+        &i30,
+        &m_TimeLineOutput,
+        &timeline,
+        &m_SecDescrOutput,
+        &secdescr)
+    {
+        m_FileInfoOutput.CloseOne(config.outFileInfo, fileinfo);
+        m_AttrOutput.CloseOne(config.outAttrInfo, attr);
+        m_I30Output.CloseOne(config.outI30Info, i30);
+        m_TimeLineOutput.CloseOne(config.outTimeLine, timeline);
+        m_SecDescrOutput.CloseOne(config.outSecDescrInfo, secdescr);
+    }
+    BOOST_SCOPE_EXIT_END;
+
+    {
+        std::lock_guard<std::mutex> lock(m_consoleLock);
+        m_console.Print(L"Parsing: {} [{}]", loc->GetLocation(), boost::join(loc->GetPaths(), L", "));
+    }
+
+    // Authenticode's catalog context and cache are not thread safe: concurrent walks use their own
+    std::unique_ptr<Authenticode> localVerifier;
+    if (bParallel)
+    {
+        localVerifier = std::make_unique<Authenticode>();
+        localVerifier->SetCache(std::make_shared<AuthenticodeCache>());
+        localVerifier->SetCatalogIndex(m_codeVerifier.GetCatalogIndex());
+    }
+    Authenticode& codeVerifier = localVerifier ? *localVerifier : m_codeVerifier;
+
+    MFTWalker walker;
+    HRESULT hr = E_FAIL;
+
+    MFTWalker::FullNameBuilder fullNameBuilder;
+    MFTWalker::Callbacks callBacks;
+
+    if (fileinfo.second.Writer() != nullptr)
+    {
+        callBacks.FileNameAndDataCallback = [this, &fileinfo, &fullNameBuilder, &codeVerifier, &walker](
+                                                const std::shared_ptr<VolumeReader>& volreader,
+                                                MFTRecord* pElt,
+                                                const PFILE_NAME pFileName,
+                                                const std::shared_ptr<DataAttribute>& pDataAttr) {
+            FileAndDataInformation(
+                *fileinfo.second.Writer(),
+                fullNameBuilder,
+                codeVerifier,
+                walker.GetSecurityDescriptors(),
+                volreader,
+                pElt,
+                pFileName,
+                pDataAttr);
+        };
+        callBacks.DirectoryCallback = [this, &fileinfo, &fullNameBuilder, &codeVerifier, &walker](
+                                          const std::shared_ptr<VolumeReader>& volreader,
+                                          MFTRecord* pElt,
+                                          const PFILE_NAME pFileName,
+                                          const std::shared_ptr<IndexAllocationAttribute>& pAttr) {
+            DirectoryInformation(
+                *fileinfo.second.Writer(),
+                fullNameBuilder,
+                codeVerifier,
+                walker.GetSecurityDescriptors(),
+                volreader,
+                pElt,
+                pFileName,
+                pAttr);
+        };
+
+        // Owner columns are resolved once per security ID from $Secure rather than once per file
+        walker.LoadSecurityDescriptors(
+            HasFlag(config.ColumnIntentions, Intentions::FILEINFO_OWNERSID)
+            || HasFlag(config.ColumnIntentions, Intentions::FILEINFO_OWNER));
+    }
+    if (timeline.second.Writer() != nullptr)
+    {
+        callBacks.ElementCallback = [this, &timeline](const std::shared_ptr<VolumeReader>& volreader, MFTRecord* pElt) {
+            ElementInformation(*timeline.second.Writer(), volreader, pElt);
+        };
+        callBacks.FileNameCallback =
+            [this, &timeline](
+                const std::shared_ptr<VolumeReader>& volreader, MFTRecord* pElt, const PFILE_NAME pFileName) {
+                TimelineInformation(*timeline.second.Writer(), volreader, pElt, pFileName);
+            };
+    }
+
+    if (attr.second.Writer() != nullptr)
+    {
+        callBacks.AttributeCallback = [this, &attr](
+                                          const std::shared_ptr<VolumeReader>& volreader,
+                                          MFTRecord* pElt,
+                                          const AttributeListEntry& AttrEntry) {
+            AttrInformation(*attr.second.Writer(), volreader, pElt, AttrEntry);
+        };
+    }
+
+    if (i30.second.Writer() != nullptr)
+    {
+        callBacks.I30Callback = [this, &i30](
+                                    const std::shared_ptr<VolumeReader>& volreader,
+                                    MFTRecord* pElt,
+                                    const PINDEX_ENTRY& pEntry,
+                                    const PFILE_NAME pFileName,
+                                    bool bCarvedEntry) {
+            I30Information(*i30.second.Writer(), volreader, pElt, pEntry, pFileName, bCarvedEntry);
+        };
+    }
+
+    if (secdescr.second.Writer() != nullptr)
+    {
+        callBacks.SecDescCallback = [this, &secdescr](
+                                        const std::shared_ptr<VolumeReader>& volreader,
+                                        const PSECURITY_DESCRIPTOR_ENTRY pEntry) {
+            SecurityDescriptorInformation(*secdescr.second.Writer(), volreader, pEntry);
+        };
+    }
+
+    // Progress dots of concurrent walks would interleave
+    if (!bParallel)
+    {
+        callBacks.ProgressCallback = [this](const ULONG dwProgress) -> HRESULT {
+            DisplayProgress(dwProgress);
+            return S_OK;
+        };
+    }
+
+    walker.SetMemoryLimit(config.ullMemoryLimit);
+    if (FAILED(hr = walker.Initialize(loc, config.resurrectRecordsMode)))
+    {
+        if (hr == HRESULT_FROM_WIN32(ERROR_FILE_SYSTEM_LIMITATION))
+        {
+            Log::Warn(L"File system not eligible for '{}'", loc->GetLocation());
+            return S_OK;
+        }
+
+        Log::Critical(L"Failed to init walk for '{}' [{}]", loc->GetLocation(), SystemError(hr));
+        return hr;
+    }
+
+    // Incremental runs only walk the records the USN journal reports as changed since the previous run
+    MFTIndex::VolumeState volumeState;
+    std::filesystem::path indexPath;
+    std::unique_ptr<MFTIndex> previous;
+    std::unique_ptr<MFTIndex::Builder> indexBuilder;
+    std::unordered_set<ULONGLONG> changed;
+    std::unordered_set<ULONGLONG> walked;
+    std::vector<Tombstone> tombstones;
+
+    if (!config.strIncrementalDirectory.empty())
+    {
+        if (FAILED(MFTIndex::GetVolumeState(loc, walker.GetMFTRecordCount(), config.resurrectRecordsMode, volumeState))
+            || !volumeState.Journal)
+        {
+            Log::Warn(
+                L"Location '{}' cannot be walked incrementally (should be a journaled mounted volume)",
+                loc->GetLocation());
+        }
+        else
+        {
+            indexPath = std::filesystem::path(config.strIncrementalDirectory)
+                / fmt::format(L"NTFSInfo_{:016X}.idx", volumeState.VolumeSerialNumber);
+            indexBuilder = std::make_unique<MFTIndex::Builder>();
+
+            if (SUCCEEDED(MFTIndex::Open(indexPath, previous)) && previous->IsValidFor(volumeState)
+                && GetChangedRecords(loc->GetReader(), *previous, volumeState, changed, walked, tombstones) == S_OK)
+            {
+                Log::Info(
+                    L"Walking {} records changed since the previous run of '{}' ({} deleted)",
+                    changed.size(),
+                    loc->GetLocation(),
+                    tombstones.size());
+            }
+            else
+            {
+                // No previous run, the journal wrapped or was recreated since then
+                Log::Info(L"Walking the complete volume '{}'", loc->GetLocation());
+                previous.reset();
+                changed.clear();
+                walked.clear();
+                tombstones.clear();
+            }
+        }
+    }
+
+    if (previous)
+    {
+        // Ancestors are walked to build the full names of the changed records, not to be reported
+        const auto filter = [&changed](auto& callback) {
+            if (callback)
+            {
+                callback = [inner = std::move(callback), &changed](
+                               const std::shared_ptr<VolumeReader>& volreader, MFTRecord* pElt, auto&&... args) {
+                    const auto frn = NtfsFullSegmentNumber(&pElt->GetFileReferenceNumber());
+                    if (changed.find(MFTIndex::SegmentNumber(frn)) != std::cend(changed))
+                    {
+                        inner(volreader, pElt, args...);
+                    }
+                };
+            }
+        };
+
+        filter(callBacks.FileNameAndDataCallback);
+        filter(callBacks.DirectoryCallback);
+        filter(callBacks.ElementCallback);
+        filter(callBacks.FileNameCallback);
+        filter(callBacks.AttributeCallback);
+
+        // Index entries are reported for their own record: unchanged directories list new files too
+        if (callBacks.I30Callback)
+        {
+            callBacks.I30Callback = [inner = std::move(callBacks.I30Callback), &changed](
+                                        const std::shared_ptr<VolumeReader>& volreader,
+                                        MFTRecord* pElt,
+                                        const PINDEX_ENTRY pEntry,
+                                        const PFILE_NAME pFileName,
+                                        bool bCarvedEntry) {
+                const auto frn = NtfsFullSegmentNumber(&pEntry->FileReference);
+                if (changed.find(MFTIndex::SegmentNumber(frn)) != std::cend(changed))
+                {
+                    inner(volreader, pElt, pEntry, pFileName, bCarvedEntry);
+                }
+            };
+        }
+    }
+
+    if (indexBuilder)
+    {
+        callBacks.ElementCallback = [element = std::move(callBacks.ElementCallback), &indexBuilder](
+                                        const std::shared_ptr<VolumeReader>& volreader, MFTRecord* pElt) {
+            indexBuilder->Add(volreader, pElt);
+            if (element)
+            {
+                element(volreader, pElt);
+            }
+        };
+    }
+
+    fullNameBuilder = walker.GetFullNameBuilder();
+    if (previous)
+    {
+        std::vector<MFT_SEGMENT_REFERENCE> records;
+        records.reserve(walked.size());
+        for (const auto segment : walked)
+        {
+            MFT_SEGMENT_REFERENCE reference;
+            NtfsSetSegmentNumber(&reference, static_cast<USHORT>(segment >> 32), static_cast<ULONG>(segment));
+            records.push_back(reference);
+        }
+
+        hr = walker.Walk(callBacks, records);
+    }
+    else
+    {
+        hr = walker.Walk(callBacks);
+    }
+
+    if (FAILED(hr))
+    {
+        Log::Critical(L"Failed to walk volume '{}' [{}]", loc->GetLocation(), SystemError(hr));
+        return hr;
+    }
+
+    if (indexBuilder)
+    {
+        // Records which were not walked again are carried over from the previous run
+        if (previous)
+        {
+            indexBuilder->Add(*previous, walked);
+            previous.reset();
+        }
+
+        std::error_code ec;
+        std::filesystem::create_directories(indexPath.parent_path(), ec);
+
+        if (FAILED(hr = indexBuilder->Write(indexPath, volumeState)))
+        {
+            Log::Error(L"Failed to save the state of '{}' for the next run [{}]", loc->GetLocation(), SystemError(hr));
+        }
+
+        std::lock_guard<std::mutex> lock(m_tombstonesLock);
+        std::move(std::begin(tombstones), std::end(tombstones), std::back_inserter(m_tombstones));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_consoleLock);
+        if (bParallel)
+        {
+            m_console.Print(L"Done: {}", loc->GetLocation());
+        }
+        else
+        {
+            m_console.Print("Done");
+        }
+    }
+
+    walker.Statistics(L"");
+    return S_OK;
+}
+
 HRESULT Main::RunThroughMFT()
 {
-    auto output = m_console.OutputTree();
     HRESULT hr = E_FAIL;
 
     const auto& locs = config.locs.GetAltitudeLocations();
@@ -836,139 +1279,52 @@ HRESULT Main::RunThroughMFT()
         }
     }
 
-    auto fileinfoIterator = begin(m_FileInfoOutput.Outputs());
-    auto attrIterator = begin(m_AttrOutput.Outputs());
-    auto i30Iterator = begin(m_I30Output.Outputs());
-    auto timelineIterator = begin(m_TimeLineOutput.Outputs());
-    auto secdescrIterator = begin(m_SecDescrOutput.Outputs());
-
-    bool hasSomeFailure = false;
+    // Locations are walked concurrently only when each one has its own writers
+    auto HasWriterPerLocation = [](const OutputSpec& spec) {
+        return spec.Type == OutputSpec::Kind::None || spec.Type == OutputSpec::Kind::Directory
+            || spec.Type == OutputSpec::Kind::Archive;
+    };
 
-    for (auto& loc : locations)
+    DWORD dwMaxThreads = 1L;
+    if (HasWriterPerLocation(config.outFileInfo) && HasWriterPerLocation(config.outAttrInfo)
+        && HasWriterPerLocation(config.outI30Info) && HasWriterPerLocation(config.outTimeLine)
+        && HasWriterPerLocation(config.outSecDescrInfo))
     {
-        BOOST_SCOPE_EXIT(
-            &config,
-            &m_FileInfoOutput,
-            &fileinfoIterator,
-            &m_AttrOutput,
-            &attrIterator,
-            &m_I30Output,
-            &i30Iterator,
-            &m_TimeLineOutput,
-            &timelineIterator,
-            &m_SecDescrOutput,
-            &secdescrIterator)
-        {
-            m_FileInfoOutput.CloseOne(config.outFileInfo, *fileinfoIterator);
-            fileinfoIterator++;
-            m_AttrOutput.CloseOne(config.outAttrInfo, *attrIterator);
-            attrIterator++;
-            m_I30Output.CloseOne(config.outI30Info, *i30Iterator);
-            i30Iterator++;
-            m_TimeLineOutput.CloseOne(config.outTimeLine, *timelineIterator);
-            timelineIterator++;
-            m_SecDescrOutput.CloseOne(config.outSecDescrInfo, *secdescrIterator);
-            secdescrIterator++;
-        }
-        BOOST_SCOPE_EXIT_END;
-
-        output.Add(L"Parsing: {} [{}]", loc->GetLocation(), boost::join(loc->GetPaths(), L", "));
-
-        MFTWalker::Callbacks callBacks;
-
-        if (fileinfoIterator->second.Writer() != nullptr)
-        {
-            callBacks.FileNameAndDataCallback = [this, fileinfoIterator](
-                                                    const std::shared_ptr<VolumeReader>& volreader,
-                                                    MFTRecord* pElt,
-                                                    const PFILE_NAME pFileName,
-                                                    const std::shared_ptr<DataAttribute>& pDataAttr) {
-                FileAndDataInformation(*fileinfoIterator->second.Writer(), volreader, pElt, pFileName, pDataAttr);
-            };
-            callBacks.DirectoryCallback = [this, fileinfoIterator](
-                                              const std::shared_ptr<VolumeReader>& volreader,
-                                              MFTRecord* pElt,
-                                              const PFILE_NAME pFileName,
-                                              const std::shared_ptr<IndexAllocationAttribute>& pAttr) {
-                DirectoryInformation(*fileinfoIterator->second.Writer(), volreader, pElt, pFileName, pAttr);
-            };
-        }
-        if (timelineIterator->second.Writer() != nullptr)
-        {
-            callBacks.ElementCallback =
-                [this, timelineIterator](const std::shared_ptr<VolumeReader>& volreader, MFTRecord* pElt) {
-                    ElementInformation(*timelineIterator->second.Writer(), volreader, pElt);
-                };
-            callBacks.FileNameCallback =
-                [this, timelineIterator](
-                    const std::shared_ptr<VolumeReader>& volreader, MFTRecord* pElt, const PFILE_NAME pFileName) {
-                    TimelineInformation(*timelineIterator->second.Writer(), volreader, pElt, pFileName);
-                };
-        }
-
-        if (attrIterator->second.Writer() != nullptr)
-        {
-            callBacks.AttributeCallback = [this, attrIterator](
-                                              const std::shared_ptr<VolumeReader>& volreader,
-                                              MFTRecord* pElt,
-                                              const AttributeListEntry& AttrEntry) {
-                AttrInformation(*attrIterator->second.Writer(), volreader, pElt, AttrEntry);
-            };
-        }
+        dwMaxThreads = config.dwMaxLocationThreads;
+    }
+    else if (config.dwMaxLocationThreads > 1)
+    {
+        Log::Warn(L"Locations are parsed sequentially: outputs must be directories or archives to parse in parallel");
+    }
 
-        if (i30Iterator->second.Writer() != nullptr)
-        {
-            callBacks.I30Callback = [this, i30Iterator](
-                                        const std::shared_ptr<VolumeReader>& volreader,
-                                        MFTRecord* pElt,
-                                        const PINDEX_ENTRY& pEntry,
-                                        const PFILE_NAME pFileName,
-                                        bool bCarvedEntry) {
-                I30Information(*i30Iterator->second.Writer(), volreader, pElt, pEntry, pFileName, bCarvedEntry);
-            };
-        }
+    const bool bParallel = dwMaxThreads > 1 && LocationSet::GroupByPhysicalDrive(locations).size() > 1;
+    std::atomic<bool> hasSomeFailure = false;
 
-        if (secdescrIterator->second.Writer() != nullptr)
+    ForEachLocation(locations, dwMaxThreads, [&](size_t index) {
+        if (FAILED(WalkLocation(locations[index], index, bParallel)))
         {
-            callBacks.SecDescCallback = [this, secdescrIterator](
-                                            const std::shared_ptr<VolumeReader>& volreader,
-                                            const PSECURITY_DESCRIPTOR_ENTRY pEntry) {
-                SecurityDescriptorInformation(*secdescrIterator->second.Writer(), volreader, pEntry);
-            };
+            hasSomeFailure = true;
         }
+    });
 
-        callBacks.ProgressCallback = [this](const ULONG dwProgress) -> HRESULT {
-            DisplayProgress(dwProgress);
-            return S_OK;
-        };
-
-        MFTWalker walker;
-        HRESULT hr = E_FAIL;
-
-        if (FAILED(hr = walker.Initialize(loc, config.resurrectRecordsMode)))
+    if (!config.strIncrementalDirectory.empty())
+    {
+        std::shared_ptr<TableOutput::IWriter> tombstonesWriter;
+        if (FAILED(hr = WriteTombstones(config.tombstonesOutput, tombstonesWriter)))
         {
-            if (hr == HRESULT_FROM_WIN32(ERROR_FILE_SYSTEM_LIMITATION))
-            {
-                Log::Warn(L"File system not eligible for '{}'", loc->GetLocation());
-            }
-            else
-            {
-                hasSomeFailure = true;
-                Log::Critical(L"Failed to init walk for '{}' [{}]", loc->GetLocation(), SystemError(hr));
-            }
+            Log::Error("Failed to write tombstones [{}]", SystemError(hr));
+            hasSomeFailure = true;
         }
-        else
+        else if (tombstonesWriter)
         {
-            m_FullNameBuilder = walker.GetFullNameBuilder();
-            if (FAILED(hr = walker.Walk(callBacks)))
-            {
-                hasSomeFailure = true;
-                Log::Critical(L"Failed to walk volume '{}' [{}]", loc->GetLocation(), SystemError(hr));
-            }
-            else
+            tombstonesWriter->Close();
+
+            auto pStreamWriter = std::dynamic_pointer_cast<TableOutput::IStreamWriter>(tombstonesWriter);
+            if (config.tombstonesOutput.Type == OutputSpec::Kind::Archive && pStreamWriter
+                && pStreamWriter->GetStream())
             {
-                m_console.Print("Done");
-                walker.Statistics(L"");
+                m_FileInfoOutput.AddStream(
+                    config.tombstonesOutput, L"tombstones.csv", pStreamWriter->GetStream(), false, true);
             }
         }
     }
@@ -988,6 +1344,23 @@ HRESULT Main::Run()
     if (FAILED(hr = LoadWinTrust()))
         return hr;
 
+    if (!config.strCatRootDirectory.empty())
+    {
+        auto index = std::make_shared<CatalogIndex>();
+        if (auto rv = index->Load(config.strCatRootDirectory); rv.has_error())
+        {
+            Log::Error(L"Failed to load catalogs from '{}' [{}]", config.strCatRootDirectory, rv.error());
+            return ToHRESULT(rv.error());
+        }
+
+        Log::Info(
+            L"Loaded {} hashes from {} catalogs of '{}'",
+            index->HashCount(),
+            index->CatalogCount(),
+            config.strCatRootDirectory);
+        m_codeVerifier.SetCatalogIndex(std::move(index));
+    }
+
     try
     {
         if (!config.strWalker.compare(L"USN"))
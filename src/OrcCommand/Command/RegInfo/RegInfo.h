@@ -98,6 +98,9 @@ public:
             Information = static_cast<RegInfoType>(
                 REGINFO_LASTMODDATE | REGINFO_TERMNAME | REGINFO_TERMDESCRIPTION | REGINFO_KEYNAME | REGINFO_KEYTREE
                 | REGINFO_VALUENAME | REGINFO_VALUETYPE);
+
+            // Rows are written by an I/O thread so that the hive walk does not wait on the output files
+            Output.dwAsyncBufferCount = 2;
         };
 
         RegFindConfig regFindConfig;
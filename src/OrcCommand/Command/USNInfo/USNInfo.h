@@ -10,6 +10,7 @@
 
 #include "UtilitiesMain.h"
 
+#include <mutex>
 #include <optional>
 
 #include <boost/logic/tribool.hpp>
@@ -51,6 +52,9 @@ public:
         std::optional<Ntfs::ShadowCopy::ParserType> m_shadowsParser;
         std::optional<LocationSet::PathExcludes> m_excludes;
         std::vector<std::wstring> m_inputLocations;
+
+        // Maximum number of physical drives parsed concurrently
+        DWORD dwMaxLocationThreads = 1L;
     };
 
 private:
@@ -82,6 +86,7 @@ private:
     };
 
     MultipleOutput<LocationOutput> m_outputs;
+    std::mutex m_consoleLock;
 
     HRESULT USNRecordInformation(
         ITableOutput& output,
@@ -116,6 +116,8 @@ HRESULT Main::GetConfigurationFromArgcArgv(int argc, LPCWSTR argv[])
             case L'-':
                 if (OutputOption(argv[i] + 1, L"out", config.output))
                     ;
+                else if (ParameterOption(argv[i] + 1, L"Parallel", config.dwMaxLocationThreads))
+                    ;
                 else if (BooleanOption(argv[i] + 1, L"Compact", config.bCompactForm))
                     ;
                 else if (ShadowsOption(argv[i] + 1, L"Shadows", config.bAddShadows, config.m_shadows))
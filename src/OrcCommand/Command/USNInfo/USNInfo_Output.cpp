@@ -49,6 +49,9 @@ void Main::PrintUsage()
 
     Usage::PrintParameters(usageNode, "PARAMETERS", kSpecificParameters);
 
+    constexpr std::array kCustomMiscParameters = {Usage::kMiscParameterParallelLocations};
+    Usage::PrintMiscellaneousParameters(usageNode, kCustomMiscParameters);
+
     Usage::PrintLoggingParameters(usageNode);
 }
 
@@ -63,6 +66,7 @@ void Main::PrintParameters()
 
     PrintValues(node, L"Parsed locations", config.locs.GetParsedLocations());
     PrintValue(node, L"Compact", Traits::Boolean(config.bCompactForm));
+    PrintValue(node, L"Parallel", config.dwMaxLocationThreads);
 
     m_console.PrintNewLine();
 }
@@ -10,6 +10,8 @@
 
 #include <strsafe.h>
 
+#include <mutex>
+
 #include <boost/scope_exit.hpp>
 
 #include "USNInfo.h"
@@ -190,15 +192,29 @@ HRESULT Main::Run()
         return hr;
     }
 
-    auto outputIt = std::begin(m_outputs.Outputs());
-    for (const auto& loc : locations)
+    // Locations are parsed concurrently only when each one has its own writer
+    DWORD dwMaxThreads = 1L;
+    if (config.output.Type == OutputSpec::Kind::Directory || config.output.Type == OutputSpec::Kind::Archive)
+    {
+        dwMaxThreads = config.dwMaxLocationThreads;
+    }
+    else if (config.dwMaxLocationThreads > 1)
     {
-        Guard::Scope onExit([this, &outputIt]() {
-            m_outputs.CloseOne(config.output, *outputIt);
-            outputIt++;
-        });
+        Log::Warn(L"Locations are parsed sequentially: output must be a directory or an archive to parse in parallel");
+    }
+
+    ForEachLocation(locations, dwMaxThreads, [this, &locations](size_t index) {
+        // Writers are index aligned with the locations they were created for
+        auto& output = m_outputs.Outputs()[index];
+        Guard::Scope onExit([this, &output]() { m_outputs.CloseOne(config.output, output); });
+
+        const auto& loc = locations[index];
+
+        {
+            std::lock_guard<std::mutex> lock(m_consoleLock);
+            m_console.Print(L"Parsing: {} [{}]", loc->GetLocation(), boost::join(loc->GetPaths(), L", "));
+        }
 
-        m_console.Print(L"Parsing: {} [{}]", loc->GetLocation(), boost::join(loc->GetPaths(), L", "));
         USNJournalWalkerOffline walker;
 
         HRESULT hr = walker.Initialize(loc);
@@ -207,17 +223,17 @@ HRESULT Main::Run()
             if (hr == HRESULT_FROM_WIN32(ERROR_FILE_SYSTEM_LIMITATION))
             {
                 Log::Warn(L"File system not eligible for volume '{}'", loc->GetLocation());
-                continue;
+                return;
             }
 
             Log::Critical(L"Failed to init walk for volume '{}' [{}]", loc->GetLocation(), SystemError(hr));
-            continue;
+            return;
         }
 
         if (!walker.GetUsnJournal())
         {
             Log::Warn(L"Did not find a USN journal on following volume '{}'", loc->GetLocation());
-            continue;
+            return;
         }
 
         IUSNJournalWalker::Callbacks callbacks;
@@ -228,21 +244,21 @@ HRESULT Main::Run()
         if (FAILED(hr))
         {
             Log::Error(L"Failed to enum MFT records '{}' [{}]", loc->GetLocation(), SystemError(hr));
-            continue;
+            return;
         }
 
         callbacks.RecordCallback =
-            [this, &outputIt](const std::shared_ptr<VolumeReader>& volreader, WCHAR* szFullName, USN_RECORD* pElt) {
-                USNRecordInformation(*outputIt->second.Writer(), volreader, szFullName, pElt);
+            [this, &output](const std::shared_ptr<VolumeReader>& volreader, WCHAR* szFullName, USN_RECORD* pElt) {
+                USNRecordInformation(*output.second.Writer(), volreader, szFullName, pElt);
             };
 
         hr = walker.ReadJournal(callbacks);
         if (FAILED(hr))
         {
             Log::Error(L"Failed to walk volume '{}' [{}]", loc->GetLocation(), SystemError(hr));
-            continue;
+            return;
         }
-    }
+    });
 
     if (FAILED(hr))
     {
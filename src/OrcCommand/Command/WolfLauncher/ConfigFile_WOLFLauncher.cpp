@@ -94,6 +94,10 @@ HRESULT wolf_command(ConfigItem& parent, DWORD dwIndex)
         return hr;
     if (FAILED(hr = parent[dwIndex].AddAttribute(L"timeout", WOLFLAUNCHER_COMMAND_TIMEOUT, ConfigItem::OPTION)))
         return hr;
+    if (FAILED(hr = parent[dwIndex].AddAttribute(L"profile", WOLFLAUNCHER_COMMAND_PROFILE, ConfigItem::OPTION)))
+        return hr;
+    if (FAILED(hr = parent[dwIndex].AddAttribute(L"priority", WOLFLAUNCHER_COMMAND_PRIORITY, ConfigItem::OPTION)))
+        return hr;
     return S_OK;
 }
 
@@ -197,6 +201,8 @@ HRESULT Orc::Config::Wolf::root(ConfigItem& item)
         return hr;
     if (FAILED(hr = item.AddChild(L"upload", Orc::Config::Common::upload, WOLFLAUNCHER_UPLOAD)))
         return hr;
+    if (FAILED(hr = item.AddAttribute(L"aead_encryption", WOLFLAUNCHER_AEAD_ENCRYPTION, ConfigItem::OPTION)))
+        return hr;
 
     return S_OK;
 }
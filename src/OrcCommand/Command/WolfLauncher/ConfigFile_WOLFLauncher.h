@@ -38,6 +38,8 @@ constexpr auto WOLFLAUNCHER_COMMAND_SYSTEMTYPE = 6L;
 constexpr auto WOLFLAUNCHER_COMMAND_QUEUE = 7L;
 constexpr auto WOLFLAUNCHER_COMMAND_OPTIONAL = 8L;
 constexpr auto WOLFLAUNCHER_COMMAND_TIMEOUT = 9L;
+constexpr auto WOLFLAUNCHER_COMMAND_PROFILE = 10L;
+constexpr auto WOLFLAUNCHER_COMMAND_PRIORITY = 11L;
 
 constexpr auto WOLFLAUNCHER_DESTINATION = 0L;
 constexpr auto WOLFLAUNCHER_METHOD = 1L;
@@ -77,6 +79,7 @@ constexpr auto WOLFLAUNCHER_GLOBAL_ARCHIVE_TIMEOUT = 8L;
 constexpr auto WOLFLAUNCHER_WERDONTSHOWUI = 9L;
 constexpr auto WOLFLAUNCHER_UPLOAD = 10L;
 constexpr auto WOLFLAUNCHER_PRIORITY = 11L;
+constexpr auto WOLFLAUNCHER_AEAD_ENCRYPTION = 12L;
 
 constexpr auto WOLFLAUNCHER_WOLF = 0L;
 
@@ -127,6 +127,25 @@ void Write(
     writer->WriteNamed(L"active_proces", statistics->GetActiveProcessCount());
     writer->WriteNamed(L"terminated_process", statistics->GetTerminatedProcessCount());
     writer->WriteNamed(L"page_fault", statistics->GetPageFaultCount());
+
+    if (!statistics->GetTraceStatistics().empty())
+    {
+        writer->BeginCollection(L"trace");
+        Guard::Scope onTraceExit([&]() { writer->EndCollection(L"trace"); });
+
+        for (const auto& span : statistics->GetTraceStatistics())
+        {
+            writer->BeginElement(nullptr);
+            Guard::Scope onSpanExit([&]() { writer->EndElement(nullptr); });
+
+            writer->WriteNamed(L"category", span.Category);
+            writer->WriteNamed(L"name", span.Name);
+            writer->WriteNamed(L"count", span.Count);
+            writer->WriteNamed(
+                L"duration", std::chrono::duration_cast<std::chrono::milliseconds>(span.Duration).count());
+            writer->WriteNamed(L"bytes", span.Bytes);
+        }
+    }
 }
 
 void Write(StructuredOutputWriter::IWriter::Ptr& writer, const Outcome::Archive::Item& item)
@@ -258,6 +277,19 @@ void Write(
     writer->WriteNamed(key.data(), value->count());
 }
 
+void Write(
+    StructuredOutputWriter::IWriter::Ptr& writer,
+    std::wstring_view key,
+    const std::optional<std::chrono::milliseconds>& value)
+{
+    if (!value)
+    {
+        return;
+    }
+
+    writer->WriteNamed(key.data(), value->count());
+}
+
 void Write(StructuredOutputWriter::IWriter::Ptr& writer, const Outcome::Command& command)
 {
     writer->BeginElement(nullptr);
@@ -279,6 +311,7 @@ void Write(StructuredOutputWriter::IWriter::Ptr& writer, const Outcome::Command&
     ::Write(writer, L"origin", command.GetOrigin());
     ::Write(writer, L"user_time", command.GetUserTime());
     ::Write(writer, L"kernel_time", command.GetKernelTime());
+    ::Write(writer, L"startup_time_ms", command.GetStartupTime());
     ::Write(writer, L"io_counters", command.GetIOCounters());
     ::Write(writer, L"output", command.GetOutput());
 }
@@ -18,6 +18,7 @@
 
 #include "StructuredOutputWriter.h"
 #include "Utils/Result.h"
+#include "Utils/Trace.h"
 
 namespace Orc::Command::Wolf::Outcome {
 
@@ -159,6 +160,10 @@ public:
     std::optional<std::chrono::seconds> GetKernelTime() const { return m_kernelTime; }
     void SetKernelTime(const std::chrono::seconds& kernelTime) { m_kernelTime = kernelTime; }
 
+    // Time spent between dequeuing the command and its process creation (includes embedded tool extraction)
+    std::optional<std::chrono::milliseconds> GetStartupTime() const { return m_startupTime; }
+    void SetStartupTime(const std::optional<std::chrono::milliseconds>& startupTime) { m_startupTime = startupTime; }
+
     std::optional<int32_t> GetExitCode() const { return m_exitCode; }
     void SetExitCode(int32_t code) { m_exitCode = code; }
 
@@ -215,6 +220,7 @@ private:
     std::optional<Timestamp> m_exitTime;
     std::optional<std::chrono::seconds> m_userTime;
     std::optional<std::chrono::seconds> m_kernelTime;
+    std::optional<std::chrono::milliseconds> m_startupTime;
     std::optional<IO_COUNTERS> m_ioCounters;
     std::optional<int32_t> m_exitCode;
     std::optional<uint32_t> m_pid;
@@ -244,6 +250,11 @@ public:
     const IO_COUNTERS& GetIOCounters() const { return m_ioCounters; }
     void SetIOCounters(const IO_COUNTERS& counters) { m_ioCounters = counters; }
 
+    // Spans recorded by the launcher while the command set ran, merged with those its DFIR-Orc commands wrote with
+    // /PerfTrace, only when tracing is enabled
+    const std::vector<Trace::Statistics>& GetTraceStatistics() const { return m_traceStatistics; }
+    void SetTraceStatistics(std::vector<Trace::Statistics> statistics) { m_traceStatistics = std::move(statistics); }
+
 private:
     uint64_t m_pageFaultCount;
     uint64_t m_processCount;
@@ -252,6 +263,7 @@ private:
     uint64_t m_peakProcessMemory;
     uint64_t m_peakJobMemory;
     IO_COUNTERS m_ioCounters;
+    std::vector<Trace::Statistics> m_traceStatistics;
 };
 
 class CommandSet
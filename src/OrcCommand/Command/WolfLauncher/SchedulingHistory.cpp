@@ -0,0 +1,181 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+
+#include "stdafx.h"
+
+#include "Command/WolfLauncher/SchedulingHistory.h"
+
+#include <fstream>
+#include <sstream>
+
+#include <rapidjson/document.h>
+
+#include "Text/Iconv.h"
+#include "Log/Log.h"
+
+using namespace Orc::Command::Wolf;
+using namespace Orc;
+
+namespace {
+
+// Parse outcome's "YYYY-MM-DDTHH:MM:SSZ" timestamps
+std::optional<ULONGLONG> ParseTimestamp(const rapidjson::Value& object, const char* name)
+{
+    auto it = object.FindMember(name);
+    if (it == object.MemberEnd() || !it->value.IsString())
+    {
+        return {};
+    }
+
+    SYSTEMTIME st = {0};
+    if (sscanf_s(
+            it->value.GetString(),
+            "%hu-%hu-%huT%hu:%hu:%huZ",
+            &st.wYear,
+            &st.wMonth,
+            &st.wDay,
+            &st.wHour,
+            &st.wMinute,
+            &st.wSecond)
+        != 6)
+    {
+        return {};
+    }
+
+    FILETIME ft;
+    if (!SystemTimeToFileTime(&st, &ft))
+    {
+        return {};
+    }
+
+    return (static_cast<ULONGLONG>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+}
+
+std::optional<uint64_t> ParseUInt(const rapidjson::Value& object, const char* name)
+{
+    auto it = object.FindMember(name);
+    if (it == object.MemberEnd() || !it->value.IsUint64())
+    {
+        return {};
+    }
+
+    return it->value.GetUint64();
+}
+
+std::wstring MakeKey(const std::wstring& commandSet, const std::wstring& command)
+{
+    return commandSet + L"|" + command;
+}
+
+}  // namespace
+
+namespace Orc::Command::Wolf {
+
+Orc::Result<SchedulingHistory> SchedulingHistory::Load(const std::filesystem::path& outcome)
+{
+    std::ifstream file(outcome, std::ios::binary);
+    if (!file)
+    {
+        Log::Error(L"Failed to open scheduling history '{}'", outcome);
+        return std::errc::no_such_file_or_directory;
+    }
+
+    std::stringstream content;
+    content << file.rdbuf();
+
+    rapidjson::Document document;
+    document.Parse(content.str().c_str());
+    if (document.HasParseError() || !document.IsObject())
+    {
+        Log::Error(L"Failed to parse scheduling history '{}'", outcome);
+        return std::errc::invalid_argument;
+    }
+
+    auto root = document.FindMember("dfir-orc");
+    if (root == document.MemberEnd() || !root->value.IsObject())
+    {
+        return std::errc::invalid_argument;
+    }
+
+    auto outcomeNode = root->value.FindMember("outcome");
+    if (outcomeNode == root->value.MemberEnd() || !outcomeNode->value.IsObject())
+    {
+        return std::errc::invalid_argument;
+    }
+
+    auto commandSets = outcomeNode->value.FindMember("command_set");
+    if (commandSets == outcomeNode->value.MemberEnd() || !commandSets->value.IsArray())
+    {
+        return std::errc::invalid_argument;
+    }
+
+    SchedulingHistory history;
+
+    for (const auto& commandSet : commandSets->value.GetArray())
+    {
+        auto setName = commandSet.FindMember("name");
+        auto commands = commandSet.FindMember("commands");
+        if (setName == commandSet.MemberEnd() || !setName->value.IsString() || commands == commandSet.MemberEnd()
+            || !commands->value.IsArray())
+        {
+            continue;
+        }
+
+        const auto strCommandSet = ToUtf16(setName->value.GetString());
+
+        for (const auto& command : commands->value.GetArray())
+        {
+            auto name = command.FindMember("name");
+            if (name == command.MemberEnd() || !name->value.IsString())
+            {
+                continue;
+            }
+
+            const auto start = ParseTimestamp(command, "start");
+            const auto end = ParseTimestamp(command, "end");
+            if (!start || !end || *end < *start)
+            {
+                continue;
+            }
+
+            // FILETIME are in 100ns units
+            Entry entry;
+            entry.duration = std::chrono::milliseconds((*end - *start) / 10000);
+            entry.profile = CommandProfile::Undefined;
+
+            const auto userTime = ParseUInt(command, "user_time");
+            const auto kernelTime = ParseUInt(command, "kernel_time");
+            if (userTime && kernelTime && entry.duration.count() > 0)
+            {
+                const auto cpuTime = std::chrono::seconds(*userTime + *kernelTime);
+                const auto ratio = static_cast<double>(std::chrono::milliseconds(cpuTime).count())
+                    / static_cast<double>(entry.duration.count());
+                entry.profile = ratio >= CommandScheduler::kCpuBoundRatio ? CommandProfile::Cpu : CommandProfile::Io;
+            }
+
+            history.m_entries[MakeKey(strCommandSet, ToUtf16(name->value.GetString()))] = entry;
+        }
+    }
+
+    Log::Debug(L"Loaded scheduling history for {} command(s) from '{}'", history.m_entries.size(), outcome);
+    return history;
+}
+
+const SchedulingHistory::Entry*
+SchedulingHistory::Find(const std::wstring& commandSet, const std::wstring& command) const
+{
+    auto it = m_entries.find(MakeKey(commandSet, command));
+    if (it == std::cend(m_entries))
+    {
+        return nullptr;
+    }
+
+    return &it->second;
+}
+
+}  // namespace Orc::Command::Wolf
@@ -0,0 +1,43 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <string>
+
+#include "CaseInsensitive.h"
+#include "CommandScheduler.h"
+#include "Utils/Result.h"
+
+namespace Orc::Command::Wolf {
+
+// Durations and resource profiles of the commands of a previous execution, read from its json outcome file.
+// They are used as hints to order and admit commands (see CommandScheduler).
+class SchedulingHistory
+{
+public:
+    struct Entry
+    {
+        std::chrono::milliseconds duration;
+        CommandProfile profile;
+    };
+
+    static Orc::Result<SchedulingHistory> Load(const std::filesystem::path& outcome);
+
+    const Entry* Find(const std::wstring& commandSet, const std::wstring& command) const;
+
+    size_t size() const { return m_entries.size(); }
+
+private:
+    std::map<std::wstring, Entry, CaseInsensitive> m_entries;
+};
+
+}  // namespace Orc::Command::Wolf
@@ -11,6 +11,7 @@
 
 #include <regex>
 #include <chrono>
+#include <filesystem>
 
 #include <boost/logic/tribool.hpp>
 
@@ -26,6 +27,7 @@
 
 #include "Command/WolfLauncher/Journal.h"
 #include "Command/WolfLauncher/Outcome.h"
+#include "Command/WolfLauncher/SchedulingHistory.h"
 #include "Utils/Locker.h"
 
 #pragma managed(push, off)
@@ -102,6 +104,7 @@ private:
     std::chrono::milliseconds m_ArchiveTimeOut;
 
     bool m_bUseJournalWhenEncrypting = true;
+    bool m_bUseAeadEncryption = false;
     bool m_bTeeClearTextOutput = false;
 
     bool m_bOptional = false;
@@ -130,6 +133,7 @@ private:
     FILETIME m_ArchiveFinishTime;
 
     std::vector<CommandMessage::Message> m_Commands;
+    std::vector<std::filesystem::path> m_ChildPerfTraces;
 
     std::map<std::wstring, std::shared_ptr<WolfTask>> m_TasksByKeyword;
     DWORD m_dwLongerTaskKeyword = 0L;
@@ -200,6 +204,9 @@ public:
         m_bUseJournalWhenEncrypting = bUseJournalWhenEncrypting;
     };
 
+    bool UseAeadEncryption() const { return m_bUseAeadEncryption; };
+    void SetUseAeadEncryption(bool bUseAeadEncryption) { m_bUseAeadEncryption = bUseAeadEncryption; };
+
     bool TeeClearTextOutput() const { return m_bTeeClearTextOutput; };
     void SetTeeClearTextOutput(bool bTeeClearTextOutput) { m_bTeeClearTextOutput = bTeeClearTextOutput; };
 
@@ -213,6 +220,7 @@ public:
     HRESULT SetRepeatBehaviourFromConfig(const ConfigItem& item);
     HRESULT SetRepeatBehaviour(const Repeat behavior);
     HRESULT SetCompressionLevel(const std::wstring& strCompressionLevel);
+    HRESULT SetSchedulingHistory(const SchedulingHistory& history);
 
     void SetOptional() { m_bOptional = true; }
     void SetMandatory() { m_bOptional = false; }
@@ -250,6 +258,8 @@ public:
     const std::wstring& GetOutputFileName() const { return m_strOutputFileName; };
     const std::vector<CommandMessage::Message>& GetCommands() const { return m_Commands; };
 
+    void AddChildPerfTrace(std::filesystem::path path) { m_ChildPerfTraces.push_back(std::move(path)); }
+
     std::vector<std::shared_ptr<Recipient>>& Recipients() { return m_Recipients; };
     const std::vector<std::shared_ptr<Recipient>>& Recipients() const { return m_Recipients; };
 
@@ -534,9 +534,57 @@ CommandMessage::Message WolfExecution::SetCommandFromConfigItem(const ConfigItem
         command->SetTimeout(timeout);
     }
 
+    if (item[WOLFLAUNCHER_COMMAND_PROFILE])
+    {
+        const auto profile = ToCommandProfile(item[WOLFLAUNCHER_COMMAND_PROFILE].c_str());
+        if (profile == CommandProfile::Undefined)
+        {
+            Log::Warn(
+                L"Unknown command profile '{}' (expecting 'cpu' or 'io')",
+                item[WOLFLAUNCHER_COMMAND_PROFILE].c_str());
+        }
+
+        command->SetProfile(profile);
+    }
+
+    if (item[WOLFLAUNCHER_COMMAND_PRIORITY])
+    {
+        LARGE_INTEGER li;
+        hr = GetIntegerFromArg(item[WOLFLAUNCHER_COMMAND_PRIORITY].c_str(), li);
+        if (FAILED(hr))
+        {
+            Log::Debug(L"Failed to initialize command priority [{}]", SystemError(hr));
+            return nullptr;
+        }
+
+        command->SetPriority(static_cast<LONG>(li.QuadPart));
+    }
+
     return command;
 }
 
+HRESULT WolfExecution::SetSchedulingHistory(const SchedulingHistory& history)
+{
+    for (const auto& command : m_Commands)
+    {
+        const auto entry = history.Find(m_commandSet, command->Keyword());
+        if (entry == nullptr)
+        {
+            continue;
+        }
+
+        command->SetExpectedDuration(entry->duration);
+
+        // Configured profile prevails over the observed one
+        if (command->GetProfile() == CommandProfile::Undefined)
+        {
+            command->SetProfile(entry->profile);
+        }
+    }
+
+    return S_OK;
+}
+
 HRESULT WolfExecution::SetRestrictionsFromConfig(const ConfigItem& item)
 {
     HRESULT hr = E_FAIL;
@@ -36,11 +36,14 @@
 #include "SystemDetails.h"
 
 #include "EncodeMessageStream.h"
+#include "AeadStream.h"
+#include "AsyncWriteStream.h"
 
 #include "WolfTask.h"
 #include "Convert.h"
 #include "Utils/Time.h"
 #include "Utils/WinApi.h"
+#include "Utils/Trace.h"
 #include "Text/HexDump.h"
 #include "Text/Fmt/std_optional.h"
 #include "Text/Fmt/ByteQuantity.h"
@@ -212,8 +215,9 @@ HRESULT WolfExecution::BuildFullArchiveName()
 
     if (!m_Recipients.empty())
     {
-        m_strOutputFullPath = m_strArchiveFullPath + L".p7b";
-        m_strOutputFileName = m_strArchiveFileName + L".p7b";
+        const std::wstring extension = UseAeadEncryption() ? AeadStream::kFileExtension : L".p7b";
+        m_strOutputFullPath = m_strArchiveFullPath + extension;
+        m_strOutputFileName = m_strArchiveFileName + extension;
     }
     else
     {
@@ -369,29 +373,52 @@ HRESULT WolfExecution::CreateArchiveAgent()
             return hr;
         }
 
-        auto pEncodingStream = std::make_shared<EncodeMessageStream>();
+        // Compression, encryption and disk write each run on their own thread
+        auto pWriteStage = std::make_shared<AsyncWriteStream>(m_archiveHashStream);
 
-        for (auto& recipient : m_Recipients)
-        {
-            if (FAILED(hr = pEncodingStream->AddRecipient(recipient->Certificate)))
+        auto initializeEncodingStream = [this, &pWriteStage](auto& stream) {
+            HRESULT hr = E_FAIL;
+            for (auto& recipient : m_Recipients)
+            {
+                if (FAILED(hr = stream.AddRecipient(recipient->Certificate)))
+                {
+                    Log::Error(L"Failed to add certificate for recipient '{}' [{}]", recipient->Name, SystemError(hr));
+                    return hr;
+                }
+            }
+            if (FAILED(hr = stream.Initialize(pWriteStage)))
             {
-                Log::Error(L"Failed to add certificate for recipient '{}' [{}]", recipient->Name, SystemError(hr));
+                Log::Error(L"Failed initialize encoding stream for '{}' [{}]", m_strOutputFullPath, SystemError(hr));
                 return hr;
             }
+            return S_OK;
+        };
+
+        std::shared_ptr<ByteStream> pEncodingStream;
+        if (UseAeadEncryption())
+        {
+            auto pAeadStream = std::make_shared<AeadEncryptStream>();
+            if (FAILED(hr = initializeEncodingStream(*pAeadStream)))
+                return hr;
+            pEncodingStream = pAeadStream;
         }
-        if (FAILED(hr = pEncodingStream->Initialize(m_archiveHashStream)))
+        else
         {
-            Log::Error(L"Failed initialize encoding stream for '{}' [{}]", m_strOutputFullPath, SystemError(hr));
-            return hr;
+            auto pMessageStream = std::make_shared<EncodeMessageStream>();
+            if (FAILED(hr = initializeEncodingStream(*pMessageStream)))
+                return hr;
+            pEncodingStream = pMessageStream;
         }
 
+        auto pEncodingStage = std::make_shared<AsyncWriteStream>(pEncodingStream);
+
         std::shared_ptr<ByteStream> pFinalStream;
 
         if (UseJournalWhenEncrypting())
         {
             auto pJournalingStream = std::make_shared<JournalingStream>();
 
-            if (FAILED(hr = pJournalingStream->Open(pEncodingStream)))
+            if (FAILED(hr = pJournalingStream->Open(pEncodingStage)))
             {
                 Log::Error(L"Failed open journaling stream to write [{}]", SystemError(hr));
                 return hr;
@@ -402,7 +429,7 @@ HRESULT WolfExecution::CreateArchiveAgent()
         {
             auto pAccumulatingStream = std::make_shared<AccumulatingStream>();
 
-            if (FAILED(hr = pAccumulatingStream->Open(pEncodingStream, m_Temporary.Path, 100 * 1024 * 1024)))
+            if (FAILED(hr = pAccumulatingStream->Open(pEncodingStage, m_Temporary.Path, 100 * 1024 * 1024)))
             {
                 Log::Error(L"Failed open accumulating stream to write [{}]", SystemError(hr));
                 return hr;
@@ -584,6 +611,29 @@ HRESULT WolfExecution::CreateCommandAgent(
                             statistics.SetPeakJobMemory(jobStats->PeakJobMemoryUsed);
                             statistics.SetIOCounters(jobStats->IoInfo);
 
+                            if (Trace::IsEnabled())
+                            {
+                                auto spans = Trace::GetStatistics(true);
+                                for (const auto& path : m_ChildPerfTraces)
+                                {
+                                    std::error_code ec;
+                                    const auto statisticsPath = Trace::GetStatisticsPath(path);
+                                    const auto childSpans = Trace::ReadStatistics(statisticsPath, ec);
+                                    if (ec)
+                                    {
+                                        Log::Debug(
+                                            L"Failed to read child performance statistics '{}' [{}]",
+                                            statisticsPath.c_str(),
+                                            ec);
+                                        continue;
+                                    }
+
+                                    Trace::MergeStatistics(spans, childSpans);
+                                }
+
+                                statistics.SetTraceStatistics(std::move(spans));
+                            }
+
                             commandSetOutcome.SetJobStatistics(statistics);
                         }
 
@@ -603,6 +653,7 @@ HRESULT WolfExecution::CreateCommandAgent(
                                 commandOutcome.GetOrigin().SetResourceName(task->OriginResourceName());
                                 commandOutcome.GetOrigin().SetFriendlyName(task->OriginFriendlyName());
                                 commandOutcome.SetSha1(task->ExecutableSha1());
+                                commandOutcome.SetStartupTime(task->StartupTime());
                                 commandOutcome.SetCreationTime(FromFileTime(task->CreationTime()));
                                 commandOutcome.SetExitTime(FromFileTime(task->ExitTime()));
 
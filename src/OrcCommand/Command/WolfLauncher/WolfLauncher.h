@@ -100,6 +100,7 @@ public:
         OutputSpec TempWorkingDir;
 
         std::optional<std::wstring> strOfflineLocation;
+        std::optional<std::wstring> strSchedulingHistory;
 
         std::chrono::milliseconds msRefreshTimer = 1s;
         std::chrono::milliseconds msArchiveTimeOut = 10min;
@@ -117,6 +118,7 @@ public:
         bool bAddConfigToArchive = true;
         bool bUseJournalWhenEncrypting = true;
         bool bNoJournaling = false;
+        bool bAeadEncryption = false;
         bool bTeeClearTextOutput = false;
         bool bWERDontShowUI = false;
         bool bNoLimits = false;
@@ -310,6 +310,18 @@ HRESULT Main::GetConfigurationFromConfig(const ConfigItem& configitem)
         }
     }
 
+    if (configitem[WOLFLAUNCHER_AEAD_ENCRYPTION])
+    {
+        if (equalCaseInsensitive(L"No"sv, (const std::wstring&)configitem[WOLFLAUNCHER_AEAD_ENCRYPTION]))
+        {
+            config.bAeadEncryption = false;
+        }
+        else
+        {
+            config.bAeadEncryption = true;
+        }
+    }
+
     ReadLogConfiguration(configitem[WOLFLAUNCHER_LOG], configitem[WOLFLAUNCHER_CONSOLE].Status == ConfigItem::PRESENT);
 
     if (configitem[WOLFLAUNCHER_CONSOLE])
@@ -694,6 +706,8 @@ HRESULT Main::GetConfigurationFromArgcArgv(int argc, LPCWSTR argv[])
                         ;
                     else if (ParameterOption(argv[i] + 1, L"Offline", config.strOfflineLocation))
                         ;
+                    else if (ParameterOption(argv[i] + 1, L"SchedulingHistory", config.strSchedulingHistory))
+                        ;
                     else if (BooleanOption(argv[i] + 1, L"Beep", config.bBeepWhenDone))
                         ;
                     else if (ParameterOption(argv[i] + 1, L"Priority", strPriority))
@@ -713,6 +727,8 @@ HRESULT Main::GetConfigurationFromArgcArgv(int argc, LPCWSTR argv[])
                     {
                         config.bUseJournalWhenEncrypting = false;
                     }
+                    else if (BooleanOption(argv[i] + 1, L"aead_encryption", config.bAeadEncryption))
+                        ;
                     else if (EncodingOption(argv[i] + 1, config.Output.OutputEncoding))
                     {
                         config.TempWorkingDir.OutputEncoding = config.Output.OutputEncoding;
@@ -943,11 +959,31 @@ HRESULT Main::CheckConfiguration()
         config.RepeatBehavior = WolfExecution::Repeat::Overwrite;
     }
 
+    std::optional<SchedulingHistory> schedulingHistory;
+    if (config.strSchedulingHistory)
+    {
+        auto history = SchedulingHistory::Load(*config.strSchedulingHistory);
+        if (history.has_error())
+        {
+            Log::Warn(L"Failed to load scheduling history '{}' [{}]", *config.strSchedulingHistory, history.error());
+        }
+        else
+        {
+            schedulingHistory = std::move(history.value());
+        }
+    }
+
     for (const auto& wolfexec : m_wolfexecs)
     {
         wolfexec->SetRepeatBehaviour(config.RepeatBehavior);
+
+        if (schedulingHistory)
+        {
+            wolfexec->SetSchedulingHistory(*schedulingHistory);
+        }
         wolfexec->SetOutput(config.Output, config.TempWorkingDir);
         wolfexec->SetRecipients(config.m_Recipients);
+        wolfexec->SetUseAeadEncryption(config.bAeadEncryption);
 
         if (!config.strCompressionLevel.empty())
         {
@@ -1147,5 +1183,28 @@ HRESULT Main::CheckConfiguration()
         }
     }
 
+    // Each DFIR-Orc child traces into its own file, next to the launcher's, for the job statistics to merge it
+    if (m_perfTracePath)
+    {
+        for (const auto& exec : m_wolfexecs)
+        {
+            for (const auto& command : exec->GetCommands())
+            {
+                if (!command->IsSelfOrcExecutable())
+                {
+                    continue;
+                }
+
+                auto tracePath = *m_perfTracePath;
+                tracePath.replace_filename(fmt::format(
+                    L"{}_{}_{}.json", m_perfTracePath->stem().c_str(), exec->GetKeyword(), command->Keyword()));
+
+                command->PushArgument(
+                    command->GetParameters().size(), fmt::format(L"/PerfTrace=\"{}\"", tracePath.c_str()));
+                exec->AddChildPerfTrace(std::move(tracePath));
+            }
+        }
+    }
+
     return S_OK;
 }
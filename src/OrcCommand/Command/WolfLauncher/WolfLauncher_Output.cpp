@@ -133,6 +133,10 @@ void Main::PrintUsage()
         Usage::kMiscParameterCompression,
         Usage::Parameter {"/ChildDebug", "Attach a debugger to child processes, dump memory in case of crash"},
         Usage::Parameter {"/NoChildDebug", "Block child debugging (if selected in config file)"},
+        Usage::Parameter {
+            "/aead_encryption",
+            "Encrypt archives with chunked AES-256-GCM instead of a CMS enveloped message into '.aead' files, "
+            "decrypted with 'DFIR-Orc.exe Decrypt' (or aead_encryption=\"yes\" in configuration)"},
         Usage::Parameter {
             "/archive_timeout",
             "Configures the time (in minutes) the engine will wait for the archive to complete. Upon timeout, this "
@@ -145,6 +149,9 @@ void Main::PrintUsage()
             "/NoLimits[:<KeyWord1>,<Keyword2>, ...]",
             "Override specified limits on GetThis or GetSamples on all commands or comma separated list (output can "
             "get VERY big)"},
+        Usage::Parameter {
+            "/SchedulingHistory=<Outcome.json>",
+            "Use the command durations and resource usage of a previous outcome file to order and throttle commands"},
         Usage::Parameter {
             "/WERDontShowUI",
             "Configures Windows Error Reporting to prevent blocking UI in case of a crash during DFIR ORC execution. "
@@ -180,6 +187,7 @@ void Main::PrintParameters()
     PrintValue(node, L"Output", config.Output);
     PrintValue(node, L"TempDir", config.TempWorkingDir);
     PrintValue(node, L"Child debug", config.bChildDebug);
+    PrintValue(node, L"AEAD encryption", Traits::Boolean(config.bAeadEncryption));
     PrintValue(node, L"CreateNew", Traits::Boolean(config.bRepeatCreateNew));
     PrintValue(node, L"Once", Traits::Boolean(config.bRepeatOnce));
     PrintValue(node, L"Overwrite", Traits::Boolean(config.bRepeatOverwrite));
@@ -27,6 +27,7 @@
 #include "FileStream.h"
 #include "SystemIdentity.h"
 #include "CryptoHashStream.h"
+#include "CommandAgentResources.h"
 
 #include "Utils/Guard.h"
 #include "Utils/TypeTraits.h"
@@ -1140,6 +1141,12 @@ HRESULT Main::Run_Execute()
         }
     }
 
+    // Embedded tools are shared between command sets, delete them once all sets are complete
+    if (auto hr = CommandAgentResources::DeleteSharedResources(); FAILED(hr))
+    {
+        Log::Error(L"Failed to delete extracted resources [{}]", SystemError(hr));
+    }
+
     auto rv = CreateAndUploadOutcome();
     if (rv.has_error())
     {
@@ -47,6 +47,7 @@ HRESULT WolfTask::ApplyNotification(
             m_originResourceName = notification->GetOriginResourceName();
             m_originFriendlyName = notification->GetOriginFriendlyName();
             m_executableSha1 = notification->GetExecutableSha1();
+            m_startupTime = notification->GetStartupTime();
             m_isSelfOrcExecutable = notification->IsSelfOrcExecutable();
             m_orcTool = notification->GetOrcTool();
 
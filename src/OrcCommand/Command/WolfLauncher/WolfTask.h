@@ -70,6 +70,7 @@ public:
     std::optional<std::wstring> OriginResourceName() const { return m_originResourceName; }
     std::optional<std::wstring> OriginFriendlyName() const { return m_originFriendlyName; }
     std::optional<std::wstring> ExecutableSha1() const { return m_executableSha1; }
+    std::optional<std::chrono::milliseconds> StartupTime() const { return m_startupTime; }
     std::optional<std::wstring> OrcTool() const { return m_orcTool; }
     bool IsSelfOrcExecutable() const { return m_isSelfOrcExecutable; }
 
@@ -86,6 +87,7 @@ private:
     std::optional<std::wstring> m_originResourceName;
     std::optional<std::wstring> m_originFriendlyName;
     std::optional<std::wstring> m_executableSha1;
+    std::optional<std::chrono::milliseconds> m_startupTime;
     std::optional<std::wstring> m_orcTool;
     bool m_isSelfOrcExecutable;
 
@@ -104,6 +104,8 @@ public:
 
         void AddEndpoint(Orc::Log::UdpSocket&& socket) { m_syslogSink.AddEndpoint(std::move(socket)); }
 
+        uint64_t DroppedCount() const { return m_syslogSink.DroppedCount(); }
+
     private:
         SyslogSinkT& m_syslogSink;
     };
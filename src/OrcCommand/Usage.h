@@ -136,6 +136,7 @@ auto PrintLoggingParameters(Orc::Text::Tree& root, CustomParameterLists&&... cus
 
 constexpr std::array kUsageMiscellaneous = {
     Parameter("/Low", "Runs with lowered priority"),
+    Parameter("/PerfTrace=<File.json>", "Record a performance trace of the command (chrome://tracing format)"),
     Parameter("/Config=<ConfigFile>", "XML configuration file overriding current values")};
 
 constexpr auto kMiscParameterLocal = Usage::Parameter {
@@ -155,6 +156,10 @@ constexpr auto kMiscParameterResurrectRecords = Usage::Parameter {
     "/ResurrectRecords",
     "Include records marked as \"not in use\" in enumeration. (they will need the FILE tag)"};
 
+constexpr auto kMiscParameterParallelLocations = Usage::Parameter {
+    "/Parallel=<N>",
+    "Parse up to N physical drives concurrently. Volumes and shadow copies of a same drive are parsed sequentially"};
+
 constexpr auto kMiscParameterCompression =
     Usage::Parameter {"/Compression=<CompressionLevel>", "Set archive compression level"};
 
@@ -9,8 +9,10 @@
 
 #include "UtilitiesMain.h"
 
+#include <atomic>
 #include <filesystem>
 #include <set>
+#include <thread>
 
 #include <psapi.h>
 
@@ -32,6 +34,7 @@
 #include "PSAPIExtension.h"
 #include "CaseInsensitive.h"
 #include "Utils/WinApi.h"
+#include "Utils/Trace.h"
 
 using namespace std;
 
@@ -357,6 +360,64 @@ HRESULT Orc::Command::UtilitiesMain::LoadPSAPI()
     return S_OK;
 }
 
+void UtilitiesMain::ForEachLocation(
+    const std::vector<std::shared_ptr<Location>>& locations,
+    DWORD dwMaxThreads,
+    const std::function<void(size_t)>& callback)
+{
+    auto SafeCallback = [&callback, &locations](size_t index) {
+        try
+        {
+            callback(index);
+        }
+        catch (const std::exception& e)
+        {
+            Log::Error("Exception while processing location '{}': {}", locations[index]->GetLocation(), e.what());
+        }
+        catch (...)
+        {
+            Log::Error(L"Exception while processing location '{}'", locations[index]->GetLocation());
+        }
+    };
+
+    const auto groups = LocationSet::GroupByPhysicalDrive(locations);
+    const auto dwThreads = static_cast<DWORD>(std::min<size_t>(dwMaxThreads, groups.size()));
+
+    if (dwThreads <= 1)
+    {
+        for (size_t i = 0; i < locations.size(); ++i)
+        {
+            SafeCallback(i);
+        }
+        return;
+    }
+
+    Log::Debug(L"Processing {} location(s) on {} drive(s) with {} threads", locations.size(), groups.size(), dwThreads);
+
+    // Each thread takes the next drive and processes its locations sequentially to avoid seek thrashing
+    std::atomic<size_t> nextGroup = 0;
+    std::vector<std::thread> threads;
+    threads.reserve(dwThreads);
+
+    for (DWORD i = 0; i < dwThreads; ++i)
+    {
+        threads.emplace_back([&]() {
+            for (auto group = nextGroup++; group < groups.size(); group = nextGroup++)
+            {
+                for (const auto index : groups[group])
+                {
+                    SafeCallback(index);
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
 bool UtilitiesMain::OutputOption(LPCWSTR szArg, LPCWSTR szOption, OutputSpec::Kind supportedTypes, OutputSpec& anOutput)
 {
     HRESULT hr = E_FAIL;
@@ -1022,6 +1083,89 @@ bool UtilitiesMain::IgnoreWaitForDebuggerOption(LPCWSTR szArg)
     return false;
 }
 
+bool UtilitiesMain::PerfTrace(int argc, const WCHAR* argv[])
+{
+    for (int i = 0; i < argc; i++)
+    {
+        switch (argv[i][0])
+        {
+            case L'/':
+            case L'-':
+                if (PerfTraceOption(argv[i] + 1))
+                    return true;
+        }
+    }
+    return false;
+}
+
+bool UtilitiesMain::PerfTraceOption(LPCWSTR szArg)
+{
+    if (_wcsnicmp(szArg, L"PerfTrace", wcslen(L"PerfTrace")))
+        return false;
+
+    LPCWSTR szPath = szArg + wcslen(L"PerfTrace");
+    if (*szPath != L'=' && *szPath != L':')
+    {
+        Log::Error(L"Option /PerfTrace should be like: /PerfTrace=<File.json>");
+        return false;
+    }
+
+    szPath++;
+    if (*szPath == L'\0')
+    {
+        Log::Error(L"Option /PerfTrace should be like: /PerfTrace=<File.json>");
+        return false;
+    }
+
+    m_perfTracePath = std::filesystem::absolute(szPath);
+    Trace::Enable();
+    Log::Debug(L"Performance trace will be written to '{}'", m_perfTracePath->c_str());
+    return true;
+}
+
+bool UtilitiesMain::IgnorePerfTraceOption(LPCWSTR szArg)
+{
+    if (!_wcsnicmp(szArg, L"PerfTrace", wcslen(L"PerfTrace")))
+        return true;
+    return false;
+}
+
+void UtilitiesMain::WritePerfTrace()
+{
+    if (!m_perfTracePath)
+    {
+        return;
+    }
+
+    std::error_code ec;
+    Trace::WriteChromeTrace(*m_perfTracePath, ec);
+    if (ec)
+    {
+        Log::Error(L"Failed to write performance trace '{}' [{}]", m_perfTracePath->c_str(), ec);
+        return;
+    }
+
+    // Aggregates are read back by a parent WolfLauncher to be merged into its job statistics
+    const auto statisticsPath = Trace::GetStatisticsPath(*m_perfTracePath);
+    Trace::WriteStatistics(statisticsPath, ec);
+    if (ec)
+    {
+        Log::Error(L"Failed to write performance statistics '{}' [{}]", statisticsPath.c_str(), ec);
+        ec.clear();
+    }
+
+    for (const auto& stats : Trace::GetStatistics())
+    {
+        Log::Debug(
+            "Trace: {}/{}: {} calls, {} ms, {} bytes",
+            stats.Category,
+            stats.Name,
+            stats.Count,
+            stats.Duration.count() / 1000,
+            stats.Bytes);
+    }
+}
+
 bool UtilitiesMain::IgnoreLoggingOptions(LPCWSTR szArg)
 {
     if (!_wcsnicmp(szArg, L"Verbose", wcslen(L"Verbose")) || !_wcsnicmp(szArg, L"Trace", wcslen(L"Trace"))
@@ -1073,6 +1217,11 @@ bool UtilitiesMain::IgnoreCommonOptions(LPCWSTR szArg)
         return true;
     }
 
+    if (IgnorePerfTraceOption(szArg))
+    {
+        return true;
+    }
+
     if (IgnoreConfigOptions(szArg))
     {
         return true;
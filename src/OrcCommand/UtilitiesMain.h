@@ -50,6 +50,7 @@
 #include <iostream>
 #include <chrono>
 #include <filesystem>
+#include <functional>
 
 #include <concrt.h>
 
@@ -488,12 +489,22 @@ protected:
     UtilitiesConfiguration m_utilitiesConfig;
     HANDLE m_hMothership;
 
+    // Where the performance trace is written when the command completes, if requested with /PerfTrace
+    std::optional<std::filesystem::path> m_perfTracePath;
+
     std::vector<std::shared_ptr<ExtensionLibrary>> m_extensions;
     HRESULT LoadCommonExtensions();
     HRESULT LoadWinTrust();
     HRESULT LoadEvtLibrary();
     HRESULT LoadPSAPI();
 
+    // Calls 'callback' with the index of each location. Up to 'dwMaxThreads' physical drives are processed
+    // concurrently, the locations of a same drive (volumes, shadow copies) are always processed sequentially.
+    static void ForEachLocation(
+        const std::vector<std::shared_ptr<Location>>& locations,
+        DWORD dwMaxThreads,
+        const std::function<void(size_t)>& callback);
+
     virtual void Configure(int argc, const wchar_t* argv[]);
 
     void PrintCommonParameters(Orc::Text::Tree& root);
@@ -762,6 +773,11 @@ protected:
     bool IgnoreWaitForDebuggerOption(LPCWSTR szArg);
     bool WaitForDebuggerOption(LPCWSTR szArg);
 
+    bool PerfTrace(int argc, const WCHAR* argv[]);
+    bool IgnorePerfTraceOption(LPCWSTR szArg);
+    bool PerfTraceOption(LPCWSTR szArg);
+    void WritePerfTrace();
+
     bool IgnoreLoggingOptions(LPCWSTR szArg);
     bool IgnoreConfigOptions(LPCWSTR szArg);
     bool IgnoreCommonOptions(LPCWSTR szArg);
@@ -854,6 +870,7 @@ public:
         }
 
         Cmd.WaitForDebugger(argc, argv);
+        Cmd.PerfTrace(argc, argv);
 
         // TODO: FIXME
 
@@ -1000,7 +1017,14 @@ public:
 
         GetSystemTime(&Cmd.theFinishTime.value);
         Cmd.theFinishTickCount = GetTickCount();
+
+        if (const auto dropped = Cmd.m_logging.syslogSink()->DroppedCount())
+        {
+            Log::Warn("Syslog queue was full, {} record(s) were dropped", dropped);
+        }
+
         Cmd.PrintFooter();
+        Cmd.WritePerfTrace();
 
         if (WSACleanup())
         {
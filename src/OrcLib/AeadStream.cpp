@@ -0,0 +1,723 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include "AeadStream.h"
+
+#include "BCryptExtension.h"
+#include "CryptoUtilities.h"
+
+#include <thread>
+
+#include <boost/scope_exit.hpp>
+
+#ifndef BCRYPT_CHACHA20_POLY1305_ALGORITHM
+#    define BCRYPT_CHACHA20_POLY1305_ALGORITHM L"CHACHA20_POLY1305"
+#endif
+
+using namespace Orc;
+
+namespace {
+
+constexpr size_t kMaxSlots = 16;
+
+size_t GetSlotCount()
+{
+    const size_t threads = std::thread::hardware_concurrency();
+    return (std::max)(static_cast<size_t>(1), (std::min)(threads, kMaxSlots));
+}
+
+// RSA operations of CryptoAPI use little endian buffers, wrapped keys are stored in big endian like CNG and PKCS#1
+void ReverseBytes(CBinaryBuffer& buffer)
+{
+    std::reverse(buffer.GetData(), buffer.GetData() + buffer.GetCount());
+}
+
+}  // namespace
+
+AeadStream::AeadStream(Algorithm algorithm, ULONG chunkSize)
+    : ChainingStream()
+    , m_algorithm(algorithm)
+    , m_chunkSize((std::min)((std::max)(chunkSize, kMinChunkSize), kMaxChunkSize))
+    , m_slots(::GetSlotCount())
+{
+    m_authenticatedHeader.fill(0);
+}
+
+HRESULT AeadStream::OpenKey(const std::array<BYTE, kKeySize>& key)
+{
+    HRESULT hr = E_FAIL;
+
+    m_bcrypt = ExtensionLibrary::GetLibrary<BCryptExtension>();
+    if (m_bcrypt == nullptr)
+    {
+        Log::Error("Failed to load bcrypt library, authenticated encryption requires Windows 7 or later");
+        return E_FAIL;
+    }
+
+    const auto szAlgorithm =
+        m_algorithm == Algorithm::ChaCha20Poly1305 ? BCRYPT_CHACHA20_POLY1305_ALGORITHM : BCRYPT_AES_ALGORITHM;
+
+    if (FAILED(hr = m_bcrypt->BCryptOpenAlgorithmProvider(&m_hAlgorithm, szAlgorithm, nullptr, 0L)))
+    {
+        Log::Error(L"Failed to open algorithm provider '{}' [{}]", szAlgorithm, SystemError(hr));
+        return hr;
+    }
+
+    if (m_algorithm == Algorithm::AES256GCM)
+    {
+        if (FAILED(
+                hr = m_bcrypt->BCryptSetProperty(
+                    m_hAlgorithm,
+                    BCRYPT_CHAINING_MODE,
+                    (PUCHAR)BCRYPT_CHAIN_MODE_GCM,
+                    static_cast<ULONG>(sizeof(BCRYPT_CHAIN_MODE_GCM)),
+                    0L)))
+        {
+            Log::Error("Failed to set GCM chaining mode [{}]", SystemError(hr));
+            return hr;
+        }
+    }
+
+    for (size_t i = 0; i < m_slots; ++i)
+    {
+        BCRYPT_KEY_HANDLE hKey = NULL;
+        if (FAILED(
+                hr = m_bcrypt->BCryptGenerateSymmetricKey(
+                    m_hAlgorithm, &hKey, nullptr, 0L, const_cast<PUCHAR>(key.data()), kKeySize, 0L)))
+        {
+            Log::Error("Failed to create content key [{}]", SystemError(hr));
+            return hr;
+        }
+
+        m_keys.push_back(hKey);
+    }
+
+    m_output.resize(m_slots * (m_chunkSize + kTagSize));
+    return S_OK;
+}
+
+HRESULT AeadStream::CryptChunk(
+    BCRYPT_KEY_HANDLE hKey,
+    bool bEncrypt,
+    ULONGLONG ullIndex,
+    bool bFinal,
+    const BYTE* pInput,
+    ULONG cbInput,
+    BYTE* pOutput,
+    BYTE* pTag)
+{
+    std::array<BYTE, kNonceSize> nonce;
+    nonce.fill(0);
+    CopyMemory(nonce.data(), &ullIndex, sizeof(ullIndex));
+    nonce[sizeof(ullIndex)] = bFinal ? 1 : 0;
+
+    BCRYPT_AUTHENTICATED_CIPHER_MODE_INFO info;
+    BCRYPT_INIT_AUTH_MODE_INFO(info);
+    info.pbNonce = nonce.data();
+    info.cbNonce = static_cast<ULONG>(nonce.size());
+    info.pbAuthData = m_authenticatedHeader.data();
+    info.cbAuthData = static_cast<ULONG>(m_authenticatedHeader.size());
+    info.pbTag = pTag;
+    info.cbTag = kTagSize;
+
+    ULONG cbResult = 0L;
+    if (bEncrypt)
+    {
+        return m_bcrypt->BCryptEncrypt(
+            hKey, const_cast<PUCHAR>(pInput), cbInput, &info, nullptr, 0L, pOutput, cbInput, &cbResult, 0L);
+    }
+
+    return m_bcrypt->BCryptDecrypt(
+        hKey, const_cast<PUCHAR>(pInput), cbInput, &info, nullptr, 0L, pOutput, cbInput, &cbResult, 0L);
+}
+
+HRESULT AeadStream::CryptChunks(bool bEncrypt, const BYTE* pInput, size_t count, ULONG cbLast, bool bFinal)
+{
+    if (count == 0)
+        return S_OK;
+
+    if (count > m_keys.size())
+        return E_INVALIDARG;
+
+    const size_t recordSize = m_chunkSize + kTagSize;
+    const size_t inputStride = bEncrypt ? m_chunkSize : recordSize;
+    const size_t outputStride = bEncrypt ? recordSize : m_chunkSize;
+
+    std::vector<HRESULT> results(count, S_OK);
+    auto cryptChunk = [&](size_t i) {
+        const ULONG cbChunk = i + 1 == count ? cbLast : m_chunkSize;
+        const BYTE* pChunkInput = pInput + i * inputStride;
+        BYTE* pChunkOutput = m_output.data() + i * outputStride;
+
+        // Tags follow the ciphertext of their chunk
+        BYTE* pTag = const_cast<BYTE*>(bEncrypt ? pChunkOutput + cbChunk : pChunkInput + cbChunk);
+
+        results[i] = CryptChunk(
+            m_keys[i], bEncrypt, m_chunkIndex + i, bFinal && i + 1 == count, pChunkInput, cbChunk, pChunkOutput, pTag);
+    };
+
+    if (count > 1)
+    {
+        Concurrency::parallel_for(static_cast<size_t>(0), count, cryptChunk);
+    }
+    else
+    {
+        cryptChunk(0);
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (FAILED(results[i]))
+        {
+            Log::Error(
+                "Failed to {} chunk #{} [{}]",
+                bEncrypt ? "encrypt" : "decrypt",
+                m_chunkIndex + i,
+                SystemError(results[i]));
+            return results[i];
+        }
+    }
+
+    m_chunkIndex += count;
+
+    const size_t cbOutput = (count - 1) * outputStride + cbLast + (bEncrypt ? kTagSize : 0);
+
+    HRESULT hr = E_FAIL;
+    ULONGLONG ullWritten = 0LL;
+    if (FAILED(hr = m_pChainedStream->Write(m_output.data(), cbOutput, &ullWritten)))
+    {
+        Log::Error("Failed to write {} bytes to chained stream [{}]", cbOutput, SystemError(hr));
+        return hr;
+    }
+
+    return S_OK;
+}
+
+__data_entrypoint(File) HRESULT AeadStream::Read_(
+    __out_bcount_part(cbBytesToRead, *pcbBytesRead) PVOID pBuffer,
+    __in ULONGLONG cbBytesToRead,
+    __out_opt PULONGLONG pcbBytesRead)
+{
+    DBG_UNREFERENCED_PARAMETER(pBuffer);
+    DBG_UNREFERENCED_PARAMETER(cbBytesToRead);
+
+    if (pcbBytesRead)
+        *pcbBytesRead = 0;
+
+    Log::Debug("Cannot read from an AeadStream");
+    return E_NOTIMPL;
+}
+
+HRESULT AeadStream::SetFilePointer(
+    __in LONGLONG lDistanceToMove,
+    __in DWORD dwMoveMethod,
+    __out_opt PULONG64 pqwCurrPointer)
+{
+    // Only querying the current position is supported
+    if (lDistanceToMove != 0LL || dwMoveMethod != FILE_CURRENT)
+    {
+        Log::Debug("SetFilePointer is not supported by AeadStream");
+        return E_NOTIMPL;
+    }
+
+    if (pqwCurrPointer)
+        *pqwCurrPointer = m_ullWritten;
+    return S_OK;
+}
+
+ULONG64 AeadStream::GetSize()
+{
+    Log::Debug("AeadStream: GetSize is not implemented");
+    return (ULONG64)-1;
+}
+
+HRESULT AeadStream::SetSize(ULONG64 ullNewSize)
+{
+    DBG_UNREFERENCED_PARAMETER(ullNewSize);
+    Log::Debug("AeadStream: SetSize is not implemented");
+    return S_OK;
+}
+
+AeadStream::~AeadStream()
+{
+    for (auto hKey : m_keys)
+    {
+        m_bcrypt->BCryptDestroyKey(hKey);
+    }
+    m_keys.clear();
+
+    if (m_hAlgorithm != NULL)
+    {
+        m_bcrypt->BCryptCloseAlgorithmProvider(m_hAlgorithm, 0L);
+        m_hAlgorithm = NULL;
+    }
+}
+
+STDMETHODIMP AeadEncryptStream::AddRecipient(const CBinaryBuffer& certificate)
+{
+    PCCERT_CONTEXT pCertContext = CertCreateCertificateContext(
+        X509_ASN_ENCODING | PKCS_7_ASN_ENCODING, certificate.GetData(), static_cast<DWORD>(certificate.GetCount()));
+    if (pCertContext == NULL)
+    {
+        const auto hr = HRESULT_FROM_WIN32(GetLastError());
+        Log::Error("Failed CertCreateCertificateContext [{}]", SystemError(hr));
+        return hr;
+    }
+
+    m_recipients.push_back(pCertContext);
+    return S_OK;
+}
+
+HRESULT
+AeadEncryptStream::WrapKey(PCCERT_CONTEXT pRecipient, const std::array<BYTE, kKeySize>& key, CBinaryBuffer& wrappedKey)
+{
+    HRESULT hr = E_FAIL;
+
+    HCRYPTPROV hProv = NULL;
+    if (FAILED(hr = CryptoUtilities::AcquireContext(hProv)))
+    {
+        Log::Error("Failed to acquire suitable Crypto Service Provider [{}]", SystemError(hr));
+        return hr;
+    }
+    BOOST_SCOPE_EXIT(hProv) { CryptReleaseContext(hProv, 0L); }
+    BOOST_SCOPE_EXIT_END;
+
+    HCRYPTKEY hPublicKey = NULL;
+    if (!CryptImportPublicKeyInfo(hProv, X509_ASN_ENCODING, &pRecipient->pCertInfo->SubjectPublicKeyInfo, &hPublicKey))
+    {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+        Log::Error("Failed CryptImportPublicKeyInfo [{}]", SystemError(hr));
+        return hr;
+    }
+    BOOST_SCOPE_EXIT(hPublicKey) { CryptDestroyKey(hPublicKey); }
+    BOOST_SCOPE_EXIT_END;
+
+    DWORD cbWrapped = kKeySize;
+    if (!CryptEncrypt(hPublicKey, NULL, TRUE, CRYPT_OAEP, NULL, &cbWrapped, 0L))
+    {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+        Log::Error("Failed to compute wrapped key size [{}]", SystemError(hr));
+        return hr;
+    }
+
+    if (!wrappedKey.SetCount(cbWrapped))
+        return E_OUTOFMEMORY;
+
+    CopyMemory(wrappedKey.GetData(), key.data(), kKeySize);
+
+    DWORD cbData = kKeySize;
+    if (!CryptEncrypt(hPublicKey, NULL, TRUE, CRYPT_OAEP, wrappedKey.GetData(), &cbData, cbWrapped))
+    {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+        Log::Error("Failed to wrap content key [{}]", SystemError(hr));
+        return hr;
+    }
+
+    ReverseBytes(wrappedKey);
+    return S_OK;
+}
+
+STDMETHODIMP AeadEncryptStream::Initialize(const std::shared_ptr<ByteStream>& pInnerStream)
+{
+    HRESULT hr = E_FAIL;
+
+    if (m_recipients.empty())
+    {
+        Log::Error("Authenticated encryption requires at least one recipient");
+        return E_INVALIDARG;
+    }
+
+    m_pChainedStream = pInnerStream;
+
+    std::array<BYTE, kKeySize> key;
+    {
+        HCRYPTPROV hProv = NULL;
+        if (FAILED(hr = CryptoUtilities::AcquireContext(hProv)))
+        {
+            Log::Error("Failed to acquire suitable Crypto Service Provider [{}]", SystemError(hr));
+            return hr;
+        }
+
+        BOOST_SCOPE_EXIT(hProv) { CryptReleaseContext(hProv, 0L); }
+        BOOST_SCOPE_EXIT_END;
+
+        if (!CryptGenRandom(hProv, kKeySize, key.data()))
+        {
+            hr = HRESULT_FROM_WIN32(GetLastError());
+            Log::Error("Failed to generate content key [{}]", SystemError(hr));
+            return hr;
+        }
+    }
+    BOOST_SCOPE_EXIT(&key) { SecureZeroMemory(key.data(), key.size()); }
+    BOOST_SCOPE_EXIT_END;
+
+    Header header;
+    CopyMemory(header.Magic, kMagic, sizeof(header.Magic));
+    header.Version = kVersion;
+    header.Algorithm = static_cast<uint16_t>(m_algorithm);
+    header.ChunkSize = m_chunkSize;
+    header.RecipientCount = static_cast<uint16_t>(m_recipients.size());
+    CopyMemory(m_authenticatedHeader.data(), &header, kAuthenticatedHeaderSize);
+
+    CBinaryBuffer buffer;
+    if (!buffer.SetCount(sizeof(Header)))
+        return E_OUTOFMEMORY;
+    CopyMemory(buffer.GetData(), &header, sizeof(Header));
+
+    for (const auto pRecipient : m_recipients)
+    {
+        RecipientHeader recipient;
+        DWORD cbThumbprint = sizeof(recipient.Thumbprint);
+        if (!CertGetCertificateContextProperty(pRecipient, CERT_SHA1_HASH_PROP_ID, recipient.Thumbprint, &cbThumbprint))
+        {
+            hr = HRESULT_FROM_WIN32(GetLastError());
+            Log::Error("Failed to compute recipient thumbprint [{}]", SystemError(hr));
+            return hr;
+        }
+
+        CBinaryBuffer wrappedKey;
+        if (FAILED(hr = WrapKey(pRecipient, key, wrappedKey)))
+            return hr;
+
+        recipient.WrappedKeySize = static_cast<uint16_t>(wrappedKey.GetCount());
+
+        const auto offset = buffer.GetCount();
+        if (!buffer.SetCount(offset + sizeof(RecipientHeader) + wrappedKey.GetCount()))
+            return E_OUTOFMEMORY;
+        CopyMemory(buffer.GetData() + offset, &recipient, sizeof(RecipientHeader));
+        CopyMemory(buffer.GetData() + offset + sizeof(RecipientHeader), wrappedKey.GetData(), wrappedKey.GetCount());
+    }
+
+    if (FAILED(hr = OpenKey(key)))
+        return hr;
+
+    m_input.resize(m_slots * m_chunkSize);
+
+    ULONGLONG ullWritten = 0LL;
+    if (FAILED(hr = m_pChainedStream->Write(buffer.GetData(), buffer.GetCount(), &ullWritten)))
+    {
+        Log::Error("Failed to write authenticated encryption header [{}]", SystemError(hr));
+        return hr;
+    }
+
+    return S_OK;
+}
+
+HRESULT AeadEncryptStream::Write_(
+    __in_bcount(cbBytes) const PVOID pBuffer,
+    __in ULONGLONG cbBytes,
+    __out PULONGLONG pcbBytesWritten)
+{
+    HRESULT hr = E_FAIL;
+
+    if (m_keys.empty() || m_pChainedStream == nullptr)
+        return E_POINTER;
+
+    *pcbBytesWritten = 0LL;
+
+    auto pData = reinterpret_cast<const BYTE*>(pBuffer);
+    ULONGLONG cbRemaining = cbBytes;
+    while (cbRemaining > 0)
+    {
+        const auto cbCopy = (std::min)(static_cast<ULONGLONG>(m_input.size() - m_cbInput), cbRemaining);
+        CopyMemory(m_input.data() + m_cbInput, pData, static_cast<size_t>(cbCopy));
+        m_cbInput += static_cast<size_t>(cbCopy);
+        pData += cbCopy;
+        cbRemaining -= cbCopy;
+
+        // The last chunk is only encrypted when closing as its nonce is flagged
+        if (m_cbInput == m_input.size())
+        {
+            if (FAILED(hr = CryptChunks(true, m_input.data(), m_slots, m_chunkSize, false)))
+                return hr;
+
+            m_cbInput = 0;
+        }
+    }
+
+    m_ullWritten += cbBytes;
+    *pcbBytesWritten = cbBytes;
+    return S_OK;
+}
+
+HRESULT AeadEncryptStream::Close()
+{
+    HRESULT hr = E_FAIL;
+
+    if (m_bClosed)
+        return S_OK;
+
+    if (m_keys.empty() || m_pChainedStream == nullptr)
+        return E_POINTER;
+
+    m_bClosed = true;
+
+    // Data ends with a short (or empty) final chunk
+    const auto count = m_cbInput / m_chunkSize + 1;
+    const auto cbLast = static_cast<ULONG>(m_cbInput % m_chunkSize);
+    if (FAILED(hr = CryptChunks(true, m_input.data(), count, cbLast, true)))
+        return hr;
+
+    m_cbInput = 0;
+    return m_pChainedStream->Close();
+}
+
+AeadEncryptStream::~AeadEncryptStream()
+{
+    if (!m_bClosed && !m_keys.empty())
+        Close();
+
+    for (auto pRecipient : m_recipients)
+    {
+        CertFreeCertificateContext(pRecipient);
+    }
+    m_recipients.clear();
+}
+
+STDMETHODIMP AeadDecryptStream::Initialize(HCERTSTORE hKeyStore, const std::shared_ptr<ByteStream>& pInnerStream)
+{
+    if (hKeyStore == NULL)
+        return E_INVALIDARG;
+
+    m_hKeyStore = hKeyStore;
+    m_pChainedStream = pInnerStream;
+    return S_OK;
+}
+
+HRESULT AeadDecryptStream::UnwrapKey(
+    const RecipientHeader& recipient,
+    const BYTE* pWrappedKey,
+    std::array<BYTE, kKeySize>& key)
+{
+    HRESULT hr = E_FAIL;
+
+    CRYPT_HASH_BLOB thumbprint;
+    thumbprint.cbData = sizeof(recipient.Thumbprint);
+    thumbprint.pbData = const_cast<BYTE*>(recipient.Thumbprint);
+
+    PCCERT_CONTEXT pCertContext = CertFindCertificateInStore(
+        m_hKeyStore, X509_ASN_ENCODING | PKCS_7_ASN_ENCODING, 0L, CERT_FIND_SHA1_HASH, &thumbprint, NULL);
+    if (pCertContext == NULL)
+    {
+        return HRESULT_FROM_WIN32(ERROR_NOT_FOUND);
+    }
+    BOOST_SCOPE_EXIT(pCertContext) { CertFreeCertificateContext(pCertContext); }
+    BOOST_SCOPE_EXIT_END;
+
+    HCRYPTPROV hProv = NULL;
+    DWORD dwKeySpec = 0L;
+    BOOL bCallerFree = FALSE;
+    if (!CryptAcquireCertificatePrivateKey(
+            pCertContext, CRYPT_ACQUIRE_SILENT_FLAG, NULL, &hProv, &dwKeySpec, &bCallerFree))
+    {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+        Log::Debug("Failed CryptAcquireCertificatePrivateKey [{}]", SystemError(hr));
+        return hr;
+    }
+    BOOST_SCOPE_EXIT(hProv, bCallerFree)
+    {
+        if (bCallerFree)
+            CryptReleaseContext(hProv, 0L);
+    }
+    BOOST_SCOPE_EXIT_END;
+
+    HCRYPTKEY hPrivateKey = NULL;
+    if (!CryptGetUserKey(hProv, dwKeySpec, &hPrivateKey))
+    {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+        Log::Debug("Failed CryptGetUserKey [{}]", SystemError(hr));
+        return hr;
+    }
+    BOOST_SCOPE_EXIT(hPrivateKey) { CryptDestroyKey(hPrivateKey); }
+    BOOST_SCOPE_EXIT_END;
+
+    CBinaryBuffer buffer;
+    if (!buffer.SetCount(recipient.WrappedKeySize))
+        return E_OUTOFMEMORY;
+    CopyMemory(buffer.GetData(), pWrappedKey, recipient.WrappedKeySize);
+    ReverseBytes(buffer);
+
+    DWORD cbData = recipient.WrappedKeySize;
+    if (!CryptDecrypt(hPrivateKey, NULL, TRUE, CRYPT_OAEP, buffer.GetData(), &cbData))
+    {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+        Log::Debug("Failed to unwrap content key [{}]", SystemError(hr));
+        return hr;
+    }
+
+    if (cbData != kKeySize)
+    {
+        Log::Debug("Unexpected content key size: {}", cbData);
+        return NTE_BAD_KEY;
+    }
+
+    CopyMemory(key.data(), buffer.GetData(), kKeySize);
+    SecureZeroMemory(buffer.GetData(), buffer.GetCount());
+    return S_OK;
+}
+
+HRESULT AeadDecryptStream::ReadHeader(size_t& cbHeader)
+{
+    HRESULT hr = E_FAIL;
+
+    if (m_input.size() < sizeof(Header))
+        return S_FALSE;
+
+    Header header;
+    CopyMemory(&header, m_input.data(), sizeof(Header));
+
+    if (memcmp(header.Magic, kMagic, sizeof(header.Magic)) || header.Version != kVersion)
+    {
+        Log::Error("Not an authenticated encryption stream or unsupported version");
+        return NTE_BAD_DATA;
+    }
+
+    if (header.Algorithm != static_cast<uint16_t>(Algorithm::AES256GCM)
+        && header.Algorithm != static_cast<uint16_t>(Algorithm::ChaCha20Poly1305))
+    {
+        Log::Error("Unsupported authenticated encryption algorithm: {}", header.Algorithm);
+        return NTE_BAD_ALGID;
+    }
+
+    if (header.ChunkSize < kMinChunkSize || header.ChunkSize > kMaxChunkSize)
+    {
+        Log::Error("Invalid authenticated encryption chunk size: {}", header.ChunkSize);
+        return NTE_BAD_DATA;
+    }
+
+    // Wait for the whole recipient list before looking for a usable key
+    size_t offset = sizeof(Header);
+    for (uint16_t i = 0; i < header.RecipientCount; ++i)
+    {
+        if (m_input.size() < offset + sizeof(RecipientHeader))
+            return S_FALSE;
+
+        RecipientHeader recipient;
+        CopyMemory(&recipient, m_input.data() + offset, sizeof(RecipientHeader));
+
+        offset += sizeof(RecipientHeader) + recipient.WrappedKeySize;
+        if (m_input.size() < offset)
+            return S_FALSE;
+    }
+
+    std::array<BYTE, kKeySize> key;
+    BOOST_SCOPE_EXIT(&key) { SecureZeroMemory(key.data(), key.size()); }
+    BOOST_SCOPE_EXIT_END;
+
+    hr = HRESULT_FROM_WIN32(ERROR_NOT_FOUND);
+
+    offset = sizeof(Header);
+    for (uint16_t i = 0; i < header.RecipientCount && FAILED(hr); ++i)
+    {
+        RecipientHeader recipient;
+        CopyMemory(&recipient, m_input.data() + offset, sizeof(RecipientHeader));
+
+        hr = UnwrapKey(recipient, m_input.data() + offset + sizeof(RecipientHeader), key);
+        offset += sizeof(RecipientHeader) + recipient.WrappedKeySize;
+    }
+
+    if (FAILED(hr))
+    {
+        Log::Error(
+            "No private key available for any of the {} recipient(s) [{}]", header.RecipientCount, SystemError(hr));
+        return hr;
+    }
+
+    m_algorithm = static_cast<Algorithm>(header.Algorithm);
+    m_chunkSize = header.ChunkSize;
+    CopyMemory(m_authenticatedHeader.data(), &header, kAuthenticatedHeaderSize);
+
+    if (FAILED(hr = OpenKey(key)))
+        return hr;
+
+    cbHeader = offset;
+    return S_OK;
+}
+
+HRESULT AeadDecryptStream::Write_(
+    __in_bcount(cbBytes) const PVOID pBuffer,
+    __in ULONGLONG cbBytes,
+    __out PULONGLONG pcbBytesWritten)
+{
+    HRESULT hr = E_FAIL;
+
+    if (m_hKeyStore == NULL || m_pChainedStream == nullptr)
+        return E_POINTER;
+
+    *pcbBytesWritten = 0LL;
+
+    auto pData = reinterpret_cast<const BYTE*>(pBuffer);
+    m_input.insert(std::end(m_input), pData, pData + cbBytes);
+
+    if (!m_bKeyed)
+    {
+        size_t cbHeader = 0;
+        if (FAILED(hr = ReadHeader(cbHeader)))
+            return hr;
+
+        if (hr == S_FALSE)
+        {
+            *pcbBytesWritten = cbBytes;
+            return S_OK;
+        }
+
+        m_input.erase(std::begin(m_input), std::begin(m_input) + cbHeader);
+        m_bKeyed = true;
+    }
+
+    // A chunk is known not to be the last one only once data follows it
+    const size_t recordSize = m_chunkSize + kTagSize;
+    size_t offset = 0;
+    while (m_input.size() - offset > recordSize)
+    {
+        const auto count = (std::min)((m_input.size() - offset - 1) / recordSize, m_slots);
+        if (FAILED(hr = CryptChunks(false, m_input.data() + offset, count, m_chunkSize, false)))
+            return hr;
+
+        offset += count * recordSize;
+    }
+
+    m_input.erase(std::begin(m_input), std::begin(m_input) + offset);
+
+    m_ullWritten += cbBytes;
+    *pcbBytesWritten = cbBytes;
+    return S_OK;
+}
+
+HRESULT AeadDecryptStream::Close()
+{
+    HRESULT hr = E_FAIL;
+
+    if (m_bClosed)
+        return S_OK;
+
+    if (m_pChainedStream == nullptr)
+        return E_POINTER;
+
+    m_bClosed = true;
+
+    if (!m_bKeyed || m_input.size() < kTagSize || m_input.size() > m_chunkSize + kTagSize)
+    {
+        Log::Error("Authenticated encryption stream is truncated");
+        return NTE_BAD_DATA;
+    }
+
+    const auto cbLast = static_cast<ULONG>(m_input.size() - kTagSize);
+    if (FAILED(hr = CryptChunks(false, m_input.data(), 1, cbLast, true)))
+        return hr;
+
+    m_input.clear();
+    return m_pChainedStream->Close();
+}
+
+AeadDecryptStream::~AeadDecryptStream()
+{
+    if (!m_bClosed && m_bKeyed)
+        Close();
+}
@@ -0,0 +1,193 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#pragma once
+
+#include "ChainingStream.h"
+#include "BinaryBuffer.h"
+
+#include <array>
+
+#include <bcrypt.h>
+
+#pragma managed(push, off)
+
+namespace Orc {
+
+class BCryptExtension;
+
+// Chunked authenticated encryption, an alternative to the CMS enveloped message of EncodeMessageStream whose chunks
+// are encrypted concurrently.
+//
+// Layout (little endian):
+//   header:    "ORCAEAD\0", version (2), algorithm (2), chunk size (4), recipient count (2)
+//   recipient: certificate SHA1 thumbprint (20), wrapped key size (2), RSA-OAEP wrapped content key (big endian)
+//   chunk:     ciphertext (chunk size bytes, the last one is shorter and may be empty), tag (16)
+//
+// The nonce of a chunk is its index followed by a flag only set on the last chunk, and the first 16 bytes of the
+// header are authenticated with each chunk: reordered, truncated or extended streams fail to decrypt.
+class AeadStream : public ChainingStream
+{
+public:
+    enum class Algorithm : uint16_t
+    {
+        AES256GCM = 1,
+        ChaCha20Poly1305 = 2
+    };
+
+    static constexpr ULONG kDefaultChunkSize = 256 * 1024;
+    static constexpr ULONG kMinChunkSize = 4 * 1024;
+    static constexpr ULONG kMaxChunkSize = 64 * 1024 * 1024;
+    static constexpr ULONG kKeySize = 32;
+    static constexpr ULONG kTagSize = 16;
+    static constexpr ULONG kNonceSize = 12;
+
+    // Appended to the archive name, CMS enveloped archives use '.p7b'
+    static constexpr auto kFileExtension = L".aead";
+
+    AeadStream(Algorithm algorithm, ULONG chunkSize);
+    ~AeadStream();
+
+    STDMETHOD(CanSeek)() { return S_FALSE; };
+
+    STDMETHOD(Read_)
+    (__out_bcount_part(cbBytesToRead, *pcbBytesRead) PVOID pBuffer,
+     __in ULONGLONG cbBytesToRead,
+     __out_opt PULONGLONG pcbBytesRead);
+
+    STDMETHOD(SetFilePointer)
+    (__in LONGLONG DistanceToMove, __in DWORD dwMoveMethod, __out_opt PULONG64 pCurrPointer);
+
+    STDMETHOD_(ULONG64, GetSize)();
+    STDMETHOD(SetSize)(ULONG64 ullSize);
+
+protected:
+#pragma pack(push, 1)
+    struct Header
+    {
+        char Magic[8];
+        uint16_t Version;
+        uint16_t Algorithm;
+        uint32_t ChunkSize;
+        uint16_t RecipientCount;
+    };
+
+    struct RecipientHeader
+    {
+        BYTE Thumbprint[20];
+        uint16_t WrappedKeySize;
+    };
+#pragma pack(pop)
+
+    static constexpr char kMagic[8] = {'O', 'R', 'C', 'A', 'E', 'A', 'D', '\0'};
+    static constexpr uint16_t kVersion = 1;
+
+    // Authenticated header bytes: magic, version, algorithm and chunk size
+    static constexpr ULONG kAuthenticatedHeaderSize = 16;
+
+    Algorithm m_algorithm;
+    ULONG m_chunkSize;
+
+    // Number of chunks processed concurrently, each one with its own key handle
+    size_t m_slots;
+
+    std::shared_ptr<BCryptExtension> m_bcrypt;
+    BCRYPT_ALG_HANDLE m_hAlgorithm = NULL;
+    std::vector<BCRYPT_KEY_HANDLE> m_keys;
+    std::array<BYTE, kAuthenticatedHeaderSize> m_authenticatedHeader;
+
+    ULONGLONG m_chunkIndex = 0LL;
+    ULONGLONG m_ullWritten = 0LL;
+    std::vector<BYTE> m_output;
+
+    bool m_bClosed = false;
+
+    HRESULT OpenKey(const std::array<BYTE, kKeySize>& key);
+
+    // Encrypts (or decrypts) 'count' consecutive chunks from 'pInput' into 'm_output', the last one being 'cbLast'
+    // bytes long (excluding tag), and writes the result to the chained stream
+    HRESULT CryptChunks(bool bEncrypt, const BYTE* pInput, size_t count, ULONG cbLast, bool bFinal);
+
+private:
+    HRESULT CryptChunk(
+        BCRYPT_KEY_HANDLE hKey,
+        bool bEncrypt,
+        ULONGLONG ullIndex,
+        bool bFinal,
+        const BYTE* pInput,
+        ULONG cbInput,
+        BYTE* pOutput,
+        BYTE* pTag);
+};
+
+class AeadEncryptStream : public AeadStream
+{
+public:
+    AeadEncryptStream(Algorithm algorithm = Algorithm::AES256GCM, ULONG chunkSize = kDefaultChunkSize)
+        : AeadStream(algorithm, chunkSize)
+    {
+    }
+
+    void Accept(ByteStreamVisitor& visitor) override { return visitor.Visit(*this); };
+
+    STDMETHOD(CanRead)() { return S_FALSE; };
+
+    // 'certificate' is DER encoded, its RSA public key wraps the content key
+    STDMETHOD(AddRecipient)(const CBinaryBuffer& certificate);
+
+    STDMETHOD(Initialize)(const std::shared_ptr<ByteStream>& pInnerStream);
+
+    STDMETHOD(Write_)
+    (__in_bcount(cbBytes) const PVOID pBuffer, __in ULONGLONG cbBytes, __out PULONGLONG pcbBytesWritten);
+
+    STDMETHOD(Close)();
+
+    ~AeadEncryptStream();
+
+private:
+    std::vector<PCCERT_CONTEXT> m_recipients;
+
+    std::vector<BYTE> m_input;
+    size_t m_cbInput = 0;
+
+    HRESULT WrapKey(PCCERT_CONTEXT pRecipient, const std::array<BYTE, kKeySize>& key, CBinaryBuffer& wrappedKey);
+};
+
+class AeadDecryptStream : public AeadStream
+{
+public:
+    AeadDecryptStream()
+        : AeadStream(Algorithm::AES256GCM, kDefaultChunkSize)
+    {
+    }
+
+    STDMETHOD(CanRead)() { return S_FALSE; };
+
+    // Recipient private keys are looked up by thumbprint in 'hKeyStore' (ex: an imported PFX)
+    STDMETHOD(Initialize)(HCERTSTORE hKeyStore, const std::shared_ptr<ByteStream>& pInnerStream);
+
+    STDMETHOD(Write_)
+    (__in_bcount(cbBytes) const PVOID pBuffer, __in ULONGLONG cbBytes, __out PULONGLONG pcbBytesWritten);
+
+    STDMETHOD(Close)();
+
+    ~AeadDecryptStream();
+
+private:
+    HCERTSTORE m_hKeyStore = NULL;
+    bool m_bKeyed = false;
+
+    std::vector<BYTE> m_input;
+
+    // Returns S_FALSE until the whole header has been written
+    HRESULT ReadHeader(size_t& cbHeader);
+    HRESULT UnwrapKey(const RecipientHeader& recipient, const BYTE* pWrappedKey, std::array<BYTE, kKeySize>& key);
+};
+
+}  // namespace Orc
+
+#pragma managed(pop)
@@ -20,6 +20,7 @@
 #include "Archive/7z/ArchiveOpenCallback.h"
 #include "Archive/7z/ArchiveUpdateCallback.h"
 #include "ByteStream.h"
+#include "Utils/Trace.h"
 
 using namespace Orc::Archive;
 using namespace Orc;
@@ -161,6 +162,8 @@ void Archive7z::Compress(
     const std::shared_ptr<ByteStream>& inputArchive,
     std::error_code& ec)
 {
+    Trace::Span span("archive", "Archive7z::Compress");
+
     if (m_items.empty() && inputArchive == nullptr)
     {
         ec = std::make_error_code(std::errc::invalid_argument);
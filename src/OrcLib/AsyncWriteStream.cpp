@@ -0,0 +1,243 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include "AsyncWriteStream.h"
+
+#include "Log/Log.h"
+
+using namespace Orc;
+
+AsyncWriteStream::AsyncWriteStream(
+    std::shared_ptr<ByteStream> stream,
+    bool bCloseStream,
+    DWORD dwBufferCount,
+    DWORD dwBufferSize)
+    : ByteStream()
+    , m_stream(std::move(stream))
+    , m_bCloseStream(bCloseStream)
+    , m_dwBufferSize(std::max<DWORD>(dwBufferSize, 4096))
+{
+    // One buffer is always owned by the producer
+    dwBufferCount = std::max<DWORD>(dwBufferCount, 2);
+
+    m_current.reserve(m_dwBufferSize);
+    for (DWORD i = 1; i < dwBufferCount; ++i)
+    {
+        m_free.emplace_back();
+        m_free.back().reserve(m_dwBufferSize);
+    }
+
+    m_thread = std::thread([this]() { WriterThread(); });
+}
+
+AsyncWriteStream::~AsyncWriteStream()
+{
+    Close();
+}
+
+void AsyncWriteStream::WriterThread()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    for (;;)
+    {
+        m_cv.wait(lock, [this]() { return m_bStop || !m_pending.empty(); });
+
+        if (m_pending.empty())
+        {
+            // m_bStop is set and everything was written
+            return;
+        }
+
+        auto buffer = std::move(m_pending.front());
+        m_pending.pop_front();
+        m_bWriting = true;
+
+        const bool bFailed = FAILED(m_hrWrite);
+        lock.unlock();
+
+        HRESULT hr = S_OK;
+        if (!bFailed)
+        {
+            ULONGLONG ullWritten = 0LL;
+            try
+            {
+                hr = m_stream->Write(buffer.data(), buffer.size(), &ullWritten);
+                if (SUCCEEDED(hr) && ullWritten != buffer.size())
+                {
+                    hr = HRESULT_FROM_WIN32(ERROR_WRITE_FAULT);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                Log::Error("Exception while writing asynchronous buffer: {}", e.what());
+                hr = E_FAIL;
+            }
+        }
+
+        buffer.clear();
+
+        lock.lock();
+        if (FAILED(hr) && SUCCEEDED(m_hrWrite))
+        {
+            Log::Error(L"Failed to write asynchronous buffer [{}]", SystemError(hr));
+            m_hrWrite = hr;
+        }
+
+        m_free.push_back(std::move(buffer));
+        m_bWriting = false;
+        m_cv.notify_all();
+    }
+}
+
+HRESULT AsyncWriteStream::Submit(std::unique_lock<std::mutex>& lock)
+{
+    if (m_current.empty())
+    {
+        return m_hrWrite;
+    }
+
+    if (m_free.empty())
+    {
+        ++m_ullStalls;
+        m_cv.wait(lock, [this]() { return !m_free.empty(); });
+    }
+
+    auto next = std::move(m_free.front());
+    m_free.pop_front();
+
+    m_pending.push_back(std::move(m_current));
+    m_current = std::move(next);
+    m_cv.notify_all();
+
+    return m_hrWrite;
+}
+
+HRESULT AsyncWriteStream::Read_(
+    __out_bcount_part(cbBytes, *pcbBytesRead) PVOID pReadBuffer,
+    __in ULONGLONG cbBytes,
+    __out_opt PULONGLONG pcbBytesRead)
+{
+    DBG_UNREFERENCED_PARAMETER(pReadBuffer);
+    DBG_UNREFERENCED_PARAMETER(cbBytes);
+
+    if (pcbBytesRead)
+        *pcbBytesRead = 0;
+    return E_NOTIMPL;
+}
+
+HRESULT AsyncWriteStream::Write_(
+    __in_bcount(cbBytesToWrite) const PVOID pWriteBuffer,
+    __in ULONGLONG cbBytesToWrite,
+    __out_opt PULONGLONG pcbBytesWritten)
+{
+    if (pcbBytesWritten)
+        *pcbBytesWritten = 0;
+
+    if (!m_thread.joinable())
+        return E_UNEXPECTED;
+
+    auto pBytes = reinterpret_cast<const BYTE*>(pWriteBuffer);
+    ULONGLONG ullRemaining = cbBytesToWrite;
+
+    while (ullRemaining > 0)
+    {
+        if (m_current.size() == m_dwBufferSize)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (auto hr = Submit(lock); FAILED(hr))
+                return hr;
+        }
+
+        const auto cbChunk =
+            static_cast<size_t>(std::min<ULONGLONG>(ullRemaining, m_dwBufferSize - m_current.size()));
+        m_current.insert(std::end(m_current), pBytes, pBytes + cbChunk);
+
+        pBytes += cbChunk;
+        ullRemaining -= cbChunk;
+    }
+
+    m_ullPosition += cbBytesToWrite;
+    if (pcbBytesWritten)
+        *pcbBytesWritten = cbBytesToWrite;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hrWrite;
+}
+
+HRESULT AsyncWriteStream::SetFilePointer(
+    __in LONGLONG DistanceToMove,
+    __in DWORD dwMoveMethod,
+    __out_opt PULONG64 pCurrPointer)
+{
+    if (DistanceToMove != 0 || dwMoveMethod != FILE_CURRENT)
+        return E_NOTIMPL;
+
+    if (pCurrPointer)
+        *pCurrPointer = m_ullPosition;
+    return S_OK;
+}
+
+ULONG64 AsyncWriteStream::GetSize()
+{
+    if (FAILED(Flush()))
+        return 0LL;
+
+    return m_stream->GetSize();
+}
+
+HRESULT AsyncWriteStream::SetSize(ULONG64 ullSize)
+{
+    if (auto hr = Flush(); FAILED(hr))
+        return hr;
+
+    return m_stream->SetSize(ullSize);
+}
+
+HRESULT AsyncWriteStream::Flush()
+{
+    if (!m_thread.joinable())
+        return S_OK;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (auto hr = Submit(lock); FAILED(hr))
+        return hr;
+
+    m_cv.wait(lock, [this]() { return m_pending.empty() && !m_bWriting; });
+    return m_hrWrite;
+}
+
+HRESULT AsyncWriteStream::Close()
+{
+    if (!m_thread.joinable())
+        return S_OK;
+
+    HRESULT hr = Flush();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_bStop = true;
+    }
+    m_cv.notify_all();
+    m_thread.join();
+
+    if (m_ullStalls)
+    {
+        Log::Debug("AsyncWriteStream: producer waited {} times for a free buffer", m_ullStalls);
+    }
+
+    if (m_stream && m_bCloseStream)
+    {
+        if (auto hrClose = m_stream->Close(); SUCCEEDED(hr))
+            hr = hrClose;
+    }
+
+    return hr;
+}
@@ -0,0 +1,104 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#pragma once
+
+#include "ByteStream.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#pragma managed(push, off)
+
+namespace Orc {
+
+//
+// Write-behind stream: writes are copied into a small ring of large buffers and full buffers are written to the
+// underlying stream by a background thread. Producer only blocks when all the buffers are waiting to be written so
+// memory usage is bounded by 'bufferCount * bufferSize'.
+//
+// Chaining one in front of each stage of a pipeline (ex: compressor -> encryption -> file) lets the stages overlap
+// instead of adding up.
+//
+// Errors from the underlying stream are reported by the next Write, Flush or Close call.
+//
+class AsyncWriteStream : public ByteStream
+{
+public:
+    static constexpr DWORD kDefaultBufferCount = 3;
+    static constexpr DWORD kDefaultBufferSize = 0x100000;
+
+    AsyncWriteStream(
+        std::shared_ptr<ByteStream> stream,
+        bool bCloseStream = true,
+        DWORD dwBufferCount = kDefaultBufferCount,
+        DWORD dwBufferSize = kDefaultBufferSize);
+
+    ~AsyncWriteStream();
+
+    STDMETHOD(IsOpen)() { return m_stream ? m_stream->IsOpen() : S_FALSE; };
+    STDMETHOD(CanRead)() { return S_FALSE; };
+    STDMETHOD(CanWrite)() { return m_stream ? m_stream->CanWrite() : S_FALSE; };
+    STDMETHOD(CanSeek)() { return S_FALSE; };
+
+    STDMETHOD(Read_)
+    (__out_bcount_part(cbBytes, *pcbBytesRead) PVOID pReadBuffer,
+     __in ULONGLONG cbBytes,
+     __out_opt PULONGLONG pcbBytesRead);
+
+    STDMETHOD(Write_)
+    (__in_bcount(cbBytesToWrite) const PVOID pWriteBuffer,
+     __in ULONGLONG cbBytesToWrite,
+     __out_opt PULONGLONG pcbBytesWritten);
+
+    // Only current position query (FILE_CURRENT with a distance of 0) is supported
+    STDMETHOD(SetFilePointer)
+    (__in LONGLONG DistanceToMove, __in DWORD dwMoveMethod, __out_opt PULONG64 pCurrPointer);
+
+    STDMETHOD_(ULONG64, GetSize)();
+    STDMETHOD(SetSize)(ULONG64 ullSize);
+
+    // Hand the current buffer to the writer thread and wait until everything has been written
+    STDMETHOD(Flush)();
+
+    STDMETHOD(Close)();
+
+    const std::shared_ptr<ByteStream>& GetStream() const { return m_stream; }
+
+    // Number of times the producer had to wait for a free buffer
+    ULONGLONG Stalls() const { return m_ullStalls; }
+
+private:
+    HRESULT Submit(std::unique_lock<std::mutex>& lock);
+    void WriterThread();
+
+    std::shared_ptr<ByteStream> m_stream;
+    bool m_bCloseStream;
+    DWORD m_dwBufferSize;
+
+    std::vector<BYTE> m_current;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<std::vector<BYTE>> m_free;
+    std::deque<std::vector<BYTE>> m_pending;
+    bool m_bWriting = false;
+    bool m_bStop = false;
+    HRESULT m_hrWrite = S_OK;
+
+    ULONGLONG m_ullPosition = 0LL;
+    ULONGLONG m_ullStalls = 0LL;
+
+    std::thread m_thread;
+};
+
+}  // namespace Orc
+
+#pragma managed(pop)
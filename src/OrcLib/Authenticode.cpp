@@ -16,6 +16,7 @@
 #include "MemoryStream.h"
 #include "CryptoHashStream.h"
 #include "FileStream.h"
+#include "CatalogIndex.h"
 
 #include "SystemDetails.h"
 
@@ -704,8 +705,13 @@ HRESULT Authenticode::Verify(LPCWSTR szFileName, const std::shared_ptr<ByteStrea
         static const DWORD dwRequestedHashSize = Authenticode::ExpectedHashSize();
         static const auto algorithms = dwRequestedHashSize == BYTES_IN_SHA1_HASH ? CryptoHashStream::Algorithm::SHA1
                                                                                  : CryptoHashStream::Algorithm::SHA256;
+
+        // Catalogs of an index may not use the algorithm of the running system
         PeParser::PeHash hashes;
-        pe.GetAuthenticodeHash(algorithms, hashes, ec);
+        pe.GetAuthenticodeHash(
+            m_catalogIndex ? CryptoHashStream::Algorithm::SHA1 | CryptoHashStream::Algorithm::SHA256 : algorithms,
+            hashes,
+            ec);
         if (ec)
         {
             Log::Debug("Failed to compute pe hashes [{}]", ec);
@@ -723,6 +729,11 @@ HRESULT Authenticode::VerifyAnySignatureWithCatalogs(LPCWSTR szFileName, const P
     data.isSigned = false;
     data.bSignatureVerifies = false;
 
+    if (m_catalogIndex)
+    {
+        return VerifySignatureWithCatalogIndex(hashs, data);
+    }
+
     HCATINFO hCatalog = INVALID_HANDLE_VALUE;
     bool bIsCatalogSigned = false;
 
@@ -792,6 +803,61 @@ HRESULT Authenticode::VerifyAnySignatureWithCatalogs(LPCWSTR szFileName, const P
     return S_OK;
 }
 
+HRESULT Authenticode::VerifySignatureWithCatalogIndex(const PE_Hashs& hashs, AuthenticodeData& data)
+{
+    std::optional<std::wstring_view> catalogPath;
+    for (const CBinaryBuffer* hash : {&hashs.sha256, &hashs.sha1})
+    {
+        if (hash->GetCount())
+        {
+            catalogPath = m_catalogIndex->Find(std::string_view(*hash));
+            if (catalogPath)
+            {
+                break;
+            }
+        }
+    }
+
+    if (!catalogPath)
+    {
+        data.AuthStatus = AUTHENTICODE_NOT_SIGNED;
+        return S_OK;
+    }
+
+    Log::Debug(L"The file is associated with catalog: '{}'", *catalogPath);
+    data.isSigned = true;
+    data.AuthStatus = AUTHENTICODE_SIGNED_NOT_VERIFIED;
+
+    // Signers of a catalog are extracted, and its signature checked, on its first hit: later hits use the cache
+    HRESULT hr = E_FAIL;
+    if (data.AuthenticodeCache() && data.AuthenticodeCache()->Find(*catalogPath))
+    {
+        hr = ExtractCatalogSigners(*catalogPath, std::string_view(), data);
+    }
+    else
+    {
+        fmt::basic_memory_buffer<char, 65536> catalogData;
+        auto rv = ::MapFile(std::wstring(*catalogPath), catalogData);
+        if (rv.has_error())
+        {
+            Log::Error(L"Failed to map catalog '{}' [{}]", *catalogPath, rv.error());
+            return ToHRESULT(rv.error());
+        }
+
+        hr = ExtractCatalogSigners(*catalogPath, std::string_view(catalogData.data(), catalogData.size()), data);
+    }
+
+    if (FAILED(hr))
+    {
+        Log::Debug(L"Failed to verify catalog '{}' [{}]", *catalogPath, SystemError(hr));
+        return S_OK;
+    }
+
+    data.bSignatureVerifies = true;
+    data.AuthStatus = AUTHENTICODE_CATALOG_SIGNED_VERIFIED;
+    return S_OK;
+}
+
 HRESULT Orc::Authenticode::ExtractSignatureSize(const CBinaryBuffer& signature, DWORD& cbSize)
 {
     HRESULT hr = E_FAIL;
@@ -29,6 +29,7 @@ namespace Orc {
 
 class CBinaryBuffer;
 class ByteStream;
+class CatalogIndex;
 
 class AuthenticodeCache
 {
@@ -206,6 +207,10 @@ public:
     std::shared_ptr<AuthenticodeCache>& Cache() { return m_authenticodeCache; }
     void SetCache(std::shared_ptr<AuthenticodeCache> cache) { m_authenticodeCache = std::move(cache); }
 
+    // Catalog signatures are resolved with this index instead of the catalog database of the running system
+    const std::shared_ptr<const CatalogIndex>& GetCatalogIndex() const { return m_catalogIndex; }
+    void SetCatalogIndex(std::shared_ptr<const CatalogIndex> index) { m_catalogIndex = std::move(index); }
+
 private:
     static HRESULT ExtractCatalogSigners(
         std::string_view catalog,
@@ -225,6 +230,8 @@ private:
         HCATINFO& hCatalog,
         AuthenticodeData& data);
 
+    HRESULT VerifySignatureWithCatalogIndex(const PE_Hashs& hashs, AuthenticodeData& data);
+
     HRESULT ExtractSignatureSize(const CBinaryBuffer& signature, DWORD& cbSize);
     HRESULT ExtractSignatureHash(const CBinaryBuffer& signature, AuthenticodeData& data);
     HRESULT ExtractSignatureTimeStamp(const CBinaryBuffer& signature, AuthenticodeData& data);
@@ -247,6 +254,7 @@ private:
     HANDLE m_hContext = INVALID_HANDLE_VALUE;
     WinTrustExtension m_wintrust;
     std::shared_ptr<AuthenticodeCache> m_authenticodeCache;
+    std::shared_ptr<const CatalogIndex> m_catalogIndex;
 };
 
 }  // namespace Orc
@@ -0,0 +1,32 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include "BCryptExtension.h"
+
+STDMETHODIMP_(HRESULT __stdcall) Orc::BCryptExtension::Initialize()
+{
+    ScopedLock sl(m_cs);
+
+    if (m_bInitialized)
+        return S_OK;
+
+    if (IsLoaded())
+    {
+        Get(m_BCryptOpenAlgorithmProvider, "BCryptOpenAlgorithmProvider");
+        Get(m_BCryptCloseAlgorithmProvider, "BCryptCloseAlgorithmProvider");
+        Get(m_BCryptSetProperty, "BCryptSetProperty");
+        Get(m_BCryptGenerateSymmetricKey, "BCryptGenerateSymmetricKey");
+        Get(m_BCryptDestroyKey, "BCryptDestroyKey");
+        Get(m_BCryptEncrypt, "BCryptEncrypt");
+        Get(m_BCryptDecrypt, "BCryptDecrypt");
+
+        m_bInitialized = true;
+    }
+    return S_OK;
+}
@@ -0,0 +1,111 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#pragma once
+
+#include "ExtensionLibrary.h"
+
+#include <bcrypt.h>
+
+#pragma managed(push, off)
+
+namespace Orc {
+
+// CNG primitives are loaded dynamically as bcrypt.dll does not exist before Vista
+class BCryptExtension : public ExtensionLibrary
+{
+public:
+    BCryptExtension()
+        : ExtensionLibrary(L"bcrypt", L"bcrypt.dll", L"bcrypt.dll") {};
+
+    STDMETHOD(Initialize)();
+
+    template <typename... Args>
+    auto BCryptOpenAlgorithmProvider(Args&&... args)
+    {
+        return NtCall(m_BCryptOpenAlgorithmProvider, std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    auto BCryptCloseAlgorithmProvider(Args&&... args)
+    {
+        return NtCall(m_BCryptCloseAlgorithmProvider, std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    auto BCryptSetProperty(Args&&... args)
+    {
+        return NtCall(m_BCryptSetProperty, std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    auto BCryptGenerateSymmetricKey(Args&&... args)
+    {
+        return NtCall(m_BCryptGenerateSymmetricKey, std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    auto BCryptDestroyKey(Args&&... args)
+    {
+        return NtCall(m_BCryptDestroyKey, std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    auto BCryptEncrypt(Args&&... args)
+    {
+        return NtCall(m_BCryptEncrypt, std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    auto BCryptDecrypt(Args&&... args)
+    {
+        return NtCall(m_BCryptDecrypt, std::forward<Args>(args)...);
+    }
+
+private:
+    NTSTATUS(WINAPI* m_BCryptOpenAlgorithmProvider)
+    (_Out_ BCRYPT_ALG_HANDLE* phAlgorithm,
+     _In_ LPCWSTR pszAlgId,
+     _In_opt_ LPCWSTR pszImplementation,
+     _In_ ULONG dwFlags);
+    NTSTATUS(WINAPI* m_BCryptCloseAlgorithmProvider)(_Inout_ BCRYPT_ALG_HANDLE hAlgorithm, _In_ ULONG dwFlags);
+    NTSTATUS(WINAPI* m_BCryptSetProperty)
+    (_Inout_ BCRYPT_HANDLE hObject,
+     _In_ LPCWSTR pszProperty,
+     _In_reads_bytes_(cbInput) PUCHAR pbInput,
+     _In_ ULONG cbInput,
+     _In_ ULONG dwFlags);
+    NTSTATUS(WINAPI* m_BCryptGenerateSymmetricKey)
+    (_Inout_ BCRYPT_ALG_HANDLE hAlgorithm,
+     _Out_ BCRYPT_KEY_HANDLE* phKey,
+     _Out_writes_bytes_all_opt_(cbKeyObject) PUCHAR pbKeyObject,
+     _In_ ULONG cbKeyObject,
+     _In_reads_bytes_(cbSecret) PUCHAR pbSecret,
+     _In_ ULONG cbSecret,
+     _In_ ULONG dwFlags);
+    NTSTATUS(WINAPI* m_BCryptDestroyKey)(_Inout_ BCRYPT_KEY_HANDLE hKey);
+    NTSTATUS(WINAPI* m_BCryptEncrypt)
+    (_Inout_ BCRYPT_KEY_HANDLE hKey,
+     _In_reads_bytes_opt_(cbInput) PUCHAR pbInput,
+     _In_ ULONG cbInput,
+     _In_opt_ VOID* pPaddingInfo,
+     _Inout_updates_bytes_opt_(cbIV) PUCHAR pbIV,
+     _In_ ULONG cbIV,
+     _Out_writes_bytes_to_opt_(cbOutput, *pcbResult) PUCHAR pbOutput,
+     _In_ ULONG cbOutput,
+     _Out_ ULONG* pcbResult,
+     _In_ ULONG dwFlags);
+    NTSTATUS(WINAPI* m_BCryptDecrypt)
+    (_Inout_ BCRYPT_KEY_HANDLE hKey,
+     _In_reads_bytes_opt_(cbInput) PUCHAR pbInput,
+     _In_ ULONG cbInput,
+     _In_opt_ VOID* pPaddingInfo,
+     _Inout_updates_bytes_opt_(cbIV) PUCHAR pbIV,
+     _In_ ULONG cbIV,
+     _Out_writes_bytes_to_opt_(cbOutput, *pcbResult) PUCHAR pbOutput,
+     _In_ ULONG cbOutput,
+     _Out_ ULONG* pcbResult,
+     _In_ ULONG dwFlags);
+};
+
+}  // namespace Orc
+
+#pragma managed(pop)
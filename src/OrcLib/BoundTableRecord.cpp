@@ -14,6 +14,7 @@
 
 #include <safeint.h>
 #include "Filesystem/FileAttribute.h"
+#include "Text/FileTime.h"
 
 using namespace Orc;
 using namespace Orc::TableOutput;
@@ -368,8 +369,8 @@ HRESULT BoundColumn::WriteAttributes(DWORD dwAttributes)
 HRESULT BoundColumn::FileTimeToDBTime(FILETIME& FileTime, Orc::TableOutput::DBTIMESTAMP& DBTime)
 {
     SYSTEMTIME stUTC;
-    if (!FileTimeToSystemTime(&FileTime, &stUTC))
-        return HRESULT_FROM_WIN32(GetLastError());
+    if (!Text::FileTimeEncoder().ToSystemTime(FileTime, stUTC))
+        return HRESULT_FROM_WIN32(ERROR_INVALID_PARAMETER);
 
     DBTime.year = stUTC.wYear;
     DBTime.month = stUTC.wMonth;
@@ -394,38 +395,22 @@ HRESULT BoundColumn::WriteFileTime(FILETIME fileTime)
                 return hr;
             break;
         case ColumnType::UTF16Type: {
-            // Convert the Create time to System time.
             SYSTEMTIME stUTC;
-            FileTimeToSystemTime(&fileTime, &stUTC);
+            if (!Text::FileTimeEncoder().ToSystemTime(fileTime, stUTC))
+                return HRESULT_FROM_WIN32(ERROR_INVALID_PARAMETER);
 
-            if (FAILED(
-                    hr = PrintToBuffer(
-                        L"%u-%02u-%02u %02u:%02u:%02u.%03u%s",
-                        stUTC.wYear,
-                        stUTC.wMonth,
-                        stUTC.wDay,
-                        stUTC.wHour,
-                        stUTC.wMinute,
-                        stUTC.wSecond,
-                        stUTC.wMilliseconds)))
+            WCHAR text[Text::kMaxTimeStampLength];
+            if (FAILED(hr = WriteString(std::wstring_view(text, Text::ToTimeStamp(stUTC, text)))))
                 return hr;
         }
         break;
         case ColumnType::UTF8Type: {
-            // Convert the Create time to System time.
             SYSTEMTIME stUTC;
-            FileTimeToSystemTime(&fileTime, &stUTC);
+            if (!Text::FileTimeEncoder().ToSystemTime(fileTime, stUTC))
+                return HRESULT_FROM_WIN32(ERROR_INVALID_PARAMETER);
 
-            if (FAILED(
-                    hr = PrintToBuffer(
-                        "%u-%02u-%02u %02u:%02u:%02u.%03u%s",
-                        stUTC.wYear,
-                        stUTC.wMonth,
-                        stUTC.wDay,
-                        stUTC.wHour,
-                        stUTC.wMinute,
-                        stUTC.wSecond,
-                        stUTC.wMilliseconds)))
+            CHAR text[Text::kMaxTimeStampLength];
+            if (FAILED(hr = WriteString(std::string_view(text, Text::ToTimeStamp(stUTC, text)))))
                 return hr;
         }
         break;
@@ -451,73 +436,11 @@ HRESULT BoundColumn::WriteFileTime(FILETIME fileTime)
 
 HRESULT BoundColumn::WriteFileTime(LONGLONG fileTime)
 {
-    HRESULT hr = E_FAIL;
-
     LARGE_INTEGER li;
     li.QuadPart = fileTime;
 
     FILETIME ft = {(DWORD)li.u.LowPart, (DWORD)li.u.HighPart};
-
-    switch (Type)
-    {
-        case ColumnType::TimeStampType:
-            if (FAILED(hr = FileTimeToDBTime(ft, boundData.TimeStamp)))
-                return hr;
-            break;
-        case ColumnType::UTF16Type: {
-            // Convert the Create time to System time.
-            SYSTEMTIME stUTC;
-            FileTimeToSystemTime(&ft, &stUTC);
-
-            if (FAILED(
-                    hr = PrintToBuffer(
-                        L"%u-%02u-%02u %02u:%02u:%02u.%03u%s",
-                        stUTC.wYear,
-                        stUTC.wMonth,
-                        stUTC.wDay,
-                        stUTC.wHour,
-                        stUTC.wMinute,
-                        stUTC.wSecond,
-                        stUTC.wMilliseconds)))
-                return hr;
-        }
-        break;
-        case ColumnType::UTF8Type: {
-            // Convert the Create time to System time.
-            SYSTEMTIME stUTC;
-            FileTimeToSystemTime(&ft, &stUTC);
-
-            if (FAILED(
-                    hr = PrintToBuffer(
-                        "%u-%02u-%02u %02u:%02u:%02u.%03u%s",
-                        stUTC.wYear,
-                        stUTC.wMonth,
-                        stUTC.wDay,
-                        stUTC.wHour,
-                        stUTC.wMinute,
-                        stUTC.wSecond,
-                        stUTC.wMilliseconds)))
-                return hr;
-        }
-        break;
-        case ColumnType::FixedBinaryType:
-            if (sizeof(FILETIME) > dwLen)
-                return E_NOT_SUFFICIENT_BUFFER;
-            boundData.Binary->iIndicator = sizeof(FILETIME);
-            *((FILETIME*)boundData.Binary->Data) = ft;
-            break;
-        case ColumnType::BinaryType:
-            if (sizeof(FILETIME) > dwMaxLen)
-                return E_NOT_SUFFICIENT_BUFFER;
-            boundData.Binary->iIndicator = sizeof(FILETIME);
-            *((FILETIME*)boundData.Binary->Data) = ft;
-            break;
-        case ColumnType::Nothing:
-            return S_OK;
-        default:
-            return E_NOTIMPL;
-    }
-    return S_OK;
+    return WriteFileTime(ft);
 }
 
 HRESULT BoundColumn::WriteFileSize(LARGE_INTEGER fileSize)
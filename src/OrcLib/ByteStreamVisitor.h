@@ -23,6 +23,7 @@ class ResourceStream;
 class PipeStream;
 class OnDiskChunkStream;
 class EncodeMessageStream;
+class AeadEncryptStream;
 class JournalingStream;
 class AccumulatingStream;
 class TeeStream;
@@ -42,6 +43,7 @@ public:
     virtual void Visit(PipeStream&) {}
     virtual void Visit(OnDiskChunkStream&) {}
     virtual void Visit(EncodeMessageStream&) {}
+    virtual void Visit(AeadEncryptStream&) {}
     virtual void Visit(JournalingStream&) {}
     virtual void Visit(AccumulatingStream&) {}
     virtual void Visit(TeeStream&) {}
@@ -0,0 +1,266 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include "CatalogIndex.h"
+
+#include "Utils/MapFile.h"
+
+#include "Log/Log.h"
+
+using namespace std::string_view_literals;
+
+using namespace Orc;
+
+namespace {
+
+constexpr uint8_t kDerInteger = 0x02;
+constexpr uint8_t kDerOctetString = 0x04;
+constexpr uint8_t kDerObjectIdentifier = 0x06;
+constexpr uint8_t kDerSequence = 0x30;
+constexpr uint8_t kDerSet = 0x31;
+constexpr uint8_t kDerExplicit0 = 0xA0;
+
+// Encoded content of the object identifiers 1.2.840.113549.1.7.2 (szOID_PKCS_7_SIGNED), 1.3.6.1.4.1.311.10.1
+// (szOID_CTL) and 1.3.6.1.4.1.311.2.1.4 (SPC_INDIRECT_DATA_OBJID)
+constexpr auto kOidPkcs7Signed = "\x2A\x86\x48\x86\xF7\x0D\x01\x07\x02"sv;
+constexpr auto kOidCertificateTrustList = "\x2B\x06\x01\x04\x01\x82\x37\x0A\x01"sv;
+constexpr auto kOidIndirectData = "\x2B\x06\x01\x04\x01\x82\x37\x02\x01\x04"sv;
+
+struct DerElement
+{
+    uint8_t tag = 0;
+    std::string_view content;
+};
+
+// Reads the DER element at the beginning of 'input' and moves 'input' past it
+bool ReadDer(std::string_view& input, DerElement& element)
+{
+    if (input.size() < 2)
+    {
+        return false;
+    }
+
+    element.tag = static_cast<uint8_t>(input[0]);
+    if ((element.tag & 0x1F) == 0x1F)
+    {
+        // High tag numbers are not used by catalogs
+        return false;
+    }
+
+    size_t length = static_cast<uint8_t>(input[1]);
+    size_t offset = 2;
+    if (length & 0x80)
+    {
+        // Indefinite lengths are BER only
+        const size_t count = length & 0x7F;
+        if (count == 0 || count > sizeof(uint32_t) || input.size() < offset + count)
+        {
+            return false;
+        }
+
+        length = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            length = (length << 8) | static_cast<uint8_t>(input[offset + i]);
+        }
+
+        offset += count;
+    }
+
+    if (input.size() - offset < length)
+    {
+        return false;
+    }
+
+    element.content = input.substr(offset, length);
+    input.remove_prefix(offset + length);
+    return true;
+}
+
+bool ReadDer(std::string_view& input, uint8_t tag, std::string_view& content)
+{
+    DerElement element;
+    if (!ReadDer(input, element) || element.tag != tag)
+    {
+        return false;
+    }
+
+    content = element.content;
+    return true;
+}
+
+// ContentInfo { contentType, [0] SignedData { version, digestAlgorithms, encapContentInfo { eContentType, [0] CTL } } }
+bool GetCertificateTrustList(std::string_view catalog, std::string_view& ctl)
+{
+    std::string_view contentInfo, oid, content, signedData, ignored, encapContentInfo;
+
+    if (!ReadDer(catalog, kDerSequence, contentInfo) || !ReadDer(contentInfo, kDerObjectIdentifier, oid)
+        || oid != kOidPkcs7Signed || !ReadDer(contentInfo, kDerExplicit0, content)
+        || !ReadDer(content, kDerSequence, signedData))
+    {
+        return false;
+    }
+
+    if (!ReadDer(signedData, kDerInteger, ignored) || !ReadDer(signedData, kDerSet, ignored)
+        || !ReadDer(signedData, kDerSequence, encapContentInfo))
+    {
+        return false;
+    }
+
+    if (!ReadDer(encapContentInfo, kDerObjectIdentifier, oid) || oid != kOidCertificateTrustList
+        || !ReadDer(encapContentInfo, kDerExplicit0, content) || !ReadDer(content, kDerSequence, ctl))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+// Members are the only sequence of the CTL made of sequences: subject usage and algorithm start with an identifier
+bool GetTrustedSubjects(std::string_view ctl, std::string_view& subjects)
+{
+    DerElement element;
+    while (ReadDer(ctl, element))
+    {
+        if (element.tag != kDerSequence || element.content.empty())
+        {
+            continue;
+        }
+
+        if (static_cast<uint8_t>(element.content[0]) == kDerSequence)
+        {
+            subjects = element.content;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// TrustedSubject { identifier, attributes { { SPC_INDIRECT_DATA_OBJID, { { data, DigestInfo { alg, digest } } } } } }
+std::optional<std::string_view> GetMemberDigest(std::string_view subject)
+{
+    std::string_view identifier, attributes;
+    if (!ReadDer(subject, kDerOctetString, identifier) || !ReadDer(subject, kDerSet, attributes))
+    {
+        return {};
+    }
+
+    std::string_view attribute;
+    while (ReadDer(attributes, kDerSequence, attribute))
+    {
+        std::string_view oid, values, indirectData, ignored, digestInfo, digest;
+        if (!ReadDer(attribute, kDerObjectIdentifier, oid) || oid != kOidIndirectData
+            || !ReadDer(attribute, kDerSet, values))
+        {
+            continue;
+        }
+
+        if (!ReadDer(values, kDerSequence, indirectData) || !ReadDer(indirectData, kDerSequence, ignored)
+            || !ReadDer(indirectData, kDerSequence, digestInfo) || !ReadDer(digestInfo, kDerSequence, ignored)
+            || !ReadDer(digestInfo, kDerOctetString, digest))
+        {
+            return {};
+        }
+
+        return digest;
+    }
+
+    return {};
+}
+
+}  // namespace
+
+namespace Orc {
+
+Result<void> CatalogIndex::Load(const std::filesystem::path& catroot)
+{
+    std::error_code ec;
+    std::filesystem::recursive_directory_iterator it(catroot, ec), end;
+    if (ec)
+    {
+        Log::Error(L"Failed to enumerate catalogs in '{}' [{}]", catroot, ec);
+        return ec;
+    }
+
+    for (; it != end; it.increment(ec))
+    {
+        if (ec)
+        {
+            Log::Debug(L"Failed to enumerate catalogs in '{}' [{}]", catroot, ec);
+            break;
+        }
+
+        if (!it->is_regular_file(ec) || _wcsicmp(it->path().extension().c_str(), L".cat"))
+        {
+            continue;
+        }
+
+        auto catalog = MapFile(it->path());
+        if (catalog.has_error())
+        {
+            Log::Debug(L"Failed to read catalog '{}' [{}]", it->path(), catalog.error());
+            continue;
+        }
+
+        const std::string_view data(reinterpret_cast<const char*>(catalog->data()), catalog->size());
+        auto rv = Add(it->path().wstring(), data);
+        if (rv.has_error())
+        {
+            Log::Debug(L"Failed to parse catalog '{}' [{}]", it->path(), rv.error());
+            continue;
+        }
+    }
+
+    Log::Debug(L"Indexed {} hashes from {} catalogs in '{}'", m_hashes.size(), m_catalogs.size(), catroot);
+    return Success<void>();
+}
+
+Result<void> CatalogIndex::Add(std::wstring catalogPath, std::string_view catalogData)
+{
+    std::string_view ctl, subjects;
+    if (!GetCertificateTrustList(catalogData, ctl))
+    {
+        return std::errc::bad_message;
+    }
+
+    if (!GetTrustedSubjects(ctl, subjects))
+    {
+        // Catalog without any member
+        return Success<void>();
+    }
+
+    const auto catalogIndex = static_cast<uint32_t>(m_catalogs.size());
+    m_catalogs.push_back(std::move(catalogPath));
+
+    std::string_view subject;
+    while (ReadDer(subjects, kDerSequence, subject))
+    {
+        const auto digest = ::GetMemberDigest(subject);
+        if (digest)
+        {
+            m_hashes.insert({std::string(*digest), catalogIndex});
+        }
+    }
+
+    return Success<void>();
+}
+
+std::optional<std::wstring_view> CatalogIndex::Find(std::string_view hash) const
+{
+    const auto it = m_hashes.find(std::string(hash));
+    if (it == std::cend(m_hashes))
+    {
+        return {};
+    }
+
+    return m_catalogs[it->second];
+}
+
+}  // namespace Orc
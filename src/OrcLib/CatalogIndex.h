@@ -0,0 +1,52 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Utils/FlatHashMap.h"
+#include "Utils/Result.h"
+
+#pragma managed(push, off)
+
+namespace Orc {
+
+// Index of the member hashes of the catalogs of a CatRoot directory.
+//
+// Catalogs (PKCS#7 signed certificate trust lists) are parsed once and each member Authenticode hash is mapped to the
+// catalog listing it, so that catalog signatures are resolved with one lookup per file and without the catalog
+// database of the running system (ex: CatRoot of an offline image). Signatures of the catalogs themselves are only
+// checked when a lookup hits them.
+class CatalogIndex
+{
+public:
+    // Parses every '.cat' file under 'catroot', catalogs which cannot be parsed are skipped
+    Result<void> Load(const std::filesystem::path& catroot);
+
+    // Adds the member hashes of the catalog 'catalogData' which is located at 'catalogPath'
+    Result<void> Add(std::wstring catalogPath, std::string_view catalogData);
+
+    // Path of a catalog listing the Authenticode hash 'hash'
+    std::optional<std::wstring_view> Find(std::string_view hash) const;
+
+    size_t CatalogCount() const { return m_catalogs.size(); }
+    size_t HashCount() const { return m_hashes.size(); }
+
+private:
+    std::vector<std::wstring> m_catalogs;
+    FlatHashMap<std::string, uint32_t, std::hash<std::string>> m_hashes;
+};
+
+}  // namespace Orc
+
+#pragma managed(pop)
@@ -590,14 +590,8 @@ std::shared_ptr<CommandExecute> CommandAgent::PrepareCommandExecute(const std::s
 
                     if (EmbeddedResource::IsResourceBased(parameter.Name))
                     {
-                        wstring extracted;
-
-                        if (FAILED(hr = m_Resources.GetResource(parameter.Name, parameter.Keyword, extracted)))
-                        {
-                            Log::Error(L"Failed to extract resource '{}' [{}]", parameter.Name, SystemError(hr));
-                            return;
-                        }
-
+                        // Extraction (and hash) is deferred until the command is about to be launched
+                        retval->SetExecutableResource(parameter.Name, parameter.Keyword);
                         retval->SetOriginResourceName(parameter.Name);
 
                         auto separator = parameter.Name.find(L'|');
@@ -605,11 +599,6 @@ std::shared_ptr<CommandExecute> CommandAgent::PrepareCommandExecute(const std::s
                         {
                             retval->SetOriginFriendlyName(parameter.Name.substr(separator + 1));
                         }
-
-                        if (FAILED(hr = retval->AddExecutableToRun(extracted)))
-                            return;
-
-                        executable = extracted;
                     }
                     else
                     {
@@ -707,6 +696,10 @@ std::shared_ptr<CommandExecute> CommandAgent::PrepareCommandExecute(const std::s
         retval->m_timeout = *message->GetTimeout();
     }
 
+    retval->SetProfile(message->GetProfile());
+    retval->SetPriority(message->GetPriority());
+    retval->SetExpectedDuration(message->GetExpectedDuration());
+
     if (m_bChildDebug)
     {
         Log::Debug(L"CommandAgent: Configured dump file path '{}'", m_TempDir);
@@ -774,6 +767,8 @@ VOID CALLBACK CommandAgent::WaitOrTimerCallbackFunction(__in PVOID lpParameter,
 
     pBlock->command->SetStatus(CommandExecute::Complete);
 
+    CommandScheduler::RecordCompletion(*pBlock->command);
+
     pBlock->pAgent->MoveCompletedCommand(pBlock->command);
     pBlock->command = nullptr;
 
@@ -799,85 +794,148 @@ HRESULT CommandAgent::MoveCompletedCommand(const std::shared_ptr<CommandExecute>
     return S_OK;
 }
 
-HRESULT CommandAgent::ExecuteNextCommand()
+HRESULT CommandAgent::ExtractExecutable(CommandExecute& command)
 {
     HRESULT hr = E_FAIL;
 
-    if (!m_MaximumRunningSemaphore.TryAcquire())
+    const auto& resource = command.GetExecutableResource();
+    if (!resource)
+    {
         return S_OK;
+    }
 
-    std::shared_ptr<CommandExecute> command;
+    const auto& [strRef, strKeyword] = *resource;
 
+    wstring extracted;
+    if (FAILED(hr = m_Resources.GetResource(strRef, strKeyword, extracted)))
     {
-        Concurrency::critical_section::scoped_lock lock(m_cs);
+        Log::Error(L"Failed to extract resource '{}' [{}]", strRef, SystemError(hr));
+        return hr;
+    }
 
-        if (!m_CommandQueue.try_pop(command))
-        {
-            // nothing queued, release the semaphore
-            command = nullptr;
-            m_MaximumRunningSemaphore.Release();
-        }
+    if (FAILED(hr = command.AddExecutableToRun(extracted)))
+    {
+        return hr;
     }
 
-    if (command)
+    auto sha1 = Hash(extracted, CryptoHashStream::Algorithm::SHA1);
+    if (sha1.has_error())
     {
-        hr = command->CreateChildProcess(m_Job, m_bWillRequireBreakAway);
-        if (FAILED(hr))
-        {
-            m_MaximumRunningSemaphore.Release();
-            command->CompleteExecution();
+        Log::Error(L"Failed to compute sha1 for command '{}' [{}]", command.GetKeyword(), sha1.error());
+    }
+    else
+    {
+        command.SetExecutableSha1(*sha1);
+    }
+
+    return S_OK;
+}
+
+HRESULT CommandAgent::ExecuteNextCommand()
+{
+    HRESULT hr = E_FAIL;
+
+    // Start as many commands as the semaphore and the scheduler allow
+    for (;;)
+    {
+        if (!m_MaximumRunningSemaphore.TryAcquire())
             return S_OK;
-        }
+
+        std::shared_ptr<CommandExecute> command;
 
         {
-            Concurrency::critical_section::scoped_lock s(m_cs);
-            m_RunningCommands.push_back(command);
+            Concurrency::critical_section::scoped_lock lock(m_cs);
+            command = m_Scheduler.Pop(m_RunningCommands);
         }
 
-        if (command->GetTimeout().has_value() && command->GetTimeout()->count() != 0)
+        if (command == nullptr)
         {
-            auto timer = std::make_shared<Concurrency::timer<CommandMessage::Message>>(
-                (unsigned int)command->GetTimeout()->count(),
-                CommandMessage::MakeAbortMessage(command->GetKeyword(), command->ProcessID(), command->ProcessHandle()),
-                static_cast<CommandMessage::ITarget*>(&m_cmdAgentBuffer));
-
-            command->SetTimeoutTimer(timer);
-            timer->start();
+            // nothing queued or admissible, release the semaphore
+            m_MaximumRunningSemaphore.Release();
+            return S_OK;
         }
 
-        // Register a callback that will handle process termination (release semaphore, notify, etc...)
-        HANDLE hWaitObject = INVALID_HANDLE_VALUE;
-        CompletionBlock* pBlockPtr = (CompletionBlock*)Concurrency::Alloc(sizeof(CompletionBlock));
-        CompletionBlock* pBlock = new (pBlockPtr) CompletionBlock;
-        pBlock->pAgent = this;
-        pBlock->command = command;
-
-        if (!RegisterWaitForSingleObject(
-                &hWaitObject,
-                command->ProcessHandle(),
-                WaitOrTimerCallbackFunction,
-                pBlock,
-                INFINITE,
-                WT_EXECUTEDEFAULT | WT_EXECUTEONLYONCE))
+        if (FAILED(hr = StartCommand(command)))
         {
-            hr = HRESULT_FROM_WIN32(GetLastError());
-            Log::Error(L"Could not register for process '{}' termination [{}]", command->GetKeyword(), SystemError(hr));
             return hr;
         }
+    }
+}
+
+HRESULT CommandAgent::StartCommand(const std::shared_ptr<CommandExecute>& command)
+{
+    HRESULT hr = E_FAIL;
+
+    const auto startupStart = std::chrono::steady_clock::now();
+
+    hr = ExtractExecutable(*command);
+    if (FAILED(hr))
+    {
+        m_MaximumRunningSemaphore.Release();
+        command->CompleteExecution();
+        return S_OK;
+    }
+
+    hr = command->CreateChildProcess(m_Job, m_bWillRequireBreakAway);
+    if (FAILED(hr))
+    {
+        m_MaximumRunningSemaphore.Release();
+        command->CompleteExecution();
+        return S_OK;
+    }
 
-        auto notification = CommandNotification::NotifyCreated(command->GetKeyword(), command->ProcessID());
+    command->SetStartupTime(
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startupStart));
 
-        notification->SetOriginFriendlyName(command->GetOriginFriendlyName());
-        notification->SetOriginResourceName(command->GetOriginResourceName());
-        notification->SetExecutableSha1(command->GetExecutableSha1());
-        notification->SetOrcTool(command->GetOrcTool());
-        notification->SetIsSelfOrcExecutable(command->IsSelfOrcExecutable());
-        notification->SetProcessHandle(command->ProcessHandle());
-        notification->SetProcessCommandLine(command->m_commandLine);
+    {
+        Concurrency::critical_section::scoped_lock s(m_cs);
+        m_RunningCommands.push_back(command);
+    }
+
+    if (command->GetTimeout().has_value() && command->GetTimeout()->count() != 0)
+    {
+        auto timer = std::make_shared<Concurrency::timer<CommandMessage::Message>>(
+            (unsigned int)command->GetTimeout()->count(),
+            CommandMessage::MakeAbortMessage(command->GetKeyword(), command->ProcessID(), command->ProcessHandle()),
+            static_cast<CommandMessage::ITarget*>(&m_cmdAgentBuffer));
+
+        command->SetTimeoutTimer(timer);
+        timer->start();
+    }
 
-        SendResult(notification);
+    // Register a callback that will handle process termination (release semaphore, notify, etc...)
+    HANDLE hWaitObject = INVALID_HANDLE_VALUE;
+    CompletionBlock* pBlockPtr = (CompletionBlock*)Concurrency::Alloc(sizeof(CompletionBlock));
+    CompletionBlock* pBlock = new (pBlockPtr) CompletionBlock;
+    pBlock->pAgent = this;
+    pBlock->command = command;
+
+    if (!RegisterWaitForSingleObject(
+            &hWaitObject,
+            command->ProcessHandle(),
+            WaitOrTimerCallbackFunction,
+            pBlock,
+            INFINITE,
+            WT_EXECUTEDEFAULT | WT_EXECUTEONLYONCE))
+    {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+        Log::Error(L"Could not register for process '{}' termination [{}]", command->GetKeyword(), SystemError(hr));
+        return hr;
     }
 
+    auto notification = CommandNotification::NotifyCreated(command->GetKeyword(), command->ProcessID());
+
+    notification->SetOriginFriendlyName(command->GetOriginFriendlyName());
+    notification->SetOriginResourceName(command->GetOriginResourceName());
+    notification->SetExecutableSha1(command->GetExecutableSha1());
+    notification->SetStartupTime(command->GetStartupTime());
+    notification->SetOrcTool(command->GetOrcTool());
+    notification->SetIsSelfOrcExecutable(command->IsSelfOrcExecutable());
+    notification->SetProcessHandle(command->ProcessHandle());
+    notification->SetProcessCommandLine(command->m_commandLine);
+
+    SendResult(notification);
+
     return S_OK;
 }
 
@@ -1253,7 +1311,8 @@ void CommandAgent::run()
                 {
                     auto command = PrepareCommandExecute(request);
 
-                    m_CommandQueue.push(command);
+                    Concurrency::critical_section::scoped_lock lock(m_cs);
+                    m_Scheduler.Push(command);
                 }
                 else
                 {
@@ -1346,11 +1405,7 @@ void CommandAgent::run()
                 m_bStopping = true;
                 {
                     Concurrency::critical_section::scoped_lock lock(m_cs);
-
-                    std::shared_ptr<CommandExecute> cmd;
-                    while (m_CommandQueue.try_pop(cmd))
-                    {
-                    }
+                    m_Scheduler.Clear();
                 }
                 if (!TerminateJobObject(m_Job.GetHandle(), (UINT)-1))
                 {
@@ -1365,8 +1420,7 @@ void CommandAgent::run()
                 m_bStopping = true;
                 {
                     Concurrency::critical_section::scoped_lock lock(m_cs);
-                    std::shared_ptr<CommandExecute> cmd;
-                    while (m_CommandQueue.try_pop(cmd))
+                    for (const auto& cmd : m_Scheduler.Clear())
                     {
                         Log::Info(L"Canceling command {}", cmd->GetKeyword());
                     }
@@ -1401,7 +1455,7 @@ void CommandAgent::run()
             Log::Error(L"Failed to execute next command [{}]", SystemError(hr));
         }
 
-        if (m_bStopping && m_RunningCommands.size() == 0 && m_CommandQueue.empty())
+        if (m_bStopping && m_RunningCommands.size() == 0 && m_Scheduler.Empty())
         {
             // delete temporary resources
             m_Resources.DeleteTemporaryResources();
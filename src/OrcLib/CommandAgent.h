@@ -14,6 +14,7 @@
 #include "ArchiveMessage.h"
 
 #include "CommandAgentResources.h"
+#include "CommandScheduler.h"
 #include "JobObject.h"
 
 #include <optional>
@@ -21,8 +22,6 @@
 
 #include <agents.h>
 
-#include <concurrent_queue.h>
-
 #pragma managed(push, off)
 
 auto constexpr DEFAULT_MAX_RUNNING_PROCESSES = 20;
@@ -140,7 +139,7 @@ protected:
 
     Concurrency::critical_section m_cs;
 
-    Concurrency::concurrent_queue<std::shared_ptr<CommandExecute>> m_CommandQueue;
+    CommandScheduler m_Scheduler;
     std::vector<std::shared_ptr<CommandExecute>> m_RunningCommands;
     std::vector<std::shared_ptr<CommandExecute>> m_CompletedCommands;
 
@@ -158,7 +157,9 @@ protected:
     std::shared_ptr<CommandExecute> PrepareCommandExecute(const std::shared_ptr<CommandMessage>& message);
     void StartCommandExecute(const std::shared_ptr<CommandMessage>& message);
 
+    HRESULT ExtractExecutable(CommandExecute& command);
     HRESULT ExecuteNextCommand();
+    HRESULT StartCommand(const std::shared_ptr<CommandExecute>& command);
 
     static DWORD WINAPI JobObjectNotificationRoutine(__in LPVOID lpParameter);
     static VOID CALLBACK WaitOrTimerCallbackFunction(__in PVOID lpParameter, __in BOOLEAN TimerOrWaitFired);
@@ -10,14 +10,129 @@
 #include "CommandAgentResources.h"
 
 #include "EmbeddedResource.h"
+#include "ResourceStream.h"
+#include "CryptoHashStream.h"
+#include "DevNullStream.h"
 
 #include "Temporary.h"
 
 #include "Log/Log.h"
 
+#include <filesystem>
+#include <mutex>
+
 using namespace std;
 using namespace Orc;
 
+namespace {
+
+// Process wide registry of extracted resources, shared by all the command agents (one per command set)
+struct SharedResources
+{
+    std::mutex m_lock;
+
+    // content key -> extracted file
+    std::map<std::wstring, std::wstring, CaseInsensitive> m_extracted;
+
+    // 'mothership|resource' -> sha1 of the embedded resource
+    std::map<std::wstring, std::wstring, CaseInsensitive> m_contentHashes;
+};
+
+SharedResources& GetSharedResources()
+{
+    static SharedResources resources;
+    return resources;
+}
+
+HRESULT HashResource(const std::wstring& strMotherShip, const std::wstring& strResName, std::wstring& strHash)
+{
+    HMODULE hModule = NULL;
+    HRSRC hRes = NULL;
+    std::wstring strBinaryPath;
+
+    HRESULT hr = EmbeddedResource::LocateResource(
+        strMotherShip, strResName, EmbeddedResource::BINARY(), hModule, hRes, strBinaryPath);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    auto resourceStream = std::make_shared<ResourceStream>();
+    if (FAILED(hr = resourceStream->OpenForReadOnly(hModule, hRes)))
+    {
+        return hr;
+    }
+
+    CryptoHashStream hashStream;
+    if (FAILED(hr = hashStream.OpenToRead(CryptoHashStream::Algorithm::SHA1, resourceStream)))
+    {
+        return hr;
+    }
+
+    ULONGLONG ullBytesRead = 0LL;
+    DevNullStream devNull;
+    if (FAILED(hr = hashStream.CopyTo(devNull, &ullBytesRead)))
+    {
+        return hr;
+    }
+
+    return hashStream.GetHash(CryptoHashStream::Algorithm::SHA1, strHash);
+}
+
+// Build the key identifying the content of a resource reference: hash of the embedding resource, name of the file in
+// the archive (if any) and extraction directory. Returns an error when the reference cannot be shared.
+HRESULT GetContentKey(const std::wstring& strRef, const std::wstring& strTempDirectory, std::wstring& strKey)
+{
+    if (EmbeddedResource::IsSelf(strRef))
+    {
+        return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+    }
+
+    std::wstring strMotherShip, strResName, strNameInArchive, strFormatName;
+    HRESULT hr =
+        EmbeddedResource::SplitResourceReference(strRef, strMotherShip, strResName, strNameInArchive, strFormatName);
+    if (FAILED(hr))
+    {
+        return hr;
+    }
+
+    auto& shared = GetSharedResources();
+    const auto strResource = strMotherShip + L"|" + strResName;
+
+    std::wstring strHash;
+    {
+        std::lock_guard<std::mutex> lock(shared.m_lock);
+        auto it = shared.m_contentHashes.find(strResource);
+        if (it != std::end(shared.m_contentHashes))
+        {
+            strHash = it->second;
+        }
+    }
+
+    if (strHash.empty())
+    {
+        if (FAILED(hr = HashResource(strMotherShip, strResName, strHash)))
+        {
+            Log::Debug(L"Failed to hash resource '{}' [{}]", strResource, SystemError(hr));
+            return hr;
+        }
+
+        std::lock_guard<std::mutex> lock(shared.m_lock);
+        shared.m_contentHashes[strResource] = strHash;
+    }
+
+    strKey = strHash + L"|" + strNameInArchive + L"|" + strTempDirectory;
+    return S_OK;
+}
+
+bool IsExtracted(const std::wstring& strPath)
+{
+    std::error_code ec;
+    return !strPath.empty() && std::filesystem::exists(strPath, ec);
+}
+
+}  // namespace
+
 HRESULT CommandAgentResources::ExtractResource(
     const std::wstring& strRef,
     const std::wstring& strKeyword,
@@ -25,8 +140,15 @@ HRESULT CommandAgentResources::ExtractResource(
 {
     HRESULT hr = E_FAIL;
 
-    if (EmbeddedResource::IsResourceBased(strRef))
+    if (!EmbeddedResource::IsResourceBased(strRef))
     {
+        return S_OK;
+    }
+
+    std::wstring strKey;
+    if (FAILED(hr = GetContentKey(strRef, m_strTempDirectory, strKey)))
+    {
+        // Not shareable (ex: self reference), simply extract it
         hr = EmbeddedResource::ExtractToFile(
             strRef, strKeyword, RESSOURCE_READ_EXECUTE_BA, m_strTempDirectory, strExtracted);
         if (FAILED(hr))
@@ -34,7 +156,31 @@ HRESULT CommandAgentResources::ExtractResource(
             Log::Error(L"Failed to extract resource '{}' [{}]", strRef, SystemError(hr));
             return hr;
         }
+        return S_OK;
+    }
+
+    auto& shared = GetSharedResources();
+
+    // Holding the lock during extraction prevents concurrent agents from extracting the same tool twice
+    std::lock_guard<std::mutex> lock(shared.m_lock);
+
+    auto it = shared.m_extracted.find(strKey);
+    if (it != std::end(shared.m_extracted) && IsExtracted(it->second))
+    {
+        Log::Debug(L"Reusing extracted resource '{}' (file: '{}')", strRef, it->second);
+        strExtracted = it->second;
+        return S_OK;
     }
+
+    hr = EmbeddedResource::ExtractToFile(
+        strRef, strKeyword, RESSOURCE_READ_EXECUTE_BA, m_strTempDirectory, strExtracted);
+    if (FAILED(hr))
+    {
+        Log::Error(L"Failed to extract resource '{}' [{}]", strRef, SystemError(hr));
+        return hr;
+    }
+
+    shared.m_extracted[strKey] = strExtracted;
     return S_OK;
 }
 
@@ -45,33 +191,36 @@ HRESULT CommandAgentResources::GetResource(
 {
     HRESULT hr = E_FAIL;
 
+    Concurrency::critical_section::scoped_lock sl(m_cs);
+
     auto it = m_TempResources.find(strRef);
-    if (it == end(m_TempResources))
+    if (it != end(m_TempResources))
     {
-        if (FAILED(hr = ExtractResource(strRef, strKeyword, strExtracted)))
-        {
-            // We failed to extract this resource, save this information as an empty extracted path
-            m_TempResources[strRef] = L"";
-            return hr;
-        }
-        else
+        if (it->second.empty())
+            return HRESULT_FROM_WIN32(ERROR_RESOURCE_NOT_FOUND);
+
+        if (IsExtracted(it->second))
         {
-            m_TempResources[strRef] = strExtracted;
+            strExtracted = it->second;
             return S_OK;
         }
     }
-    else
+
+    if (FAILED(hr = ExtractResource(strRef, strKeyword, strExtracted)))
     {
-        strExtracted = it->second;
-        if (strExtracted.empty())
-            return HRESULT_FROM_WIN32(ERROR_RESOURCE_NOT_FOUND);
-        else
-            return S_OK;
+        // We failed to extract this resource, save this information as an empty extracted path
+        m_TempResources[strRef] = L"";
+        return hr;
     }
+
+    m_TempResources[strRef] = strExtracted;
+    return S_OK;
 }
 
 HRESULT CommandAgentResources::DeleteTemporaryResource(const std::wstring& strRef)
 {
+    Concurrency::critical_section::scoped_lock sl(m_cs);
+
     auto it = m_TempResources.find(strRef);
 
     if (it == end(m_TempResources))
@@ -80,37 +229,40 @@ HRESULT CommandAgentResources::DeleteTemporaryResource(const std::wstring& strRe
         return S_OK;  // Nothing to delete here
     }
 
-    if (!it->second.empty())
-    {
-        Log::Debug(L"No temporary file associated with '{}'", strRef);
-        return S_OK;
-    }
-
-    HRESULT hr = E_FAIL;
-    if (FAILED(hr = UtilDeleteTemporaryFile(it->second.c_str())))
-    {
-        Log::Error(L"Failed to delete temporary resource '{}' (temp: '{}', [{}])", strRef, it->second, SystemError(hr));
-        return hr;
-    }
+    // Extracted files are shared with other agents and deleted by DeleteSharedResources
+    m_TempResources.erase(it);
     return S_OK;
 }
 
 HRESULT CommandAgentResources::DeleteTemporaryResources()
 {
-    std::for_each(
-        begin(m_TempResources), end(m_TempResources), [this](const std::pair<std::wstring, std::wstring>& item) {
-            HRESULT hr = E_FAIL;
-
-            if (FAILED(hr = UtilDeleteTemporaryFile(item.second.c_str())))
-            {
-                Log::Error(
-                    L"Failed to delete temporary resource {} (temp: {}, [{}])",
-                    item.first,
-                    item.second,
-                    SystemError(hr));
-            }
-        });
+    Concurrency::critical_section::scoped_lock sl(m_cs);
+
+    // Extracted files are shared with other agents and deleted by DeleteSharedResources
+    m_TempResources.clear();
+    return S_OK;
+}
+
+HRESULT CommandAgentResources::DeleteSharedResources()
+{
+    auto& shared = GetSharedResources();
+    std::lock_guard<std::mutex> lock(shared.m_lock);
+
+    for (const auto& [key, path] : shared.m_extracted)
+    {
+        if (!IsExtracted(path))
+        {
+            continue;
+        }
+
+        HRESULT hr = E_FAIL;
+        if (FAILED(hr = UtilDeleteTemporaryFile(path.c_str())))
+        {
+            Log::Error(L"Failed to delete temporary resource (temp: {}, [{}])", path, SystemError(hr));
+        }
+    }
 
+    shared.m_extracted.clear();
     return S_OK;
 }
 
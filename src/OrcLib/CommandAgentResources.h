@@ -8,6 +8,7 @@
 #pragma once
 
 #include <map>
+#include <concrt.h>
 #include <boost/logic/tribool.hpp>
 
 #include "OrcLib.h"
@@ -18,11 +19,15 @@
 
 namespace Orc {
 
+// Resources are extracted on demand, when the command using them is about to be launched. Extracted files are shared
+// by all agents of the process and keyed by the hash of their embedded content, so that a tool used by several
+// command sets is only extracted once per run. They are deleted by DeleteSharedResources().
 class CommandAgentResources
 {
 private:
     std::wstring m_strTempDirectory;
     std::map<std::wstring, std::wstring, CaseInsensitive> m_TempResources;
+    Concurrency::critical_section m_cs;
 
     HRESULT ExtractResource(const std::wstring& strRef, const std::wstring& strKeyword, std::wstring& strExtracted);
 
@@ -37,6 +42,7 @@ public:
 
     boost::logic::tribool IsResourceAvailable(const std::wstring& strResourceRef)
     {
+        Concurrency::critical_section::scoped_lock sl(m_cs);
         auto it = m_TempResources.find(strResourceRef);
         if (it != end(m_TempResources))
         {
@@ -55,6 +61,8 @@ public:
     HRESULT DeleteTemporaryResource(const std::wstring& strResourceRef);
     HRESULT DeleteTemporaryResources();
 
+    static HRESULT DeleteSharedResources();
+
     ~CommandAgentResources();
 };
 }  // namespace Orc
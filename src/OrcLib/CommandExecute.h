@@ -17,6 +17,7 @@
 
 #include "ProcessRedirect.h"
 #include "DebugAgent.h"
+#include "CommandScheduler.h"
 
 #pragma managed(push, off)
 
@@ -167,6 +168,16 @@ public:
 
     HRESULT AddExecutableToRun(const std::wstring& szImageFilePath);
 
+    // Embedded executable whose extraction is deferred until the command is about to be launched
+    const std::optional<std::pair<std::wstring, std::wstring>>& GetExecutableResource() const
+    {
+        return m_executableResource;
+    }
+    void SetExecutableResource(const std::wstring& strRef, const std::wstring& strKeyword)
+    {
+        m_executableResource = std::make_pair(strRef, strKeyword);
+    }
+
     HRESULT AddOnCompleteAction(std::shared_ptr<OnComplete>&& action)
     {
         m_OnCompleteActions.push_back(action);
@@ -179,7 +190,7 @@ public:
     HRESULT CreateChildProcess(const JobObject& job, bool bBreakAway = true);
     HRESULT ResumeChildProcess();
 
-    HANDLE ProcessHandle() { return m_pi.hProcess; };
+    HANDLE ProcessHandle() const { return m_pi.hProcess; };
 
     virtual HRESULT WaitCompletion(DWORD dwTimeOut = INFINITE);
     virtual bool HasCompleted();
@@ -209,6 +220,9 @@ public:
     const std::optional<std::wstring>& GetExecutableSha1() const { return m_executableSha1; }
     void SetExecutableSha1(const std::wstring& sha1) { m_executableSha1 = sha1; }
 
+    const std::optional<std::chrono::milliseconds>& GetStartupTime() const { return m_startupTime; }
+    void SetStartupTime(const std::chrono::milliseconds& duration) { m_startupTime = duration; }
+
     bool IsSelfOrcExecutable() const { return m_isSelfOrcExecutable; }
     void SetIsSelfOrcExecutable(bool value) { m_isSelfOrcExecutable = value; }
 
@@ -217,6 +231,18 @@ public:
 
     const std::optional<std::chrono::milliseconds>& GetTimeout() const { return m_timeout; }
 
+    CommandProfile GetProfile() const { return m_profile; }
+    void SetProfile(CommandProfile profile) { m_profile = profile; }
+
+    LONG GetPriority() const { return m_priority; }
+    void SetPriority(LONG priority) { m_priority = priority; }
+
+    const std::optional<std::chrono::milliseconds>& GetExpectedDuration() const { return m_expectedDuration; }
+    void SetExpectedDuration(const std::optional<std::chrono::milliseconds>& duration)
+    {
+        m_expectedDuration = duration;
+    }
+
     void SetTimeoutTimer(std::shared_ptr<void> timer) { m_timeoutTimer = std::move(timer); }
 
     ~CommandExecute(void);
@@ -229,9 +255,14 @@ private:
     PROCESS_INFORMATION m_pi;
     std::optional<std::chrono::milliseconds> m_timeout;
     std::shared_ptr<void> m_timeoutTimer;
+    CommandProfile m_profile = CommandProfile::Undefined;
+    LONG m_priority = 0L;
+    std::optional<std::chrono::milliseconds> m_expectedDuration;
     std::optional<std::wstring> m_originResourceName;
     std::optional<std::wstring> m_originFriendlyName;
     std::optional<std::wstring> m_executableSha1;
+    std::optional<std::pair<std::wstring, std::wstring>> m_executableResource;
+    std::optional<std::chrono::milliseconds> m_startupTime;
     std::optional<std::wstring> m_orcTool;
     bool m_isSelfOrcExecutable;
 
@@ -17,6 +17,7 @@
 #include "BoundedBuffer.h"
 
 #include "BinaryBuffer.h"
+#include "CommandScheduler.h"
 
 #pragma managed(push, off)
 
@@ -200,6 +201,16 @@ public:
     void SetTimeout(std::chrono::milliseconds timeout) { m_timeout = timeout; }
     const std::optional<std::chrono::milliseconds>& GetTimeout() const { return m_timeout; }
 
+    // Scheduling hints, see CommandScheduler
+    void SetProfile(CommandProfile profile) { m_profile = profile; }
+    CommandProfile GetProfile() const { return m_profile; }
+
+    void SetPriority(LONG priority) { m_priority = priority; }
+    LONG GetPriority() const { return m_priority; }
+
+    void SetExpectedDuration(std::chrono::milliseconds duration) { m_expectedDuration = duration; }
+    const std::optional<std::chrono::milliseconds>& GetExpectedDuration() const { return m_expectedDuration; }
+
     const Parameters& GetParameters() { return m_Parameters; };
 
     CmdRequest Request() const { return m_Request; };
@@ -232,6 +243,10 @@ private:
     DWORD m_dwPid;
     HANDLE m_hProcess;
     std::optional<std::chrono::milliseconds> m_timeout;
+
+    CommandProfile m_profile = CommandProfile::Undefined;
+    LONG m_priority = 0L;
+    std::optional<std::chrono::milliseconds> m_expectedDuration;
 };
 
 }  // namespace Orc
@@ -101,6 +101,7 @@ private:
     std::optional<std::wstring> m_originResourceName;
     std::optional<std::wstring> m_originFriendlyName;
     std::optional<std::wstring> m_executableSha1;
+    std::optional<std::chrono::milliseconds> m_startupTime;
     std::optional<std::wstring> m_orcTool;
     bool m_isSelfOrcExecutable;
 
@@ -121,6 +122,9 @@ public:
     std::optional<std::wstring> GetExecutableSha1() const { return m_executableSha1; }
     void SetExecutableSha1(const std::optional<std::wstring>& sha1) { m_executableSha1 = sha1; }
 
+    std::optional<std::chrono::milliseconds> GetStartupTime() const { return m_startupTime; }
+    void SetStartupTime(const std::optional<std::chrono::milliseconds>& duration) { m_startupTime = duration; }
+
     std::optional<std::wstring> GetOrcTool() const { return m_orcTool; }
     void SetOrcTool(const std::optional<std::wstring>& tool) { m_orcTool = tool; }
 
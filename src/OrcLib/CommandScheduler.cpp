@@ -0,0 +1,245 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include "CommandScheduler.h"
+
+#include "CommandExecute.h"
+
+#include "CaseInsensitive.h"
+
+#include "Log/Log.h"
+#include "Utils/Result.h"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+using namespace Orc;
+
+namespace {
+
+// Minimum interval between two samples of the system times
+constexpr auto kCpuSampleInterval = 250ULL;
+
+// Profiles observed during this run, shared by all the command agents
+struct ObservedProfiles
+{
+    std::mutex m_lock;
+    std::map<std::wstring, CommandProfile, CaseInsensitive> m_profiles;
+};
+
+ObservedProfiles& GetObservedProfiles()
+{
+    static ObservedProfiles profiles;
+    return profiles;
+}
+
+ULONGLONG ToULL(const FILETIME& ft)
+{
+    return (static_cast<ULONGLONG>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+}
+
+std::wstring GetExecutableKey(const CommandExecute& command)
+{
+    if (command.IsSelfOrcExecutable() && command.GetOrcTool())
+    {
+        return *command.GetOrcTool();
+    }
+
+    if (command.GetOriginResourceName())
+    {
+        return *command.GetOriginResourceName();
+    }
+
+    if (command.GetOriginFriendlyName())
+    {
+        return *command.GetOriginFriendlyName();
+    }
+
+    return command.GetKeyword();
+}
+
+}  // namespace
+
+std::wstring_view Orc::ToString(CommandProfile profile)
+{
+    switch (profile)
+    {
+        case CommandProfile::Cpu:
+            return L"cpu";
+        case CommandProfile::Io:
+            return L"io";
+        default:
+            return L"undefined";
+    }
+}
+
+CommandProfile Orc::ToCommandProfile(std::wstring_view profile)
+{
+    if (equalCaseInsensitive(profile, L"cpu"))
+        return CommandProfile::Cpu;
+    if (equalCaseInsensitive(profile, L"io"))
+        return CommandProfile::Io;
+    return CommandProfile::Undefined;
+}
+
+void CommandScheduler::Push(const std::shared_ptr<CommandExecute>& command)
+{
+    if (command == nullptr)
+        return;
+
+    m_pending.push_back({command, m_ullSequence++});
+
+    std::stable_sort(std::begin(m_pending), std::end(m_pending), [](const Entry& lhs, const Entry& rhs) {
+        if (lhs.command->GetPriority() != rhs.command->GetPriority())
+            return lhs.command->GetPriority() > rhs.command->GetPriority();
+
+        const auto lhsDuration = lhs.command->GetExpectedDuration().value_or(std::chrono::milliseconds(0));
+        const auto rhsDuration = rhs.command->GetExpectedDuration().value_or(std::chrono::milliseconds(0));
+        if (lhsDuration != rhsDuration)
+            return lhsDuration > rhsDuration;
+
+        return lhs.ullSequence < rhs.ullSequence;
+    });
+}
+
+std::shared_ptr<CommandExecute>
+CommandScheduler::Pop(const std::vector<std::shared_ptr<CommandExecute>>& running)
+{
+    if (m_pending.empty())
+        return nullptr;
+
+    DWORD dwRunning = 0L;
+    DWORD dwRunningIo = 0L;
+    for (const auto& command : running)
+    {
+        if (command == nullptr)
+            continue;
+
+        dwRunning++;
+        if (GetProfile(*command) == CommandProfile::Io)
+            dwRunningIo++;
+    }
+
+    // Always make progress when nothing is running, the completion of a running command triggers the next pop
+    if (dwRunning == 0)
+    {
+        auto command = std::move(m_pending.front().command);
+        m_pending.erase(std::begin(m_pending));
+        return command;
+    }
+
+    const auto dwCpuLoad = GetCpuLoad();
+
+    auto it = std::find_if(std::begin(m_pending), std::end(m_pending), [&](const Entry& entry) {
+        switch (GetProfile(*entry.command))
+        {
+            case CommandProfile::Io:
+                return dwRunningIo < m_dwMaxConcurrentIo;
+            default:
+                return dwCpuLoad < m_dwMaxCpuLoad;
+        }
+    });
+
+    if (it == std::end(m_pending))
+    {
+        Log::Debug(
+            L"CommandScheduler: delaying {} command(s) (cpu: {}%, running: {}, running io: {})",
+            m_pending.size(),
+            dwCpuLoad,
+            dwRunning,
+            dwRunningIo);
+        return nullptr;
+    }
+
+    auto command = std::move(it->command);
+    m_pending.erase(it);
+    return command;
+}
+
+std::vector<std::shared_ptr<CommandExecute>> CommandScheduler::Clear()
+{
+    std::vector<std::shared_ptr<CommandExecute>> commands;
+    commands.reserve(m_pending.size());
+
+    for (auto& entry : m_pending)
+    {
+        commands.push_back(std::move(entry.command));
+    }
+
+    m_pending.clear();
+    return commands;
+}
+
+CommandProfile CommandScheduler::GetProfile(const CommandExecute& command)
+{
+    if (command.GetProfile() != CommandProfile::Undefined)
+        return command.GetProfile();
+
+    auto& observed = GetObservedProfiles();
+    std::lock_guard<std::mutex> lock(observed.m_lock);
+
+    auto it = observed.m_profiles.find(GetExecutableKey(command));
+    if (it == std::end(observed.m_profiles))
+        return CommandProfile::Undefined;
+
+    return it->second;
+}
+
+void CommandScheduler::RecordCompletion(const CommandExecute& command)
+{
+    FILETIME creation, exit, kernel, user;
+    if (!GetProcessTimes(command.ProcessHandle(), &creation, &exit, &kernel, &user))
+    {
+        Log::Debug(
+            L"CommandScheduler: failed to get process times for '{}' [{}]", command.GetKeyword(), LastWin32Error());
+        return;
+    }
+
+    const auto ullElapsed = ToULL(exit) > ToULL(creation) ? ToULL(exit) - ToULL(creation) : 0ULL;
+    if (ullElapsed == 0)
+        return;
+
+    const auto ratio = static_cast<double>(ToULL(kernel) + ToULL(user)) / ullElapsed;
+    const auto profile = ratio >= kCpuBoundRatio ? CommandProfile::Cpu : CommandProfile::Io;
+
+    Log::Debug(
+        L"CommandScheduler: '{}' observed as {} bound (ratio: {:.2f})", command.GetKeyword(), ToString(profile), ratio);
+
+    auto& observed = GetObservedProfiles();
+    std::lock_guard<std::mutex> lock(observed.m_lock);
+    observed.m_profiles[GetExecutableKey(command)] = profile;
+}
+
+DWORD CommandScheduler::GetCpuLoad()
+{
+    const auto ullNow = GetTickCount64();
+    if (m_ullLastSample != 0 && ullNow - m_ullLastSample < kCpuSampleInterval)
+        return m_dwCpuLoad;
+
+    FILETIME idle, kernel, user;
+    if (!GetSystemTimes(&idle, &kernel, &user))
+        return m_dwCpuLoad;
+
+    // Kernel time includes idle time
+    const auto ullIdle = ToULL(idle);
+    const auto ullTotal = ToULL(kernel) + ToULL(user);
+
+    if (m_ullLastSample != 0 && ullTotal > m_ullLastTotal)
+    {
+        const auto ullIdleDelta = ullIdle - m_ullLastIdle;
+        const auto ullTotalDelta = ullTotal - m_ullLastTotal;
+        m_dwCpuLoad = static_cast<DWORD>(100 - std::min<ULONGLONG>(100, (ullIdleDelta * 100) / ullTotalDelta));
+    }
+
+    m_ullLastIdle = ullIdle;
+    m_ullLastTotal = ullTotal;
+    m_ullLastSample = ullNow;
+    return m_dwCpuLoad;
+}
@@ -0,0 +1,95 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#pragma once
+
+#include "OrcLib.h"
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#pragma managed(push, off)
+
+namespace Orc {
+
+class CommandExecute;
+
+// Dominant resource consumed by a command, used to decide whether it can run alongside the running ones
+enum class CommandProfile
+{
+    Undefined = 0,
+    Cpu,
+    Io
+};
+
+std::wstring_view ToString(CommandProfile profile);
+CommandProfile ToCommandProfile(std::wstring_view profile);
+
+// Orders queued commands and admits them depending on the current load of the endpoint.
+//
+// Commands are picked by descending priority, then by descending expected duration (longest first shortens the
+// critical path of the command set), then in queuing order. The agent's semaphore remains the hard limit, the
+// scheduler only delays a command while the CPU is saturated or too many I/O bound commands are already running.
+class CommandScheduler
+{
+public:
+    static constexpr DWORD kDefaultMaxCpuLoad = 85;
+    static constexpr DWORD kDefaultMaxConcurrentIo = 2;
+
+    // Below this ratio of CPU time over elapsed time, a command is considered as I/O bound
+    static constexpr double kCpuBoundRatio = 0.5;
+
+    CommandScheduler(DWORD dwMaxCpuLoad = kDefaultMaxCpuLoad, DWORD dwMaxConcurrentIo = kDefaultMaxConcurrentIo)
+        : m_dwMaxCpuLoad(dwMaxCpuLoad)
+        , m_dwMaxConcurrentIo(dwMaxConcurrentIo)
+    {
+    }
+
+    void Push(const std::shared_ptr<CommandExecute>& command);
+
+    // Returns the next command allowed to start, nullptr if none should start now
+    std::shared_ptr<CommandExecute> Pop(const std::vector<std::shared_ptr<CommandExecute>>& running);
+
+    std::vector<std::shared_ptr<CommandExecute>> Clear();
+
+    bool Empty() const { return m_pending.empty(); }
+    size_t Size() const { return m_pending.size(); }
+
+    // Profile of a command: configured one, or observed from a previous execution of the same executable
+    static CommandProfile GetProfile(const CommandExecute& command);
+
+    // Record the resources consumed by a completed command to classify the next executions of its executable
+    static void RecordCompletion(const CommandExecute& command);
+
+    // Current CPU utilisation of the system, in percent
+    DWORD GetCpuLoad();
+
+private:
+    struct Entry
+    {
+        std::shared_ptr<CommandExecute> command;
+        ULONGLONG ullSequence;
+    };
+
+    DWORD m_dwMaxCpuLoad;
+    DWORD m_dwMaxConcurrentIo;
+
+    std::vector<Entry> m_pending;
+    ULONGLONG m_ullSequence = 0LL;
+
+    ULONGLONG m_ullLastIdle = 0LL;
+    ULONGLONG m_ullLastTotal = 0LL;
+    ULONGLONG m_ullLastSample = 0LL;
+    DWORD m_dwCpuLoad = 0L;
+};
+
+}  // namespace Orc
+
+#pragma managed(pop)
@@ -13,6 +13,7 @@
 #include "Kernel32Extension.h"
 
 #include "Log/Log.h"
+#include "Utils/Trace.h"
 
 using namespace Orc;
 
@@ -88,6 +89,10 @@ CompleteVolumeReader::Read(ULONGLONG offset, CBinaryBuffer& data, ULONGLONG byte
 
     concurrency::critical_section::scoped_lock sl(m_cs);
 
+    // Started once the reader is owned: concurrent readers waiting for it are not counted as I/O time
+    Trace::Span span("io", "VolumeReader::Read");
+    span.SetBytes(bytesToRead);
+
     // Unaligned read
     if (m_BytesPerSector == 0)
     {
@@ -17,6 +17,7 @@
 #include "BinaryBuffer.h"
 #include "DevNullStream.h"
 #include "FileStream.h"
+#include "Utils/Trace.h"
 
 #include <sstream>
 #include <iomanip>
@@ -174,6 +175,9 @@ HRESULT CryptoHashStream::ResetHash(bool bContinue)
 
 HRESULT CryptoHashStream::HashData(LPBYTE pBuffer, DWORD dwBytesToHash)
 {
+    Trace::Span span("hash", "CryptoHashStream::HashData");
+    span.SetBytes(dwBytesToHash);
+
     if (m_bHashIsValid)
     {
         if (m_MD5)
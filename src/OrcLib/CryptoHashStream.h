@@ -49,6 +49,9 @@ public:
     HRESULT GetSHA1(CBinaryBuffer& hash) { return GetHash(Algorithm::SHA1, hash); };
     HRESULT GetMD5(CBinaryBuffer& hash) { return GetHash(Algorithm::MD5, hash); };
 
+    // Hashes bytes which are not written to the chained stream (ex: zero blocks skipped in a sparse output)
+    HRESULT HashWithoutWriting(LPBYTE pBuffer, DWORD dwBytesToHash) { return HashData(pBuffer, dwBytesToHash); };
+
     static Algorithm GetSupportedAlgorithm(std::wstring_view svAlgo);
     static std::wstring GetSupportedAlgorithm(Algorithm algs);
 
@@ -19,6 +19,7 @@
 
 #include "ByteStream.h"
 #include "FileStream.h"
+#include "AsyncWriteStream.h"
 
 #include "OrcException.h"
 
@@ -30,6 +31,8 @@
 #include "Log/Log.h"
 
 #include "Filesystem/FileAttribute.h"
+#include "Text/Utf16ToUtf8.h"
+#include "Utils/Trace.h"
 
 using namespace Orc;
 namespace fs = std::filesystem;
@@ -46,6 +49,91 @@ struct WriterT : public Orc::TableOutput::CSV::Writer
     }
 };
 
+constexpr auto kDefaultTimeStampFormat = L"{YYYY:#04}-{MM:#02}-{DD:#02} {hh:#02}:{mm:#02}:{ss:#02}.{mmm:#03}"sv;
+
+// Match formats like '0x{:016X}' or '{:02x}': a single zero padded hexadecimal field surrounded with literal text
+bool ParseHexFormat(
+    std::wstring_view format,
+    std::wstring_view& prefix,
+    std::wstring_view& suffix,
+    DWORD& dwWidth,
+    bool& bUpperCase)
+{
+    const auto open = format.find(L'{');
+    const auto close = format.find(L'}');
+    if (open == std::wstring_view::npos || close == std::wstring_view::npos || close < open)
+    {
+        return false;
+    }
+
+    prefix = format.substr(0, open);
+    suffix = format.substr(close + 1);
+    if (suffix.find_first_of(L"{}") != std::wstring_view::npos)
+    {
+        return false;
+    }
+
+    auto spec = format.substr(open + 1, close - open - 1);
+    if (spec.size() < 2 || spec.front() != L':')
+    {
+        return false;
+    }
+    spec.remove_prefix(1);
+
+    if (spec.back() == L'X')
+    {
+        bUpperCase = true;
+    }
+    else if (spec.back() == L'x')
+    {
+        bUpperCase = false;
+    }
+    else
+    {
+        return false;
+    }
+    spec.remove_suffix(1);
+
+    dwWidth = 0;
+    if (spec.empty())
+    {
+        return true;
+    }
+
+    if (spec.front() != L'0')
+    {
+        return false;
+    }
+
+    for (const auto c : spec)
+    {
+        if (c < L'0' || c > L'9')
+        {
+            return false;
+        }
+        dwWidth = dwWidth * 10 + (c - L'0');
+    }
+
+    return dwWidth <= 16;
+}
+
+std::string ToUtf8(std::wstring_view value)
+{
+    std::string utf8;
+    if (value.empty())
+    {
+        return utf8;
+    }
+
+    if (auto hr = WideToAnsi(value, utf8); FAILED(hr))
+    {
+        Log::Error(L"Failed to convert CSV format element to utf-8 [{}]", SystemError(hr));
+        return {};
+    }
+
+    return utf8;
+}
+
 }  // namespace
 
 class Orc::TableOutput::CSV::WriterTermination : public TerminationHandler
@@ -73,6 +161,11 @@ HRESULT Orc::TableOutput::CSV::WriterTermination::operator()()
 Orc::TableOutput::CSV::Writer::Writer(std::unique_ptr<Options>&& options)
     : m_Options(std::move(options))
 {
+    if (m_Options)
+    {
+        m_delimiter = ToUtf8(m_Options->Delimiter);
+        m_endOfLine = ToUtf8(m_Options->EndOfLine);
+    }
 }
 
 std::shared_ptr<Orc::TableOutput::CSV::Writer>
@@ -89,45 +182,79 @@ Orc::TableOutput::CSV::Writer::MakeNew(std::unique_ptr<TableOutput::Options>&& o
     return retval;
 }
 
+void Orc::TableOutput::CSV::Writer::CompileColumn(Column& column, bool bFirst) const
+{
+    std::wstring_view format;
+    bool bString = false;
+
+    switch (column.Type)
+    {
+        case ColumnType::UTF16Type:
+        case ColumnType::UTF8Type:
+        case ColumnType::XMLType:
+            format = column.Format ? std::wstring_view(*column.Format) : L"{}"sv;
+            bString = true;
+            break;
+        case ColumnType::BinaryType:
+        case ColumnType::FixedBinaryType:
+            format = column.Format ? std::wstring_view(*column.Format) : L"{:02X}"sv;
+            break;
+        case ColumnType::TimeStampType:
+            format = column.Format ? std::wstring_view(*column.Format) : kDefaultTimeStampFormat;
+            break;
+        default:
+            format = column.Format ? std::wstring_view(*column.Format) : L"{}"sv;
+            break;
+    }
+
+    column.FormatColumn.assign(format);
+    column.Prefix = bFirst ? std::string() : m_delimiter;
+    column.Suffix.clear();
+
+    if (bString)
+    {
+        const auto stringDelimiter = ToUtf8(m_Options->StringDelimiter);
+        column.Prefix.append(stringDelimiter);
+        column.Suffix.append(stringDelimiter);
+        column.bEscapeQuotes = m_Options->StringDelimiter == L"\"";
+    }
+
+    std::wstring_view literalPrefix, literalSuffix;
+
+    if (format == L"{}"sv)
+    {
+        column.Kind = Column::Formatter::Plain;
+    }
+    else if (column.Type == ColumnType::TimeStampType && format == kDefaultTimeStampFormat)
+    {
+        column.Kind = Column::Formatter::TimeStamp;
+    }
+    else if (ParseHexFormat(format, literalPrefix, literalSuffix, column.dwHexWidth, column.bHexUpperCase))
+    {
+        column.Kind = Column::Formatter::Hex;
+        column.Prefix.append(ToUtf8(literalPrefix));
+        column.Suffix.insert(0, ToUtf8(literalSuffix));
+
+        // Values left to fmt (ex: negative ones) are formatted with the field only, literals are already compiled
+        column.FormatColumn.assign(
+            format.substr(literalPrefix.size(), format.size() - literalPrefix.size() - literalSuffix.size()));
+    }
+    else
+    {
+        column.Kind = Column::Formatter::Generic;
+    }
+}
+
 STDMETHODIMP Orc::TableOutput::CSV::Writer::SetSchema(const Schema& schema)
 {
     m_Schema.reserve(schema.size());
 
     bool bFirst = true;
 
-    std::wstring emptyStr;
-
     for (const auto& column : schema)
     {
         auto csv_col = std::make_unique<Column>(*column);
-
-        if (csv_col->Type == ColumnType::UTF16Type || csv_col->Type == ColumnType::UTF8Type
-            || csv_col->Type == ColumnType::XMLType)
-        {
-            csv_col->FormatColumn = fmt::format(
-                L"{}{}{}{}",
-                bFirst ? emptyStr : m_Options->Delimiter,
-                m_Options->StringDelimiter,
-                csv_col->Format.value_or(L"{}"),
-                m_Options->StringDelimiter);
-        }
-        else if (csv_col->Type == ColumnType::BinaryType || csv_col->Type == ColumnType::FixedBinaryType)
-        {
-            csv_col->FormatColumn =
-                fmt::format(L"{}{}", bFirst ? emptyStr : m_Options->Delimiter, csv_col->Format.value_or(L"{:02X}"));
-        }
-        else if (csv_col->Type == ColumnType::TimeStampType)
-        {
-            csv_col->FormatColumn = fmt::format(
-                L"{}{}",
-                bFirst ? emptyStr : m_Options->Delimiter,
-                csv_col->Format.value_or(L"{YYYY:#04}-{MM:#02}-{DD:#02} {hh:#02}:{mm:#02}:{ss:#02}.{mmm:#03}"));
-        }
-        else
-        {
-            csv_col->FormatColumn =
-                fmt::format(L"{}{}", bFirst ? emptyStr : m_Options->Delimiter, csv_col->Format.value_or(L"{}"));
-        }
+        CompileColumn(*csv_col, bFirst);
 
         m_Schema.AddColumn(std::move(csv_col));
         bFirst = false;
@@ -168,8 +295,8 @@ STDMETHODIMP Orc::TableOutput::CSV::Writer::InitializeBuffer(DWORD dwBufferSize)
         dwPagesToAlloc++;
 
     DWORD dwBytesToAlloc = dwPagesToAlloc * PageSize();
-    m_buffer.reserve(dwBytesToAlloc / sizeof(decltype(m_buffer)::value_type));
-    m_bufferUtf8.reserve(dwBytesToAlloc);
+    m_buffer.reserve(dwBytesToAlloc);
+    m_scratch.reserve(ORC_MAX_PATH);
 
     return S_OK;
 }
@@ -184,18 +311,20 @@ STDMETHODIMP Orc::TableOutput::CSV::Writer::WriteBOM()
     if (m_Options->bBOM)
     {
         ULONGLONG bytesWritten;
+        const std::shared_ptr<ByteStream> stream =
+            m_pAsyncStream ? std::static_pointer_cast<ByteStream>(m_pAsyncStream) : m_pByteStream;
 
         switch (m_Options->Encoding)
         {
             case OutputSpec::Encoding::UTF8: {
                 BYTE bom[3] = {0xEF, 0xBB, 0xBF};
-                if (auto hr = m_pByteStream->Write(bom, 3 * sizeof(BYTE), &bytesWritten); FAILED(hr))
+                if (auto hr = stream->Write(bom, 3 * sizeof(BYTE), &bytesWritten); FAILED(hr))
                     return hr;
             }
             break;
             case OutputSpec::Encoding::UTF16: {
                 BYTE bom[2] = {0xFF, 0xFE};
-                if (auto hr = m_pByteStream->Write(bom, 2 * sizeof(BYTE), &bytesWritten); FAILED(hr))
+                if (auto hr = stream->Write(bom, 2 * sizeof(BYTE), &bytesWritten); FAILED(hr))
                     return hr;
             }
             break;
@@ -231,6 +360,12 @@ HRESULT Orc::TableOutput::CSV::Writer::WriteToFile(const WCHAR* szFileName)
 
 STDMETHODIMP Orc::TableOutput::CSV::Writer::WriteToStream(const std::shared_ptr<ByteStream>& pStream, bool bCloseStream)
 {
+    if (m_pAsyncStream != nullptr)
+    {
+        m_pAsyncStream->Close();
+        m_pAsyncStream.reset();
+    }
+
     if (m_pByteStream != nullptr && m_bCloseStream)
     {
         m_pByteStream->Close();
@@ -239,6 +374,13 @@ STDMETHODIMP Orc::TableOutput::CSV::Writer::WriteToStream(const std::shared_ptr<
     m_bCloseStream = bCloseStream;
     m_pByteStream = pStream;
 
+    if (m_pByteStream && m_Options->dwAsyncBufferCount)
+    {
+        // Writer's own buffer is the one being filled, write-behind buffers are only written by the I/O thread
+        m_pAsyncStream = std::make_shared<AsyncWriteStream>(
+            m_pByteStream, false, m_Options->dwAsyncBufferCount + 1, m_Options->dwBufferSize);
+    }
+
     if (auto hr = WriteBOM(); FAILED(hr))
         return hr;
 
@@ -254,6 +396,26 @@ STDMETHODIMP Orc::TableOutput::CSV::Writer::Flush()
 {
     ScopedLock sl(m_cs);
 
+    if (auto hr = FlushBuffer(); FAILED(hr))
+    {
+        return hr;
+    }
+
+    if (m_pAsyncStream)
+    {
+        return m_pAsyncStream->Flush();
+    }
+
+    return S_OK;
+}
+
+HRESULT Orc::TableOutput::CSV::Writer::FlushBuffer()
+{
+    ScopedLock sl(m_cs);
+
+    Trace::Span span("table", "CSV::Writer::FlushBuffer");
+    span.SetBytes(m_buffer.size());
+
     // Always clearing the buffer is the best trade-off. It is a growable buffer, a failure in this function coud
     // trigger a massive memory usage as caller will continue to fill it
     BOOST_SCOPE_EXIT(&m_buffer) { m_buffer.clear(); }
@@ -265,53 +427,62 @@ STDMETHODIMP Orc::TableOutput::CSV::Writer::Flush()
     }
 
     std::string_view writeBuffer;
-    DWORD dwBytesToWrite = 0L;
-
-    // TODO: fix this with a growable buffer
-    // utf8 buffer size must follow utf16 buffer with a margin for conversion
-    const auto kBufferElementCb = sizeof(decltype(m_buffer)::value_type);
-    const auto kExpectedUtf8Cb = (m_buffer.size() + 8192) * kBufferElementCb;
-    if (m_bufferUtf8.capacity() < kExpectedUtf8Cb)
-    {
-        m_bufferUtf8.reserve(kExpectedUtf8Cb);
-    }
 
     switch (m_Options->Encoding)
     {
         case OutputSpec::Encoding::UTF8:
-            dwBytesToWrite = WideCharToMultiByte(
+            writeBuffer = std::string_view(m_buffer.data(), m_buffer.size());
+            break;
+        case OutputSpec::Encoding::UTF16: {
+            if (m_buffer.size() == 0)
+            {
+                return S_OK;
+            }
+
+            // utf16 never needs more code units than utf8 bytes
+            if (m_bufferUtf16.size() < m_buffer.size())
+            {
+                m_bufferUtf16.resize(m_buffer.size());
+            }
+
+            const auto cchWritten = MultiByteToWideChar(
                 CP_UTF8,
                 0L,
-                reinterpret_cast<LPCWCH>(m_buffer.data()),
-                m_buffer.size(),
-                reinterpret_cast<LPSTR>(m_bufferUtf8.data()),
-                m_bufferUtf8.capacity(),
-                NULL,
-                NULL);
-
-            if (!dwBytesToWrite)
+                m_buffer.data(),
+                static_cast<int>(m_buffer.size()),
+                m_bufferUtf16.data(),
+                static_cast<int>(m_bufferUtf16.size()));
+
+            if (!cchWritten)
             {
                 return HRESULT_FROM_WIN32(GetLastError());
             }
 
-            writeBuffer = std::string_view(m_bufferUtf8.data(), dwBytesToWrite);
-            break;
-        case OutputSpec::Encoding::UTF16:
-            writeBuffer = std::string_view(reinterpret_cast<char*>(m_buffer.data()), m_buffer.size() * sizeof(wchar_t));
+            writeBuffer =
+                std::string_view(reinterpret_cast<char*>(m_bufferUtf16.data()), cchWritten * sizeof(WCHAR));
             break;
+        }
         default:
             return E_INVALIDARG;
     }
 
+    if (writeBuffer.empty())
+    {
+        return S_OK;
+    }
+
+    const std::shared_ptr<ByteStream> stream =
+        m_pAsyncStream ? std::static_pointer_cast<ByteStream>(m_pAsyncStream) : m_pByteStream;
+
     ULONGLONG ullBytesWritten;
     // TODO: this const cast is safe but interface requires it
-    auto hr = m_pByteStream->Write(const_cast<char*>(writeBuffer.data()), writeBuffer.size(), &ullBytesWritten);
+    auto hr = stream->Write(const_cast<char*>(writeBuffer.data()), writeBuffer.size(), &ullBytesWritten);
     if (FAILED(hr))
     {
         return hr;
     }
 
-    if (ullBytesWritten < dwBytesToWrite)
+    if (ullBytesWritten < writeBuffer.size())
     {
         return HRESULT_FROM_WIN32(ERROR_WRITE_FAULT);
     }
@@ -329,7 +500,13 @@ STDMETHODIMP Orc::TableOutput::CSV::Writer::Close()
         m_pTermination = nullptr;
     }
 
-    Flush();
+    FlushBuffer();
+
+    if (m_pAsyncStream != nullptr)
+    {
+        m_pAsyncStream->Close();
+        m_pAsyncStream.reset();
+    }
 
     if (m_pByteStream != nullptr && m_bCloseStream)
     {
@@ -360,22 +537,18 @@ STDMETHODIMP Orc::TableOutput::CSV::Writer::WriteHeaders(const TableOutput::Sche
     if (!columns)
         return E_INVALIDARG;
 
-    using namespace std::string_view_literals;
-    auto format_string = fmt::format(L"{}{{}}", m_Options->Delimiter);
-
     for (const auto& column : columns)
     {
         if (bFirst)
         {
-            if (auto hr = FormatToBuffer(L"{}", column->ColumnName); FAILED(hr))
-                AbandonColumn();
             bFirst = false;
         }
         else
         {
-            if (auto hr = FormatToBuffer(format_string, column->ColumnName); FAILED(hr))
-                AbandonColumn();
+            Append(m_delimiter);
         }
+
+        AppendUtf16(column->ColumnName, false);
         m_dwColumnCounter++;
     }
     WriteEndOfLine();
@@ -386,13 +559,104 @@ STDMETHODIMP Orc::TableOutput::CSV::Writer::WriteNothing()
 {
     if (m_dwColumnCounter > 0)  // First column does not need the ",", second column will be prepended with it
     {
-        if (auto hr = FormatToBuffer(m_Options->Delimiter); FAILED(hr))
+        Append(m_delimiter);
+        if (auto hr = CheckFlush(); FAILED(hr))
             return hr;
     }
     AddColumnAndCheckNumbers();
     return S_OK;
 }
 
+void Orc::TableOutput::CSV::Writer::AppendUtf8(std::string_view value, bool bEscapeQuotes)
+{
+    if (!bEscapeQuotes)
+    {
+        Append(value);
+        return;
+    }
+
+    size_t start = 0;
+    for (auto quote = value.find('"'); quote != std::string_view::npos; quote = value.find('"', quote + 1))
+    {
+        Append(value.substr(start, quote + 1 - start));
+        m_buffer.push_back('"');
+        start = quote + 1;
+    }
+    Append(value.substr(start));
+}
+
+void Orc::TableOutput::CSV::Writer::AppendUtf16(std::wstring_view value, bool bEscapeQuotes)
+{
+    // Worst case is 3 bytes per utf16 code unit (and 2 for an escaped quote)
+    const auto offset = m_buffer.size();
+    m_buffer.resize(offset + Text::GetUtf8MaxLength(value.size()));
+    auto out = m_buffer.data() + offset;
+
+    if (bEscapeQuotes)
+    {
+        for (auto quote = value.find(L'"'); quote != std::wstring_view::npos; quote = value.find(L'"'))
+        {
+            out += Text::Utf16ToUtf8(value.substr(0, quote + 1), out);
+            *out++ = '"';
+            value.remove_prefix(quote + 1);
+        }
+    }
+
+    out += Text::Utf16ToUtf8(value, out);
+    m_buffer.resize(out - m_buffer.data());
+}
+
+void Orc::TableOutput::CSV::Writer::AppendUnsigned(ULONGLONG value)
+{
+    char digits[20];
+    auto it = std::end(digits);
+
+    do
+    {
+        *--it = static_cast<char>('0' + (value % 10));
+        value /= 10;
+    } while (value);
+
+    m_buffer.append(it, std::end(digits));
+}
+
+void Orc::TableOutput::CSV::Writer::AppendSigned(LONGLONG value)
+{
+    if (value < 0)
+    {
+        m_buffer.push_back('-');
+        AppendUnsigned(0ULL - static_cast<ULONGLONG>(value));
+        return;
+    }
+
+    AppendUnsigned(static_cast<ULONGLONG>(value));
+}
+
+void Orc::TableOutput::CSV::Writer::AppendHex(ULONGLONG value, DWORD dwWidth, bool bUpperCase)
+{
+    const char* hex = bUpperCase ? "0123456789ABCDEF" : "0123456789abcdef";
+
+    char digits[16];
+    auto it = std::end(digits);
+    DWORD dwCount = 0;
+
+    do
+    {
+        *--it = hex[value & 0xF];
+        value >>= 4;
+        ++dwCount;
+    } while (value || dwCount < dwWidth);
+
+    m_buffer.append(it, std::end(digits));
+}
+
+void Orc::TableOutput::CSV::Writer::AppendTimeStamp(const SYSTEMTIME& st)
+{
+    // Layout of kDefaultTimeStampFormat: 'YYYY-MM-DD hh:mm:ss.mmm'
+    char text[Text::kMaxTimeStampLength];
+    m_buffer.append(text, text + Text::ToTimeStamp(st, text));
+}
+
 HRESULT
 Orc::TableOutput::CSV::Writer::WriteFormated_(std::wstring_view szFormat, fmt::wformat_args args)
 {
@@ -419,20 +683,12 @@ HRESULT Orc::TableOutput::CSV::Writer::WriteFormated_(std::string_view szFormat,
 
     std::string_view result_string((LPCSTR)buffer, buffer.size());
 
-    if (auto [hr, wstr] = AnsiToWide(result_string); SUCCEEDED(hr))
-    {
-        if (auto hr = FormatColumn(wstr); FAILED(hr))
-        {
-            AbandonColumn();
-            return hr;
-        }
-        AddColumnAndCheckNumbers();
-    }
-    else
+    if (auto hr = FormatColumn(result_string); FAILED(hr))
     {
         AbandonColumn();
         return hr;
     }
+    AddColumnAndCheckNumbers();
     return S_OK;
 }
 
@@ -449,9 +705,22 @@ STDMETHODIMP Orc::TableOutput::CSV::Writer::WriteAttributes(DWORD dwFileAttribut
 
 HRESULT Orc::TableOutput::CSV::Writer::WriteFileTime(FILETIME fileTime)
 {
-    // Convert the Create time to System time.
     SYSTEMTIME stUTC;
-    FileTimeToSystemTime(&fileTime, &stUTC);
+    if (!m_fileTimeEncoder.ToSystemTime(fileTime, stUTC))
+    {
+        // Not a valid FILETIME, FileTimeToSystemTime would have failed too
+        return WriteNothing();
+    }
+
+    if (const auto& column = CurrentColumn(); column.Kind == Column::Formatter::TimeStamp)
+    {
+        Append(column.Prefix);
+        AppendTimeStamp(stUTC);
+        Append(column.Suffix);
+
+        AddColumnAndCheckNumbers();
+        return CheckFlush();
+    }
 
     if (auto hr = FormatColumn(
             fmt::arg(L"YYYY", stUTC.wYear),
@@ -490,6 +759,24 @@ STDMETHODIMP Orc::TableOutput::CSV::Writer::WriteTimeStamp(time_t time)
 
 STDMETHODIMP Orc::TableOutput::CSV::Writer::WriteTimeStamp(tm tmStamp)
 {
+    if (const auto& column = CurrentColumn(); column.Kind == Column::Formatter::TimeStamp)
+    {
+        SYSTEMTIME stUTC = {0};
+        stUTC.wYear = static_cast<WORD>(tmStamp.tm_year + 1900);
+        stUTC.wMonth = static_cast<WORD>(tmStamp.tm_mon + 1);
+        stUTC.wDay = static_cast<WORD>(tmStamp.tm_mday);
+        stUTC.wHour = static_cast<WORD>(tmStamp.tm_hour);
+        stUTC.wMinute = static_cast<WORD>(tmStamp.tm_min);
+        stUTC.wSecond = static_cast<WORD>(tmStamp.tm_sec);
+
+        Append(column.Prefix);
+        AppendTimeStamp(stUTC);
+        Append(column.Suffix);
+
+        AddColumnAndCheckNumbers();
+        return CheckFlush();
+    }
+
     if (auto hr = FormatColumn(
             fmt::arg(L"YYYY", tmStamp.tm_year + 1900),
             fmt::arg(L"MM", tmStamp.tm_mon + 1),
@@ -542,7 +829,8 @@ STDMETHODIMP Orc::TableOutput::CSV::Writer::AbandonColumn()
 
 HRESULT Orc::TableOutput::CSV::Writer::WriteEndOfLine()
 {
-    if (auto hr = FormatToBuffer(m_Options->EndOfLine); FAILED(hr))
+    Append(m_endOfLine);
+    if (auto hr = CheckFlush(); FAILED(hr))
         return hr;
 
     auto counter = m_dwColumnCounter;
@@ -858,48 +1146,21 @@ STDMETHODIMP Orc::TableOutput::CSV::Writer::WriteXML(const WCHAR* szString, DWOR
 
 STDMETHODIMP Orc::TableOutput::CSV::Writer::WriteXML(const CHAR* szString)
 {
-    std::string strXML(szString);
-    std::replace(begin(strXML), end(strXML), '\r', ' ');
-    std::replace(begin(strXML), end(strXML), '\n', ' ');
-
-    if (auto [hr, wstr] = AnsiToWide(strXML); SUCCEEDED(hr))
-    {
-        if (auto hr = FormatColumn(wstr); FAILED(hr))
-        {
-            AbandonColumn();
-            return hr;
-        }
-        AddColumnAndCheckNumbers();
-    }
-    else
-    {
-        AbandonColumn();
-        return hr;
-    }
-
-    return S_OK;
+    return WriteXML(szString, static_cast<DWORD>(strlen(szString)));
 }
 
 STDMETHODIMP Orc::TableOutput::CSV::Writer::WriteXML(const CHAR* szString, DWORD dwCharCount)
 {
-    if (auto [hr, wstr] = AnsiToWide(std::string_view(szString, dwCharCount)); SUCCEEDED(hr))
-    {
-        std::replace(begin(wstr), end(wstr), L'\r', L' ');
-        std::replace(begin(wstr), end(wstr), L'\n', L' ');
+    std::string strXML(szString, dwCharCount);
+    std::replace(begin(strXML), end(strXML), '\r', ' ');
+    std::replace(begin(strXML), end(strXML), '\n', ' ');
 
-        if (auto hr = FormatColumn(wstr); FAILED(hr))
-        {
-            AbandonColumn();
-            return hr;
-        }
-        AddColumnAndCheckNumbers();
-    }
-    else
+    if (auto hr = FormatColumn(std::string_view(strXML)); FAILED(hr))
     {
         AbandonColumn();
         return hr;
     }
-
+    AddColumnAndCheckNumbers();
     return S_OK;
 }
 
@@ -910,6 +1171,19 @@ STDMETHODIMP Orc::TableOutput::CSV::Writer::WriteBytes(const BYTE pBytes[], DWOR
         return WriteNothing();
     }
 
+    if (const auto& column = CurrentColumn(); column.Kind == Column::Formatter::Hex)
+    {
+        Append(column.Prefix);
+        for (DWORD i = 0; i < dwLen; ++i)
+        {
+            AppendHex(pBytes[i], column.dwHexWidth, column.bHexUpperCase);
+        }
+        Append(column.Suffix);
+
+        AddColumnAndCheckNumbers();
+        return CheckFlush();
+    }
+
     Buffer<BYTE> buffer;
     buffer.view_of((BYTE*)pBytes, dwLen, dwLen);
 
@@ -15,9 +15,14 @@
 #include "OutputSpec.h"
 #include "WideAnsi.h"
 #include "CriticalSection.h"
+#include "Text/FileTime.h"
 
 #pragma managed(push, off)
 
+namespace Orc {
+class AsyncWriteStream;
+}
+
 namespace Orc::TableOutput::CSV {
 
 class WriterTermination;
@@ -25,10 +30,27 @@ class WriterTermination;
 class Column : public ::Orc::TableOutput::Column
 {
 public:
+    // Formatter selected once in SetSchema: only 'Generic' goes through fmt, others emit UTF-8 digits directly
+    enum class Formatter
+    {
+        Generic,
+        Plain,
+        Hex,
+        TimeStamp
+    };
+
     Column(const ::Orc::TableOutput::Column& base)
         : ::Orc::TableOutput::Column(base) {};
+
     std::wstring FormatColumn;
 
+    Formatter Kind = Formatter::Generic;
+    std::string Prefix;  // UTF-8 column delimiter, string delimiter and format literal text
+    std::string Suffix;
+    DWORD dwHexWidth = 0L;
+    bool bHexUpperCase = true;
+    bool bEscapeQuotes = false;
+
     virtual ~Column() override final {};
 };
 
@@ -45,14 +67,19 @@ public:
         std::swap(m_pTermination, other.m_pTermination);
         wcscpy_s(m_szFileName, other.m_szFileName);
         std::swap(m_buffer, other.m_buffer);
-        std::swap(m_bufferUtf8, other.m_bufferUtf8);
+        std::swap(m_bufferUtf16, other.m_bufferUtf16);
+        std::swap(m_scratch, other.m_scratch);
+        std::swap(m_delimiter, other.m_delimiter);
+        std::swap(m_endOfLine, other.m_endOfLine);
         std::swap(m_Options, other.m_Options);
         std::swap(m_bBOMWritten, other.m_bBOMWritten);
         std::swap(m_pByteStream, other.m_pByteStream);
+        std::swap(m_pAsyncStream, other.m_pAsyncStream);
         std::swap(m_bCloseStream, other.m_bCloseStream);
         std::swap(m_dwColumnCounter, other.m_dwColumnCounter);
         std::swap(m_dwColumnNumber, other.m_dwColumnNumber);
         std::swap(m_dwPageSize, other.m_dwPageSize);
+        std::swap(m_fileTimeEncoder, other.m_fileTimeEncoder);
     }
 
     std::shared_ptr<ByteStream> GetStream() const { return m_pByteStream; };
@@ -85,18 +112,7 @@ public:
 
     STDMETHOD(WriteString)(const std::string& strString) override final
     {
-        if (strString.empty())
-        {
-            return WriteNothing();
-        }
-
-        auto [hr, wstr] = AnsiToWide(strString);
-        if (FAILED(hr))
-        {
-            return hr;
-        }
-
-        return WriteColumn(wstr);
+        return WriteString(std::string_view(strString));
     }
     STDMETHOD(WriteString)(std::string_view strString) override final
     {
@@ -105,13 +121,7 @@ public:
             return WriteNothing();
         }
 
-        auto [hr, wstr] = AnsiToWide(strString);
-        if (FAILED(hr))
-        {
-            return hr;
-        }
-
-        return WriteColumn(wstr);
+        return WriteColumn(strString);
     }
 
     STDMETHOD(WriteString)(const CHAR* szString) override final
@@ -213,16 +223,26 @@ public:
 protected:
     STDMETHOD(WriteHeaders)(const ::Orc::TableOutput::Schema& columns);
 
-    fmt::wmemory_buffer m_buffer;
+    // UTF-8 output buffer, columns are directly encoded into it
+    fmt::memory_buffer m_buffer;
+
+    // Used by 'Generic' formatter and to transcode m_buffer when UTF-16 output is requested
+    fmt::wmemory_buffer m_scratch;
+    std::vector<WCHAR> m_bufferUtf16;
+
+    // Rows often have several timestamps of the same day, the encoder keeps the last converted date
+    Text::FileTimeEncoder m_fileTimeEncoder;
+
+    std::string m_delimiter;
+    std::string m_endOfLine;
 
     std::shared_ptr<WriterTermination> m_pTermination;
 
     WCHAR m_szFileName[ORC_MAX_PATH] = {0};
 
-    std::vector<char> m_bufferUtf8;
-
     bool m_bBOMWritten = false;
     std::shared_ptr<ByteStream> m_pByteStream = nullptr;
+    std::shared_ptr<AsyncWriteStream> m_pAsyncStream;  // Write-behind wrapper of m_pByteStream
     bool m_bCloseStream = true;
     CriticalSection m_cs;
 
@@ -246,74 +266,112 @@ protected:
 
     Writer(std::unique_ptr<Options>&& options);
 
+    void CompileColumn(Column& column, bool bFirst) const;
+
+    // Hand m_buffer to the output stream without waiting for asynchronous writes to complete
+    HRESULT FlushBuffer();
+
+    const Column& CurrentColumn() const { return static_cast<const Column&>(m_Schema[m_dwColumnCounter]); }
+
+    void Append(std::string_view utf8) { m_buffer.append(utf8.data(), utf8.data() + utf8.size()); }
+
     //
     // Workaround: 'Unescaped double quote characters in csv files #13 (github)'
     //
-    // Double all quotes for escaping with CSV format but ignore first and last
-    // ones.
-    //
-    // A more complete approach is possible by specializing fmt::formatter but
-    // it could be less cpu friendly.
+    // Quotes of string values are doubled while being appended, column string delimiters are part of the compiled
+    // prefix and suffix and are never escaped.
     //
-    template <typename T>
-    struct EscapeQuoteInserter
+    void AppendUtf8(std::string_view value, bool bEscapeQuotes);
+    void AppendUtf16(std::wstring_view value, bool bEscapeQuotes);
+
+    void AppendUnsigned(ULONGLONG value);
+    void AppendSigned(LONGLONG value);
+    void AppendHex(ULONGLONG value, DWORD dwWidth, bool bUpperCase);
+    void AppendTimeStamp(const SYSTEMTIME& st);
+
+    template <typename... Args>
+    HRESULT FormatGeneric(const Column& column, Args&&... args)
     {
-        using value_type = typename T::value_type;
+        m_scratch.clear();
 
-        EscapeQuoteInserter(T& wrapped)
-            : m_wrapped(wrapped)
-            , previousWasQuote(false)
-            , quoteCount(0)
+        try
         {
+            fmt::format_to(
+                std::back_inserter(m_scratch), std::wstring_view(column.FormatColumn), std::forward<Args>(args)...);
         }
-
-        void push_back(const wchar_t& u)
+        catch (const fmt::format_error& error)
         {
-            if (previousWasQuote)
-            {
-                quoteCount++;
-
-                if (quoteCount > 1)
-                {
-                    m_wrapped.push_back(L'"');
-                }
-            }
-
-            previousWasQuote = (u == L'"');
-
-            m_wrapped.push_back(u);
+            Log::Error("fmt::format_error: {}", error.what());
+            return E_INVALIDARG;
         }
 
-        T& m_wrapped;
-        bool previousWasQuote;
-        size_t quoteCount;
-    };
+        AppendUtf16(std::wstring_view(m_scratch.data(), m_scratch.size()), column.bEscapeQuotes);
+        return S_OK;
+    }
 
-    template <typename... Args>
-    HRESULT FormatToBuffer(std::wstring_view strFormat, Args&&... args)
+    template <typename T>
+    HRESULT FormatValue(const Column& column, T&& value)
     {
-        try
+        using ValueType = std::remove_cv_t<std::remove_reference_t<T>>;
+
+        if constexpr (std::is_convertible_v<const ValueType&, std::wstring_view>)
         {
-            if (strFormat.find(L"\"{}\"") != std::wstring::npos)
+            if (column.Kind == Column::Formatter::Plain)
             {
-                auto escapedBuffer = EscapeQuoteInserter(m_buffer);
-                fmt::format_to(std::back_inserter(escapedBuffer), strFormat, std::forward<Args>(args)...);
+                AppendUtf16(std::wstring_view(value), column.bEscapeQuotes);
+                return S_OK;
             }
-            else
+        }
+        else if constexpr (std::is_convertible_v<const ValueType&, std::string_view>)
+        {
+            if (column.Kind == Column::Formatter::Plain)
             {
-                fmt::format_to(std::back_inserter(m_buffer), strFormat, std::forward<Args>(args)...);
+                AppendUtf8(std::string_view(value), column.bEscapeQuotes);
+                return S_OK;
             }
         }
-        catch (const fmt::format_error& error)
+        else if constexpr (std::is_same_v<ValueType, wchar_t>)
         {
-            Log::Error("fmt::format_error: {}", error.what());
-            return E_INVALIDARG;
+            if (column.Kind == Column::Formatter::Plain)
+            {
+                AppendUtf16(std::wstring_view(&value, 1), column.bEscapeQuotes);
+                return S_OK;
+            }
         }
+        else if constexpr (std::is_integral_v<ValueType> && !std::is_same_v<ValueType, bool>)
+        {
+            if (column.Kind == Column::Formatter::Plain)
+            {
+                if constexpr (std::is_signed_v<ValueType>)
+                    AppendSigned(value);
+                else
+                    AppendUnsigned(value);
+                return S_OK;
+            }
 
+            if (column.Kind == Column::Formatter::Hex)
+            {
+                // Negative values are left to fmt which prints them with a sign
+                if constexpr (std::is_signed_v<ValueType>)
+                {
+                    if (value < 0)
+                        return FormatGeneric(column, std::forward<T>(value));
+                }
+
+                AppendHex(static_cast<ULONGLONG>(value), column.dwHexWidth, column.bHexUpperCase);
+                return S_OK;
+            }
+        }
+
+        return FormatGeneric(column, std::forward<T>(value));
+    }
+
+    HRESULT CheckFlush()
+    {
         // Flush when buffer is over 80% of its capacity
         if (m_buffer.size() > (80 * m_buffer.capacity() / 100))
         {
-            if (auto hr = Flush(); FAILED(hr))
+            if (auto hr = FlushBuffer(); FAILED(hr))
             {
                 return hr;
             }
@@ -322,22 +380,39 @@ protected:
         return S_OK;
     }
 
+    // Format a complete column: compiled prefix, value and suffix. Buffer is restored on failure.
     template <typename... Args>
     HRESULT FormatColumn(Args&&... args)
     {
+        const auto& column = CurrentColumn();
+        const auto mark = m_buffer.size();
 
-        auto pCol = static_cast<const Column*>(&m_Schema[m_dwColumnCounter]);
+        Append(column.Prefix);
 
-        return FormatToBuffer(pCol->FormatColumn, std::forward<Args>(args)...);
+        HRESULT hr = S_OK;
+        if constexpr (sizeof...(Args) == 1)
+        {
+            hr = FormatValue(column, std::forward<Args>(args)...);
+        }
+        else
+        {
+            hr = FormatGeneric(column, std::forward<Args>(args)...);
+        }
+
+        if (FAILED(hr))
+        {
+            m_buffer.resize(mark);
+            return hr;
+        }
+
+        Append(column.Suffix);
+        return CheckFlush();
     }
 
     template <typename... Args>
     HRESULT WriteColumn(Args&&... args)
     {
-
-        auto pCol = static_cast<const Column*>(&m_Schema[m_dwColumnCounter]);
-
-        if (auto hr = FormatToBuffer(pCol->FormatColumn, std::forward<Args>(args)...); FAILED(hr))
+        if (auto hr = FormatColumn(std::forward<Args>(args)...); FAILED(hr))
         {
             AbandonColumn();
             return hr;
@@ -64,36 +64,35 @@ void FatFileEntry::FillSegmentDetailsMap(ULONGLONG rootDirectoryOffset, ULONG ul
     m_SegmentDetailsMap.clear();
     ULONG ulTotalSize = 0;
 
-    std::for_each(
-        std::begin(m_ClusterChain),
-        std::end(m_ClusterChain),
-        [this, &ulTotalSize, rootDirectoryOffset, ulClusterSize](const FatTableEntry& entry) {
-            ULONG clusterNumber = 0;
-
-            if (m_ulSize > ulTotalSize && (entry.IsUsed() && (clusterNumber = entry.GetValue()) >= 2))
-            {
-                SegmentDetails segmentDetails;
-                ULONGLONG startOffset =
-                    rootDirectoryOffset + ((ULONGLONG)(clusterNumber - 2) * (ULONGLONG)ulClusterSize);
-                ULONGLONG endOffset = 0;
-
-                segmentDetails.mStartOffset = startOffset;
-
-                if (m_ulSize > ulTotalSize + ulClusterSize)
-                {
-                    segmentDetails.mEndOffset = startOffset + ulClusterSize;
-                    segmentDetails.mSize = ulClusterSize;
-                }
-                else
-                {
-                    segmentDetails.mSize = m_ulSize - ulTotalSize;
-                    segmentDetails.mEndOffset = startOffset + (segmentDetails.mSize);
-                }
-
-                m_SegmentDetailsMap.insert(std::pair<ULONGLONG, SegmentDetails>(ulTotalSize, segmentDetails));
-                ulTotalSize += segmentDetails.mSize;
-            }
-        });
+    // one segment per run of contiguous clusters so that streams read them at once
+    FatTable::ClusterRuns clusterRuns;
+    FatTable::GetClusterRuns(m_ClusterChain, clusterRuns);
+
+    for (const auto& run : clusterRuns)
+    {
+        if (m_ulSize <= ulTotalSize)
+            break;
+
+        SegmentDetails segmentDetails;
+        ULONGLONG startOffset = rootDirectoryOffset + ((ULONGLONG)(run.ulFirstCluster - 2) * (ULONGLONG)ulClusterSize);
+        ULONGLONG runSize = (ULONGLONG)run.ulCount * (ULONGLONG)ulClusterSize;
+
+        segmentDetails.mStartOffset = startOffset;
+
+        if (m_ulSize > ulTotalSize + runSize)
+        {
+            segmentDetails.mSize = static_cast<DWORD>(runSize);
+        }
+        else
+        {
+            segmentDetails.mSize = m_ulSize - ulTotalSize;
+        }
+
+        segmentDetails.mEndOffset = startOffset + segmentDetails.mSize;
+
+        m_SegmentDetailsMap.insert(std::pair<ULONGLONG, SegmentDetails>(ulTotalSize, segmentDetails));
+        ulTotalSize += segmentDetails.mSize;
+    }
 }
 
 std::wostream& Orc::operator<<(std::wostream& os, const FatFileEntry& fatFatFileEntry)
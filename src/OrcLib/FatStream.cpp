@@ -72,48 +72,50 @@ HRESULT FatStream::Read_(
 
     const SegmentDetailsMap& map(m_FatFileEntry->m_SegmentDetailsMap);
 
-    if (m_CurrentSegmentDetails == map.end())
-        return S_OK;
-
-    ULONGLONG ullRemainingSegmentSize = m_CurrentSegmentDetails->second.mSize;
+    // segments are runs of contiguous clusters, a read continues on the next ones until the request is satisfied
+    ULONGLONG ullTotalRead = 0LL;
 
-    if (m_CurrentPosition > m_CurrentSegmentDetails->first)
+    while (ullTotalRead < cbBytes && m_CurrentSegmentDetails != map.end())
     {
-        ULONGLONG ulDelta = m_CurrentPosition - m_CurrentSegmentDetails->first;
+        const SegmentDetails& segmentDetails(m_CurrentSegmentDetails->second);
+        ULONGLONG ullDelta = 0LL;
 
-        if (ullRemainingSegmentSize > ulDelta)
-        {
-            ullRemainingSegmentSize -= ulDelta;
-        }
-        else
+        if (m_CurrentPosition > m_CurrentSegmentDetails->first)
         {
-            // should not happen
-            return hr;
+            ullDelta = m_CurrentPosition - m_CurrentSegmentDetails->first;
+
+            if (ullDelta >= segmentDetails.mSize)
+            {
+                // should not happen
+                return ullTotalRead > 0 ? S_OK : hr;
+            }
         }
-    }
 
-    ULONGLONG ullToRead = std::min(cbBytes, ullRemainingSegmentSize);
+        ULONGLONG ullToRead = std::min(cbBytes - ullTotalRead, segmentDetails.mSize - ullDelta);
 
-    CBinaryBuffer buffer((PBYTE)pReadBuffer, static_cast<size_t>(ullToRead));
-    ULONGLONG ullBytesRead = 0LL;
-    ULONGLONG ullOffset = m_CurrentSegmentDetails->second.mStartOffset;
+        CBinaryBuffer buffer((PBYTE)pReadBuffer + ullTotalRead, static_cast<size_t>(ullToRead));
+        ULONGLONG ullBytesRead = 0LL;
 
-    if (m_CurrentPosition > m_CurrentSegmentDetails->first)
-    {
-        ullOffset += m_CurrentPosition - m_CurrentSegmentDetails->first;
-    }
+        if (FAILED(hr = m_pVolReader->Read(segmentDetails.mStartOffset + ullDelta, buffer, ullToRead, ullBytesRead)))
+        {
+            if (ullTotalRead == 0)
+                return hr;
+            break;
+        }
 
-    if (FAILED(hr = m_pVolReader->Read(ullOffset, buffer, ullToRead, ullBytesRead)))
-        return hr;
+        m_CurrentPosition += ullBytesRead;
+        ullTotalRead += ullBytesRead;
 
-    m_CurrentPosition += ullBytesRead;
+        if (m_CurrentPosition >= m_CurrentSegmentDetails->first + segmentDetails.mSize)
+        {
+            m_CurrentSegmentDetails++;
+        }
 
-    if (m_CurrentPosition >= m_CurrentSegmentDetails->first + m_CurrentSegmentDetails->second.mSize)
-    {
-        m_CurrentSegmentDetails++;
+        if (ullBytesRead < ullToRead)
+            break;
     }
 
-    *pullBytesRead = ullBytesRead;
+    *pullBytesRead = ullTotalRead;
 
     return S_OK;
 }
@@ -156,36 +158,11 @@ FatStream::SetFilePointer(__in LONGLONG distanceToMove, __in DWORD dwMoveMethod,
             else
             {
                 // find the right segment
-                if (distanceToMove > 0)
-                {
-                    for (SegmentDetailsMap::const_iterator it = m_CurrentSegmentDetails; it != end; it++)
-                    {
-                        const SegmentDetails& segmentDetails(it->second);
-
-                        if (it->first <= ullNewFilePointer && ullNewFilePointer < it->first + segmentDetails.mSize)
-                        {
-                            m_CurrentPosition = ullNewFilePointer;
-                            m_CurrentSegmentDetails = it;
-                            break;
-                        }
-                    }
-                }
-                else if (distanceToMove < 0)
+                auto it = FindSegment(ullNewFilePointer);
+                if (it != end)
                 {
-                    for (SegmentDetailsMap::const_iterator it = m_CurrentSegmentDetails; it != begin; it--)
-                    {
-                        if (it != end)
-                        {
-                            const SegmentDetails& segmentDetails(it->second);
-
-                            if (it->first <= ullNewFilePointer && ullNewFilePointer < it->first + segmentDetails.mSize)
-                            {
-                                m_CurrentPosition = ullNewFilePointer;
-                                m_CurrentSegmentDetails = it;
-                                break;
-                            }
-                        }
-                    }
+                    m_CurrentPosition = ullNewFilePointer;
+                    m_CurrentSegmentDetails = it;
                 }
             }
 
@@ -199,21 +176,11 @@ FatStream::SetFilePointer(__in LONGLONG distanceToMove, __in DWORD dwMoveMethod,
             }
 
             ullNewFilePointer = GetSize() + distanceToMove;
-            m_CurrentSegmentDetails = end;
+            m_CurrentSegmentDetails = FindSegment(ullNewFilePointer);
 
-            for (SegmentDetailsMap::const_iterator it = m_CurrentSegmentDetails; it != begin; it--)
+            if (m_CurrentSegmentDetails != end)
             {
-                if (it != end)
-                {
-                    const SegmentDetails& segmentDetails(it->second);
-
-                    if (it->first <= ullNewFilePointer && ullNewFilePointer < it->first + segmentDetails.mSize)
-                    {
-                        m_CurrentPosition = ullNewFilePointer;
-                        m_CurrentSegmentDetails = it;
-                        break;
-                    }
-                }
+                m_CurrentPosition = ullNewFilePointer;
             }
 
             break;
@@ -232,16 +199,11 @@ FatStream::SetFilePointer(__in LONGLONG distanceToMove, __in DWORD dwMoveMethod,
             {
                 if (ullNewFilePointer <= GetSize())
                 {
-                    for (SegmentDetailsMap::const_iterator it = begin; it != end; it++)
+                    auto it = FindSegment(ullNewFilePointer);
+                    if (it != end)
                     {
-                        const SegmentDetails& segmentDetails(it->second);
-
-                        if (it->first <= ullNewFilePointer && ullNewFilePointer < it->first + segmentDetails.mSize)
-                        {
-                            m_CurrentPosition = ullNewFilePointer;
-                            m_CurrentSegmentDetails = it;
-                            break;
-                        }
+                        m_CurrentPosition = ullNewFilePointer;
+                        m_CurrentSegmentDetails = it;
                     }
                 }
                 else
@@ -269,6 +231,21 @@ FatStream::SetFilePointer(__in LONGLONG distanceToMove, __in DWORD dwMoveMethod,
     return S_OK;
 }
 
+SegmentDetailsMap::const_iterator FatStream::FindSegment(ULONGLONG ullPosition) const
+{
+    const SegmentDetailsMap& map(m_FatFileEntry->m_SegmentDetailsMap);
+
+    auto it = map.upper_bound(ullPosition);
+    if (it == map.begin())
+        return map.end();
+
+    --it;
+    if (ullPosition >= it->first + it->second.mSize)
+        return map.end();
+
+    return it;
+}
+
 HRESULT FatStream::Close()
 {
     m_CurrentPosition = 0LL;
@@ -46,6 +46,9 @@ public:
     STDMETHOD(Close)();
 
 private:
+    // Segment containing the position, end of the map if none
+    SegmentDetailsMap::const_iterator FindSegment(ULONGLONG ullPosition) const;
+
     const std::shared_ptr<VolumeReader> m_pVolReader;
     const std::shared_ptr<FatFileEntry> m_FatFileEntry;
     ULONGLONG m_CurrentPosition;
@@ -13,6 +13,10 @@
 #include "BinaryBuffer.h"
 
 #include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "Log/Log.h"
 
 #pragma managed(push, off)
 
@@ -52,85 +56,224 @@ public:
             return 32;
     }
 
-    void AddChunk(const std::shared_ptr<CBinaryBuffer>& chunk) { mFatTableChunks.push_back(chunk); }
+    // A run of physically contiguous clusters
+    struct ClusterRun
+    {
+        ULONG ulFirstCluster;
+        ULONG ulCount;
+    };
+
+    using ClusterRuns = std::vector<ClusterRun>;
+
+    void AddChunk(const std::shared_ptr<CBinaryBuffer>& chunk)
+    {
+        mFatTableChunks.push_back(chunk);
+
+        // Offset of each chunk in the table: entries are decoded from the chunks, even those spanning two of them
+        m_ChunkOffsets.push_back(m_ullTableSize);
+        m_ullTableSize += chunk->GetCount();
+        m_RunMap.clear();
+    }
 
     const FatTableChunks& GetFatTableChunks() { return mFatTableChunks; }
 
+    ULONG GetEntryCount() const
+    {
+        return static_cast<ULONG>(std::min<ULONGLONG>(
+            (m_ullTableSize * 8) / GetEntrySizeInBits(), (std::numeric_limits<ULONG>::max)()));
+    }
+
     HRESULT FillClusterChain(ULONG firstClusterNumber, ClusterChain& clusterChain) const
     {
         clusterChain.clear();
+
+        ClusterRuns runs;
+        HRESULT hr = FillClusterRuns(firstClusterNumber, runs);
+
+        for (const auto& run : runs)
+        {
+            for (ULONG i = 0; i < run.ulCount; ++i)
+            {
+                clusterChain.emplace_back(run.ulFirstCluster + i, GetEntrySizeInBits());
+            }
+        }
+
+        return hr;
+    }
+
+    // Same chain as FillClusterChain, as runs of contiguous clusters: one lookup in the run map per fragment
+    HRESULT FillClusterRuns(ULONG firstClusterNumber, ClusterRuns& clusterRuns) const
+    {
+        clusterRuns.clear();
+
+        const auto& runMap = GetRunMap();
+        const ULONG ulEntryCount = GetEntryCount();
+        ULONGLONG ullClusters = 0;
         FatTableEntry entry(firstClusterNumber, GetEntrySizeInBits());
 
         do
         {
-            clusterChain.push_back(entry);
+            const ULONG ulCluster = entry.GetValue();
 
-            if (FAILED(GetEntry(entry.GetValue(), entry)))
-                return E_FAIL;
+            auto it = std::upper_bound(
+                std::cbegin(runMap), std::cend(runMap), ulCluster, [](ULONG cluster, const TableRun& run) {
+                    return cluster < run.ulFirstCluster;
+                });
+
+            if (it == std::cbegin(runMap) || ulCluster - (it - 1)->ulFirstCluster >= (it - 1)->ulCount)
+            {
+                // Not an allocated cluster (free, reserved or out of range), follow its entry as is
+                AddClusterRun(clusterRuns, ulCluster, 1);
+                ullClusters++;
 
+                if (FAILED(GetEntry(ulCluster, entry)))
+                    return E_FAIL;
+            }
+            else
+            {
+                --it;
+                const ULONG ulCount = it->ulFirstCluster + it->ulCount - ulCluster;
+                AddClusterRun(clusterRuns, ulCluster, ulCount);
+                ullClusters += ulCount;
+
+                entry = FatTableEntry(it->ulNext, GetEntrySizeInBits());
+            }
+
+            // A corrupted table could loop
+            if (ullClusters > ulEntryCount)
+            {
+                Log::Debug(L"Cluster chain starting at cluster {} loops", firstClusterNumber);
+                return E_FAIL;
+            }
         } while (entry.IsUsed());
 
         return S_OK;
     }
 
+    // Coalesce the allocated clusters of a chain in runs of contiguous clusters
+    static void GetClusterRuns(const ClusterChain& clusterChain, ClusterRuns& clusterRuns)
+    {
+        clusterRuns.clear();
+
+        for (const auto& entry : clusterChain)
+        {
+            if (entry.IsUsed() && entry.GetValue() >= 2)
+            {
+                AddClusterRun(clusterRuns, entry.GetValue(), 1);
+            }
+        }
+    }
+
     HRESULT GetEntry(ULONG entryNumber, FatTableEntry& entry) const
     {
-        ULONGLONG ulCurrentOffset = 0;
-        ULONGLONG ulTargetOffset = (static_cast<ULONGLONG>(entryNumber) * GetEntrySizeInBits()) / 8;
+        if (entryNumber >= GetEntryCount())
+            return E_FAIL;
 
-        auto chunkIter = std::find_if(
-            mFatTableChunks.begin(),
-            mFatTableChunks.end(),
-            [this, &ulCurrentOffset, ulTargetOffset, &entry](const std::shared_ptr<CBinaryBuffer>& chunk) -> bool {
-                ULONGLONG ulChunkEndOffset = ulCurrentOffset + chunk->GetCount();
+        entry = FatTableEntry(GetEntryValue(entryNumber), GetEntrySizeInBits());
+        return S_OK;
+    }
 
-                if (ulTargetOffset >= ulCurrentOffset && ulTargetOffset < ulChunkEndOffset)
-                {
-                    return true;
-                }
+private:
+    // Maximal run of clusters where each entry points to the next cluster, 'ulNext' is the entry of the last one
+    struct TableRun
+    {
+        ULONG ulFirstCluster;
+        ULONG ulCount;
+        ULONG ulNext;
+    };
 
-                ulCurrentOffset += chunk->GetCount();
-                return false;
-            });
+    using RunMap = std::vector<TableRun>;
 
-        if (chunkIter != mFatTableChunks.end())
+    static void AddClusterRun(ClusterRuns& clusterRuns, ULONG ulCluster, ULONG ulCount)
+    {
+        if (!clusterRuns.empty() && clusterRuns.back().ulFirstCluster + clusterRuns.back().ulCount == ulCluster)
         {
-            ULONGLONG index = ulTargetOffset - ulCurrentOffset;
-            const std::shared_ptr<CBinaryBuffer>& buffer(*chunkIter);
+            clusterRuns.back().ulCount += ulCount;
+            return;
+        }
 
-            if (index >= buffer->GetCount())
-                return E_FAIL;
+        clusterRuns.push_back({ulCluster, ulCount});
+    }
 
-            if (IsFat12Table())
-            {
-                if (entryNumber % 2 == 0)
-                    entry = FatTableEntry(
-                        *(reinterpret_cast<unsigned short*>(buffer->GetData() + index)) & 0x0FFF, GetEntrySizeInBits());
-                else
-                    entry = FatTableEntry(
-                        (*(reinterpret_cast<unsigned short*>(buffer->GetData() + index)) & 0xFFF0) >> 4,
-                        GetEntrySizeInBits());
-            }
-            else if (IsFat16Table())
-            {
-                entry = FatTableEntry(
-                    *(reinterpret_cast<unsigned short*>(buffer->GetData() + index)), GetEntrySizeInBits());
-            }
-            else
-                entry =
-                    FatTableEntry(*(reinterpret_cast<unsigned long*>(buffer->GetData() + index)), GetEntrySizeInBits());
+    // Copies 'count' bytes of the table from 'offset' into 'data', bytes past the end of the table read as 0
+    void ReadTable(ULONGLONG offset, BYTE* data, size_t count) const
+    {
+        auto it = std::upper_bound(std::cbegin(m_ChunkOffsets), std::cend(m_ChunkOffsets), offset);
+        size_t chunkIndex = static_cast<size_t>(std::distance(std::cbegin(m_ChunkOffsets), it)) - 1;
 
-            return S_OK;
+        while (count > 0 && chunkIndex < mFatTableChunks.size())
+        {
+            const auto& chunk = *mFatTableChunks[chunkIndex];
+            const size_t index = static_cast<size_t>(offset - m_ChunkOffsets[chunkIndex]);
+            const size_t toCopy = (std::min)(count, chunk.GetCount() - index);
+
+            std::copy_n(chunk.GetData() + index, toCopy, data);
+            data += toCopy;
+            offset += toCopy;
+            count -= toCopy;
+            chunkIndex++;
         }
-        else
+
+        std::fill_n(data, count, static_cast<BYTE>(0));
+    }
+
+    // Caller must have checked that entryNumber < GetEntryCount()
+    ULONG GetEntryValue(ULONG entryNumber) const
+    {
+        const ULONGLONG offset = (static_cast<ULONGLONG>(entryNumber) * GetEntrySizeInBits()) / 8;
+        BYTE data[4];
+
+        if (IsFat12Table())
         {
-            return E_FAIL;
+            // Last odd entry of an odd sized table has no following byte, it reads as 0
+            ReadTable(offset, data, 2);
+            const USHORT value = data[0] | data[1] << 8;
+            return entryNumber % 2 == 0 ? value & 0x0FFF : (value & 0xFFF0) >> 4;
+        }
+        else if (IsFat16Table())
+        {
+            ReadTable(offset, data, 2);
+            return data[0] | data[1] << 8;
         }
+
+        ReadTable(offset, data, 4);
+        return data[0] | data[1] << 8 | data[2] << 16 | static_cast<ULONG>(data[3]) << 24;
+    }
+
+    // The run map is built on first use, a FatTable must not be shared between threads while it is being filled
+    const RunMap& GetRunMap() const
+    {
+        if (!m_RunMap.empty() || m_ullTableSize == 0)
+            return m_RunMap;
+
+        const ULONG ulEntryCount = GetEntryCount();
+
+        for (ULONG cluster = 2; cluster < ulEntryCount; ++cluster)
+        {
+            const FatTableEntry entry(GetEntryValue(cluster), GetEntrySizeInBits());
+            if (!entry.IsUsed() && !entry.IsEOFEntry())
+                continue;
+
+            if (!m_RunMap.empty() && m_RunMap.back().ulFirstCluster + m_RunMap.back().ulCount == cluster
+                && m_RunMap.back().ulNext == cluster)
+            {
+                m_RunMap.back().ulCount++;
+                m_RunMap.back().ulNext = entry.GetValue();
+                continue;
+            }
+
+            m_RunMap.push_back({cluster, 1, entry.GetValue()});
+        }
+
+        m_RunMap.shrink_to_fit();
+        return m_RunMap;
     }
 
-private:
     FatTableChunks mFatTableChunks;
     FatTableType m_FatTableType;
+    std::vector<ULONGLONG> m_ChunkOffsets;
+    ULONGLONG m_ullTableSize = 0;
+    mutable RunMap m_RunMap;
 };
 
 }  // namespace Orc
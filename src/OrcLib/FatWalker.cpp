@@ -145,11 +145,11 @@ HRESULT FatWalker::Init(const std::shared_ptr<Location>& loc, bool bResurrectRec
     else
     {
         // get root directory clusters and read them
-        FatTable::ClusterChain clusterChain;
-        fatTable.FillClusterChain(rootDirectoryCluster, clusterChain);
+        FatTable::ClusterRuns clusterRuns;
+        fatTable.FillClusterRuns(rootDirectoryCluster, clusterRuns);
 
         // read root directory - it starts at cluster 2. there is actually no cluster 0 and no cluster 1
-        if (S_OK != (hr = ReadClusterChain(clusterChain, m_RootDirectoryBuffer)))
+        if (S_OK != (hr = ReadClusterRuns(clusterRuns, m_RootDirectoryBuffer)))
         {
             Log::Error(
                 L"Failed to read root directory from location {} [{}]", m_Location->GetLocation(), SystemError(hr));
@@ -165,6 +165,9 @@ HRESULT FatWalker::Init(const std::shared_ptr<Location>& loc, bool bResurrectRec
     FatFileEntryList subFolders;
     ParseFolder(fatTable, m_RootDirectoryBuffer, m_RootFolder, subFolders);
 
+    // folder buffer is reused from one subfolder to the next
+    CBinaryBuffer buffer;
+
     while (!subFolders.empty())
     {
         // we put the deleted folder entries at the end of the structure
@@ -198,7 +201,6 @@ HRESULT FatWalker::Init(const std::shared_ptr<Location>& loc, bool bResurrectRec
             continue;
 
         // read subfolder entries
-        CBinaryBuffer buffer;
         if (S_OK != (hr = ReadClusterChain(clusterChain, buffer)))
         {
             Log::Error(L"Failed to read subfolder {} [{}]", subfolder->m_Name, SystemError(hr));
@@ -299,6 +301,14 @@ HRESULT FatWalker::ReadRootDirectory(CBinaryBuffer& buffer, DWORD size)
 }
 
 HRESULT FatWalker::ReadClusterChain(const FatTable::ClusterChain& clusterChain, CBinaryBuffer& buffer)
+{
+    FatTable::ClusterRuns clusterRuns;
+    FatTable::GetClusterRuns(clusterChain, clusterRuns);
+
+    return ReadClusterRuns(clusterRuns, buffer);
+}
+
+HRESULT FatWalker::ReadClusterRuns(const FatTable::ClusterRuns& clusterRuns, CBinaryBuffer& buffer)
 {
     HRESULT hr = E_FAIL;
     std::shared_ptr<VolumeReader> reader(m_Location->GetReader());
@@ -310,49 +320,68 @@ HRESULT FatWalker::ReadClusterChain(const FatTable::ClusterChain& clusterChain,
     }
 
     ULONG ulClusterSize = reader->GetBytesPerCluster();
-    ULONGLONG offset = 0;
+
+    size_t ulClusterCount = 0;
+    for (const auto& run : clusterRuns)
+    {
+        ulClusterCount += run.ulCount;
+    }
 
     size_t buffer_size = 0;
-    if (!msl::utilities::SafeMultiply(clusterChain.size(), ulClusterSize, buffer_size))
+    if (!msl::utilities::SafeMultiply(ulClusterCount, ulClusterSize, buffer_size))
         return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
 
-    buffer.SetCount(buffer_size);
+    if (!buffer.SetCount(buffer_size))
+        return E_OUTOFMEMORY;
+
     buffer.ZeroMe();
 
-    hr = S_OK;
+    // contiguous clusters are read at once, directly in the folder buffer
+    // a run which cannot be read is skipped: the entries of the other runs are still parsed
+    size_t offset = 0;
+    HRESULT hrLastError = S_OK;
+    for (const auto& run : clusterRuns)
+    {
+        const ULONGLONG ullRunSize = static_cast<ULONGLONG>(run.ulCount) * ulClusterSize;
+        ULONGLONG ullSeekOffset =
+            m_ullRootDirectoryOffset + ((ULONGLONG)(run.ulFirstCluster - 2) * (ULONGLONG)ulClusterSize);
+        ULONGLONG ullRunBytesRead = 0;
+        const size_t runOffset = offset;
 
-    std::for_each(
-        std::begin(clusterChain),
-        std::end(clusterChain),
-        [this, &hr, ulClusterSize, &offset, &reader, &buffer](const FatTableEntry& entry) {
-            ULONG clusterNumber = 0;
+        while (ullRunBytesRead < ullRunSize)
+        {
+            const ULONGLONG ullToRead = ullRunSize - ullRunBytesRead;
+            CBinaryBuffer runBuffer(buffer.GetData() + offset, static_cast<size_t>(ullToRead));
+            ULONGLONG ullBytesRead = 0;
 
-            if (entry.IsUsed() && (clusterNumber = entry.GetValue()) >= 2)
+            if (FAILED(hr = reader->Read(ullSeekOffset, runBuffer, ullToRead, ullBytesRead)) || ullBytesRead == 0)
             {
-                CBinaryBuffer localBuffer;
-                localBuffer.SetCount(ulClusterSize);
-                ULONGLONG ullBytesRead;
-                ULONGLONG seekOffset =
-                    m_ullRootDirectoryOffset + ((ULONGLONG)(clusterNumber - 2) * (ULONGLONG)ulClusterSize);
-
-                hr = reader->Read(seekOffset, localBuffer, ulClusterSize, ullBytesRead);
-                if (S_OK == hr && ulClusterSize == ullBytesRead)
-                {
-                    memcpy(buffer.GetData() + offset, localBuffer.GetData(), ulClusterSize);
-                    offset += ulClusterSize;
-                }
-                else
-                {
-                    Log::Error(
-                        L"Failed to read cluster number {} from location {} [{}]",
-                        clusterNumber,
-                        m_Location->GetLocation(),
-                        SystemError(hr));
-                }
+                Log::Error(
+                    L"Failed to read {} cluster(s) from cluster number {} from location {} [{}]",
+                    run.ulCount,
+                    run.ulFirstCluster,
+                    m_Location->GetLocation(),
+                    SystemError(hr));
+                hrLastError = FAILED(hr) ? hr : HRESULT_FROM_WIN32(ERROR_HANDLE_EOF);
+
+                // drop the partially read run, the next one takes its place
+                memset(buffer.GetData() + runOffset, 0, offset - runOffset);
+                offset = runOffset;
+                break;
             }
-        });
 
-    return hr;
+            ullSeekOffset += ullBytesRead;
+            ullRunBytesRead += ullBytesRead;
+            offset += static_cast<size_t>(ullBytesRead);
+        }
+    }
+
+    if (offset == 0 && FAILED(hrLastError))
+    {
+        return hrLastError;
+    }
+
+    return S_OK;
 }
 
 HRESULT FatWalker::ParseFolder(
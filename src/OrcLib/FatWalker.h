@@ -66,6 +66,7 @@ public:
 private:
     HRESULT ReadRootDirectory(CBinaryBuffer& buffer, DWORD size);
     HRESULT ReadClusterChain(const FatTable::ClusterChain& clusterChain, CBinaryBuffer& buffer);
+    HRESULT ReadClusterRuns(const FatTable::ClusterRuns& clusterRuns, CBinaryBuffer& buffer);
 
     HRESULT ParseFolder(
         const FatTable& fatTable,
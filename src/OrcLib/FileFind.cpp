@@ -4391,13 +4391,44 @@ HRESULT FileFind::Find(
 
         bool bStop = false;
 
+        // With an index directory, a valid index restricts the walk to its candidates, otherwise one is built
+        std::filesystem::path indexPath;
+        MFTIndex::VolumeState volumeState;
+        std::unique_ptr<MFTIndex::Builder> indexBuilder;
+        std::optional<std::vector<MFT_SEGMENT_REFERENCE>> indexedRecords;
+
+        if (!m_IndexDirectory.empty()
+            && SUCCEEDED(
+                MFTIndex::GetVolumeState(location, walk.GetMFTRecordCount(), resurrectRecordsMode, volumeState)))
+        {
+            indexPath = m_IndexDirectory / fmt::format(L"MFTIndex_{:016X}.idx", volumeState.VolumeSerialNumber);
+
+            std::unique_ptr<MFTIndex> index;
+            std::vector<MFT_SEGMENT_REFERENCE> records;
+            if (CanUseMFTIndex(bParseI30Data) && SUCCEEDED(MFTIndex::Open(indexPath, index))
+                && index->IsValidFor(volumeState) && GetIndexedRecords(*index, volumeState, records) == S_OK)
+            {
+                Log::Debug(L"Using MFT index '{}': walking {} records", indexPath, records.size());
+                indexedRecords = std::move(records);
+            }
+            else
+            {
+                indexBuilder = std::make_unique<MFTIndex::Builder>();
+            }
+        }
+
         cbs.ElementCallback =
-            [this, aCallback, &bStop, &hr](const std::shared_ptr<VolumeReader>& volreader, MFTRecord* pElt) {
-                DBG_UNREFERENCED_PARAMETER(volreader);
+            [this, aCallback, &bStop, &hr, &indexBuilder](
+                const std::shared_ptr<VolumeReader>& volreader, MFTRecord* pElt) {
                 try
                 {
                     if (pElt)
                     {
+                        if (indexBuilder)
+                        {
+                            indexBuilder->Add(volreader, pElt);
+                        }
+
                         if (FAILED(hr = FindMatch(pElt, bStop, aCallback)))
                         {
                             Log::Error(L"FindMatch failed");
@@ -4450,7 +4481,8 @@ HRESULT FileFind::Find(
             };
         }
 
-        if (FAILED(hr = walk.Walk(cbs)) && hr != HRESULT_FROM_WIN32(ERROR_NO_MORE_FILES))
+        hr = indexedRecords ? walk.Walk(cbs, *indexedRecords) : walk.Walk(cbs);
+        if (FAILED(hr) && hr != HRESULT_FROM_WIN32(ERROR_NO_MORE_FILES))
         {
             Log::Debug(L"Failed to walk volume '{}' [{}]", location->GetLocation(), SystemError(hr));
         }
@@ -4458,12 +4490,137 @@ HRESULT FileFind::Find(
         {
             Log::Debug("Done");
             walk.Statistics(L"Done");
+
+            // A stopped walk did not see every record
+            if (indexBuilder && SUCCEEDED(hr) && !bStop)
+            {
+                std::error_code ec;
+                std::filesystem::create_directories(m_IndexDirectory, ec);
+
+                if (auto hrIndex = indexBuilder->Write(indexPath, volumeState); FAILED(hrIndex))
+                {
+                    Log::Warn(L"Failed to write MFT index of '{}' [{}]", location->GetLocation(), SystemError(hrIndex));
+                }
+            }
         }
     }
 
     return hr;
 }
 
+bool FileFind::CanUseMFTIndex(bool bParseI30Data) const
+{
+    // Generic terms may need any attribute, $I30 terms need the directory indexes
+    if (!m_Terms.empty())
+    {
+        return false;
+    }
+
+    if (bParseI30Data && (!m_I30ExactNameTerms.empty() || !m_I30ExactPathTerms.empty() || !m_I30Terms.empty()))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+HRESULT FileFind::GetIndexedRecords(
+    const MFTIndex& index,
+    const MFTIndex::VolumeState& state,
+    std::vector<MFT_SEGMENT_REFERENCE>& records) const
+{
+    HRESULT hr = E_FAIL;
+
+    std::vector<const MFTIndex::Record*> candidates;
+    const auto addCandidates = [&candidates](const std::vector<const MFTIndex::Record*>& found) {
+        candidates.insert(std::end(candidates), std::cbegin(found), std::cend(found));
+    };
+
+    for (const auto& [name, term] : m_ExactNameTerms)
+    {
+        addCandidates(index.FindByName(name));
+    }
+
+    // Exact path candidates are the records with the same file name, the full path is checked once walked
+    for (const auto& [path, term] : m_ExactPathTerms)
+    {
+        std::wstring_view fileName(path);
+        if (const auto pos = fileName.find_last_of(L'\\'); pos != std::wstring_view::npos)
+        {
+            fileName.remove_prefix(pos + 1);
+        }
+
+        addCandidates(index.FindByName(fileName));
+    }
+
+    for (const auto& [size, term] : m_SizeTerms)
+    {
+        addCandidates(index.FindBySize(size));
+    }
+
+    // Records changed since the snapshot are walked as well, directories may have moved
+    std::vector<MFTIndex::JournalChange> changes;
+    MFTIndex::MovedDirectories moved;
+    if (state.Journal)
+    {
+        if (FAILED(
+                hr = MFTIndex::ReadJournalChanges(
+                    m_pVolReader, *state.Journal, index.State().Journal->NextUsn, changes)))
+        {
+            return hr;
+        }
+
+        for (const auto& change : changes)
+        {
+            if (change.FileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+            {
+                moved[MFTIndex::SegmentNumber(change.FRN)] = change.ParentFRN;
+            }
+        }
+    }
+
+    // Past this point a complete walk costs less
+    constexpr size_t kMaxIndexedRecordsRatio = 4;
+    if ((candidates.size() + changes.size()) * kMaxIndexedRecordsRatio > index.RecordCount())
+    {
+        Log::Debug(
+            "MFT index has too many candidates or changes ({}/{})",
+            candidates.size() + changes.size(),
+            index.RecordCount());
+        return S_FALSE;
+    }
+
+    // Parent directories are walked too for the walker to build full names
+    std::unordered_set<ULONGLONG> segments;
+    for (const auto pRecord : candidates)
+    {
+        segments.insert(MFTIndex::SegmentNumber(pRecord->FRN));
+
+        const auto [first, last] = index.GetLinks(*pRecord);
+        for (auto pLink = first; pLink != last; ++pLink)
+        {
+            index.AddAncestors(pLink->ParentFRN, moved, segments);
+        }
+    }
+
+    for (const auto& change : changes)
+    {
+        segments.insert(MFTIndex::SegmentNumber(change.FRN));
+        index.AddAncestors(change.ParentFRN, moved, segments);
+    }
+
+    records.clear();
+    records.reserve(segments.size());
+    for (const auto segment : segments)
+    {
+        MFT_SEGMENT_REFERENCE reference;
+        NtfsSetSegmentNumber(&reference, static_cast<USHORT>(segment >> 32), static_cast<ULONG>(segment));
+        records.push_back(reference);
+    }
+
+    return S_OK;
+}
+
 void FileFind::PrintSpecs() const
 {
     std::for_each(
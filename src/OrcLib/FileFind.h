@@ -12,6 +12,7 @@
 #include "CaseInsensitive.h"
 #include "VolumeReader.h"
 #include "MFTWalker.h"
+#include "MFTIndex.h"
 #include "MFTRecord.h"
 #include "MftRecordAttribute.h"
 #include "CryptoHashStream.h"
@@ -19,6 +20,7 @@
 #include "TableOutput.h"
 #include "YaraScanner.h"
 
+#include <filesystem>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -523,6 +525,10 @@ public:
         return m_Matches;
     }
 
+    // Keep a MFTIndex of each walked volume in 'directory': later name and size searches on an unchanged (or journaled)
+    // volume only fetch the candidate records
+    void SetIndexDirectory(const std::filesystem::path& directory) { m_IndexDirectory = directory; }
+
     void PrintSpecs() const;
 
     ~FileFind(void);
@@ -593,6 +599,8 @@ private:
 
     bool m_storeMatches;
 
+    std::filesystem::path m_IndexDirectory;
+
     SearchTerm::Criteria DiscriminateName(const std::wstring& strName);
     SearchTerm::Criteria DiscriminateADS(const std::wstring& strADS);
     SearchTerm::Criteria DiscriminateEA(const std::wstring& strEA);
@@ -760,6 +768,12 @@ private:
 
     HRESULT FindI30Match(const PFILE_NAME pFileName, bool& bStop, FileFind::FoundMatchCallback aCallback);
 
+    bool CanUseMFTIndex(bool bParseI30Data) const;
+    HRESULT GetIndexedRecords(
+        const MFTIndex& index,
+        const MFTIndex::VolumeState& state,
+        std::vector<MFT_SEGMENT_REFERENCE>& records) const;
+
     CryptoHashStream::Algorithm GetNeededHashAlgorithms();
 };
 
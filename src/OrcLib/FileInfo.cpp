@@ -132,6 +132,27 @@ bool IsFailureAcceptedForDirectories(const Orc::Intentions& intention)
     return false;
 }
 
+// Authenticode verification uses the PE hashes: they are computed in the same read as the other hashes
+constexpr auto kAuthenticodeIntentions = Orc::Intentions::FILEINFO_AUTHENTICODE_STATUS
+    | Orc::Intentions::FILEINFO_AUTHENTICODE_SIGNER | Orc::Intentions::FILEINFO_AUTHENTICODE_SIGNER_THUMBPRINT
+    | Orc::Intentions::FILEINFO_AUTHENTICODE_CA | Orc::Intentions::FILEINFO_AUTHENTICODE_CA_THUMBPRINT
+    | Orc::Intentions::FILEINFO_SIGNED_HASH;
+
+// Predicates of those filters read the data stream to parse the PE headers
+bool IsExpensiveFilter(const Orc::Filter& filter)
+{
+    using namespace Orc;
+
+    switch (filter.type)
+    {
+        case FILEFILTER_VERSIONINFO:
+        case FILEFILTER_PEHEADER:
+            return true;
+    }
+
+    return false;
+}
+
 }  // namespace
 
 using namespace Orc;
@@ -371,7 +392,11 @@ HRESULT FileInfo::WriteFileInformation(
 {
     HRESULT hr = E_FAIL;
 
-    Intentions localIntentions = FilterIntentions(filters);
+    // Name and size predicates are evaluated first: the data stream is only read for predicates that can still change
+    // a column of the schema and then for the expensive intentions which survived the filters
+    const auto& plan = GetEvaluationPlan(columnNames, filters);
+    Intentions localIntentions = ResolveIntentions(plan, filters, filters.size(), plan.Columns);
+    m_RowIntentions = localIntentions;
 
     const ColumnNameDef* pCurCol = columnNames;
     while (pCurCol->dwIntention != Intentions::FILEINFO_NONE)
@@ -678,7 +703,11 @@ HRESULT FileInfo::OpenHash()
     if (FAILED(hr = CheckStream()))
         return hr;
 
-    Intentions localIntentions = FilterIntentions(m_Filters);
+    Intentions localIntentions = m_RowIntentions ? *m_RowIntentions : FilterIntentions(m_Filters);
+    if (HasAnyFlag(localIntentions, kAuthenticodeIntentions))
+    {
+        localIntentions |= Intentions::FILEINFO_AUTHENTICODE_STATUS;
+    }
 
     if (HasAnyFlag(
             localIntentions,
@@ -1833,6 +1862,91 @@ bool FileInfo::FilterApplies(const Filter& filter)
     return false;
 }
 
+const FileInfo::EvaluationPlan&
+FileInfo::GetEvaluationPlan(const ColumnNameDef columnNames[], const std::vector<Filter>& filters)
+{
+    struct CachedPlan
+    {
+        std::vector<FilterType> filterTypes;
+        EvaluationPlan plan;
+    };
+
+    Intentions columns = Intentions::FILEINFO_NONE;
+    for (const ColumnNameDef* pCurCol = columnNames; pCurCol->dwIntention != Intentions::FILEINFO_NONE; pCurCol++)
+    {
+        columns |= pCurCol->dwIntention;
+    }
+
+    // Rows of a table are written by the same thread with the same schema: keep the last plan built by each thread.
+    // It is keyed on what it is built from, the addresses of the columns and filters could be reused by another schema
+    thread_local CachedPlan cached;
+    if (cached.plan.Columns == columns
+        && std::equal(
+            std::cbegin(cached.filterTypes),
+            std::cend(cached.filterTypes),
+            std::cbegin(filters),
+            std::cend(filters),
+            [](FilterType type, const Filter& filter) { return type == filter.type; }))
+    {
+        return cached.plan;
+    }
+
+    cached.plan.Columns = columns;
+    cached.filterTypes.clear();
+    cached.plan.ExpensiveFilters.clear();
+    for (const auto& filter : filters)
+    {
+        cached.filterTypes.push_back(filter.type);
+        cached.plan.ExpensiveFilters.push_back(::IsExpensiveFilter(filter));
+    }
+
+    return cached.plan;
+}
+
+Intentions FileInfo::ResolveIntentions(
+    const EvaluationPlan& plan,
+    const std::vector<Filter>& filters,
+    size_t count,
+    Intentions mask)
+{
+    // Filters are applied in order so the last one which applies decides of an intention: walk them backwards and
+    // stop as soon as every intention of 'mask' is decided
+    while (count > 0 && mask != Intentions::FILEINFO_NONE)
+    {
+        const auto index = --count;
+        const auto& filter = filters[index];
+
+        const auto decided = filter.intent & mask;
+        if (decided == Intentions::FILEINFO_NONE)
+        {
+            continue;
+        }
+
+        const auto value = filter.bInclude ? decided : Intentions::FILEINFO_NONE;
+
+        if (!plan.ExpensiveFilters[index])
+        {
+            if (FilterApplies(filter))
+            {
+                return value | ResolveIntentions(plan, filters, count, mask & ~decided);
+            }
+
+            continue;
+        }
+
+        // Resolve the previous filters first, this predicate is only evaluated if it would change their outcome
+        const auto previous = ResolveIntentions(plan, filters, count, mask);
+        if ((previous & decided) == value || !FilterApplies(filter))
+        {
+            return previous;
+        }
+
+        return (previous & ~decided) | value;
+    }
+
+    return m_DefaultIntentions & mask;
+}
+
 Intentions FileInfo::FilterIntentions(const std::vector<Filter>& filters)
 {
     Intentions intentions = m_DefaultIntentions;
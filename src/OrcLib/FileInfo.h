@@ -9,6 +9,7 @@
 
 #include <vector>
 #include <memory>
+#include <optional>
 
 #include "DataDetails.h"
 #include "FSUtils.h"
@@ -40,6 +41,16 @@ public:
         Authenticode& verifytrust);
     virtual ~FileInfo();
 
+    // Evaluation order of a table schema, built once and shared by every row written with the same columns and filters
+    struct EvaluationPlan
+    {
+        Intentions Columns = Intentions::FILEINFO_NONE;  // intentions with a column in the schema
+        std::vector<bool> ExpensiveFilters;  // filters whose predicate reads the data stream (PE header, version)
+    };
+
+    static const EvaluationPlan&
+    GetEvaluationPlan(const ColumnNameDef columnNames[], const std::vector<Filter>& filters);
+
     const WCHAR* GetFullName() const { return m_szFullName; }
 
     virtual HRESULT HandleIntentions(const Intentions& intention, ITableOutput& writer);
@@ -108,9 +119,9 @@ protected:
     virtual HRESULT WriteLastModificationDate(ITableOutput& output) = 0;
     virtual HRESULT WriteLastAccessDate(ITableOutput& output) = 0;
 
-    HRESULT WriteOwnerId(ITableOutput& output);
-    HRESULT WriteOwnerSid(ITableOutput& output);
-    HRESULT WriteOwner(ITableOutput& output);
+    virtual HRESULT WriteOwnerId(ITableOutput& output);
+    virtual HRESULT WriteOwnerSid(ITableOutput& output);
+    virtual HRESULT WriteOwner(ITableOutput& output);
 
     HRESULT WritePlatform(ITableOutput& output);
     HRESULT WriteTimeStamp(ITableOutput& output);
@@ -161,10 +172,15 @@ protected:
     Intentions m_DefaultIntentions = Intentions::FILEINFO_NONE;
     Intentions m_ColumnIntentions = Intentions::FILEINFO_NONE;
 
+    // Intentions of the row being written, resolved once from the filters by WriteFileInformation
+    std::optional<Intentions> m_RowIntentions;
+
     Authenticode& m_codeVerifyTrust;
 
 private:
     Intentions FilterIntentions(const std::vector<Filter>& Filters);
+    Intentions
+    ResolveIntentions(const EvaluationPlan& plan, const std::vector<Filter>& filters, size_t count, Intentions mask);
     bool FilterApplies(const Filter& filter);
 
     size_t FindVersionQueryValueRec(
@@ -19,6 +19,9 @@ namespace Ntfs {
  * public:
  *    size_t Decompress(BufferView input, gsl::span<uint8_t> output, std::error_code& ec);
  * };
+ *
+ * A DecompressorConcept must be copyable: WofStreamConcept gives a copy to each of its workers, copies are used
+ * concurrently and must not share any state.
  */
 
 }  // namespace Ntfs
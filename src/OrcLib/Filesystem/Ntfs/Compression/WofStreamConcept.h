@@ -9,6 +9,10 @@
 #pragma once
 
 #include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <ppl.h>
 
 #include <fmt/format.h>
 
@@ -25,6 +29,11 @@ class WofStreamConcept
 {
 public:
     using ChunkBufferT = fmt::basic_memory_buffer<uint8_t, WofChunks::kDefaultChunkSize>;
+    using DecompressorElementT = typename details::MetaPtr<DecompressorT>::element_type;
+
+    // Complete chunks handled by each worker of a concurrent read: below that the read remains sequential
+    static constexpr uint64_t kMinChunksPerWorker = 4;
+    static constexpr uint64_t kMaxWorkers = 8;
 
     // Required by ByteStream interface
     WofStreamConcept()
@@ -98,17 +107,14 @@ public:
             endIndex = m_chunks.ChunkCount() - 1;
         }
 
-        for (uint64_t i = startIndex + 1; i < endIndex; ++i)
+        if (endIndex > startIndex + 1)
         {
             auto subspan = output.subspan(totalProcessed, output.size() - totalProcessed);
-            const auto processed = DecompressCompleteChunk(i, subspan, ec);
+            totalProcessed += DecompressCompleteChunks(startIndex + 1, endIndex, subspan, ec);
             if (ec)
             {
-                Log::Error("Failed to decompress chunk #{} [{}]", i, ec);
                 return totalProcessed;
             }
-
-            totalProcessed += processed;
         }
 
         // Decompress last chunk making sure it will work even if it must be truncated because of output's size
@@ -256,6 +262,117 @@ private:
         return processed;
     }
 
+    // Decompress the complete chunks [first, last) which cannot be the last chunk of the stream. When there are
+    // enough of them their compressed data is fetched with a single read and they are decompressed concurrently, each
+    // worker using its own copy of the decompressor.
+    size_t DecompressCompleteChunks(uint64_t first, uint64_t last, gsl::span<uint8_t> output, std::error_code& ec)
+    {
+        const size_t chunkSize = m_chunks.ChunkSize();
+        const auto count = last - first;
+
+        // BEWARE: 'output' must be big enough to store all the decompressed chunks
+        assert(output.size() >= count * chunkSize);
+
+        const auto workers = GetWorkerCount(first, last);
+        if (workers <= 1)
+        {
+            size_t totalProcessed = 0;
+            for (uint64_t i = first; i < last; ++i)
+            {
+                auto subspan = output.subspan(totalProcessed, output.size() - totalProcessed);
+                totalProcessed += DecompressCompleteChunk(i, subspan, ec);
+                if (ec)
+                {
+                    Log::Error("Failed to decompress chunk #{} [{}]", i, ec);
+                    return totalProcessed;
+                }
+            }
+
+            return totalProcessed;
+        }
+
+        const auto inputOffset = m_locations[first].offset;
+        const auto inputSize = m_locations[last - 1].offset + m_locations[last - 1].size - inputOffset;
+        m_batchBuffer.resize(inputSize);
+        Orc::Stream::ReadChunkAt(*m_stream, inputOffset, m_batchBuffer, ec);
+        if (ec)
+        {
+            Log::Error(
+                "Failed to read chunks #{} to #{} (offset: {}, size: {}) [{}]",
+                first,
+                last - 1,
+                inputOffset,
+                inputSize,
+                ec);
+            return 0;
+        }
+
+        while (m_workerDecompressors.size() < workers)
+        {
+            m_workerDecompressors.push_back(*m_decompressor);
+        }
+
+        std::vector<std::error_code> errors(count);
+        const auto chunksPerWorker = (count + workers - 1) / workers;
+
+        Concurrency::parallel_for(uint64_t(0), workers, [&](uint64_t worker) {
+            auto& decompressor = m_workerDecompressors[worker];
+
+            const auto end = std::min(count, (worker + 1) * chunksPerWorker);
+            for (auto i = worker * chunksPerWorker; i < end; ++i)
+            {
+                const auto& location = m_locations[first + i];
+                BufferView input(m_batchBuffer.data() + (location.offset - inputOffset), location.size);
+                decompressor.Decompress(input, output.subspan(i * chunkSize, chunkSize), errors[i]);
+                if (errors[i])
+                {
+                    return;
+                }
+            }
+        });
+
+        // Report the first failure, previous chunks are valid
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (errors[i])
+            {
+                ec = errors[i];
+                Log::Error(
+                    "Failed to decompress chunk {}/{} (algorithm: {}, chunk size: {}) [{}]",
+                    first + i,
+                    m_chunks.ChunkCount(),
+                    ToString(m_chunks.Algorithm()),
+                    chunkSize,
+                    ec);
+                return i * chunkSize;
+            }
+        }
+
+        return count * chunkSize;
+    }
+
+    // Number of workers to decompress the chunks [first, last), 1 when they should be processed sequentially
+    uint64_t GetWorkerCount(uint64_t first, uint64_t last) const
+    {
+        const uint64_t processors = std::thread::hardware_concurrency();
+        const auto workers = std::min({(last - first) / kMinChunksPerWorker, processors, kMaxWorkers});
+        if (workers <= 1)
+        {
+            return 1;
+        }
+
+        // The single read expects the compressed chunks to be stored one after the other
+        for (auto i = first + 1; i < last; ++i)
+        {
+            if (m_locations[i].offset != m_locations[i - 1].offset + m_locations[i - 1].size)
+            {
+                return 1;
+            }
+        }
+
+        return workers;
+    }
+
     // Decompress a complete a chunk in a big enough output buffer of at least "chunk size"
     size_t DecompressCompleteChunk(uint64_t chunkIndex, gsl::span<uint8_t> output, std::error_code& ec)
     {
@@ -313,6 +430,9 @@ private:
 
     fmt::basic_memory_buffer<WofChunks::ChunkLocation, 8192> m_locations;
     ChunkBufferT m_inputBuffer;
+
+    std::vector<uint8_t> m_batchBuffer;
+    std::vector<DecompressorElementT> m_workerDecompressors;
 };
 
 }  // namespace Ntfs
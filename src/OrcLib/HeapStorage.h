@@ -75,7 +75,10 @@ public:
         if (cell)
         {
             m_NumberOfAllocatedCells--;
-            _ASSERT(HeapFree(m_heap, 0L, cell));
+
+            // Not within _ASSERT: it is compiled out of release builds
+            [[maybe_unused]] const BOOL bFreed = HeapFree(m_heap, 0L, cell);
+            _ASSERT(bFreed);
         }
     }
 
@@ -12,6 +12,7 @@
 #include "WideAnsi.h"
 #include "BinaryBuffer.h"
 #include "Buffer.h"
+#include "AsyncWriteStream.h"
 
 #include "rapidjson/writer.h"
 #include "rapidjson/prettywriter.h"
@@ -36,6 +37,11 @@ Writer<_RapidWriter, _Ch>::Writer(std::shared_ptr<ByteStream> stream, std::uniqu
 std::shared_ptr<StructuredOutput::IWriter>
 GetWriter(std::shared_ptr<ByteStream> stream, std::unique_ptr<Options>&& options)
 {
+    if (options && options->dwAsyncBufferCount && stream)
+    {
+        stream = std::make_shared<AsyncWriteStream>(std::move(stream), true, options->dwAsyncBufferCount + 1);
+    }
+
     if (options == nullptr)
         return std::make_shared<Writer<
             rapidjson::PrettyWriter<Stream<rapidjson::UTF8<>::Ch>, rapidjson::UTF16<>, rapidjson::UTF8<>>,
@@ -70,6 +70,7 @@ public:
     }
     const std::vector<std::wstring>& GetSubDirs() const { return m_SubDirs; }
     const std::vector<std::wstring>& GetPaths() const { return m_Paths; }
+    const std::vector<CDiskExtent>& GetExtents() const { return m_Extents; }
     Location::Type GetType() const { return m_Type; }
     bool GetParse() const { return m_bParse; }
     bool IsValid() const { return m_bIsValid; }
@@ -2482,6 +2482,68 @@ std::vector<std::shared_ptr<Orc::Location>> LocationSet::GetParsedLocations()
     return locations;
 }
 
+std::vector<std::vector<size_t>>
+LocationSet::GroupByPhysicalDrive(const std::vector<std::shared_ptr<Location>>& locations)
+{
+    // Physical drive, or image file, backing a location which is not a shadow copy
+    auto GetDriveKey = [](const std::shared_ptr<Location>& loc) -> std::wstring {
+        if (!loc->GetExtents().empty())
+        {
+            // Volumes spanning several drives are keyed by their first extent
+            return loc->GetExtents().front().GetName();
+        }
+
+        // Image and physical drive volumes are 'path,offset=...,size=...'
+        const auto& location = loc->GetLocation();
+        return location.substr(0, location.find(L','));
+    };
+
+    std::map<std::wstring, std::wstring, CaseInsensitive> driveByVolume;
+    for (const auto& loc : locations)
+    {
+        if (loc == nullptr || loc->GetShadow())
+            continue;
+
+        if (auto reader = loc->GetReader())
+        {
+            driveByVolume.emplace(reader->GetLocation(), GetDriveKey(loc));
+        }
+    }
+
+    std::vector<std::vector<size_t>> groups;
+    std::map<std::wstring, size_t, CaseInsensitive> groupByDrive;
+
+    for (size_t i = 0; i < locations.size(); ++i)
+    {
+        const auto& loc = locations[i];
+
+        std::wstring key;
+        if (loc == nullptr)
+        {
+            key = std::to_wstring(i);
+        }
+        else if (const auto& shadow = loc->GetShadow(); shadow && shadow->parentVolume)
+        {
+            auto it = driveByVolume.find(shadow->parentVolume->GetLocation());
+            key = it != std::cend(driveByVolume) ? it->second : shadow->parentVolume->GetLocation();
+        }
+        else
+        {
+            key = GetDriveKey(loc);
+        }
+
+        auto [it, inserted] = groupByDrive.emplace(std::move(key), groups.size());
+        if (inserted)
+        {
+            groups.emplace_back();
+        }
+
+        groups[it->second].push_back(i);
+    }
+
+    return groups;
+}
+
 HRESULT LocationSet::PrintLocation(const std::shared_ptr<Location>& loc, bool logAsDebug, LPCWSTR szIndent) const
 {
     std::wstringstream ss;
@@ -195,6 +195,11 @@ public:
 
     HRESULT IsEmpty(bool bLocToParse = true);
 
+    // Group locations stored on the same physical drive (shadow copies go with their volume), as indexes in
+    // 'locations'. Groups, and indexes in each group, keep the order of 'locations'.
+    static std::vector<std::vector<size_t>>
+    GroupByPhysicalDrive(const std::vector<std::shared_ptr<Location>>& locations);
+
     // print locations
     HRESULT PrintLocation(const std::shared_ptr<Location>& loc, bool logAsDebug, LPCWSTR szIndent = L"") const;
     HRESULT PrintLocations(bool bOnlyParsedOnes, LPCWSTR szIndent = L"") const;
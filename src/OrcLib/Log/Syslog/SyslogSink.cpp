@@ -8,6 +8,9 @@
 
 #include "SyslogSink.h"
 
+#include <algorithm>
+
+#include "Log/Log.h"
 #include "Text/Iconv.h"
 #include "Utils/Guard/Winsock.h"
 
@@ -43,7 +46,21 @@ namespace Log {
 template class SyslogSink<std::mutex>;
 
 template <typename T>
-SyslogSink<T>::SyslogSink()
+SyslogSink<T>::SyslogSink(
+    size_t queueSize,
+    size_t batchSize,
+    std::chrono::milliseconds flushInterval,
+    OverflowPolicy policy)
+    : m_ring((std::max)(queueSize, static_cast<size_t>(1)))
+    , m_head(0)
+    , m_tail(0)
+    , m_batchSize((std::max)(batchSize, static_cast<size_t>(1)))
+    , m_flushInterval(flushInterval)
+    , m_policy(policy)
+    , m_dropped(0)
+    , m_flushRequested(false)
+    , m_stop(false)
+    , m_started(false)
 {
     const std::string nil(SyslogMessage::kNilValue);  // RFC5424
     const char eol[] = "";
@@ -60,29 +77,159 @@ SyslogSink<T>::SyslogSink()
         std::make_unique<spdlog::pattern_formatter>(pattern, spdlog::pattern_time_type::utc, eol));
 }
 
+template <typename T>
+SyslogSink<T>::~SyslogSink()
+{
+    if (m_thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            m_stop = true;
+        }
+
+        m_wake.notify_one();
+        m_sent.notify_all();
+        m_thread.join();
+    }
+}
+
 template <typename T>
 void SyslogSink<T>::AddEndpoint(UdpSocket&& socket)
 {
+    std::lock_guard<std::mutex> lock(m_syslogMutex);
     m_syslog.AddEndpoint(std::move(socket));
+    Start();
 }
 
 template <typename T>
 void SyslogSink<T>::AddEndpoint(const std::string& host, const std::string& port, std::error_code& ec)
 {
-    m_syslog.AddEndpoint(host, port, ec);
+    // Created without 'm_syslogMutex' as failures are logged: with OverflowPolicy::kBlock, logging could wait for the
+    // background thread which needs the mutex to send
+    UdpSocket socket(host, port, ec);
+    if (ec)
+    {
+        Log::Debug("Failed to create socket to '{}:{}' [{}]", host, port, ec);
+        return;
+    }
+
+    AddEndpoint(std::move(socket));
+}
+
+template <typename T>
+void SyslogSink<T>::Start()
+{
+    // The background thread is only needed once there is an endpoint, called with 'm_syslogMutex' held
+    if (!m_started)
+    {
+        m_thread = std::thread([this]() { Run(); });
+        m_started.store(true, std::memory_order_release);
+    }
 }
 
 template <typename T>
 void SyslogSink<T>::sink_it_(const spdlog::details::log_msg& msg)
 {
-    spdlog::memory_buf_t payload;
-    spdlog::sinks::base_sink<T>::formatter_->format(msg, payload);
+    if (!m_started.load(std::memory_order_acquire))
+    {
+        return;
+    }
 
-    std::error_code ec;
-    m_syslog.Send(std::string_view(payload.data(), payload.size()), ec);
-    if (ec)
+    const auto tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_head.load(std::memory_order_acquire) == m_ring.size())
     {
-        assert(0);  // Do not trigger any log as it create a recursive loop
+        if (m_policy == OverflowPolicy::kDrop)
+        {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_wake.notify_one();
+        m_sent.wait(lock, [this, tail]() {
+            return m_stop || tail - m_head.load(std::memory_order_acquire) < m_ring.size();
+        });
+
+        if (m_stop)
+        {
+            return;
+        }
+    }
+
+    m_payload.clear();
+    spdlog::sinks::base_sink<T>::formatter_->format(msg, m_payload);
+    m_ring[tail % m_ring.size()].assign(m_payload.data(), m_payload.size());
+    m_tail.store(tail + 1, std::memory_order_release);
+
+    // Notify without the wake mutex to keep logging lock free: a missed wake up is caught by the flush interval
+    if (tail + 1 - m_head.load(std::memory_order_acquire) >= m_batchSize)
+    {
+        m_wake.notify_one();
+    }
+}
+
+template <typename T>
+void SyslogSink<T>::flush_()
+{
+    if (!m_started.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    const auto tail = m_tail.load(std::memory_order_relaxed);
+
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+    m_flushRequested = true;
+    m_wake.notify_one();
+    m_sent.wait(lock, [this, tail]() { return m_stop || m_head.load(std::memory_order_acquire) == tail; });
+}
+
+template <typename T>
+void SyslogSink<T>::Run()
+{
+    for (;;)
+    {
+        bool stop = false;
+        {
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+            m_wake.wait_for(lock, m_flushInterval, [this]() {
+                return m_stop || m_flushRequested || PendingCount() >= m_batchSize;
+            });
+
+            m_flushRequested = false;
+            stop = m_stop;
+        }
+
+        SendPending();
+
+        {
+            // Taking the mutex prevents a waiter to miss this notification between its predicate check and its wait
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+        }
+        m_sent.notify_all();
+
+        if (stop)
+        {
+            break;
+        }
+    }
+}
+
+template <typename T>
+void SyslogSink<T>::SendPending()
+{
+    std::lock_guard<std::mutex> lock(m_syslogMutex);
+
+    auto head = m_head.load(std::memory_order_relaxed);
+    const auto tail = m_tail.load(std::memory_order_acquire);
+    for (; head != tail; ++head)
+    {
+        // Errors are not logged as it would create a recursive loop through this sink
+        std::error_code ec;
+        m_syslog.Send(m_ring[head % m_ring.size()], ec);
+
+        // Release the slot as soon as it is sent for a producer waiting on a full ring
+        m_head.store(head + 1, std::memory_order_release);
     }
 }
 
@@ -10,9 +10,15 @@
 
 #include <spdlog/sinks/base_sink.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <string>
 #include <memory>
+#include <mutex>
 #include <cassert>
+#include <thread>
+#include <vector>
 
 #include <spdlog/details/null_mutex.h>
 #include <spdlog/details/synchronous_factory.h>
@@ -25,11 +31,30 @@ namespace Log {
 
 class UdpSocket;
 
+//
+// Records are formatted by the logging thread into a bounded ring and sent by a background thread, which wakes up
+// when a batch is ready or when the flush interval elapsed, so that logging does not wait for the network.
+//
 template <typename Mutex>
 class SyslogSink : public spdlog::sinks::base_sink<Mutex>
 {
 public:
-    SyslogSink();
+    enum class OverflowPolicy
+    {
+        kDrop,  // records are dropped and counted when the ring is full
+        kBlock  // logging waits for the background thread to free a slot
+    };
+
+    static constexpr size_t kDefaultQueueSize = 4096;
+    static constexpr size_t kDefaultBatchSize = 64;
+    static constexpr std::chrono::milliseconds kDefaultFlushInterval {200};
+
+    SyslogSink(
+        size_t queueSize = kDefaultQueueSize,
+        size_t batchSize = kDefaultBatchSize,
+        std::chrono::milliseconds flushInterval = kDefaultFlushInterval,
+        OverflowPolicy policy = OverflowPolicy::kDrop);
+    ~SyslogSink() override;
 
     SyslogSink(const SyslogSink&) = delete;
     SyslogSink& operator=(const SyslogSink&) = delete;
@@ -37,16 +62,49 @@ public:
     void AddEndpoint(UdpSocket&& socket);
     void AddEndpoint(const std::string& host, const std::string& port, std::error_code& ec);
 
+    // Number of records dropped because the ring was full
+    uint64_t DroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
 protected:
     // Prevent any formatter change as it would break syslog messages
     void set_formatter_(std::unique_ptr<spdlog::formatter> sink_formatter) override {}
 
     void sink_it_(const spdlog::details::log_msg& msg) override;
-    void flush_() override {}
+    void flush_() override;
+
+private:
+    void Start();
+    void Run();
+    void SendPending();
+
+    size_t PendingCount() const
+    {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
 
 private:
     Syslog m_syslog;
+    std::mutex m_syslogMutex;  // endpoints can be added while the background thread sends
     SyslogMessage m_message;
+
+    // Single producer ring as records are pushed under the sink mutex, slots keep their capacity between records
+    std::vector<std::string> m_ring;
+    std::atomic<size_t> m_head;  // next record to send
+    std::atomic<size_t> m_tail;  // next free slot
+    spdlog::memory_buf_t m_payload;
+
+    const size_t m_batchSize;
+    const std::chrono::milliseconds m_flushInterval;
+    const OverflowPolicy m_policy;
+    std::atomic<uint64_t> m_dropped;
+
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;  // wakes the background thread
+    std::condition_variable m_sent;  // wakes flush and producers waiting for a free slot
+    std::atomic<bool> m_flushRequested;
+    std::atomic<bool> m_stop;
+    std::atomic<bool> m_started;
+    std::thread m_thread;
 };
 
 extern template class SyslogSink<std::mutex>;
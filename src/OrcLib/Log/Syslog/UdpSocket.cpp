@@ -37,8 +37,8 @@ void UdpSocket::Send(std::string_view buffer, std::error_code& ec)
     auto ret = ::send(m_socket->value(), buffer.data(), buffer.size(), 0);
     if (ret == SOCKET_ERROR)
     {
-        ec = LastWin32Error();
-        Log::Error("Failed send() [{}]", ec);
+        // Not logged: this is called by the syslog sink and would loop back into it
+        ec.assign(WSAGetLastError(), std::system_category());
         return;
     }
 }
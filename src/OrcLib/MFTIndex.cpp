@@ -0,0 +1,867 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+
+#include "stdafx.h"
+
+#include "MFTIndex.h"
+
+#include "ByteStream.h"
+#include "Location.h"
+#include "MFTRecord.h"
+#include "MFTWalker.h"
+#include "MountedVolumeReader.h"
+
+#include "CaseInsensitive.h"
+
+#include "Log/Log.h"
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+using namespace Orc;
+
+namespace {
+
+constexpr ULONGLONG kRootSegmentNumber = 5;
+constexpr ULONG kLogFileSegmentNumber = 2;
+
+constexpr DWORD kWriteBufferSize = 1024 * 1024;
+constexpr DWORD kJournalBufferSize = 64 * 1024;
+
+static_assert(sizeof(MFTIndex::Header) == 72, "MFTIndex::Header is part of the file format");
+static_assert(sizeof(MFTIndex::Record) == 80, "MFTIndex::Record is part of the file format");
+static_assert(sizeof(MFTIndex::Link) == 24, "MFTIndex::Link is part of the file format");
+static_assert(sizeof(MFTIndex::NameKey) == 8, "MFTIndex::NameKey is part of the file format");
+static_assert(sizeof(MFTIndex::SizeKey) == 16, "MFTIndex::SizeKey is part of the file format");
+
+inline LONGLONG ToLongLong(const FILETIME& time)
+{
+    return (static_cast<LONGLONG>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+}
+
+inline ULONG NameHash(std::wstring_view name)
+{
+    return static_cast<ULONG>(hashCaseInsensitive(name));
+}
+
+// Sequential writes through a buffer, an index easily takes hundreds of megabytes
+class BufferedFileWriter
+{
+public:
+    BufferedFileWriter(HANDLE hFile)
+        : m_hFile(hFile)
+    {
+        m_buffer.reserve(kWriteBufferSize);
+    }
+
+    template <typename T>
+    HRESULT Write(const T* pItems, size_t count)
+    {
+        const auto pBytes = reinterpret_cast<const BYTE*>(pItems);
+        const size_t cbBytes = count * sizeof(T);
+
+        if (m_buffer.size() + cbBytes > kWriteBufferSize)
+        {
+            if (auto hr = Flush(); FAILED(hr))
+            {
+                return hr;
+            }
+
+            if (cbBytes > kWriteBufferSize)
+            {
+                return WriteFileChunks(pBytes, cbBytes);
+            }
+        }
+
+        m_buffer.insert(std::end(m_buffer), pBytes, pBytes + cbBytes);
+        return S_OK;
+    }
+
+    HRESULT Flush()
+    {
+        const auto hr = WriteFileChunks(m_buffer.data(), m_buffer.size());
+        m_buffer.clear();
+        return hr;
+    }
+
+private:
+    HRESULT WriteFileChunks(const BYTE* pBytes, size_t cbBytes)
+    {
+        while (cbBytes > 0)
+        {
+            const DWORD cbChunk = static_cast<DWORD>((std::min)(cbBytes, static_cast<size_t>(kWriteBufferSize)));
+
+            DWORD cbWritten = 0;
+            if (!WriteFile(m_hFile, pBytes, cbChunk, &cbWritten, NULL) || cbWritten != cbChunk)
+            {
+                return HRESULT_FROM_WIN32(GetLastError());
+            }
+
+            pBytes += cbChunk;
+            cbBytes -= cbChunk;
+        }
+
+        return S_OK;
+    }
+
+    HANDLE m_hFile;
+    std::vector<BYTE> m_buffer;
+};
+
+// Restart page of the $LogFile: two copies, the most recent one holds the highest current LSN
+constexpr size_t kRestartPageMagicLength = 4;
+constexpr size_t kRestartPageSystemPageSizeOffset = 0x10;
+constexpr size_t kRestartPageRestartAreaOffset = 0x18;
+constexpr size_t kRestartPageSectorLength = 512;
+constexpr size_t kRestartPageFixupLength = sizeof(USHORT);
+
+HRESULT ReadRestartAreaLsn(const std::shared_ptr<ByteStream>& stream, LONGLONG& lsn)
+{
+    HRESULT hr = E_FAIL;
+
+    if (stream == nullptr)
+    {
+        return E_POINTER;
+    }
+
+    lsn = 0LL;
+
+    std::array<BYTE, kRestartPageSectorLength> sector;
+    ULONG ulPageOffset = 0L;
+
+    for (size_t i = 0; i < 2; ++i)
+    {
+        ULONGLONG cbRead = 0LL;
+        if (FAILED(hr = stream->SetFilePointer(ulPageOffset, FILE_BEGIN, nullptr))
+            || FAILED(hr = stream->Read(sector.data(), sector.size(), &cbRead)))
+        {
+            return hr;
+        }
+
+        if (cbRead != sector.size() || memcmp(sector.data(), "RSTR", kRestartPageMagicLength) != 0)
+        {
+            return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+        }
+
+        // The current LSN is the first field of the restart area, it must not overlap the sector fixup
+        const auto restartArea = *reinterpret_cast<const USHORT*>(sector.data() + kRestartPageRestartAreaOffset);
+        if (restartArea + sizeof(LONGLONG) > kRestartPageSectorLength - kRestartPageFixupLength)
+        {
+            return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+        }
+
+        lsn = (std::max)(lsn, *reinterpret_cast<const LONGLONG*>(sector.data() + restartArea));
+
+        ulPageOffset = *reinterpret_cast<const ULONG*>(sector.data() + kRestartPageSystemPageSizeOffset);
+        if (ulPageOffset < kRestartPageSectorLength || (ulPageOffset & (ulPageOffset - 1)) != 0)
+        {
+            return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+        }
+    }
+
+    return S_OK;
+}
+
+// Every metadata change is logged: a volume which was not modified keeps the same $LogFile LSN
+HRESULT ReadLogFileLsn(const std::shared_ptr<Location>& location, LONGLONG& lsn)
+{
+    HRESULT hr = E_FAIL;
+
+    MFTWalker walker;
+    if (FAILED(hr = walker.Initialize(location, ResurrectRecordsMode::kNo)))
+    {
+        return hr;
+    }
+
+    std::vector<MFT_SEGMENT_REFERENCE> records(1);
+    NtfsSetSegmentNumber(&records.front(), 0, kLogFileSegmentNumber);
+
+    HRESULT hrRead = HRESULT_FROM_WIN32(ERROR_NOT_FOUND);
+
+    MFTWalker::Callbacks callbacks;
+    callbacks.DataCallback = [&hrRead, &lsn](
+                                 const std::shared_ptr<VolumeReader>& volreader,
+                                 MFTRecord* pElt,
+                                 const std::shared_ptr<DataAttribute>& pDataAttr) {
+        DBG_UNREFERENCED_PARAMETER(pElt);
+        if (pDataAttr->NameLength() == 0)
+        {
+            hrRead = ReadRestartAreaLsn(pDataAttr->GetDataStream(volreader), lsn);
+        }
+    };
+
+    if (FAILED(hr = walker.Walk(callbacks, records)))
+    {
+        return hr;
+    }
+
+    return hrRead;
+}
+
+}  // namespace
+
+void MFTIndex::Builder::Add(const std::shared_ptr<VolumeReader>& volume, MFTRecord* pRecord)
+{
+    Record record = {};
+    record.FRN = NtfsFullSegmentNumber(&pRecord->GetFileReferenceNumber());
+
+    if (pRecord->IsRecordInUse())
+    {
+        record.Flags |= kInUse;
+    }
+
+    if (pRecord->IsDirectory())
+    {
+        record.Flags |= kDirectory;
+    }
+
+    if (const auto pInfo = pRecord->GetStandardInformation())
+    {
+        record.CreationTime = ToLongLong(pInfo->CreationTime);
+        record.LastModificationTime = ToLongLong(pInfo->LastModificationTime);
+        record.LastChangeTime = ToLongLong(pInfo->LastChangeTime);
+        record.LastAccessTime = ToLongLong(pInfo->LastAccessTime);
+        record.Usn = pInfo->USN;
+    }
+
+    std::vector<Name> names;
+    for (const auto pFileName : pRecord->GetFileNames())
+    {
+        names.push_back(
+            {NtfsFullSegmentNumber(&pFileName->ParentDirectory),
+             std::wstring_view(pFileName->FileName, pFileName->FileNameLength),
+             pFileName->Flags});
+    }
+
+    std::vector<ULONGLONG> dataSizes;
+    for (const auto& pDataAttr : pRecord->GetDataAttributes())
+    {
+        ULONGLONG ullDataSize = 0LL;
+        if (FAILED(pDataAttr->DataSize(volume, ullDataSize)))
+        {
+            continue;
+        }
+
+        dataSizes.push_back(ullDataSize);
+
+        if (pDataAttr->NameLength() == 0)
+        {
+            record.DataSize = ullDataSize;
+            pDataAttr->AllocatedSize(volume, record.AllocatedSize);
+
+            if (pDataAttr->IsNonResident())
+            {
+                if (const auto pInfo = pDataAttr->GetNonResidentInformation(volume))
+                {
+                    record.ExtentCount = static_cast<ULONG>(pInfo->ExtentsVector.size());
+                }
+            }
+        }
+    }
+
+    Add(record, names, dataSizes);
+}
+
+void MFTIndex::Builder::Add(
+    const Record& record,
+    const std::vector<Name>& names,
+    const std::vector<ULONGLONG>& dataSizes)
+{
+    const auto index = static_cast<ULONG>(m_records.size());
+
+    auto& added = m_records.emplace_back(record);
+    added.FirstLink = static_cast<ULONG>(m_links.size());
+    added.LinkCount = static_cast<USHORT>((std::min)(names.size(), static_cast<size_t>(USHRT_MAX)));
+    added.DataStreamCount = static_cast<ULONG>(dataSizes.size());
+
+    for (size_t i = 0; i < added.LinkCount; ++i)
+    {
+        const auto& name = names[i];
+
+        Link link = {};
+        link.ParentFRN = name.ParentFRN;
+        link.Record = index;
+        link.NameOffset = static_cast<ULONG>(m_strings.size());
+        link.NameHash = NameHash(name.FileName);
+        link.NameLength = static_cast<USHORT>(name.FileName.size());
+        link.Flags = name.Flags;
+
+        m_strings.insert(std::end(m_strings), std::cbegin(name.FileName), std::cend(name.FileName));
+        m_links.push_back(link);
+    }
+
+    for (const auto size : dataSizes)
+    {
+        m_sizes.push_back({size, index, 0L});
+    }
+}
+
+void MFTIndex::Builder::Add(const MFTIndex& previous, const std::unordered_set<ULONGLONG>& replaced)
+{
+    // Stream sizes are only indexed by size, gather them by record
+    std::vector<SizeKey> sizes(previous.m_pSizeKeys, previous.m_pSizeKeys + previous.m_cSizeKeys);
+    std::stable_sort(std::begin(sizes), std::end(sizes), [](const SizeKey& left, const SizeKey& right) {
+        return left.Record < right.Record;
+    });
+
+    m_records.reserve(m_records.size() + previous.m_cRecords);
+
+    auto itSize = std::cbegin(sizes);
+    std::vector<Name> names;
+    std::vector<ULONGLONG> dataSizes;
+    for (ULONG i = 0; i < previous.m_cRecords; ++i)
+    {
+        dataSizes.clear();
+        for (; itSize != std::cend(sizes) && itSize->Record <= i; ++itSize)
+        {
+            if (itSize->Record == i)
+            {
+                dataSizes.push_back(itSize->Size);
+            }
+        }
+
+        const auto& record = previous.m_pRecords[i];
+        if (replaced.find(SegmentNumber(record.FRN)) != std::cend(replaced))
+        {
+            continue;
+        }
+
+        names.clear();
+        const auto [first, last] = previous.GetLinks(record);
+        for (auto pLink = first; pLink != last; ++pLink)
+        {
+            names.push_back({pLink->ParentFRN, previous.GetName(*pLink), static_cast<UCHAR>(pLink->Flags)});
+        }
+
+        Add(record, names, dataSizes);
+    }
+}
+
+HRESULT MFTIndex::Builder::Write(const std::filesystem::path& path, const VolumeState& state)
+{
+    HRESULT hr = E_FAIL;
+
+    // Records are written by segment number, links follow the order of their records
+    std::vector<ULONG> order(m_records.size());
+    std::iota(std::begin(order), std::end(order), 0);
+    std::sort(std::begin(order), std::end(order), [this](ULONG left, ULONG right) {
+        return MFTIndex::SegmentNumber(m_records[left].FRN) < MFTIndex::SegmentNumber(m_records[right].FRN);
+    });
+
+    std::vector<ULONG> newIndex(m_records.size());
+    for (ULONG i = 0; i < order.size(); ++i)
+    {
+        newIndex[order[i]] = i;
+    }
+
+    std::vector<NameKey> nameKeys;
+    nameKeys.reserve(m_links.size());
+    for (const auto index : order)
+    {
+        const auto& record = m_records[index];
+        for (ULONG i = record.FirstLink; i < record.FirstLink + record.LinkCount; ++i)
+        {
+            nameKeys.push_back({m_links[i].NameHash, static_cast<ULONG>(nameKeys.size())});
+        }
+    }
+    std::sort(std::begin(nameKeys), std::end(nameKeys), [](const NameKey& left, const NameKey& right) {
+        return left.NameHash < right.NameHash || (left.NameHash == right.NameHash && left.Link < right.Link);
+    });
+
+    for (auto& size : m_sizes)
+    {
+        size.Record = newIndex[size.Record];
+    }
+    std::sort(std::begin(m_sizes), std::end(m_sizes), [](const SizeKey& left, const SizeKey& right) {
+        return left.Size < right.Size || (left.Size == right.Size && left.Record < right.Record);
+    });
+
+    Header header = {};
+    header.Magic = kMagic;
+    header.Version = kVersion;
+    header.VolumeSerialNumber = state.VolumeSerialNumber;
+    header.MFTRecordCount = state.MFTRecordCount;
+    header.ResurrectMode = static_cast<ULONG>(state.ResurrectMode);
+    header.HasJournal = state.Journal.has_value();
+    header.RecordCount = static_cast<ULONG>(m_records.size());
+    header.JournalId = state.Journal ? state.Journal->JournalId : 0LL;
+    header.NextUsn = state.Journal ? state.Journal->NextUsn : 0LL;
+    header.LogFileLsn = state.LogFileLsn;
+    header.LinkCount = static_cast<ULONG>(m_links.size());
+    header.SizeKeyCount = static_cast<ULONG>(m_sizes.size());
+    header.StringsLength = m_strings.size();
+
+    auto tempPath = path;
+    tempPath += L".tmp";
+
+    {
+        Guard::FileHandle hFile =
+            CreateFileW(tempPath.c_str(), GENERIC_WRITE, 0L, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (!hFile.IsValid())
+        {
+            hr = HRESULT_FROM_WIN32(GetLastError());
+            Log::Error(L"Failed to create MFT index '{}' [{}]", tempPath, SystemError(hr));
+            return hr;
+        }
+
+        BufferedFileWriter writer(*hFile);
+        hr = writer.Write(&header, 1);
+
+        ULONG firstLink = 0;
+        for (size_t i = 0; SUCCEEDED(hr) && i < order.size(); ++i)
+        {
+            auto record = m_records[order[i]];
+            record.FirstLink = firstLink;
+            firstLink += record.LinkCount;
+            hr = writer.Write(&record, 1);
+        }
+
+        for (size_t i = 0; SUCCEEDED(hr) && i < order.size(); ++i)
+        {
+            const auto& record = m_records[order[i]];
+            for (ULONG l = record.FirstLink; SUCCEEDED(hr) && l < record.FirstLink + record.LinkCount; ++l)
+            {
+                auto link = m_links[l];
+                link.Record = static_cast<ULONG>(i);
+                hr = writer.Write(&link, 1);
+            }
+        }
+
+        if (SUCCEEDED(hr))
+        {
+            hr = writer.Write(nameKeys.data(), nameKeys.size());
+        }
+
+        if (SUCCEEDED(hr))
+        {
+            hr = writer.Write(m_sizes.data(), m_sizes.size());
+        }
+
+        if (SUCCEEDED(hr))
+        {
+            hr = writer.Write(m_strings.data(), m_strings.size());
+        }
+
+        if (SUCCEEDED(hr))
+        {
+            hr = writer.Flush();
+        }
+    }
+
+    if (FAILED(hr))
+    {
+        Log::Error(L"Failed to write MFT index '{}' [{}]", tempPath, SystemError(hr));
+        DeleteFileW(tempPath.c_str());
+        return hr;
+    }
+
+    if (!MoveFileExW(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING))
+    {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+        Log::Error(L"Failed to move MFT index to '{}' [{}]", path, SystemError(hr));
+        DeleteFileW(tempPath.c_str());
+        return hr;
+    }
+
+    Log::Debug(L"MFT index '{}' written ({} records, {} names)", path, m_records.size(), m_links.size());
+    return S_OK;
+}
+
+HRESULT MFTIndex::Open(const std::filesystem::path& path, std::unique_ptr<MFTIndex>& index)
+{
+    HRESULT hr = E_FAIL;
+
+    std::unique_ptr<MFTIndex> opened(new MFTIndex());
+
+    opened->m_file = CreateFileW(
+        path.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_DELETE,
+        NULL,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        NULL);
+    if (!opened->m_file.IsValid())
+    {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+        Log::Debug(L"No MFT index '{}' [{}]", path, SystemError(hr));
+        return hr;
+    }
+
+    LARGE_INTEGER fileSize = {0};
+    if (!GetFileSizeEx(*opened->m_file, &fileSize))
+    {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+        Log::Error(L"Failed to get size of MFT index '{}' [{}]", path, SystemError(hr));
+        return hr;
+    }
+
+    if (static_cast<ULONGLONG>(fileSize.QuadPart) < sizeof(Header))
+    {
+        Log::Warn(L"Invalid MFT index '{}': truncated header", path);
+        return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+    }
+
+    opened->m_mapping = CreateFileMappingW(*opened->m_file, NULL, PAGE_READONLY, 0L, 0L, NULL);
+    if (!opened->m_mapping.IsValid())
+    {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+        Log::Error(L"Failed to map MFT index '{}' [{}]", path, SystemError(hr));
+        return hr;
+    }
+
+    opened->m_pView = static_cast<const BYTE*>(MapViewOfFile(*opened->m_mapping, FILE_MAP_READ, 0L, 0L, 0));
+    if (opened->m_pView == nullptr)
+    {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+        Log::Error(L"Failed to map view of MFT index '{}' [{}]", path, SystemError(hr));
+        return hr;
+    }
+
+    const auto& header = *reinterpret_cast<const Header*>(opened->m_pView);
+    if (header.Magic != kMagic || header.Version != kVersion
+        || header.ResurrectMode >= static_cast<ULONG>(ResurrectRecordsMode::kCount))
+    {
+        Log::Warn(L"Invalid MFT index '{}': unsupported format", path);
+        return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+    }
+
+    // Computed on 64 bits: counts read from the file times the sizes of the entries can overflow a 32 bits size_t.
+    // Once it matches the size of the mapped view, the offsets below fit in a size_t
+    const ULONGLONG cbExpected = sizeof(Header) + static_cast<ULONGLONG>(header.RecordCount) * sizeof(Record)
+        + static_cast<ULONGLONG>(header.LinkCount) * (sizeof(Link) + sizeof(NameKey))
+        + static_cast<ULONGLONG>(header.SizeKeyCount) * sizeof(SizeKey)
+        + static_cast<ULONGLONG>(header.StringsLength) * sizeof(WCHAR);
+    if (static_cast<ULONGLONG>(fileSize.QuadPart) != cbExpected)
+    {
+        Log::Warn(L"Invalid MFT index '{}': unexpected size", path);
+        return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
+    }
+
+    auto& state = opened->m_state;
+    state.VolumeSerialNumber = header.VolumeSerialNumber;
+    state.MFTRecordCount = header.MFTRecordCount;
+    state.ResurrectMode = static_cast<ResurrectRecordsMode>(header.ResurrectMode);
+    if (header.HasJournal)
+    {
+        state.Journal = JournalPosition {header.JournalId, 0LL, header.NextUsn};
+    }
+    state.LogFileLsn = header.LogFileLsn;
+
+    auto pCurrent = opened->m_pView + sizeof(Header);
+
+    opened->m_pRecords = reinterpret_cast<const Record*>(pCurrent);
+    opened->m_cRecords = header.RecordCount;
+    pCurrent += opened->m_cRecords * sizeof(Record);
+
+    opened->m_pLinks = reinterpret_cast<const Link*>(pCurrent);
+    opened->m_cLinks = header.LinkCount;
+    pCurrent += opened->m_cLinks * sizeof(Link);
+
+    opened->m_pNameKeys = reinterpret_cast<const NameKey*>(pCurrent);
+    pCurrent += opened->m_cLinks * sizeof(NameKey);
+
+    opened->m_pSizeKeys = reinterpret_cast<const SizeKey*>(pCurrent);
+    opened->m_cSizeKeys = header.SizeKeyCount;
+    pCurrent += opened->m_cSizeKeys * sizeof(SizeKey);
+
+    opened->m_pStrings = reinterpret_cast<const WCHAR*>(pCurrent);
+    opened->m_cchStrings = static_cast<size_t>(header.StringsLength);
+
+    index = std::move(opened);
+    return S_OK;
+}
+
+MFTIndex::~MFTIndex()
+{
+    if (m_pView != nullptr)
+    {
+        UnmapViewOfFile(m_pView);
+        m_pView = nullptr;
+    }
+}
+
+HRESULT MFTIndex::GetVolumeState(
+    const std::shared_ptr<Location>& location,
+    ULONG ulMFTRecordCount,
+    ResurrectRecordsMode mode,
+    VolumeState& state)
+{
+    HRESULT hr = E_FAIL;
+
+    const auto volume = location->GetReader();
+
+    state.VolumeSerialNumber = volume->VolumeSerialNumber();
+    state.MFTRecordCount = ulMFTRecordCount;
+    state.ResurrectMode = mode;
+    state.Journal.reset();
+    state.LogFileLsn = 0LL;
+
+    const auto mountedVolReader = std::dynamic_pointer_cast<MountedVolumeReader>(volume);
+    if (mountedVolReader == nullptr)
+    {
+        // An offline $MFT comes without the $LogFile
+        if (location->GetType() == LocationType::OfflineMFT)
+        {
+            return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+        }
+
+        if (FAILED(hr = ReadLogFileLsn(location, state.LogFileLsn)))
+        {
+            Log::Debug(L"Failed to read $LogFile LSN of '{}' [{}]", location->GetLocation(), SystemError(hr));
+            return hr;
+        }
+
+        return S_OK;
+    }
+
+    USN_JOURNAL_DATA journalData = {0};
+    DWORD dwBytes = 0L;
+    if (!DeviceIoControl(
+            mountedVolReader->GetDevice(),
+            FSCTL_QUERY_USN_JOURNAL,
+            NULL,
+            0,
+            &journalData,
+            sizeof(journalData),
+            &dwBytes,
+            NULL))
+    {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+        Log::Debug(L"Failed to query USN journal of '{}' [{}]", location->GetLocation(), SystemError(hr));
+        return hr;
+    }
+
+    state.Journal = JournalPosition {journalData.UsnJournalID, journalData.FirstUsn, journalData.NextUsn};
+    return S_OK;
+}
+
+HRESULT MFTIndex::ReadJournalChanges(
+    const std::shared_ptr<VolumeReader>& volume,
+    const JournalPosition& position,
+    USN startUsn,
+    std::vector<JournalChange>& changes)
+{
+    const auto mountedVolReader = std::dynamic_pointer_cast<MountedVolumeReader>(volume);
+    if (mountedVolReader == nullptr)
+    {
+        return E_INVALIDARG;
+    }
+
+    READ_USN_JOURNAL_DATA_V0 request = {startUsn, 0xFFFFFFFF, FALSE, 0, 0, position.JournalId};
+    std::vector<BYTE> buffer(kJournalBufferSize);
+
+    // Changes made after 'position' are read by the next run
+    while (request.StartUsn < position.NextUsn)
+    {
+        DWORD dwBytes = 0L;
+        if (!DeviceIoControl(
+                mountedVolReader->GetDevice(),
+                FSCTL_READ_USN_JOURNAL,
+                &request,
+                sizeof(request),
+                buffer.data(),
+                static_cast<DWORD>(buffer.size()),
+                &dwBytes,
+                NULL))
+        {
+            const auto dwError = GetLastError();
+            if (dwError == ERROR_HANDLE_EOF)
+            {
+                break;
+            }
+
+            // ERROR_JOURNAL_ENTRY_DELETED once the journal wrapped past 'startUsn'
+            const auto hr = HRESULT_FROM_WIN32(dwError);
+            Log::Debug("Failed to read USN journal from {} [{}]", request.StartUsn, SystemError(hr));
+            return hr;
+        }
+
+        if (dwBytes <= sizeof(USN))
+        {
+            break;
+        }
+
+        for (DWORD dwOffset = sizeof(USN); dwOffset + sizeof(USN_RECORD_V2) <= dwBytes;)
+        {
+            const auto pRecord = reinterpret_cast<const USN_RECORD_V2*>(buffer.data() + dwOffset);
+            if (pRecord->RecordLength == 0)
+            {
+                break;
+            }
+
+            if (pRecord->MajorVersion == 2)
+            {
+                changes.push_back(
+                    {pRecord->FileReferenceNumber,
+                     pRecord->ParentFileReferenceNumber,
+                     pRecord->Usn,
+                     pRecord->Reason,
+                     pRecord->FileAttributes});
+            }
+
+            dwOffset += pRecord->RecordLength;
+        }
+
+        request.StartUsn = *reinterpret_cast<const USN*>(buffer.data());
+    }
+
+    return S_OK;
+}
+
+bool MFTIndex::IsValidFor(const VolumeState& current) const
+{
+    if (m_state.VolumeSerialNumber != current.VolumeSerialNumber || m_state.ResurrectMode != current.ResurrectMode)
+    {
+        return false;
+    }
+
+    if (m_state.Journal.has_value() != current.Journal.has_value())
+    {
+        return false;
+    }
+
+    if (!current.Journal)
+    {
+        return m_state.MFTRecordCount == current.MFTRecordCount && m_state.LogFileLsn != 0
+            && m_state.LogFileLsn == current.LogFileLsn;
+    }
+
+    // The changes since the snapshot must still be in the journal
+    return m_state.Journal->JournalId == current.Journal->JournalId
+        && m_state.Journal->NextUsn >= current.Journal->FirstUsn
+        && m_state.Journal->NextUsn <= current.Journal->NextUsn;
+}
+
+const MFTIndex::Record* MFTIndex::FindRecord(ULONGLONG frn) const
+{
+    const auto segment = SegmentNumber(frn);
+    const auto pEnd = m_pRecords + m_cRecords;
+
+    const auto pRecord = std::lower_bound(m_pRecords, pEnd, segment, [](const Record& record, ULONGLONG segment) {
+        return SegmentNumber(record.FRN) < segment;
+    });
+
+    if (pRecord == pEnd || SegmentNumber(pRecord->FRN) != segment)
+    {
+        return nullptr;
+    }
+
+    return pRecord;
+}
+
+std::vector<const MFTIndex::Record*> MFTIndex::FindByName(std::wstring_view name) const
+{
+    std::vector<const Record*> records;
+
+    const auto hash = NameHash(name);
+    const auto [first, last] = std::equal_range(
+        m_pNameKeys,
+        m_pNameKeys + m_cLinks,
+        NameKey {hash, 0L},
+        [](const NameKey& left, const NameKey& right) { return left.NameHash < right.NameHash; });
+
+    for (auto pKey = first; pKey != last; ++pKey)
+    {
+        if (pKey->Link >= m_cLinks)
+        {
+            continue;
+        }
+
+        const auto& link = m_pLinks[pKey->Link];
+        if (link.Record < m_cRecords && equalCaseInsensitive(GetName(link), name))
+        {
+            records.push_back(&m_pRecords[link.Record]);
+        }
+    }
+
+    // Hard links with the same name in different directories
+    std::sort(std::begin(records), std::end(records));
+    records.erase(std::unique(std::begin(records), std::end(records)), std::end(records));
+    return records;
+}
+
+std::vector<const MFTIndex::Record*> MFTIndex::FindBySize(ULONGLONG size) const
+{
+    std::vector<const Record*> records;
+
+    const auto [first, last] = std::equal_range(
+        m_pSizeKeys,
+        m_pSizeKeys + m_cSizeKeys,
+        SizeKey {size, 0L, 0L},
+        [](const SizeKey& left, const SizeKey& right) { return left.Size < right.Size; });
+
+    for (auto pKey = first; pKey != last; ++pKey)
+    {
+        if (pKey->Record < m_cRecords)
+        {
+            records.push_back(&m_pRecords[pKey->Record]);
+        }
+    }
+
+    // Keys are sorted by record for a given size: streams of the same size are adjacent
+    records.erase(std::unique(std::begin(records), std::end(records)), std::end(records));
+    return records;
+}
+
+std::pair<const MFTIndex::Link*, const MFTIndex::Link*> MFTIndex::GetLinks(const Record& record) const
+{
+    if (static_cast<size_t>(record.FirstLink) + record.LinkCount > m_cLinks)
+    {
+        return {nullptr, nullptr};
+    }
+
+    return {m_pLinks + record.FirstLink, m_pLinks + record.FirstLink + record.LinkCount};
+}
+
+std::wstring_view MFTIndex::GetName(const Link& link) const
+{
+    if (static_cast<size_t>(link.NameOffset) + link.NameLength > m_cchStrings)
+    {
+        return {};
+    }
+
+    return std::wstring_view(m_pStrings + link.NameOffset, link.NameLength);
+}
+
+void MFTIndex::AddAncestors(
+    ULONGLONG parentFRN,
+    const MovedDirectories& moved,
+    std::unordered_set<ULONGLONG>& directories) const
+{
+    for (auto frn = parentFRN;;)
+    {
+        const auto segment = SegmentNumber(frn);
+        if (!directories.insert(segment).second || segment == kRootSegmentNumber)
+        {
+            return;
+        }
+
+        if (const auto movedIt = moved.find(segment); movedIt != std::cend(moved))
+        {
+            frn = movedIt->second;
+            continue;
+        }
+
+        const auto pRecord = FindRecord(frn);
+        if (pRecord == nullptr)
+        {
+            return;
+        }
+
+        // Directories cannot be hard linked, every name has the same parent
+        const auto [first, last] = GetLinks(*pRecord);
+        if (first == last)
+        {
+            return;
+        }
+
+        frn = first->ParentFRN;
+    }
+}
@@ -0,0 +1,237 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#pragma once
+
+#include "NtfsDataStructures.h"
+#include "ResurrectRecordsMode.h"
+
+#include "Utils/Guard.h"
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#pragma managed(push, off)
+
+namespace Orc {
+
+class Location;
+class VolumeReader;
+class MFTRecord;
+
+// Snapshot of the base records of a NTFS volume, persisted after a complete walk.
+//
+// Later runs against the same volume memory map the snapshot: name and size lookups are answered without reading the
+// $MFT and only the candidate records (plus, on a mounted volume, the records the USN journal reports as changed since
+// the snapshot) have to be fetched.
+//
+// File layout: Header, Records sorted by segment number, Links (one per $FILE_NAME) grouped by record, NameKeys sorted
+// by name hash, SizeKeys sorted by size and the UTF-16 names.
+class MFTIndex
+{
+public:
+    static constexpr ULONG kMagic = 0x5844494D;  // 'MIDX'
+    static constexpr ULONG kVersion = 1;
+
+    // Position of the USN journal of a mounted volume
+    struct JournalPosition
+    {
+        DWORDLONG JournalId = 0LL;
+        USN FirstUsn = 0LL;
+        USN NextUsn = 0LL;
+    };
+
+    // What a snapshot was taken from, a snapshot is only used on the very same state
+    struct VolumeState
+    {
+        ULONGLONG VolumeSerialNumber = 0LL;
+        ULONG MFTRecordCount = 0L;
+        ResurrectRecordsMode ResurrectMode = ResurrectRecordsMode::kNo;
+
+        // Mounted volumes are followed with their USN journal
+        std::optional<JournalPosition> Journal;
+
+        // Other sources (images, shadow copies...) with the current LSN of the $LogFile restart area
+        LONGLONG LogFileLsn = 0LL;
+    };
+
+    // Record reported by the USN journal, with its parent directory after the change
+    struct JournalChange
+    {
+        ULONGLONG FRN;
+        ULONGLONG ParentFRN;
+        USN Usn;
+        DWORD Reason;
+        DWORD FileAttributes;
+    };
+
+    enum RecordFlags : USHORT
+    {
+        kInUse = 0x0001,
+        kDirectory = 0x0002
+    };
+
+    struct Header
+    {
+        ULONG Magic;
+        ULONG Version;
+        ULONGLONG VolumeSerialNumber;
+        ULONG MFTRecordCount;
+        ULONG ResurrectMode;
+        ULONG HasJournal;
+        ULONG RecordCount;
+        DWORDLONG JournalId;
+        USN NextUsn;
+        LONGLONG LogFileLsn;
+        ULONG LinkCount;
+        ULONG SizeKeyCount;
+        ULONGLONG StringsLength;  // in WCHARs
+    };
+
+    struct Record
+    {
+        ULONGLONG FRN;
+        ULONGLONG DataSize;  // unnamed $DATA
+        ULONGLONG AllocatedSize;
+        LONGLONG CreationTime;  // $STANDARD_INFORMATION
+        LONGLONG LastModificationTime;
+        LONGLONG LastChangeTime;
+        LONGLONG LastAccessTime;
+        USN Usn;
+        ULONG FirstLink;
+        USHORT LinkCount;
+        USHORT Flags;
+        ULONG ExtentCount;  // data runs of the unnamed $DATA
+        ULONG DataStreamCount;
+    };
+
+    struct Link
+    {
+        ULONGLONG ParentFRN;
+        ULONG Record;
+        ULONG NameOffset;  // in WCHARs
+        ULONG NameHash;
+        USHORT NameLength;
+        USHORT Flags;  // FILE_NAME_POSIX, FILE_NAME_WIN32, FILE_NAME_DOS83
+    };
+
+    struct NameKey
+    {
+        ULONG NameHash;
+        ULONG Link;
+    };
+
+    struct SizeKey
+    {
+        ULONGLONG Size;
+        ULONG Record;
+        ULONG Reserved;
+    };
+
+    struct Name
+    {
+        ULONGLONG ParentFRN;
+        std::wstring_view FileName;
+        UCHAR Flags;
+    };
+
+    // File reference number without its sequence number
+    static constexpr ULONGLONG SegmentNumber(ULONGLONG frn) { return frn & 0x0000FFFFFFFFFFFFULL; }
+
+    // Directory segment numbers whose parent changed since the snapshot, to their new parent
+    using MovedDirectories = std::unordered_map<ULONGLONG, ULONGLONG>;
+
+    class Builder
+    {
+    public:
+        // Add a parsed base record, as provided by MFTWalker's ElementCallback
+        void Add(const std::shared_ptr<VolumeReader>& volume, MFTRecord* pRecord);
+
+        // 'record' link fields are ignored, 'dataSizes' holds the size of every $DATA attribute
+        void Add(const Record& record, const std::vector<Name>& names, const std::vector<ULONGLONG>& dataSizes);
+
+        // Add the records of a previous snapshot except the 'replaced' segment numbers, which were walked again
+        void Add(const MFTIndex& previous, const std::unordered_set<ULONGLONG>& replaced);
+
+        size_t RecordCount() const { return m_records.size(); }
+
+        // Written to a temporary file first so that a concurrent run never maps a partial index, once per builder
+        HRESULT Write(const std::filesystem::path& path, const VolumeState& state);
+
+    private:
+        std::vector<Record> m_records;
+        std::vector<Link> m_links;  // Link::Record is the insertion index until Write
+        std::vector<SizeKey> m_sizes;
+        std::vector<WCHAR> m_strings;
+    };
+
+    static HRESULT Open(const std::filesystem::path& path, std::unique_ptr<MFTIndex>& index);
+
+    // Current state of the volume, 'ulMFTRecordCount' is the walker's. Fails for sources which cannot be followed.
+    static HRESULT GetVolumeState(
+        const std::shared_ptr<Location>& location,
+        ULONG ulMFTRecordCount,
+        ResurrectRecordsMode mode,
+        VolumeState& state);
+
+    // Records changed on a mounted volume since 'startUsn', fails once the journal wrapped past it
+    static HRESULT ReadJournalChanges(
+        const std::shared_ptr<VolumeReader>& volume,
+        const JournalPosition& position,
+        USN startUsn,
+        std::vector<JournalChange>& changes);
+
+    MFTIndex(const MFTIndex&) = delete;
+    MFTIndex& operator=(const MFTIndex&) = delete;
+    ~MFTIndex();
+
+    const VolumeState& State() const { return m_state; }
+    bool IsValidFor(const VolumeState& current) const;
+
+    size_t RecordCount() const { return m_cRecords; }
+
+    const Record* FindRecord(ULONGLONG frn) const;
+    std::vector<const Record*> FindByName(std::wstring_view name) const;
+    std::vector<const Record*> FindBySize(ULONGLONG size) const;
+
+    std::pair<const Link*, const Link*> GetLinks(const Record& record) const;
+    std::wstring_view GetName(const Link& link) const;
+
+    // Add the segment numbers of 'parentFRN' and its ancestors to 'directories', stop at the first one already there
+    void AddAncestors(
+        ULONGLONG parentFRN,
+        const MovedDirectories& moved,
+        std::unordered_set<ULONGLONG>& directories) const;
+
+private:
+    MFTIndex() = default;
+
+    Guard::FileHandle m_file;
+    Guard::Handle m_mapping;
+    const BYTE* m_pView = nullptr;
+
+    VolumeState m_state;
+
+    const Record* m_pRecords = nullptr;
+    size_t m_cRecords = 0;
+    const Link* m_pLinks = nullptr;
+    size_t m_cLinks = 0;
+    const NameKey* m_pNameKeys = nullptr;
+    const SizeKey* m_pSizeKeys = nullptr;
+    size_t m_cSizeKeys = 0;
+    const WCHAR* m_pStrings = nullptr;
+    size_t m_cchStrings = 0;
+};
+
+}  // namespace Orc
+
+#pragma managed(pop)
@@ -39,7 +39,8 @@ MFTRecordFileInfo::MFTRecordFileInfo(
     MFTRecord* pRecord,
     const PFILE_NAME pFileName,
     const std::shared_ptr<DataAttribute>& pDataAttr,
-    Authenticode& verifytrust)
+    Authenticode& verifytrust,
+    const std::shared_ptr<SecurityDescriptorTable>& pSecurityDescriptors)
     : NtfsFileInfo(
         std::move(strComputerName),
         pVolReader,
@@ -52,6 +53,7 @@ MFTRecordFileInfo::MFTRecordFileInfo(
     m_pMFTRecord = pRecord;
     m_pFileName = pFileName;
     m_pDataAttr = pDataAttr;
+    m_pSecurityDescriptors = pSecurityDescriptors;
 }
 
 HRESULT MFTRecordFileInfo::Open()
@@ -658,6 +660,30 @@ HRESULT MFTRecordFileInfo::WriteOwnerId(ITableOutput& output)
     return output.WriteInteger(m_pMFTRecord->m_pStandardInformation->OwnerId);
 }
 
+const SecurityDescriptorTable::Owner* MFTRecordFileInfo::GetOwner()
+{
+    if (m_pSecurityDescriptors == nullptr || m_pMFTRecord == NULL || m_pMFTRecord->m_pStandardInformation == NULL)
+        return nullptr;
+
+    return m_pSecurityDescriptors->GetOwner(m_pMFTRecord->m_pStandardInformation->SecurityId);
+}
+
+HRESULT MFTRecordFileInfo::WriteOwnerSid(ITableOutput& output)
+{
+    if (const auto pOwner = GetOwner())
+        return output.WriteString(pOwner->Sid);
+
+    return NtfsFileInfo::WriteOwnerSid(output);
+}
+
+HRESULT MFTRecordFileInfo::WriteOwner(ITableOutput& output)
+{
+    if (const auto pOwner = GetOwner(); pOwner != nullptr && !pOwner->Name.empty())
+        return output.WriteString(pOwner->Name);
+
+    return NtfsFileInfo::WriteOwner(output);
+}
+
 HRESULT MFTRecordFileInfo::WriteExtendedAttributes(ITableOutput& output)
 {
     HRESULT hr = E_FAIL;
@@ -14,6 +14,7 @@
 
 #include "MftRecordAttribute.h"
 #include "MftRecord.h"
+#include "SecurityDescriptorTable.h"
 
 #pragma managed(push, off)
 
@@ -47,6 +48,8 @@ public:
     virtual HRESULT WriteLastAccessDate(ITableOutput& output);
 
     virtual HRESULT WriteOwnerId(ITableOutput& output);
+    virtual HRESULT WriteOwnerSid(ITableOutput& output);
+    virtual HRESULT WriteOwner(ITableOutput& output);
 
     virtual HRESULT WriteUSN(ITableOutput& output);
     virtual HRESULT WriteFRN(ITableOutput& output);
@@ -86,7 +89,8 @@ public:
         MFTRecord* pRecord,
         const PFILE_NAME pFileName,
         const std::shared_ptr<DataAttribute>& pDataAttr,
-        Authenticode& verifytrust);
+        Authenticode& verifytrust,
+        const std::shared_ptr<SecurityDescriptorTable>& pSecurityDescriptors = nullptr);
     virtual ~MFTRecordFileInfo(void);
 
     const MFTRecord* MftRecord() const { return m_pMFTRecord; }
@@ -96,6 +100,10 @@ private:
     PFILE_NAME m_pFileName = nullptr;
     std::shared_ptr<DataAttribute> m_pDataAttr;
 
+    // Owners are resolved from the volume's descriptors when available, from the file otherwise
+    std::shared_ptr<SecurityDescriptorTable> m_pSecurityDescriptors;
+    const SecurityDescriptorTable::Owner* GetOwner();
+
     virtual HRESULT Open();
 
     virtual ULONGLONG GetFileReferenceNumber()
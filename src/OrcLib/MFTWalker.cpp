@@ -10,7 +10,6 @@
 
 #include "MFTWalker.h"
 
-#include "MemoryStream.h"
 #include "MountedVolumeReader.h"
 #include "OfflineMFTReader.h"
 
@@ -21,8 +20,11 @@
 
 #include <boost/scope_exit.hpp>
 
+#include <deque>
+#include <ppltasks.h>
+
 #include "Log/Log.h"
-#include "Utils/Guard.h"
+#include "Utils/Trace.h"
 
 using namespace std;
 using namespace std::string_view_literals;
@@ -30,6 +32,149 @@ using namespace Orc;
 
 namespace {
 
+// Queued $INDEX_ALLOCATION bytes triggering a batched $I30 pass
+constexpr ULONGLONG kI30BatchSize = 64 * 1024 * 1024;
+
+// Coalesced $I30 reads: at most 'kI30MaxReadSize' bytes, reading through gaps up to 'kI30MaxGapSize' bytes
+constexpr ULONGLONG kI30MaxReadSize = 4 * 1024 * 1024;
+constexpr ULONGLONG kI30MaxGapSize = 64 * 1024;
+
+// Bytes read before their blocks are handed over to the parsers
+constexpr ULONGLONG kI30WaveSize = 16 * 1024 * 1024;
+
+struct I30Entry
+{
+    PINDEX_ENTRY pEntry;
+    PFILE_NAME pFileName;
+    bool bCarved;
+};
+
+struct I30Wave
+{
+    std::deque<CBinaryBuffer> Buffers;
+    size_t FirstBlock = 0;
+
+    // Block data (nullptr if its read failed) and parsed entries, indexed from 'FirstBlock'
+    std::vector<LPBYTE> Blocks;
+    std::vector<std::vector<I30Entry>> Entries;
+};
+
+// Slack space is carved for names whose parent is the directory owning the index
+void CarveI30Entries(
+    MFTUtils::SafeMFTSegmentNumber directory,
+    LPBYTE pBegin,
+    LPBYTE pEnd,
+    std::vector<I30Entry>& entries)
+{
+    for (LPBYTE pByte = pBegin; pByte + sizeof(FILE_NAME) < pEnd; ++pByte)
+    {
+        const auto pCarvedFileName = reinterpret_cast<PFILE_NAME>(pByte);
+
+        if (NtfsFullSegmentNumber(&pCarvedFileName->ParentDirectory) != directory)
+            continue;
+
+        if (reinterpret_cast<LPBYTE>(pCarvedFileName->FileName + pCarvedFileName->FileNameLength) > pEnd)
+            continue;
+
+        entries.push_back({reinterpret_cast<PINDEX_ENTRY>(pByte - sizeof(INDEX_ENTRY)), pCarvedFileName, true});
+    }
+}
+
+template <typename BlockT>
+void ParseI30Block(
+    const std::shared_ptr<VolumeReader>& volreader,
+    const BlockT& block,
+    LPBYTE pData,
+    std::vector<I30Entry>& entries)
+{
+    HRESULT hr = E_FAIL;
+
+    const auto pIABuff = reinterpret_cast<PINDEX_ALLOCATION_BUFFER>(pData);
+    const LPBYTE pEnd = pData + block.ulSize;
+    const auto directory = block.pRecord->GetSafeMFTSegmentNumber();
+
+    if (FAILED(hr = MFTUtils::MultiSectorFixup(pIABuff, (std::min)(block.ulSizePerIndex, block.ulSize), volreader)))
+    {
+        if (block.bInUse && HRESULT_FROM_NT(NTE_BAD_SIGNATURE) != hr)
+        {
+            Log::Error(L"Failed to fixup $INDEX_ALLOCATION header [{}]", SystemError(hr));
+        }
+        else if (!block.bInUse)
+        {
+            Log::Debug("Failed to fixup carved $INDEX_ALLOCATION [{}]", SystemError(hr));
+        }
+        return;
+    }
+
+    if (!block.bInUse)
+    {
+        // Index block is not in use (anymore), only carving
+        CarveI30Entries(directory, pData + sizeof(INDEX_ENTRY), pEnd, entries);
+        return;
+    }
+
+    PINDEX_HEADER pHeader = &(pIABuff->IndexHeader);
+    PINDEX_ENTRY pEntry = (PINDEX_ENTRY)NtfsFirstIndexEntry(pHeader);
+    while (reinterpret_cast<LPBYTE>(pEntry) + sizeof(INDEX_ENTRY) <= pEnd && !(pEntry->Flags & INDEX_ENTRY_END)
+           && pEntry->Length != 0)
+    {
+        entries.push_back({pEntry, (PFILE_NAME)((PBYTE)pEntry + sizeof(INDEX_ENTRY)), false});
+        pEntry = NtfsNextIndexEntry(pEntry);
+    }
+
+    CarveI30Entries(directory, ((LPBYTE)NtfsFirstIndexEntry(pHeader)) + pHeader->FirstFreeByte, pEnd, entries);
+}
+
+struct I30Read
+{
+    ULONGLONG ullDiskOffset;
+    ULONGLONG ullSize;
+    size_t firstBlock;
+    size_t lastBlock;
+};
+
+// Reads up to 'kI30WaveSize' bytes starting with 'reads[nextRead]', in physical order
+template <typename BlockT>
+std::unique_ptr<I30Wave> ReadI30Wave(
+    const std::shared_ptr<VolumeReader>& volreader,
+    const std::vector<BlockT>& blocks,
+    const std::vector<I30Read>& reads,
+    size_t& nextRead)
+{
+    auto wave = std::make_unique<I30Wave>();
+    wave->FirstBlock = reads[nextRead].firstBlock;
+
+    ULONGLONG ullWaveSize = 0LL;
+    while (nextRead < reads.size() && ullWaveSize < kI30WaveSize)
+    {
+        const auto& read = reads[nextRead++];
+
+        auto& buffer = wave->Buffers.emplace_back();
+        ULONGLONG ullBytesRead = 0LL;
+        HRESULT hr = E_OUTOFMEMORY;
+        if (buffer.SetCount(static_cast<size_t>(read.ullSize)))
+            hr = volreader->Read(read.ullDiskOffset, buffer, read.ullSize, ullBytesRead);
+        if (FAILED(hr))
+        {
+            Log::Error("Failed to read $I30 blocks at offset {:#x} [{}]", read.ullDiskOffset, SystemError(hr));
+        }
+
+        for (size_t i = read.firstBlock; i < read.lastBlock; ++i)
+        {
+            const auto ullOffset = blocks[i].ullDiskOffset - read.ullDiskOffset;
+            if (SUCCEEDED(hr) && ullOffset + blocks[i].ulSize <= ullBytesRead)
+                wave->Blocks.push_back(buffer.GetData() + ullOffset);
+            else
+                wave->Blocks.push_back(nullptr);
+        }
+
+        ullWaveSize += read.ullSize;
+    }
+
+    wave->Entries.resize(wave->Blocks.size());
+    return wave;
+}
+
 // Check if an unused record can be considered as "resident" which means that most of its data is stored in only one
 // record. An unused "resident" record should be still worth analysis.
 bool IsRecordInUseOrResident(const MFTRecord& record)
@@ -79,15 +224,11 @@ constexpr auto SEGMENT_MAX_NUMBER = (0x10000);
 
 HCRYPTPROV MFTRecord::g_hProv = NULL;
 
-MFTWalker::MFTFileNameWrapper::MFTFileNameWrapper(const PFILE_NAME pFileName)
+MFTWalker::MFTFileNameWrapper::MFTFileNameWrapper(const PFILE_NAME pFileName, StringArena& arena)
+    : m_ParentDirectory(pFileName->ParentDirectory)
+    , m_Name(arena.Add(std::wstring_view(pFileName->FileName, pFileName->FileNameLength)))
+    , m_InLocation(boost::indeterminate)
 {
-    _ASSERT(pFileName != NULL);
-    const size_t size = sizeof(FILE_NAME) + (pFileName->FileNameLength * sizeof(WCHAR));
-    m_pFileName = (PFILE_NAME)malloc(size);
-    if (m_pFileName == NULL)
-        throw std::exception("Out of memory");
-    CopyMemory(m_pFileName, pFileName, size);
-    m_InLocation = boost::indeterminate;
 }
 
 HRESULT MFTWalker::Initialize(const shared_ptr<Location>& loc, ResurrectRecordsMode resurrectRecordsMode)
@@ -156,10 +297,18 @@ HRESULT MFTWalker::Initialize(const shared_ptr<Location>& loc, ResurrectRecordsM
         }
     }
 
-    if (FAILED(hr = m_SegmentStore.InitializeStore(0L, sizeof(MFTRecord) + m_pVolReader->GetBytesPerFRS())))
+    // Half of the memory limit goes to pending records, a quarter to cached directory paths
+    const auto dwCellSize = static_cast<DWORD>(sizeof(MFTRecord) + m_pVolReader->GetBytesPerFRS());
+    if (FAILED(hr = m_SegmentStore.InitializeStore(dwCellSize, m_ullMemoryLimit / 2)))
     {
         return hr;
     }
+    m_ullPathCacheLimit = m_ullMemoryLimit / 4;
+
+    if (m_ullMemoryLimit)
+    {
+        Log::Debug("MFT walk memory limit: {} bytes", m_ullMemoryLimit);
+    }
     return S_OK;
 }
 
@@ -293,37 +442,153 @@ bool MFTWalker::IsInLocation(PFILE_NAME pFileName)
     if (m_Locations.empty())
         return true;
 
-    boost::logic::tribool bInLocation = boost::indeterminate;
-
-    MFTUtils::SafeMFTSegmentNumber ulLastSegmentNumber = NtfsFullSegmentNumber(&(pFileName->ParentDirectory));
-    auto it = m_DirectoryNames.find(ulLastSegmentNumber);
-
+    auto it = m_DirectoryNames.find(NtfsFullSegmentNumber(&(pFileName->ParentDirectory)));
     if (it == end(m_DirectoryNames))
     {
         // parent directory not found :'( we return not in location
         return false;
     }
-    else
+
+    if (boost::logic::indeterminate(it->second.m_InLocation))
     {
-        if (it->second.m_InLocation)
+        std::wstring incompletePath;
+        const auto pPath = GetDirectoryPath(it, incompletePath);
+        if (pPath == nullptr)
         {
-            // Direct parent is in location, return true!
-            return true;
+            // some ancestor is still unknown, it cannot be determined yet
+            return false;
         }
-        else if (!it->second.m_InLocation)
+
+        it->second.m_InLocation = IsPathInLocation(*pPath);  // result saved for future queries
+    }
+
+    return static_cast<bool>(it->second.m_InLocation);
+}
+
+bool MFTWalker::IsPathInLocation(const std::wstring& path) const
+{
+    // Locations end with a backslash: a file is in a location when its parent directory is
+    return std::any_of(begin(m_Locations), end(m_Locations), [&path](const wstring& item) {
+        return !_wcsnicmp(path.c_str(), item.c_str(), item.size());
+    });
+}
+
+ULONGLONG MFTWalker::PathCacheEntrySize(const std::wstring& path)
+{
+    return sizeof(MFTUtils::SafeMFTSegmentNumber) + sizeof(std::wstring) + path.capacity() * sizeof(WCHAR);
+}
+
+void MFTWalker::TrimPathCache()
+{
+    if (m_ullPathCacheLimit == 0LL || m_ullPathCacheSize <= m_ullPathCacheLimit)
+    {
+        return;
+    }
+
+    Log::Debug("Directory path cache exceeds its memory budget ({} bytes), evicting oldest paths", m_ullPathCacheSize);
+
+    // Sub directories keep their own copy of the path: evicting a parent only costs a climb if it is queried again.
+    // Paths still referenced by a caller are kept alive by their shared_ptr
+    while (m_ullPathCacheSize > m_ullPathCacheLimit / 2 && !m_PathCacheOrder.empty())
+    {
+        auto it = m_DirectoryNames.find(m_PathCacheOrder.front());
+        m_PathCacheOrder.pop_front();
+
+        if (it != end(m_DirectoryNames) && it->second.m_Path)
         {
-            // if direct parent is determined and false then, Record is not in location!
-            return false;
+            m_ullPathCacheSize -= PathCacheEntrySize(*it->second.m_Path);
+            it->second.m_Path.reset();
         }
-        else
+    }
+}
+
+const std::wstring* MFTWalker::GetDirectoryPath(DirectoryNames::iterator directory, std::wstring& incompletePath)
+{
+    if (directory->second.m_Path)
+    {
+        return directory->second.m_Path.get();
+    }
+
+    TrimPathCache();
+
+    // Climb up to the root, or to the first ancestor whose path is already known
+    m_DirectoryChain.clear();
+
+    std::shared_ptr<const std::wstring> knownPath;
+    std::optional<MFTUtils::SafeMFTSegmentNumber> missingParent;
+
+    for (auto current = directory;;)
+    {
+        m_DirectoryChain.push_back(current);
+
+        const auto ullParent = NtfsFullSegmentNumber(&current->second.ParentDirectory());
+        if (ullParent == m_pMFT->GetUSNRoot())
+        {
+            break;
+        }
+
+        auto parent = m_DirectoryNames.find(ullParent);
+        if (parent == end(m_DirectoryNames) || m_DirectoryChain.size() >= m_DirectoryNames.size())
         {
-            // direct parent is indeterminate... need to determinate!
-            bool bNameInLocation = false;
-            GetFullNameAndIfInLocation(pFileName, nullptr, nullptr, &bNameInLocation);
-            it->second.m_InLocation = bNameInLocation;  // result saved for future queries
-            return bNameInLocation;
+            // Parent was not found (or the chain loops on a corrupted volume)
+            missingParent = ullParent;
+            break;
+        }
+
+        if (parent->second.m_Path)
+        {
+            knownPath = parent->second.m_Path;
+            break;
         }
+
+        current = parent;
     }
+
+    std::wstring path;
+    if (knownPath)
+    {
+        path = *knownPath;
+    }
+    else if (missingParent)
+    {
+        // Parent folder was _not_ found, inserting "place holder"
+        fmt::format_to(std::back_inserter(path), L"\\__{:016X}__\\", *missingParent);
+    }
+    else
+    {
+        path.push_back(L'\\');
+    }
+
+    for (auto it = std::rbegin(m_DirectoryChain); it != std::rend(m_DirectoryChain); ++it)
+    {
+        const auto name = (*it)->second.Name();
+        if (name != L".")
+        {
+            path.append(name);
+            path.push_back(L'\\');
+        }
+
+        if (!missingParent)
+        {
+            // Interned for the sub directories and files, only complete paths are cached
+            (*it)->second.m_Path = std::make_shared<const std::wstring>(path);
+            m_ullPathCacheSize += PathCacheEntrySize(*(*it)->second.m_Path);
+            if (m_ullPathCacheLimit != 0LL)
+            {
+                m_PathCacheOrder.push_back((*it)->first);
+            }
+        }
+    }
+
+    m_DirectoryChain.clear();
+
+    if (missingParent)
+    {
+        incompletePath = std::move(path);
+        return nullptr;
+    }
+
+    return directory->second.m_Path.get();
 }
 
 const WCHAR* MFTWalker::GetFullNameAndIfInLocation(
@@ -332,11 +597,9 @@ const WCHAR* MFTWalker::GetFullNameAndIfInLocation(
     DWORD* pdwLen,
     bool* pbInSpecificLocation)
 {
-    m_currentFileName.clear();
-    m_currentFileNameElements.clear();
+    Trace::Span span("mft", "MFTWalker::GetFullName");
 
-    // This clear the container which stores std::wstring_view which would be unsafe to use outside this scope
-    auto onScopeExit = Guard::CreateScopeGuard([this]() { m_currentFileNameElements.clear(); });
+    m_currentFileName.clear();
 
     if (m_Locations.empty() && pbInSpecificLocation != nullptr)
     {
@@ -352,13 +615,7 @@ const WCHAR* MFTWalker::GetFullNameAndIfInLocation(
             reinterpret_cast<wchar_t*>(reinterpret_cast<uint8_t*>(pHeader) + pHeader->NameOffset), pHeader->NameLength);
     }
 
-    // Doing base file name
-    std::wstring_view fileName;
-    if (pFileName)
-    {
-        fileName = std::wstring_view(pFileName->FileName, pFileName->FileNameLength);
-    }
-    else
+    if (pFileName == nullptr)
     {
         if (streamName)
         {
@@ -383,55 +640,29 @@ const WCHAR* MFTWalker::GetFullNameAndIfInLocation(
         return m_currentFileName.data();
     }
 
-    MFTUtils::SafeMFTSegmentNumber ulLastSegmentNumber = NtfsFullSegmentNumber(&(pFileName->ParentDirectory));
+    // Parent's path is one lookup in the directory cache
+    const MFTUtils::SafeMFTSegmentNumber ullParent = NtfsFullSegmentNumber(&(pFileName->ParentDirectory));
+    auto pDirectParent = m_DirectoryNames.find(ullParent);
 
-    auto pParentPair = m_DirectoryNames.find(NtfsFullSegmentNumber(&(pFileName->ParentDirectory)));
-    auto pDirectParent = pParentPair;
+    const std::wstring* pParentPath = nullptr;
+    std::wstring incompletePath;
 
-    while (pParentPair != end(m_DirectoryNames))
+    if (pDirectParent != end(m_DirectoryNames))
     {
-        PFILE_NAME pParentName = pParentPair->second.FileName();
-
-        if (pParentName == NULL)
-        {
-            Log::Debug(
-                L"Could not determine main parent file name for '{}'",
-                std::wstring_view(pFileName->FileName, pFileName->FileNameLength));
-            break;
-        }
-
-        if (!(pParentName->FileNameLength == 1 && *pParentName->FileName == L'.'))
-        {
-            m_currentFileNameElements.emplace_back(pParentName->FileName, pParentName->FileNameLength);
-        }
-
-        ulLastSegmentNumber = NtfsFullSegmentNumber(&(pParentName->ParentDirectory));
-        pParentPair = m_DirectoryNames.find(NtfsFullSegmentNumber(&(pParentName->ParentDirectory)));
-
-        if (ulLastSegmentNumber == m_pMFT->GetUSNRoot())
-        {
-            break;
-        }
+        pParentPath = GetDirectoryPath(pDirectParent, incompletePath);
     }
-
-    std::optional<std::wstring> unknownParentDirectory;  // ensure lifetime to be able to store as wstring_view
-    if (ulLastSegmentNumber != m_pMFT->GetUSNRoot())
+    else if (ullParent == m_pMFT->GetUSNRoot())
     {
-        // Parent folder was _not_ found, inserting "place holder"
-        unknownParentDirectory = std::wstring();
-        fmt::format_to(std::back_inserter(*unknownParentDirectory), L"__{:016X}__", ulLastSegmentNumber);
-        m_currentFileNameElements.emplace_back(*unknownParentDirectory);
+        incompletePath.push_back(L'\\');
     }
-
-    m_currentFileName.push_back(L'\\');
-
-    for (auto it = std::rbegin(m_currentFileNameElements); it != std::rend(m_currentFileNameElements); ++it)
+    else
     {
-        m_currentFileName.append(*it);
-        m_currentFileName.push_back(L'\\');
+        // Parent folder was _not_ found, inserting "place holder"
+        fmt::format_to(std::back_inserter(incompletePath), L"\\__{:016X}__\\", ullParent);
     }
 
-    m_currentFileName.append(fileName);
+    m_currentFileName.append(pParentPath ? *pParentPath : incompletePath);
+    m_currentFileName.append(pFileName->FileName, pFileName->FileNameLength);
 
     if (streamName)
     {
@@ -439,15 +670,12 @@ const WCHAR* MFTWalker::GetFullNameAndIfInLocation(
         m_currentFileName.append(*streamName);
     }
 
-    if (ulLastSegmentNumber == m_pMFT->GetUSNRoot() && pDirectParent != end(m_DirectoryNames))
+    if (pParentPath != nullptr)
     {
         // Check if path is in user's location of interest
         if (!m_Locations.empty() && boost::logic::indeterminate(pDirectParent->second.m_InLocation))
         {
-            pDirectParent->second.m_InLocation =
-                std::any_of(begin(m_Locations), end(m_Locations), [this](const wstring& item) {
-                    return !_wcsnicmp(m_currentFileName.c_str(), item.c_str(), item.size());
-                });
+            pDirectParent->second.m_InLocation = IsPathInLocation(*pParentPath);
         }
 
         if (pbInSpecificLocation != nullptr)
@@ -458,19 +686,7 @@ const WCHAR* MFTWalker::GetFullNameAndIfInLocation(
             }
             else
             {
-                if (pDirectParent->second.m_InLocation)
-                {
-                    *pbInSpecificLocation = true;
-                }
-                else if (!pDirectParent->second.m_InLocation)
-                {
-                    *pbInSpecificLocation = false;
-                }
-                else
-                {
-                    Log::Error(L"Failed to determine if in location for '{}'", m_currentFileName);
-                    *pbInSpecificLocation = false;
-                }
+                *pbInSpecificLocation = static_cast<bool>(pDirectParent->second.m_InLocation);
             }
         }
     }
@@ -608,36 +824,36 @@ bool MFTWalker::IsRecordComplete(
                 break;
             }
 
-            auto pParentName = pParentPair->second.FileName();
+            const MFTFileNameWrapper* pParentName = &pParentPair->second;
 
             while (pParentName != nullptr)
             {
                 MFTUtils::UnSafeMFTSegmentNumber UnSafeSegmentNumber =
-                    NtfsSegmentNumber(&(pParentName->ParentDirectory));
-                ULONGLONG SafeSegmentNumber = NtfsFullSegmentNumber(&(pParentName->ParentDirectory));
+                    NtfsSegmentNumber(&(pParentName->ParentDirectory()));
+                ULONGLONG SafeSegmentNumber = NtfsFullSegmentNumber(&(pParentName->ParentDirectory()));
                 if (SafeSegmentNumber == m_pMFT->GetUSNRoot() || UnSafeSegmentNumber == 0)
                     break;
 
                 const auto& pOtherParentPair =
-                    m_DirectoryNames.find(NtfsFullSegmentNumber(&(pParentName->ParentDirectory)));
+                    m_DirectoryNames.find(NtfsFullSegmentNumber(&(pParentName->ParentDirectory())));
                 if (pOtherParentPair == end(m_DirectoryNames))
                 {
                     Log::Trace(
                         "Record {}: Incomplete due to missing file name parent record {}",
                         NtfsFullSegmentNumber(&pRecord->GetFileReferenceNumber()),
-                        pParentName->ParentDirectory.SegmentNumberLowPart);
+                        pParentName->ParentDirectory().SegmentNumberLowPart);
 
-                    auto pParent = m_MFTMap.find(NtfsFullSegmentNumber(&(pParentName->ParentDirectory)));
+                    auto pParent = m_MFTMap.find(NtfsFullSegmentNumber(&(pParentName->ParentDirectory())));
                     if (pParent == end(m_MFTMap))
                     {
-                        missingRecords.push_back(pParentName->ParentDirectory);
+                        missingRecords.push_back(pParentName->ParentDirectory());
                     }
                     bIsComplete = false;
                     pParentName = nullptr;
                 }
                 else
                 {
-                    pParentName = pOtherParentPair->second.FileName();
+                    pParentName = &pOtherParentPair->second;
                 }
             }
         }
@@ -716,108 +932,172 @@ HRESULT MFTWalker::ParseI30AndCallback(MFTRecord* pRecord)
         }
     }
 
-    if (pIA != nullptr && m_Callbacks.I30Callback != nullptr)
+    if (pIR != nullptr && pIA != nullptr && m_Callbacks.I30Callback != nullptr)
     {
-        ULONGLONG ToRead = 0ULL;
-        if (FAILED(hr = pIA->DataSize(m_pVolReader, ToRead)))
+        if (FAILED(hr = QueueI30Blocks(pRecord, pIR, pIA, pBM)))
         {
-            Log::Error(L"Failed to determine $INDEX_ALLOCATION size");
+            Log::Error(L"Failed to read from $INDEX_ALLOCATION [{}]", SystemError(hr));
             return hr;
         }
+    }
+    return S_OK;
+}
 
-        UINT i = 0L;
+HRESULT MFTWalker::QueueI30Blocks(
+    MFTRecord* pRecord,
+    const std::shared_ptr<IndexRootAttribute>& pIR,
+    const std::shared_ptr<IndexAllocationAttribute>& pIA,
+    const std::shared_ptr<BitmapAttribute>& pBM)
+{
+    HRESULT hr = E_FAIL;
 
-        if (FAILED(
-                hr = pRecord->EnumData(
-                    m_pVolReader,
-                    pIA,
-                    0ULL,
-                    ToRead,
-                    pIR->SizePerIndex(),
-                    [this, pBM, pIR, &hr, pRecord, &i](ULONGLONG ullBufferStartOffset, CBinaryBuffer& Data) -> HRESULT {
-                        DBG_UNREFERENCED_PARAMETER(ullBufferStartOffset);
-                        PINDEX_ALLOCATION_BUFFER pIABuff = (PINDEX_ALLOCATION_BUFFER)Data.GetData();
+    // Directories with several names in the walked locations are only parsed once
+    if (m_I30Directories.find(pRecord) != std::cend(m_I30Directories))
+        return S_OK;
 
-                        if ((*pBM)[i])
-                        {
-                            if (FAILED(hr = MFTUtils::MultiSectorFixup(pIABuff, pIR->SizePerIndex(), m_pVolReader)))
-                            {
-                                if (HRESULT_FROM_NT(NTE_BAD_SIGNATURE) != hr)
-                                {
-                                    Log::Error(L"Failed to fixup $INDEX_ALLOCATION header");
-                                    return hr;
-                                }
-                            }
-                            else
-                            {
-                                PINDEX_HEADER pHeader = &(pIABuff->IndexHeader);
-                                PINDEX_ENTRY pEntry = (PINDEX_ENTRY)NtfsFirstIndexEntry(pHeader);
-                                while (!(pEntry->Flags & INDEX_ENTRY_END))
-                                {
-                                    PFILE_NAME pFileName = (PFILE_NAME)((PBYTE)pEntry + sizeof(INDEX_ENTRY));
+    ULONGLONG ToRead = 0ULL;
+    if (FAILED(hr = pIA->DataSize(m_pVolReader, ToRead)))
+    {
+        Log::Error(L"Failed to determine $INDEX_ALLOCATION size");
+        return hr;
+    }
 
-                                    m_Callbacks.I30Callback(m_pVolReader, pRecord, pEntry, pFileName, false);
+    const ULONG ulSizePerIndex = pIR->SizePerIndex();
 
-                                    pEntry = NtfsNextIndexEntry(pEntry);
-                                }
+    std::vector<MFTUtils::DataSegment> segments;
+    if (FAILED(hr = pIA->GetNonResidentSegmentsToRead(m_pVolReader, 0ULL, ToRead, ulSizePerIndex, segments)))
+        return hr;
 
-                                LPBYTE pFirstFreeByte =
-                                    (((LPBYTE)NtfsFirstIndexEntry(pHeader)) + pHeader->FirstFreeByte);
+    m_I30Directories.emplace(pRecord, false);
 
-                                while (pFirstFreeByte + sizeof(FILE_NAME) < Data.GetData() + Data.GetCount())
-                                {
-                                    PFILE_NAME pCarvedFileName = (PFILE_NAME)pFirstFreeByte;
+    for (size_t i = 0; i < segments.size(); ++i)
+    {
+        // Unallocated blocks read as zeroes: neither entries nor slack
+        if (segments[i].bUnallocated)
+            continue;
 
-                                    if (NtfsFullSegmentNumber(&pCarvedFileName->ParentDirectory)
-                                        == pRecord->GetSafeMFTSegmentNumber())
-                                    {
-                                        PINDEX_ENTRY pEntry =
-                                            (PINDEX_ENTRY)((LPBYTE)pCarvedFileName - sizeof(INDEX_ENTRY));
-                                        m_Callbacks.I30Callback(m_pVolReader, pRecord, pEntry, pCarvedFileName, true);
-                                    }
-                                    pFirstFreeByte++;
-                                }
-                            }
-                        }
-                        else
-                        {
-                            Log::Debug(
-                                L"Index {} of $INDEX_ALLOCATION is not in use (FRN: {:#x}) only carving...",
-                                i,
-                                NtfsFullSegmentNumber(&pRecord->GetFileReferenceNumber()));
+        I30Block block;
+        block.pRecord = pRecord;
+        block.ullDiskOffset = segments[i].ullDiskBasedOffset;
+        block.ulSize = static_cast<ULONG>(segments[i].ullSize);
+        block.ulSizePerIndex = ulSizePerIndex;
+        block.bInUse = pBM != nullptr && i < pBM->Bits().size() && (*pBM)[i];
+        m_I30Blocks.push_back(block);
 
-                            if (FAILED(hr = MFTUtils::MultiSectorFixup(pIABuff, pIR->SizePerIndex(), m_pVolReader)))
-                            {
-                                Log::Debug("Failed to fixup carved $INDEX_ALLOCATION [{}]", SystemError(hr));
-                                return S_OK;
-                            }
-                            else
-                            {
-                                LPBYTE pFirstFreeByte = (LPBYTE)pIABuff;
+        m_ullI30BatchSize += block.ulSize;
+    }
 
-                                while (pFirstFreeByte + sizeof(FILE_NAME) < Data.GetData() + Data.GetCount())
-                                {
-                                    PFILE_NAME pCarvedFileName = (PFILE_NAME)pFirstFreeByte;
+    return S_OK;
+}
 
-                                    if (NtfsFullSegmentNumber(&pCarvedFileName->ParentDirectory)
-                                        == pRecord->GetSafeMFTSegmentNumber())
-                                    {
-                                        PINDEX_ENTRY pEntry =
-                                            (PINDEX_ENTRY)((LPBYTE)pCarvedFileName - sizeof(INDEX_ENTRY));
-                                        m_Callbacks.I30Callback(m_pVolReader, pRecord, pEntry, pCarvedFileName, true);
-                                    }
-                                    pFirstFreeByte++;
-                                }
-                            }
-                        }
-                        i++;
-                        return S_OK;
-                    })))
+bool MFTWalker::DeferFreeUntilI30Flushed(MFTRecord* pRecord)
+{
+    auto it = m_I30Directories.find(pRecord);
+    if (it == std::end(m_I30Directories))
+        return false;
+
+    it->second = true;
+    return true;
+}
+
+HRESULT MFTWalker::FlushI30Blocks(bool bOnlyIfFull)
+{
+    if (m_I30Directories.empty())
+        return S_OK;
+
+    if (bOnlyIfFull && m_ullI30BatchSize < kI30BatchSize)
+        return S_OK;
+
+    Trace::Span span("mft", "MFTWalker::FlushI30Blocks");
+
+    std::sort(std::begin(m_I30Blocks), std::end(m_I30Blocks), [](const I30Block& lhs, const I30Block& rhs) {
+        return lhs.ullDiskOffset < rhs.ullDiskOffset;
+    });
+
+    // Neighbouring blocks (and the small gaps between them) are read at once
+    std::vector<I30Read> reads;
+    for (size_t i = 0; i < m_I30Blocks.size(); ++i)
+    {
+        const auto& block = m_I30Blocks[i];
+
+        if (!reads.empty())
         {
-            Log::Error(L"Failed to read from $INDEX_ALLOCATION [{}]", SystemError(hr));
-            return hr;
+            auto& read = reads.back();
+            const auto ullReadEnd = read.ullDiskOffset + read.ullSize;
+            const auto ullBlockEnd = block.ullDiskOffset + block.ulSize;
+
+            if (block.ullDiskOffset >= ullReadEnd && block.ullDiskOffset - ullReadEnd <= kI30MaxGapSize
+                && ullBlockEnd - read.ullDiskOffset <= kI30MaxReadSize)
+            {
+                read.ullSize = ullBlockEnd - read.ullDiskOffset;
+                read.lastBlock = i + 1;
+                continue;
+            }
         }
+
+        reads.push_back({block.ullDiskOffset, block.ulSize, i, i + 1});
     }
+
+    Log::Debug(
+        "Reading {} $I30 blocks of {} directories with {} reads",
+        m_I30Blocks.size(),
+        m_I30Directories.size(),
+        reads.size());
+
+    // Parsing of a wave overlaps with the reads of the next one, entries are reported in physical order
+    std::unique_ptr<I30Wave> pending;
+    auto parsing = Concurrency::task_from_result();
+
+    for (size_t nextRead = 0; nextRead < reads.size() || pending;)
+    {
+        std::unique_ptr<I30Wave> wave;
+        if (nextRead < reads.size())
+        {
+            wave = ReadI30Wave(m_pVolReader, m_I30Blocks, reads, nextRead);
+        }
+
+        if (pending)
+        {
+            parsing.wait();
+
+            for (size_t i = 0; i < pending->Entries.size(); ++i)
+            {
+                const auto& block = m_I30Blocks[pending->FirstBlock + i];
+                for (const auto& entry : pending->Entries[i])
+                {
+                    m_Callbacks.I30Callback(m_pVolReader, block.pRecord, entry.pEntry, entry.pFileName, entry.bCarved);
+                }
+            }
+
+            pending.reset();
+        }
+
+        if (wave)
+        {
+            parsing = Concurrency::create_task([this, pWave = wave.get()]() {
+                Concurrency::parallel_for(size_t(0), pWave->Entries.size(), [this, pWave](size_t i) {
+                    const auto& block = m_I30Blocks[pWave->FirstBlock + i];
+                    if (pWave->Blocks[i] != nullptr)
+                    {
+                        ParseI30Block(m_pVolReader, block, pWave->Blocks[i], pWave->Entries[i]);
+                    }
+                });
+            });
+            pending = std::move(wave);
+        }
+    }
+
+    for (const auto& [pRecord, bFree] : m_I30Directories)
+    {
+        if (bFree)
+        {
+            DeleteRecord(pRecord);
+        }
+    }
+
+    m_I30Directories.clear();
+    m_I30Blocks.clear();
+    m_ullI30BatchSize = 0LL;
     return S_OK;
 }
 
@@ -839,101 +1119,24 @@ HRESULT MFTWalker::Parse$SecureAndCallback(MFTRecord* pRecord)
         Log::Error("Failed to get $SDS data stream, nothing to parse");
         return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
     }
-    auto pMemStream = std::make_shared<MemoryStream>();
 
-    if (FAILED(hr = pMemStream->OpenForReadWrite(static_cast<DWORD>(pSDSStream->GetSize()))))
+    auto pSecurityDescriptors = std::make_shared<SecurityDescriptorTable>();
+    if (FAILED(hr = pSecurityDescriptors->Load(pSDSStream)))
     {
-        Log::Error("Failed to open mem stream to store $SDS data stream");
-        return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
-    }
-
-    ULONGLONG ullCopied = 0LL;
-    if (FAILED(hr = pSDSStream->CopyTo(pMemStream, &ullCopied)))
-    {
-        Log::Error("Failed to load $SDS data stream");
-        return HRESULT_FROM_WIN32(ERROR_INVALID_DATA);
-    }
-
-    CBinaryBuffer SDS;
-    pMemStream->GrabBuffer(SDS);
-
-    pMemStream->Close();
-    pMemStream.reset();
-
-    std::shared_ptr<IndexAllocationAttribute> pIA;
-    std::shared_ptr<IndexRootAttribute> pIR;
-    std::shared_ptr<BitmapAttribute> pBM;
-    if (FAILED(hr = pRecord->GetIndexAttributes(m_pVolReader, L"$SII", pIR, pIA, pBM)))
-    {
-        Log::Error(L"Failed to find $SII attributes [{}]", SystemError(hr));
+        Log::Error(L"Failed to load $SDS data stream [{}]", SystemError(hr));
         return hr;
     }
 
-    if (pIR != nullptr)
-    {
-        PINDEX_ENTRY entry = pIR->FirstIndexEntry();
-
-        while (!(entry->Flags & INDEX_ENTRY_END))
-        {
-            // PBYTE pFileName = (PBYTE) ((PBYTE) entry + sizeof(INDEX_ENTRY));
+    m_pSecurityDescriptors = std::move(pSecurityDescriptors);
 
-            entry = NtfsNextIndexEntry(entry);
-        }
-    }
-    if (pIA != nullptr)
+    if (m_Callbacks.SecDescCallback != nullptr)
     {
-        ULONGLONG ToRead = 0ULL;
-        if (FAILED(hr = pIA->DataSize(m_pVolReader, ToRead)))
-        {
-            Log::Error(L"Failed to determine $INDEX_ALLOCATION size [{}]", SystemError(hr));
-            return hr;
-        }
-
-        UINT i = 0L;
-
-        if (FAILED(
-                hr = pRecord->EnumData(
-                    m_pVolReader,
-                    pIA,
-                    0ULL,
-                    ToRead,
-                    pIR->SizePerIndex(),
-                    [this, pBM, pIR, &hr, pRecord, &i, &SDS](
-                        ULONGLONG ullBufferStartOffset, CBinaryBuffer& Data) -> HRESULT {
-                        DBG_UNREFERENCED_PARAMETER(ullBufferStartOffset);
-                        PINDEX_ALLOCATION_BUFFER pIABuff = (PINDEX_ALLOCATION_BUFFER)Data.GetData();
-
-                        if ((*pBM)[i])
-                        {
-                            if (FAILED(hr = MFTUtils::MultiSectorFixup(pIABuff, pIR->SizePerIndex(), m_pVolReader)))
-                            {
-                                Log::Error(L"Failed to fixup $INDEX_ALLOCATION header [{}]", SystemError(hr));
-                                return hr;
-                            }
-                            else
-                            {
-                                PINDEX_HEADER pHeader = &(pIABuff->IndexHeader);
-                                PSECURITY_DESCRIPTOR_INDEX_ENTRY pEntry = NtfsFirstSecDescIndexEntry(pHeader);
-
-                                while (!(pEntry->Flags & INDEX_ENTRY_END))
-                                {
-                                    PSECURITY_DESCRIPTOR_ENTRY pSDSEntry =
-                                        (PSECURITY_DESCRIPTOR_ENTRY)&SDS.Get<BYTE>(pEntry->SecurityDescriptorOffset);
-
-                                    if (m_Callbacks.SecDescCallback != nullptr)
-                                        m_Callbacks.SecDescCallback(m_pVolReader, pSDSEntry);
-
-                                    pEntry = NtfsNextSecDescIndexEntry(pEntry);
-                                }
-                            }
-                        }
-                        return S_OK;
-                    })))
-        {
-            Log::Error(L"Failed to read from $INDEX_ALLOCATION [{}]", SystemError(hr));
-            return hr;
-        }
+        m_pSecurityDescriptors->ForEach([this](const SECURITY_DESCRIPTOR_ENTRY& entry) {
+            auto pEntry = const_cast<PSECURITY_DESCRIPTOR_ENTRY>(&entry);
+            m_Callbacks.SecDescCallback(m_pVolReader, pEntry);
+        });
     }
+
     return S_OK;
 }
 
@@ -962,7 +1165,7 @@ HRESULT MFTWalker::SimpleCallCallbackForRecord(MFTRecord* pRecord, bool& bFreeRe
             }
         }
 
-        bFreeRecord = !m_Callbacks.KeepAliveCallback(m_pVolReader, pRecord);
+        bFreeRecord = !m_Callbacks.KeepAliveCallback(m_pVolReader, pRecord) && !DeferFreeUntilI30Flushed(pRecord);
 
         hr = m_Callbacks.ProgressCallback((DWORD)((m_dwWalkedItems * 100) / m_ulMFTRecordCount));
 
@@ -1018,6 +1221,7 @@ HRESULT MFTWalker::FullCallCallbackForRecord(MFTRecord* pRecord, bool& bFreeReco
             || m_Callbacks.DataCallback)
         {
             // "standard" case
+            bool bParseI30 = false;
             for (const auto& name : pRecord->m_FileNames)
             {
                 bool bInSpecificLocation = false;
@@ -1044,17 +1248,8 @@ HRESULT MFTWalker::FullCallCallbackForRecord(MFTRecord* pRecord, bool& bFreeReco
                         }
                     }
 
-                    if (m_Callbacks.I30Callback)
-                    {
-                        HRESULT hr = E_FAIL;
-                        if (FAILED(hr = ParseI30AndCallback(pRecord)))
-                        {
-                            Log::Error(
-                                "Failed to parse $I30 for record 0x{} [{}]",
-                                NtfsFullSegmentNumber(&pRecord->GetFileReferenceNumber()),
-                                SystemError(hr));
-                        }
-                    }
+                    // Parsed once below, even for directories with several names
+                    bParseI30 = m_Callbacks.I30Callback != nullptr;
                 }
                 else if (bInSpecificLocation && pRecord->m_DataAttrList.size() && m_Callbacks.FileNameAndDataCallback)
                 {
@@ -1066,6 +1261,18 @@ HRESULT MFTWalker::FullCallCallbackForRecord(MFTRecord* pRecord, bool& bFreeReco
                     }
                 }
             }
+            if (bParseI30)
+            {
+                HRESULT hr = E_FAIL;
+                if (FAILED(hr = ParseI30AndCallback(pRecord)))
+                {
+                    Log::Error(
+                        "Failed to parse $I30 for record 0x{} [{}]",
+                        NtfsFullSegmentNumber(&pRecord->GetFileReferenceNumber()),
+                        SystemError(hr));
+                }
+            }
+
             if (pRecord->m_DataAttrList.size() && m_Callbacks.DataCallback)
             {
                 // This record has Data attributes.
@@ -1078,7 +1285,7 @@ HRESULT MFTWalker::FullCallCallbackForRecord(MFTRecord* pRecord, bool& bFreeReco
             }
         }
 
-        bFreeRecord = !m_Callbacks.KeepAliveCallback(m_pVolReader, pRecord);
+        bFreeRecord = !m_Callbacks.KeepAliveCallback(m_pVolReader, pRecord) && !DeferFreeUntilI30Flushed(pRecord);
 
         hr = m_Callbacks.ProgressCallback((DWORD)((m_dwWalkedItems * 100) / m_ulMFTRecordCount));
 
@@ -1158,7 +1365,7 @@ HRESULT MFTWalker::WalkRecords(bool bIsFinalWalk)
         {
             Log::Trace("Calling callback for record {}", RefNumber);
 
-            if (m_Callbacks.SecDescCallback != nullptr
+            if ((m_Callbacks.SecDescCallback != nullptr || m_bLoadSecurityDescriptors)
                 && NtfsFullSegmentNumber(&pRecord->GetFileReferenceNumber()) == $SECURE_FILE_REFERENCE_NUMBER)
             {
                 if (FAILED(hr = Parse$SecureAndCallback(pRecord)))
@@ -1191,6 +1398,8 @@ HRESULT MFTWalker::WalkRecords(bool bIsFinalWalk)
             }
         }
 
+        FlushI30Blocks(true);
+
         if (hr == HRESULT_FROM_WIN32(ERROR_NO_MORE_FILES))
             return hr;
     }
@@ -1237,7 +1446,8 @@ HRESULT MFTWalker::AddDirectoryName(MFTRecord* pRecord)
         PFILE_NAME pFileName = pRecord->GetMain_PFILE_NAME();
         if (pFileName != NULL)
             m_DirectoryNames.insert(pair<MFTUtils::SafeMFTSegmentNumber, MFTFileNameWrapper>(
-                NtfsFullSegmentNumber(&pRecord->m_FileReferenceNumber), MFTFileNameWrapper(pFileName)));
+                NtfsFullSegmentNumber(&pRecord->m_FileReferenceNumber),
+                MFTFileNameWrapper(pFileName, m_DirectoryNameArena)));
         else
         {
             Log::Trace(
@@ -1257,7 +1467,7 @@ HRESULT MFTWalker::AddDirectoryName(MFTRecord* pRecord)
             if (pFileName != NULL)
                 m_DirectoryNames.insert(pair<MFTUtils::SafeMFTSegmentNumber, MFTFileNameWrapper>(
                     NtfsFullSegmentNumber(&pRecord->m_pBaseFileRecord->m_FileReferenceNumber),
-                    MFTFileNameWrapper(pFileName)));
+                    MFTFileNameWrapper(pFileName, m_DirectoryNameArena)));
             else
             {
                 Log::Trace(
@@ -1556,6 +1766,9 @@ HRESULT MFTWalker::AddRecordCallback(MFTUtils::SafeMFTSegmentNumber& ullRecordIn
 {
     HRESULT hr = E_FAIL;
 
+    Trace::Span span("mft", "MFTWalker::AddRecord");
+    span.SetBytes(Data.GetCount());
+
     try
     {
 
@@ -1696,7 +1909,7 @@ HRESULT MFTWalker::AddRecordCallback(MFTUtils::SafeMFTSegmentNumber& ullRecordIn
                 return S_OK;
             }
 
-            if (m_Callbacks.SecDescCallback != nullptr
+            if ((m_Callbacks.SecDescCallback != nullptr || m_bLoadSecurityDescriptors)
                 && NtfsFullSegmentNumber(&pRecord->GetFileReferenceNumber()) == $SECURE_FILE_REFERENCE_NUMBER)
             {
                 if (FAILED(hr = Parse$SecureAndCallback(pRecord)))
@@ -1722,6 +1935,8 @@ HRESULT MFTWalker::AddRecordCallback(MFTUtils::SafeMFTSegmentNumber& ullRecordIn
 
             if (bFreeRecord)
                 DeleteRecord(pRecord);
+
+            FlushI30Blocks(true);
         }
         else
         {
@@ -1761,6 +1976,9 @@ HRESULT MFTWalker::Walk(const Callbacks& Callbacks)
 
     if (m_ulMFTRecordCount > 0)
     {
+        // Every record read gets an entry, even once deleted
+        m_MFTMap.reserve(m_ulMFTRecordCount);
+
         hr = m_pMFT->EnumMFTRecord(
             [this](MFTUtils::SafeMFTSegmentNumber& ullRecordIndex, CBinaryBuffer& Data) -> HRESULT {
                 return AddRecordCallback(ullRecordIndex, Data);
@@ -1769,10 +1987,45 @@ HRESULT MFTWalker::Walk(const Callbacks& Callbacks)
 
     if (hr == HRESULT_FROM_WIN32(ERROR_NO_MORE_FILES))
     {
+        FlushI30Blocks(false);
+        return hr;  // no more enumeration nor walking...
+    }
+
+    hr = WalkRecords(true);
+    FlushI30Blocks(false);
+    return hr;
+}
+
+HRESULT MFTWalker::Walk(const Callbacks& Callbacks, std::vector<MFT_SEGMENT_REFERENCE>& records)
+{
+    HRESULT hr = E_FAIL;
+
+    if (FAILED(hr = SetCallbacks(Callbacks)))
+        return hr;
+
+    m_ulMFTRecordCount = GetMFTRecordCount();
+    m_MFTMap.reserve(records.size());
+
+    hr = m_pMFT->FetchMFTRecord(
+        records, [this](MFTUtils::SafeMFTSegmentNumber& ullRecordIndex, CBinaryBuffer& Data) -> HRESULT {
+            return AddRecordCallback(ullRecordIndex, Data);
+        });
+
+    if (hr == HRESULT_FROM_WIN32(ERROR_NO_MORE_FILES))
+    {
+        FlushI30Blocks(false);
         return hr;  // no more enumeration nor walking...
     }
 
-    return WalkRecords(true);
+    if (FAILED(hr))
+    {
+        Log::Error("Failed to fetch {} records [{}]", records.size(), SystemError(hr));
+        return hr;
+    }
+
+    hr = WalkRecords(true);
+    FlushI30Blocks(false);
+    return hr;
 }
 
 ULONG MFTWalker::GetMFTRecordCount() const
@@ -1840,6 +2093,17 @@ HRESULT MFTWalker::Statistics(const WCHAR* szMsg)
         Log::Warn("Heap still maintains {} entries", m_SegmentStore.AllocatedCells());
     }
 
+    if (m_SegmentStore.SpilledCells() > 0)
+    {
+        Log::Debug("Spill file still maintains {} entries", m_SegmentStore.SpilledCells());
+    }
+
+    Log::Debug(
+        "Directory names: {} ({} bytes), cached paths: {} bytes",
+        m_DirectoryNames.size(),
+        m_DirectoryNameArena.GetMemoryUsage(),
+        m_ullPathCacheSize);
+
 #ifdef _DEBUG
 
     if (FAILED(hr = m_SegmentStore.EnumCells([this](void* pData) {
@@ -11,17 +11,21 @@
 
 #include "VolumeReader.h"
 
-#include "HeapStorage.h"
+#include "SpillStorage.h"
 
 #include "Location.h"
 
 #include "MFTRecord.h"
 #include "MFTUtils.h"
 #include "IMFT.h"
+#include "SecurityDescriptorTable.h"
 
 #include "CaseInsensitive.h"
 #include "ResurrectRecordsMode.h"
+#include "Utils/FlatHashMap.h"
+#include "Utils/StringArena.h"
 
+#include <deque>
 #include <unordered_set>
 #include <set>
 #include <map>
@@ -103,9 +107,14 @@ public:
     MFTWalker()
         : m_SegmentStore(L"MFTSegmentStore")
     {
-        m_currentFileNameElements.reserve(64);
     }
 
+    // Soft limit on the memory used for records awaiting their extension records or parents and for cached directory
+    // paths (0 for no limit, the default): beyond it, record cells spill to a temporary file and paths are built again
+    // on demand. Attributes parsed from pending records and directory names are not bounded, so the peak memory of the
+    // walk can exceed it. Must be set before Initialize.
+    void SetMemoryLimit(ULONGLONG ullMemoryLimit) { m_ullMemoryLimit = ullMemoryLimit; }
+
     HRESULT Initialize(const std::shared_ptr<Location>& loc, ResurrectRecordsMode mode = ResurrectRecordsMode::kYes);
 
     FullNameBuilder GetFullNameBuilder()
@@ -122,44 +131,62 @@ public:
 
     HRESULT Walk(const Callbacks& pCallbacks);
 
+    // Walk only 'records' (and the extension records they need) instead of enumerating the whole $MFT
+    HRESULT Walk(const Callbacks& pCallbacks, std::vector<MFT_SEGMENT_REFERENCE>& records);
+
+    // Index the security descriptors of $Secure when it is walked, even if no SecDescCallback is set
+    void LoadSecurityDescriptors(bool bLoad) { m_bLoadSecurityDescriptors = bLoad; }
+
+    // Security descriptors indexed by security ID: null until $Secure was walked
+    const std::shared_ptr<SecurityDescriptorTable>& GetSecurityDescriptors() const { return m_pSecurityDescriptors; }
+
     ULONG GetMFTRecordCount() const;
     HRESULT Statistics(const WCHAR* szMsg);
 
     ~MFTWalker();
 
 private:
-    HeapStorage m_SegmentStore;
+    SpillStorage m_SegmentStore;
     size_t m_CellStoreLastWalk = 0L;
     size_t m_CellStoreThreshold = 50 * 1024;
 
-    std::unordered_map<MFTUtils::SafeMFTSegmentNumber, MFTRecord*> m_MFTMap;
+    // Segment numbers are dense: a flat table avoids a node allocation for each of the millions of records
+    FlatHashMap<MFTUtils::SafeMFTSegmentNumber, MFTRecord*> m_MFTMap;
 
+    // Directory name: its parent and its name, which is kept in m_DirectoryNameArena
     class MFTFileNameWrapper
     {
     public:
-        PFILE_NAME m_pFileName;
+        MFT_SEGMENT_REFERENCE m_ParentDirectory;
+        std::wstring_view m_Name;
         boost::logic::tribool m_InLocation;
 
-        MFTFileNameWrapper(const MFTFileNameWrapper& pFileName)
-            : m_InLocation(boost::indeterminate)
-        {
-            if (pFileName.m_pFileName != nullptr)
-                throw std::exception("Invalid MFTFileNameWrapper construction");
-            m_pFileName = nullptr;
-        };
-        MFTFileNameWrapper(const PFILE_NAME pFileName);
-        MFTFileNameWrapper(MFTFileNameWrapper&& Other) noexcept
-        {
-            m_pFileName = Other.m_pFileName;
-            Other.m_pFileName = nullptr;
-            m_InLocation = Other.m_InLocation;
-        }
-        ~MFTFileNameWrapper() { free(m_pFileName); };
-
-        PFILE_NAME FileName() const { return m_pFileName; };
+        // Full path of the directory with a trailing backslash, set once all its ancestors are known. The segments are
+        // already kept by m_ParentDirectory and m_Name: the built path makes the name of each file one lookup and one
+        // append instead of a climb to the root. Its memory is bounded by the path cache limit (see TrimPathCache)
+        std::shared_ptr<const std::wstring> m_Path;
+
+        MFTFileNameWrapper(const PFILE_NAME pFileName, StringArena& arena);
+
+        const MFT_SEGMENT_REFERENCE& ParentDirectory() const { return m_ParentDirectory; };
+        std::wstring_view Name() const { return m_Name; };
     };
 
-    std::unordered_map<MFTUtils::SafeMFTSegmentNumber, MFTFileNameWrapper> m_DirectoryNames;
+    using DirectoryNames = FlatHashMap<MFTUtils::SafeMFTSegmentNumber, MFTFileNameWrapper>;
+    DirectoryNames m_DirectoryNames;
+    StringArena m_DirectoryNameArena;
+    std::vector<DirectoryNames::iterator> m_DirectoryChain;
+
+    ULONGLONG m_ullMemoryLimit = 0LL;
+
+    // Cached paths are dropped oldest first when they exceed their share of the memory limit, down to half of it so
+    // that a miss does not evict again right away
+    ULONGLONG m_ullPathCacheSize = 0LL;
+    ULONGLONG m_ullPathCacheLimit = 0LL;
+    std::deque<MFTUtils::SafeMFTSegmentNumber> m_PathCacheOrder;
+    static ULONGLONG PathCacheEntrySize(const std::wstring& path);
+    void TrimPathCache();
+
     std::unordered_set<std::wstring, CaseInsensitiveUnordered> m_Locations;
 
     ResurrectRecordsMode m_resurrectRecordMode = ResurrectRecordsMode::kNo;
@@ -187,7 +214,6 @@ private:
     WCHAR* m_pFullNameBuffer = nullptr;
     DWORD m_dwFullNameBufferLen = 0LU;
 
-    std::vector<std::wstring_view> m_currentFileNameElements;
     std::wstring m_currentFileName;
 
     HRESULT ExtendNameBuffer(WCHAR** pCurrent);
@@ -210,9 +236,40 @@ private:
 
     HRESULT ParseI30AndCallback(MFTRecord* pRecord);
 
+    // Batched $I30 pass: $INDEX_ALLOCATION blocks of the walked directories are collected, then read in physical
+    // order with coalesced reads and parsed concurrently. Directories stay alive until their blocks are reported.
+    struct I30Block
+    {
+        MFTRecord* pRecord;
+        ULONGLONG ullDiskOffset;
+        ULONG ulSize;
+        ULONG ulSizePerIndex;
+        bool bInUse;
+    };
+
+    std::vector<I30Block> m_I30Blocks;
+    ULONGLONG m_ullI30BatchSize = 0LL;
+
+    // Directories with queued blocks, mapped to whether they should be freed once their blocks are reported
+    std::unordered_map<MFTRecord*, bool> m_I30Directories;
+
+    HRESULT QueueI30Blocks(
+        MFTRecord* pRecord,
+        const std::shared_ptr<IndexRootAttribute>& pIR,
+        const std::shared_ptr<IndexAllocationAttribute>& pIA,
+        const std::shared_ptr<BitmapAttribute>& pBM);
+    bool DeferFreeUntilI30Flushed(MFTRecord* pRecord);
+    HRESULT FlushI30Blocks(bool bOnlyIfFull);
+
+    bool m_bLoadSecurityDescriptors = false;
+    std::shared_ptr<SecurityDescriptorTable> m_pSecurityDescriptors;
+
     HRESULT Parse$SecureAndCallback(MFTRecord* pRecord);
 
     bool IsInLocation(PFILE_NAME pFileName);
+    bool IsPathInLocation(const std::wstring& path) const;
+
+    const std::wstring* GetDirectoryPath(DirectoryNames::iterator directory, std::wstring& incompletePath);
 
     const WCHAR* GetFullNameAndIfInLocation(
         PFILE_NAME pFileName,
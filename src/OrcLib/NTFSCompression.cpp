@@ -268,15 +268,49 @@ HRESULT Orc::ntfs_uncompress_compunit(NTFS_COMP_INFO* comp)
     return S_OK;
 }
 
-#undef le16_to_cpup
-/* the standard le16_to_cpup() crashes for unaligned data on some processors */
-#define le16_to_cpup(p) (*(uint8_t*)(p) + (((uint8_t*)(p))[1] << 8))
-
 /* Compression sub-block constants. */
 constexpr auto NTFS_SB_SIZE_MASK = 0x0fff;
 constexpr auto NTFS_SB_SIZE = 0x1000;
 constexpr auto NTFS_SB_IS_COMPRESSED = 0x8000;
 
+namespace {
+
+/* read unaligned little endian 16 bits values */
+inline uint16_t le16_to_cpup(const uint8_t* p)
+{
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+/*
+ * Expand a match of 'length' bytes located 'offset' bytes behind 'dest'.
+ *
+ * When the match does not overlap by less than 8 bytes it is copied 8 bytes at a time: the last copy can write up to
+ * 7 bytes past the match, the caller must guarantee that 'dest + length + 7' is still in the current sub-block (those
+ * bytes are overwritten by the next tokens or zeroed when the sub-block is completed).
+ */
+inline void copy_match(uint8_t* dest, size_t offset, size_t length, bool wide)
+{
+    const uint8_t* src = dest - offset;
+    if (wide && offset >= sizeof(uint64_t))
+    {
+        uint8_t* const end = dest + length;
+        do
+        {
+            uint64_t chunk;
+            memcpy(&chunk, src, sizeof(chunk));
+            memcpy(dest, &chunk, sizeof(chunk));
+            src += sizeof(chunk);
+            dest += sizeof(chunk);
+        } while (dest < end);
+        return;
+    }
+
+    while (length--)
+        *dest++ = *src++;
+}
+
+}  // namespace
+
 /**
  * ntfs_decompress - decompress a compression block into an array of pages
  * @dest:	buffer to which to write the decompressed data
@@ -290,180 +324,111 @@ constexpr auto NTFS_SB_IS_COMPRESSED = 0x8000;
  * @cb_start is a pointer to the compression block which needs decompressing
  * and @cb_size is the size of @cb_start in bytes (8-64kiB).
  *
- * Return 0 if success or -EOVERFLOW on error in the compressed stream.
+ * Derived from NTFS-3G: every write is checked against the current sub-block, eight literals tags are copied at
+ * once and matches are expanded with 8 bytes copies when the output has enough room.
+ *
+ * Return S_OK if success or E_FAIL on error in the compressed stream.
  */
 HRESULT Orc::ntfs_decompress(uint8_t* dest, const size_t dest_size, uint8_t* const cb_start, const size_t cb_size)
 {
-    /*
-     * Pointers into the compressed data, i.e. the compression block (cb),
-     * and the therein contained sub-blocks (sb).
-     */
-    uint8_t* cb_end = cb_start + cb_size; /* End of cb. */
-    uint8_t* cb = cb_start; /* Current position in cb. */
-    uint8_t* cb_sb_start = cb; /* Beginning of the current sb in the cb. */
-    uint8_t* cb_sb_end = 0;
-
-    /* Variables for uncompressed data / destination. */
-    uint8_t* dest_end = dest + dest_size; /* End of dest buffer. */
-
-    /* Variables for tag and token parsing. */
-    uint8_t tag; /* Current tag. */
-    int token; /* Loop counter for the eight tokens in tag. */
-
-    Log::Trace("Entering, cb_size = {:#x}", cb_size);
+    const uint8_t* cb = cb_start; /* Current position in cb. */
+    const uint8_t* const cb_end = cb_start + cb_size; /* End of cb. */
+    uint8_t* const dest_end = dest + dest_size; /* End of dest buffer. */
 
-do_next_sb:
-    Log::Trace("Beginning sub-block at offset {} in the cb", (int)(cb - cb_start));
     /*
      * Have we reached the end of the compression block or the end of the
-     * decompressed data?  The latter can happen for example if the current
-     * position in the compression block is one byte before its end so the
-     * first two checks do not detect it.
+     * decompressed data?
      */
-    if (cb == cb_end || !le16_to_cpup((uint16_t*)cb) || dest == dest_end)
+    while (cb + 2 <= cb_end && dest < dest_end)
     {
-        Log::Trace("Completed. Returning success (0)");
-        return S_OK;
-    }
-    /* Setup offset for the current sub-block destination. */
-    uint8_t* dest_sb_start = dest; /* Start of current sub-block in dest. */
-    uint8_t* dest_sb_end = dest + NTFS_SB_SIZE; /* End of current sb in dest. */
-    /* Check that we are still within allowed boundaries. */
-    if (dest_sb_end > dest_end)
-        goto return_overflow;
-    /* Does the minimum size of a compressed sb overflow valid range? */
-    if (cb + 6 > cb_end)
-        goto return_overflow;
-    /* Setup the current sub-block source pointers and validate range. */
-    cb_sb_start = cb;
-    cb_sb_end = cb_sb_start + (le16_to_cpup((uint16_t*)cb) & NTFS_SB_SIZE_MASK)
-        + 3; /* End of current sb / beginning of next sb. */
-    if (cb_sb_end > cb_end)
-        goto return_overflow;
-    /* Now, we are ready to process the current sub-block (sb). */
-    if (!(le16_to_cpup((uint16_t*)cb) & NTFS_SB_IS_COMPRESSED))
-    {
-        Log::Trace("Found uncompressed sub-block");
-        /* This sb is not compressed, just copy it into destination. */
-        /* Advance source position to first data byte. */
-        cb += 2;
-        /* An uncompressed sb must be full size. */
-        if (cb_sb_end - cb != NTFS_SB_SIZE)
+        const uint16_t sb_header = le16_to_cpup(cb);
+        if (sb_header == 0)
+            break;
+
+        /* Setup and validate the current sub-block source and destination ranges. */
+        const uint8_t* const cb_sb_end = cb + (sb_header & NTFS_SB_SIZE_MASK) + 3;
+        uint8_t* const dest_sb_start = dest;
+        uint8_t* const dest_sb_end = dest + NTFS_SB_SIZE;
+        if (cb_sb_end > cb_end || dest_sb_end > dest_end)
             goto return_overflow;
-        /* Copy the block and advance the source position. */
-        memcpy(dest, cb, NTFS_SB_SIZE);
-        cb += NTFS_SB_SIZE;
-        /* Advance destination position to next sub-block. */
-        dest += NTFS_SB_SIZE;
-        goto do_next_sb;
-    }
-    Log::Trace("Found compressed sub-block");
-    /* This sb is compressed, decompress it into destination. */
-    /* Forward to the first tag in the sub-block. */
-    cb += 2;
-do_next_tag:
-    if (cb == cb_sb_end)
-    {
-        /* Check if the decompressed sub-block was not full-length. */
-        if (dest < dest_sb_end)
-        {
-            int nr_bytes = (int)(dest_sb_end - dest);
 
-            Log::Trace("Filling incomplete sub-block with zeroes");
-            /* Zero remainder and update destination position. */
-            memset(dest, 0, nr_bytes);
-            dest += nr_bytes;
-        }
-        /* We have finished the current sub-block. */
-        goto do_next_sb;
-    }
-    /* Check we are still in range. */
-    if (cb > cb_sb_end || dest > dest_sb_end)
-        goto return_overflow;
-    /* Get the next tag and advance to first token. */
-    tag = *cb++;
-    /* Parse the eight tokens described by the tag. */
-    for (token = 0; token < 8; token++, tag >>= 1)
-    {
-        uint16_t lg, pt, length, max_non_overlap;
-        uint16_t i;
-        uint8_t* dest_back_addr;
+        cb += 2;
 
-        /* Check if we are done / still in range. */
-        if (cb >= cb_sb_end || dest > dest_sb_end)
-            break;
-        /* Determine token type and parse appropriately.*/
-        if ((tag & NTFS_TOKEN_MASK) == NTFS_SYMBOL_TOKEN)
+        if (!(sb_header & NTFS_SB_IS_COMPRESSED))
         {
-            /*
-             * We have a symbol token, copy the symbol across, and
-             * advance the source and destination positions.
-             */
-            *dest++ = *cb++;
-            /* Continue with the next token. */
+            /* This sb is not compressed, it must be full size: just copy it into destination. */
+            if (cb_sb_end - cb != NTFS_SB_SIZE)
+                goto return_overflow;
+
+            memcpy(dest, cb, NTFS_SB_SIZE);
+            cb += NTFS_SB_SIZE;
+            dest += NTFS_SB_SIZE;
             continue;
         }
+
         /*
-         * We have a phrase token. Make sure it is not the first tag in
-         * the sb as this is illegal and would confuse the code below.
-         */
-        if (dest == dest_sb_start)
-            goto return_overflow;
-        /*
-         * Determine the number of bytes to go back (p) and the number
-         * of bytes to copy (l). We use an optimized algorithm in which
-         * we first calculate log2(current destination position in sb),
-         * which allows determination of l and p in O(1) rather than
-         * O(n). We just need an arch-optimized log2() function now.
-         */
-        lg = 0;
-        for (i = (uint16_t)(dest - dest_sb_start - 1); i >= 0x10; i >>= 1)
-            lg++;
-        /* Get the phrase token into i. */
-        pt = le16_to_cpup((uint16_t*)cb);
-        /*
-         * Calculate starting position of the byte sequence in
-         * the destination using the fact that p = (pt >> (12 - lg)) + 1
-         * and make sure we don't go too far back.
+         * Number of bits of a phrase token used by the back offset minus 4. It grows with the position in the
+         * sub-block, which only increases, so it is updated incrementally instead of computing log2 for each token.
          */
-        dest_back_addr = dest - (pt >> (12 - lg)) - 1;
-        if (dest_back_addr < dest_sb_start)
-            goto return_overflow;
-        /* Now calculate the length of the byte sequence. */
-        length = (pt & (0xfff >> lg)) + 3;
-        /* Verify destination is in range. */
-        if (dest + length > dest_sb_end)
-            goto return_overflow;
-        /* The number of non-overlapping bytes. */
-        max_non_overlap = (uint16_t)(dest - dest_back_addr);
-        if (length <= max_non_overlap)
+        unsigned int lg = 0;
+
+        while (cb < cb_sb_end)
         {
-            /* The byte sequence doesn't overlap, just copy it. */
-            memcpy(dest, dest_back_addr, length);
-            /* Advance destination pointer. */
-            dest += length;
+            uint8_t tag = *cb++;
+
+            /* Fast path: eight symbol tokens. */
+            if (tag == 0 && cb_sb_end - cb >= 8 && dest_sb_end - dest >= 8)
+            {
+                memcpy(dest, cb, 8);
+                cb += 8;
+                dest += 8;
+                continue;
+            }
+
+            for (int token = 0; token < 8 && cb < cb_sb_end; token++, tag >>= 1)
+            {
+                if ((tag & NTFS_TOKEN_MASK) == NTFS_SYMBOL_TOKEN)
+                {
+                    if (dest == dest_sb_end)
+                        goto return_overflow;
+
+                    *dest++ = *cb++;
+                    continue;
+                }
+
+                /* A phrase token cannot be the first token of a sub-block and is two bytes long. */
+                const size_t position = dest - dest_sb_start;
+                if (position == 0 || cb_sb_end - cb < 2)
+                    goto return_overflow;
+
+                while ((position - 1) >= (size_t(0x10) << lg))
+                    lg++;
+
+                const uint16_t pt = le16_to_cpup(cb);
+                cb += 2;
+
+                const size_t offset = (pt >> (12 - lg)) + 1;
+                const size_t length = (pt & (0xfff >> lg)) + 3;
+                const size_t room = dest_sb_end - dest;
+                if (offset > position || length > room)
+                    goto return_overflow;
+
+                copy_match(dest, offset, length, length + 7 <= room);
+                dest += length;
+            }
         }
-        else
+
+        /* Zero the remainder of an incomplete sub-block, including any byte written past the last match. */
+        if (dest < dest_sb_end)
         {
-            /*
-             * The byte sequence does overlap, copy non-overlapping
-             * part and then do a slow byte by byte copy for the
-             * overlapping part. Also, advance the destination
-             * pointer.
-             */
-            memcpy(dest, dest_back_addr, max_non_overlap);
-            dest += max_non_overlap;
-            dest_back_addr += max_non_overlap;
-            length -= max_non_overlap;
-            while (length--)
-                *dest++ = *dest_back_addr++;
+            memset(dest, 0, dest_sb_end - dest);
+            dest = dest_sb_end;
         }
-        /* Advance source position and continue with the next token. */
-        cb += 2;
     }
-    /* No tokens left in the current tag. Continue with the next tag. */
-    goto do_next_tag;
+
+    return S_OK;
+
 return_overflow:
-    Log::Error(L"Failed to decompress file");
+    Log::Debug(L"ntfs_decompress: invalid compressed data at offset {}", cb - cb_start);
     return E_FAIL;
 }
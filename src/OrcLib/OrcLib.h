@@ -169,6 +169,8 @@ class ArchiveMessage;
 class ArchiveNotification;
 
 // In&Out/ByteStream/CryptoStream
+class AeadEncryptStream;
+class AeadDecryptStream;
 class CryptoHashStream;
 class FuzzyHashStream;
 class HashStream;
@@ -98,6 +98,9 @@ public:
     LPCWSTR szSeparator = L",";
     LPCWSTR szQuote = L"\"";
 
+    // Buffers of CSV, JSON and XML files written in background by an I/O thread, 0 writes from the caller thread
+    DWORD dwAsyncBufferCount = 0;
+
     OutputSpec() noexcept = default;
     OutputSpec(OutputSpec&&) noexcept = default;
     OutputSpec(const OutputSpec&) = default;
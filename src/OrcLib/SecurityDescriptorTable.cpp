@@ -0,0 +1,225 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+
+#include "stdafx.h"
+
+#include "SecurityDescriptorTable.h"
+
+#include "ByteStream.h"
+
+using namespace Orc;
+
+namespace {
+
+constexpr ULONG kHeaderSize = offsetof(SECURITY_DESCRIPTOR_ENTRY, SecurityDescriptor);
+constexpr ULONG kEntryAlignment = 16;
+constexpr DWORD kMaxNameLength = 512;
+
+constexpr size_t AlignEntry(size_t size)
+{
+    return (size + kEntryAlignment - 1) & ~static_cast<size_t>(kEntryAlignment - 1);
+}
+
+bool IsValidEntry(const SECURITY_DESCRIPTOR_ENTRY& entry, ULONGLONG ullOffset, ULONG ulAvailable)
+{
+    if (entry.SizeEntry < kHeaderSize + sizeof(SECURITY_DESCRIPTOR_RELATIVE) || entry.SizeEntry > ulAvailable)
+        return false;
+
+    if (entry.OffsetEntry != ullOffset)
+        return false;
+
+    if (entry.SecurityDescriptor.Revision != SECURITY_DESCRIPTOR_REVISION
+        || !(entry.SecurityDescriptor.Control & SE_SELF_RELATIVE))
+        return false;
+
+    const auto pDescriptor = reinterpret_cast<const BYTE*>(&entry.SecurityDescriptor);
+    return entry.Hash == SecurityDescriptorTable::Hash(pDescriptor, entry.SizeEntry - kHeaderSize);
+}
+
+std::wstring LookupOwnerName(PSID pSid, const std::wstring& sid)
+{
+    WCHAR szName[kMaxNameLength];
+    DWORD dwNameLength = kMaxNameLength;
+    WCHAR szDomain[kMaxNameLength];
+    DWORD dwDomainLength = kMaxNameLength;
+    SID_NAME_USE nameUse;
+
+    if (!LookupAccountSidW(NULL, pSid, szName, &dwNameLength, szDomain, &dwDomainLength, &nameUse))
+    {
+        const auto dwError = GetLastError();
+        if (dwError == ERROR_NONE_MAPPED)
+            return sid;
+
+        Log::Debug(L"Failed to lookup account of '{}' [{}]", sid, Win32Error(dwError));
+        return {};
+    }
+
+    return std::wstring(szDomain) + L"\\" + szName;
+}
+
+}  // namespace
+
+UINT32 SecurityDescriptorTable::Hash(const BYTE* pDescriptor, ULONG ulLength)
+{
+    UINT32 hash = 0;
+    for (ULONG i = 0; i + sizeof(UINT32) <= ulLength; i += sizeof(UINT32))
+    {
+        UINT32 value;
+        memcpy(&value, pDescriptor + i, sizeof(value));
+        hash = value + ((hash << 3) | (hash >> 29));
+    }
+    return hash;
+}
+
+HRESULT SecurityDescriptorTable::Load(const std::shared_ptr<ByteStream>& pSDSStream)
+{
+    HRESULT hr = E_FAIL;
+
+    if (pSDSStream == nullptr)
+        return E_POINTER;
+
+    m_entries.clear();
+    m_index.clear();
+    m_securityIds.clear();
+    m_owners.clear();
+
+    if (FAILED(hr = pSDSStream->SetFilePointer(0LL, FILE_BEGIN, NULL)))
+        return hr;
+
+    // Only half of $SDS is kept, the other half is the mirror
+    m_entries.reserve(static_cast<size_t>(pSDSStream->GetSize() / 2));
+
+    std::vector<BYTE> buffer(kReadSize);
+    ULONGLONG ullOffset = 0LL;
+
+    for (;;)
+    {
+        // Entries never span blocks: a chunk of whole blocks is parsed on its own
+        ULONGLONG ullFilled = 0LL;
+        while (ullFilled < kReadSize)
+        {
+            ULONGLONG ullRead = 0LL;
+            if (FAILED(hr = pSDSStream->Read(buffer.data() + ullFilled, kReadSize - ullFilled, &ullRead)))
+            {
+                Log::Error("Failed to read $SDS at offset {:#x} [{}]", ullOffset + ullFilled, SystemError(hr));
+                return hr;
+            }
+
+            if (ullRead == 0LL)
+                break;
+
+            ullFilled += ullRead;
+        }
+
+        for (ULONGLONG ullBlock = 0LL; ullBlock < ullFilled; ullBlock += kBlockSize)
+        {
+            // Odd blocks mirror the previous one
+            if (((ullOffset + ullBlock) / kBlockSize) % 2)
+                continue;
+
+            const auto ulBlockSize = static_cast<ULONG>((std::min)(ULONGLONG(kBlockSize), ullFilled - ullBlock));
+            AddBlock(buffer.data() + ullBlock, ulBlockSize, ullOffset + ullBlock);
+        }
+
+        ullOffset += ullFilled;
+        if (ullFilled < kReadSize)
+            break;
+    }
+
+    std::sort(std::begin(m_securityIds), std::end(m_securityIds));
+
+    Log::Debug("Loaded {} security descriptors from $SDS ({} bytes)", m_securityIds.size(), ullOffset);
+    return S_OK;
+}
+
+void SecurityDescriptorTable::AddBlock(const BYTE* pBlock, ULONG ulBlockSize, ULONGLONG ullBlockOffset)
+{
+    ULONG ulOffset = 0L;
+
+    while (ulOffset + kHeaderSize <= ulBlockSize)
+    {
+        const auto& entry = *reinterpret_cast<const SECURITY_DESCRIPTOR_ENTRY*>(pBlock + ulOffset);
+
+        if (!IsValidEntry(entry, ullBlockOffset + ulOffset, ulBlockSize - ulOffset))
+        {
+            ulOffset += kEntryAlignment;
+            continue;
+        }
+
+        if (m_index.find(entry.SecID) == m_index.cend())
+        {
+            const auto position = m_entries.size();
+            m_entries.insert(std::end(m_entries), pBlock + ulOffset, pBlock + ulOffset + entry.SizeEntry);
+            m_entries.resize(AlignEntry(m_entries.size()));
+
+            m_index.insert({entry.SecID, position});
+            m_securityIds.push_back(entry.SecID);
+        }
+
+        ulOffset += static_cast<ULONG>(AlignEntry(entry.SizeEntry));
+    }
+}
+
+const SECURITY_DESCRIPTOR_ENTRY* SecurityDescriptorTable::Find(UINT32 securityId) const
+{
+    const auto it = m_index.find(securityId);
+    if (it == m_index.cend())
+        return nullptr;
+
+    return reinterpret_cast<const SECURITY_DESCRIPTOR_ENTRY*>(m_entries.data() + it->second);
+}
+
+void SecurityDescriptorTable::ForEach(const std::function<void(const SECURITY_DESCRIPTOR_ENTRY& entry)>& callback) const
+{
+    for (const auto securityId : m_securityIds)
+    {
+        callback(*Find(securityId));
+    }
+}
+
+const SecurityDescriptorTable::Owner* SecurityDescriptorTable::GetOwner(UINT32 securityId)
+{
+    const auto [it, bInserted] = m_owners.try_emplace(securityId);
+    if (!bInserted)
+        return it->second.get();
+
+    const auto pEntry = Find(securityId);
+    if (pEntry == nullptr)
+        return nullptr;
+
+    // Self relative descriptor: the owner is an offset from the start of the descriptor
+    const auto& descriptor = pEntry->SecurityDescriptor;
+    const ULONG ulLength = pEntry->SizeEntry - kHeaderSize;
+    if (descriptor.Owner == 0 || descriptor.Owner + SECURITY_MIN_SID_SIZE > ulLength)
+        return nullptr;
+
+    const auto pDescriptor = const_cast<BYTE*>(reinterpret_cast<const BYTE*>(&descriptor));
+    const auto pSid = reinterpret_cast<PSID>(pDescriptor + descriptor.Owner);
+    if (!IsValidSid(pSid) || descriptor.Owner + GetLengthSid(pSid) > ulLength)
+        return nullptr;
+
+    LPWSTR szSid = nullptr;
+    if (!ConvertSidToStringSidW(pSid, &szSid))
+    {
+        Log::Debug("Failed to convert owner of security ID {} [{}]", securityId, LastWin32Error());
+        return nullptr;
+    }
+
+    auto owner = std::make_unique<Owner>();
+    owner->Sid = szSid;
+    LocalFree(szSid);
+
+    // Many descriptors share an owner: the account lookup is done once per SID
+    auto [name, bNewSid] = m_names.try_emplace(owner->Sid);
+    if (bNewSid)
+        name->second = ::LookupOwnerName(pSid, owner->Sid);
+    owner->Name = name->second;
+
+    it->second = std::move(owner);
+    return it->second.get();
+}
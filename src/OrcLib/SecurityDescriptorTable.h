@@ -0,0 +1,75 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#pragma once
+
+#include "NtfsDataStructures.h"
+#include "Utils/FlatHashMap.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#pragma managed(push, off)
+
+namespace Orc {
+
+class ByteStream;
+
+//
+// Security descriptors of a volume, indexed by security ID.
+//
+// $SDS is read once with large sequential reads: each 256KiB block is followed by its mirror which is skipped, and
+// each security ID is stored once. Entries are checked against their offset and hash so stale data left in the blocks
+// is not reported.
+//
+// Owner SID and account name are resolved once per security ID (and account names once per SID): owner columns of a
+// walk cost a lookup per row. Owner resolution is not thread safe.
+//
+class SecurityDescriptorTable
+{
+public:
+    static constexpr ULONG kBlockSize = 0x40000;
+    static constexpr ULONG kReadSize = 0x400000;
+
+    struct Owner
+    {
+        std::wstring Sid;
+        std::wstring Name;  // empty when the SID could not be looked up
+    };
+
+    HRESULT Load(const std::shared_ptr<ByteStream>& pSDSStream);
+
+    size_t Count() const { return m_index.size(); }
+
+    const SECURITY_DESCRIPTOR_ENTRY* Find(UINT32 securityId) const;
+
+    // Entries in security ID order
+    void ForEach(const std::function<void(const SECURITY_DESCRIPTOR_ENTRY& entry)>& callback) const;
+
+    // Returns nullptr if the security ID is unknown or its descriptor has no valid owner
+    const Owner* GetOwner(UINT32 securityId);
+
+    static UINT32 Hash(const BYTE* pDescriptor, ULONG ulLength);
+
+private:
+    void AddBlock(const BYTE* pBlock, ULONG ulBlockSize, ULONGLONG ullBlockOffset);
+
+    // Entries are copied with their header, aligned like in $SDS
+    std::vector<BYTE> m_entries;
+    FlatHashMap<UINT32, size_t> m_index;
+    std::vector<UINT32> m_securityIds;
+
+    std::unordered_map<UINT32, std::unique_ptr<Owner>> m_owners;
+    std::unordered_map<std::wstring, std::wstring> m_names;
+};
+
+}  // namespace Orc
+
+#pragma managed(pop)
@@ -0,0 +1,171 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include "SpillStorage.h"
+
+#include "Temporary.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+using namespace Orc;
+
+HRESULT SpillStorage::InitializeStore(const DWORD dwElementSize, ULONGLONG ullMaxHeapSize)
+{
+    HRESULT hr = E_FAIL;
+
+    if (dwElementSize == 0L || dwElementSize > kViewSize)
+        return E_INVALIDARG;
+
+    if (FAILED(hr = m_Heap.InitializeStore(0L, dwElementSize)))
+        return hr;
+
+    m_dwElementSize = dwElementSize;
+    m_MaxHeapCells = ullMaxHeapSize ? static_cast<size_t>((std::max)(ullMaxHeapSize / dwElementSize, 1ULL)) : 0;
+    return S_OK;
+}
+
+LPVOID SpillStorage::GetNewCell()
+{
+    if (m_MaxHeapCells == 0 || m_NumberOfHeapCells < m_MaxHeapCells)
+    {
+        const auto cell = m_Heap.GetNewCell();
+        if (cell)
+            m_NumberOfHeapCells++;
+
+        return cell;
+    }
+
+    LPVOID cell = nullptr;
+    if (!m_FreeSpilledCells.empty())
+    {
+        cell = m_FreeSpilledCells.back();
+        m_FreeSpilledCells.pop_back();
+        ZeroMemory(cell, m_dwElementSize);
+    }
+    else
+    {
+        if (m_Views.empty() || m_dwNextCellInView == kViewSize / m_dwElementSize)
+        {
+            if (FAILED(MapNextView()))
+                return nullptr;
+        }
+
+        // Fresh file pages are zeroed
+        cell = m_Views.back().Data.get() + static_cast<size_t>(m_dwNextCellInView) * m_dwElementSize;
+        m_dwNextCellInView++;
+    }
+
+    m_NumberOfSpilledCells++;
+    return cell;
+}
+
+void SpillStorage::FreeCell(LPVOID cell)
+{
+    if (cell == nullptr)
+        return;
+
+    if (IsSpilled(cell))
+    {
+        m_FreeSpilledCells.push_back(cell);
+        m_NumberOfSpilledCells--;
+        return;
+    }
+
+    m_Heap.FreeCell(cell);
+    m_NumberOfHeapCells--;
+}
+
+HRESULT SpillStorage::MapNextView()
+{
+    HRESULT hr = E_FAIL;
+
+    if (!m_SpillFile.IsValid())
+    {
+        HANDLE hFile = INVALID_HANDLE_VALUE;
+        std::wstring strPath;
+        if (FAILED(
+                hr = UtilGetTempFile(
+                    &hFile, NULL, L".spill", strPath, NULL, 0L, FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE)))
+        {
+            Log::Error(L"Failed to create spill file for '{}' [{}]", m_szStoreDescription, SystemError(hr));
+            return hr;
+        }
+
+        m_SpillFile = Guard::FileHandle(hFile);
+        Log::Debug(L"Storage '{}' exceeds its memory budget, spilling to '{}'", m_szStoreDescription, strPath);
+    }
+    else
+    {
+        // The filled view is released from the working set: its pages are still backed by the file
+        auto& filled = m_Views.back();
+        static_cast<void>(VirtualUnlock(filled.Data.get(), kViewSize));
+    }
+
+    ULARGE_INTEGER ullViewOffset;
+    ullViewOffset.QuadPart = static_cast<ULONGLONG>(m_Views.size()) * kViewSize;
+
+    ULARGE_INTEGER ullFileSize;
+    ullFileSize.QuadPart = ullViewOffset.QuadPart + kViewSize;
+
+    View view;
+    view.Mapping = Guard::Handle(
+        CreateFileMappingW(*m_SpillFile, NULL, PAGE_READWRITE, ullFileSize.HighPart, ullFileSize.LowPart, NULL));
+    if (!view.Mapping.IsValid())
+    {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+        Log::Error(L"Failed to extend spill file of '{}' [{}]", m_szStoreDescription, SystemError(hr));
+        return hr;
+    }
+
+    view.Data = Guard::ViewOfFile<BYTE>(static_cast<BYTE*>(MapViewOfFile(
+        *view.Mapping, FILE_MAP_READ | FILE_MAP_WRITE, ullViewOffset.HighPart, ullViewOffset.LowPart, kViewSize)));
+    if (!view.Data)
+    {
+        hr = HRESULT_FROM_WIN32(GetLastError());
+        Log::Error(L"Failed to map spill file of '{}' [{}]", m_szStoreDescription, SystemError(hr));
+        return hr;
+    }
+
+    m_Views.push_back(std::move(view));
+    m_dwNextCellInView = 0L;
+    return S_OK;
+}
+
+bool SpillStorage::IsSpilled(LPVOID cell) const
+{
+    const auto pCell = static_cast<const BYTE*>(cell);
+    return std::any_of(std::cbegin(m_Views), std::cend(m_Views), [pCell](const View& view) {
+        return pCell >= view.Data.get() && pCell < view.Data.get() + kViewSize;
+    });
+}
+
+HRESULT SpillStorage::EnumCells(std::function<void(void* lpData)> pCallback)
+{
+    HRESULT hr = E_FAIL;
+
+    if (FAILED(hr = m_Heap.EnumCells(pCallback)))
+        return hr;
+
+    const std::unordered_set<LPVOID> freeCells(std::cbegin(m_FreeSpilledCells), std::cend(m_FreeSpilledCells));
+    const DWORD dwCellsPerView = kViewSize / m_dwElementSize;
+
+    for (size_t i = 0; i < m_Views.size(); ++i)
+    {
+        const DWORD dwCells = i + 1 == m_Views.size() ? m_dwNextCellInView : dwCellsPerView;
+        for (DWORD j = 0; j < dwCells; ++j)
+        {
+            const auto cell = m_Views[i].Data.get() + static_cast<size_t>(j) * m_dwElementSize;
+            if (freeCells.find(cell) == std::cend(freeCells))
+                pCallback(cell);
+        }
+    }
+
+    return S_OK;
+}
@@ -0,0 +1,73 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#pragma once
+
+#include "HeapStorage.h"
+#include "Utils/Guard.h"
+
+#include <functional>
+#include <vector>
+
+#pragma managed(push, off)
+
+namespace Orc {
+
+//
+// Storage of fixed size cells, like HeapStorage, with a memory budget.
+//
+// Cells come from a private heap until 'ullMaxHeapSize' bytes are allocated, then from views of a temporary file
+// deleted on close. Mapped pages are backed by that file instead of the paging file: once a view is filled, it is
+// released from the working set and its pages are read back on access. Cells never move.
+//
+class SpillStorage
+{
+public:
+    static constexpr DWORD kViewSize = 0x4000000;
+
+    SpillStorage(const LPCWSTR szDescription)
+        : m_Heap(szDescription)
+        , m_szStoreDescription(szDescription) {};
+
+    // A null 'ullMaxHeapSize' keeps every cell in the heap
+    HRESULT InitializeStore(const DWORD dwElementSize, ULONGLONG ullMaxHeapSize = 0LL);
+
+    size_t AllocatedCells() const { return m_NumberOfHeapCells + m_NumberOfSpilledCells; }
+    size_t SpilledCells() const { return m_NumberOfSpilledCells; }
+
+    LPVOID GetNewCell();
+    void FreeCell(LPVOID cell);
+
+    HRESULT EnumCells(std::function<void(void* lpData)> pCallback);
+
+private:
+    struct View
+    {
+        Guard::Handle Mapping;
+        Guard::ViewOfFile<BYTE> Data;
+    };
+
+    HRESULT MapNextView();
+    bool IsSpilled(LPVOID cell) const;
+
+    HeapStorage m_Heap;
+    const LPCWSTR m_szStoreDescription;
+
+    DWORD m_dwElementSize = 0L;
+    size_t m_MaxHeapCells = 0;
+    size_t m_NumberOfHeapCells = 0;
+    size_t m_NumberOfSpilledCells = 0;
+
+    Guard::FileHandle m_SpillFile;
+    std::vector<View> m_Views;
+    DWORD m_dwNextCellInView = 0L;
+    std::vector<LPVOID> m_FreeSpilledCells;
+};
+
+}  // namespace Orc
+
+#pragma managed(pop)
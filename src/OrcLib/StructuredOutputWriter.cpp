@@ -61,22 +61,16 @@ HRESULT Orc::StructuredOutput::Writer::WriteAttributesBuffer(_Buffer& buffer, DW
 
 HRESULT Orc::StructuredOutput::Writer::WriteBuffer(_Buffer& buffer, FILETIME fileTime)
 {
-    HRESULT hr = E_FAIL;
-
-    // Convert the Create time to System time.
+    // Values rejected by FileTimeToSystemTime are written as an empty string
     SYSTEMTIME stUTC;
-    FileTimeToSystemTime(&fileTime, &stUTC);
+    if (!m_fileTimeEncoder.ToSystemTime(fileTime, stUTC))
+    {
+        buffer.assign(L"", 1);
+        return S_OK;
+    }
 
-    fmt::format_to(
-        std::back_inserter(buffer),
-        L"{:04}-{:02}-{:02} {:02}:{:02}:{:02}.{:03}"sv,
-        stUTC.wYear,
-        stUTC.wMonth,
-        stUTC.wDay,
-        stUTC.wHour,
-        stUTC.wMinute,
-        stUTC.wSecond,
-        stUTC.wMilliseconds);
+    WCHAR text[Text::kMaxTimeStampLength];
+    buffer.append(text, static_cast<ULONG>(Text::ToTimeStamp(stUTC, text)));
     return S_OK;
 }
 
@@ -243,6 +237,11 @@ StructuredOutput::Writer::GetWriter(const OutputSpec& outFile, std::unique_ptr<S
         Log::Error(L"Failed to open file '{}' for writing [{}]", outFile.Path, SystemError(hr));
         return nullptr;
     }
+
+    if (pOptions && outFile.dwAsyncBufferCount)
+    {
+        pOptions->dwAsyncBufferCount = outFile.dwAsyncBufferCount;
+    }
     return GetWriter(stream, outFile.Type, std::move(pOptions));
 }
 
@@ -271,6 +270,7 @@ std::shared_ptr<StructuredOutput::IWriter> StructuredOutput::Writer::GetWriter(
         Log::Error(L"Failed to configure output file for path '{}' [{}]", szOutputFile, SystemError(hr));
         return nullptr;
     }
+    fileSpec.dwAsyncBufferCount = outFile.dwAsyncBufferCount;
 
     return GetWriter(fileSpec, std::move(pOptions));
 }
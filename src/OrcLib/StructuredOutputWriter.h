@@ -11,6 +11,7 @@
 
 #include "StructuredOutput.h"
 #include "OutputSpec.h"
+#include "Text/FileTime.h"
 
 #include <Windows.h>
 #include <In6addr.h>
@@ -28,6 +29,7 @@ namespace StructuredOutput {
 struct Options : public Orc::OutputOptions
 {
     OutputSpec::Encoding Encoding = OutputSpec::Encoding::UTF8;
+    DWORD dwAsyncBufferCount = 0;  // Buffers written in background by an I/O thread, 0 writes from the caller thread
 };
 
 namespace JSON {
@@ -91,6 +93,7 @@ protected:
 
 protected:
     std::unique_ptr<Options> m_Options;
+    Text::FileTimeEncoder m_fileTimeEncoder;
 };
 
 }  // namespace StructuredOutput
@@ -57,6 +57,7 @@ std::shared_ptr<IWriter> Orc::TableOutput::GetWriter(const OutputSpec& out)
             options->bBOM = true;
             options->Delimiter = out.szSeparator;
             options->StringDelimiter = out.szQuote;
+            options->dwAsyncBufferCount = out.dwAsyncBufferCount;
 
             auto retval = CSV::Writer::MakeNew(std::move(options));
 
@@ -194,6 +195,7 @@ std::shared_ptr<IWriter> Orc::TableOutput::GetWriter(LPCWSTR szFileName, const O
 
     auto options = std::make_unique<TableOutput::CSV::Options>();
     options->Encoding = out.OutputEncoding;
+    options->dwAsyncBufferCount = out.dwAsyncBufferCount;
 
     auto retval = TableOutput::CSV::Writer::MakeNew(std::move(options));
 
@@ -66,6 +66,7 @@ struct Options : Orc::TableOutput::Options
 {
     OutputSpec::Encoding Encoding = OutputSpec::Encoding::UTF8;
     DWORD dwBufferSize = WRITE_BUFFER;
+    DWORD dwAsyncBufferCount = 0;  // Buffers written in background by an I/O thread, 0 writes from the caller thread
     bool bBOM = true;
     std::wstring Delimiter = L","s;
     std::wstring StringDelimiter = L"\""s;
@@ -0,0 +1,75 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+
+#include "Text/FileTime.h"
+
+namespace {
+
+constexpr ULONGLONG kTicksPerMillisecond = 10000ULL;
+constexpr ULONGLONG kMillisecondsPerDay = 24ULL * 3600ULL * 1000ULL;
+constexpr ULONGLONG kTicksPerDay = kMillisecondsPerDay * kTicksPerMillisecond;
+
+// Days from 0000-03-01 (proleptic gregorian) to 1601-01-01
+constexpr ULONGLONG kDaysTo1601 = 584694ULL;
+
+// 1601-01-01 was a monday
+constexpr ULONGLONG kDayOfWeek1601 = 1ULL;
+
+// Howard Hinnant's 'civil_from_days', with days counted from 0000-03-01 so that everything stays unsigned
+void CivilFromDays(ULONGLONG days, WORD& wYear, WORD& wMonth, WORD& wDay)
+{
+    const ULONGLONG era = days / 146097;
+    const ULONGLONG doe = days - era * 146097;  // [0, 146096]
+    const ULONGLONG yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;  // [0, 399]
+    const ULONGLONG doy = doe - (365 * yoe + yoe / 4 - yoe / 100);  // [0, 365]
+    const ULONGLONG mp = (5 * doy + 2) / 153;  // [0, 11], from march
+    const ULONGLONG month = mp < 10 ? mp + 3 : mp - 9;
+
+    wDay = static_cast<WORD>(doy - (153 * mp + 2) / 5 + 1);
+    wMonth = static_cast<WORD>(month);
+    wYear = static_cast<WORD>(yoe + era * 400 + (month <= 2 ? 1 : 0));
+}
+
+}  // namespace
+
+namespace Orc {
+namespace Text {
+
+bool FileTimeEncoder::ToSystemTime(ULONGLONG ullFileTime, SYSTEMTIME& st)
+{
+    if (ullFileTime > static_cast<ULONGLONG>((std::numeric_limits<LONGLONG>::max)()))
+    {
+        return false;
+    }
+
+    const ULONGLONG ullDay = ullFileTime / kTicksPerDay;
+    if (ullDay != m_ullDay)
+    {
+        CivilFromDays(ullDay + kDaysTo1601, m_wYear, m_wMonth, m_wDay);
+        m_wDayOfWeek = static_cast<WORD>((ullDay + kDayOfWeek1601) % 7);
+        m_ullDay = ullDay;
+    }
+
+    auto ullMilliseconds = (ullFileTime % kTicksPerDay) / kTicksPerMillisecond;
+
+    st.wYear = m_wYear;
+    st.wMonth = m_wMonth;
+    st.wDay = m_wDay;
+    st.wDayOfWeek = m_wDayOfWeek;
+
+    st.wMilliseconds = static_cast<WORD>(ullMilliseconds % 1000);
+    ullMilliseconds /= 1000;
+    st.wSecond = static_cast<WORD>(ullMilliseconds % 60);
+    ullMilliseconds /= 60;
+    st.wMinute = static_cast<WORD>(ullMilliseconds % 60);
+    st.wHour = static_cast<WORD>(ullMilliseconds / 60);
+    return true;
+}
+
+}  // namespace Text
+}  // namespace Orc
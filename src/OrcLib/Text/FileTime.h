@@ -0,0 +1,137 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+
+#pragma once
+
+#include <windows.h>
+
+#include <cstdint>
+#include <limits>
+
+namespace Orc {
+namespace Text {
+
+// Longest 'YYYY-MM-DD hh:mm:ss.mmm' text, FILETIME years go up to 30828
+constexpr size_t kMaxTimeStampLength = 24;
+
+// Longest 'YYYY-MM-DDThh:mm:ssZ' text
+constexpr size_t kMaxIso8601Length = 21;
+
+// Converts FILETIME to UTC SYSTEMTIME with integer arithmetic instead of FileTimeToSystemTime.
+//
+// Table writers convert several timestamps per row, mostly of the same few days: the date of the previous conversion
+// is kept and only the time of the day is computed when the next value falls on the same day.
+class FileTimeEncoder
+{
+public:
+    // Same result as FileTimeToSystemTime, which also rejects values above 0x7FFFFFFFFFFFFFFF
+    bool ToSystemTime(ULONGLONG ullFileTime, SYSTEMTIME& st);
+
+    bool ToSystemTime(const FILETIME& ft, SYSTEMTIME& st)
+    {
+        return ToSystemTime((static_cast<ULONGLONG>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime, st);
+    }
+
+private:
+    ULONGLONG m_ullDay = (std::numeric_limits<ULONGLONG>::max)();
+    WORD m_wYear = 0;
+    WORD m_wMonth = 0;
+    WORD m_wDay = 0;
+    WORD m_wDayOfWeek = 0;
+};
+
+namespace Details {
+
+constexpr char kDigitPairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+template <typename CharT>
+inline CharT* PutTwoDigits(CharT* out, unsigned value)
+{
+    out[0] = static_cast<CharT>(kDigitPairs[value * 2]);
+    out[1] = static_cast<CharT>(kDigitPairs[value * 2 + 1]);
+    return out + 2;
+}
+
+// At least four digits, as many as needed above 9999
+template <typename CharT>
+inline CharT* PutYear(CharT* out, unsigned year)
+{
+    if (year > 9999)
+    {
+        *out++ = static_cast<CharT>('0' + year / 10000);
+        year %= 10000;
+    }
+
+    out = PutTwoDigits(out, year / 100);
+    return PutTwoDigits(out, year % 100);
+}
+
+template <typename CharT>
+inline CharT* PutDate(CharT* out, const SYSTEMTIME& st)
+{
+    out = PutYear(out, st.wYear);
+    *out++ = static_cast<CharT>('-');
+    out = PutTwoDigits(out, st.wMonth);
+    *out++ = static_cast<CharT>('-');
+    return PutTwoDigits(out, st.wDay);
+}
+
+template <typename CharT>
+inline CharT* PutTime(CharT* out, const SYSTEMTIME& st)
+{
+    out = PutTwoDigits(out, st.wHour);
+    *out++ = static_cast<CharT>(':');
+    out = PutTwoDigits(out, st.wMinute);
+    *out++ = static_cast<CharT>(':');
+    return PutTwoDigits(out, st.wSecond);
+}
+
+}  // namespace Details
+
+// Write 'YYYY-MM-DD hh:mm:ss.mmm' to 'out' which must hold kMaxTimeStampLength characters, return the length written
+template <typename CharT>
+size_t ToTimeStamp(const SYSTEMTIME& st, CharT* out)
+{
+    CharT* const begin = out;
+
+    out = Details::PutDate(out, st);
+    *out++ = static_cast<CharT>(' ');
+    out = Details::PutTime(out, st);
+    *out++ = static_cast<CharT>('.');
+    *out++ = static_cast<CharT>('0' + st.wMilliseconds / 100);
+    out = Details::PutTwoDigits(out, st.wMilliseconds % 100);
+
+    return out - begin;
+}
+
+// Write 'YYYY-MM-DDThh:mm:ssZ' to 'out' which must hold kMaxIso8601Length characters, return the length written
+template <typename CharT>
+size_t ToIso8601(const SYSTEMTIME& st, CharT* out)
+{
+    CharT* const begin = out;
+
+    out = Details::PutDate(out, st);
+    *out++ = static_cast<CharT>('T');
+    out = Details::PutTime(out, st);
+    *out++ = static_cast<CharT>('Z');
+
+    return out - begin;
+}
+
+}  // namespace Text
+}  // namespace Orc
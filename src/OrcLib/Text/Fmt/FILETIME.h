@@ -9,6 +9,7 @@
 #pragma once
 
 #include "Text/Fmt/SYSTEMTIME.h"
+#include "Text/FileTime.h"
 
 // All time displayed are UTC so a FILETIME must converted to UTC (SYSTEMTIME)
 template <>
@@ -18,9 +19,11 @@ struct fmt::formatter<FILETIME> : public fmt::formatter<std::string_view>
     auto format(const FILETIME& ft, FormatContext& ctx) const -> decltype(ctx.out())
     {
         SYSTEMTIME stUTC {0};
-        if (FileTimeToSystemTime(&ft, &stUTC))
-            return formatter<std::string_view>::format(Orc::Text::FormatSystemTimeA(stUTC), ctx);
-        return ctx.out();
+        if (!Orc::Text::FileTimeEncoder().ToSystemTime(ft, stUTC))
+            return ctx.out();
+
+        char text[Orc::Text::kMaxTimeStampLength];
+        return formatter<std::string_view>::format(std::string_view(text, Orc::Text::ToTimeStamp(stUTC, text)), ctx);
     }
 };
 
@@ -31,8 +34,11 @@ struct fmt::formatter<FILETIME, wchar_t> : public fmt::formatter<std::wstring_vi
     auto format(const FILETIME& ft, FormatContext& ctx) const -> decltype(ctx.out())
     {
         SYSTEMTIME stUTC {0};
-        if (FileTimeToSystemTime(&ft, &stUTC))
-            return formatter<std::wstring_view, wchar_t>::format(Orc::Text::FormatSystemTimeW(stUTC), ctx);
-        return ctx.out();
+        if (!Orc::Text::FileTimeEncoder().ToSystemTime(ft, stUTC))
+            return ctx.out();
+
+        wchar_t text[Orc::Text::kMaxTimeStampLength];
+        return formatter<std::wstring_view, wchar_t>::format(
+            std::wstring_view(text, Orc::Text::ToTimeStamp(stUTC, text)), ctx);
     }
 };
@@ -0,0 +1,134 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+
+#include "Text/Utf16ToUtf8.h"
+
+#include <cstdint>
+
+#if defined(_M_X64) || defined(_M_IX86)
+#    include <emmintrin.h>
+#    define ORC_UTF16_SSE2
+#endif
+
+namespace {
+
+constexpr size_t kBlockLength = 16;
+
+inline uint8_t* PutCodePoint(uint8_t* out, uint32_t codepoint)
+{
+    if (codepoint < 0x80)
+    {
+        *out++ = static_cast<uint8_t>(codepoint);
+    }
+    else if (codepoint < 0x800)
+    {
+        *out++ = static_cast<uint8_t>(0xC0 | (codepoint >> 6));
+        *out++ = static_cast<uint8_t>(0x80 | (codepoint & 0x3F));
+    }
+    else if (codepoint < 0x10000)
+    {
+        *out++ = static_cast<uint8_t>(0xE0 | (codepoint >> 12));
+        *out++ = static_cast<uint8_t>(0x80 | ((codepoint >> 6) & 0x3F));
+        *out++ = static_cast<uint8_t>(0x80 | (codepoint & 0x3F));
+    }
+    else
+    {
+        *out++ = static_cast<uint8_t>(0xF0 | (codepoint >> 18));
+        *out++ = static_cast<uint8_t>(0x80 | ((codepoint >> 12) & 0x3F));
+        *out++ = static_cast<uint8_t>(0x80 | ((codepoint >> 6) & 0x3F));
+        *out++ = static_cast<uint8_t>(0x80 | (codepoint & 0x3F));
+    }
+
+    return out;
+}
+
+#ifdef ORC_UTF16_SSE2
+
+// Convert as many blocks of 16 ASCII code units as possible, stop at the first block with a non ASCII character
+inline void PutAsciiBlocks(const wchar_t*& in, const wchar_t* end, uint8_t*& out)
+{
+    const __m128i nonAsciiMask = _mm_set1_epi16(static_cast<short>(0xFF80));
+    const __m128i zero = _mm_setzero_si128();
+
+    while (static_cast<size_t>(end - in) >= kBlockLength)
+    {
+        const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 8));
+
+        const __m128i nonAscii = _mm_and_si128(_mm_or_si128(low, high), nonAsciiMask);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(nonAscii, zero)) != 0xFFFF)
+        {
+            return;
+        }
+
+        // All code units are below 0x80: saturated packing keeps them unchanged
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(low, high));
+        in += kBlockLength;
+        out += kBlockLength;
+    }
+}
+
+#endif
+
+}  // namespace
+
+namespace Orc {
+namespace Text {
+
+size_t Utf16ToUtf8(std::wstring_view utf16, char* utf8, size_t* pcReplaced)
+{
+    const wchar_t* in = utf16.data();
+    const wchar_t* const end = in + utf16.size();
+    uint8_t* out = reinterpret_cast<uint8_t*>(utf8);
+    size_t cReplaced = 0;
+
+    while (in < end)
+    {
+#ifdef ORC_UTF16_SSE2
+        PutAsciiBlocks(in, end, out);
+#endif
+
+        // Scalar conversion of the block which stopped the fast path (or of the tail), a surrogate pair may end past it
+        const wchar_t* const blockEnd = static_cast<size_t>(end - in) > kBlockLength ? in + kBlockLength : end;
+        while (in < blockEnd)
+        {
+            const uint32_t c = static_cast<uint16_t>(*in++);
+            if (c < 0x80)
+            {
+                *out++ = static_cast<uint8_t>(c);
+                continue;
+            }
+
+            if (c < 0xD800 || c > 0xDFFF)
+            {
+                out = PutCodePoint(out, c);
+                continue;
+            }
+
+            if (c <= 0xDBFF && in < end && *in >= 0xDC00 && *in <= 0xDFFF)
+            {
+                const uint32_t low = static_cast<uint16_t>(*in++);
+                out = PutCodePoint(out, 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00));
+                continue;
+            }
+
+            out = PutCodePoint(out, 0xFFFD);
+            ++cReplaced;
+        }
+    }
+
+    if (pcReplaced)
+    {
+        *pcReplaced = cReplaced;
+    }
+
+    return reinterpret_cast<char*>(out) - utf8;
+}
+
+}  // namespace Text
+}  // namespace Orc
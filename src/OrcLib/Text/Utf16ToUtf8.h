@@ -0,0 +1,41 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace Orc {
+namespace Text {
+
+// A UTF-16 code unit never takes more than 3 UTF-8 bytes, a surrogate pair takes 4 bytes for 2 code units
+constexpr size_t GetUtf8MaxLength(size_t cchUtf16)
+{
+    return cchUtf16 * 3;
+}
+
+// Transcode 'utf16' into 'utf8' which must hold GetUtf8MaxLength(utf16.size()) bytes, return the number of bytes
+// written. Runs of ASCII characters are converted 16 code units at a time.
+//
+// Lone surrogates are replaced with U+FFFD like WideCharToMultiByte does, 'pcReplaced' receives their count.
+size_t Utf16ToUtf8(std::wstring_view utf16, char* utf8, size_t* pcReplaced = nullptr);
+
+// Append the UTF-8 transcoding of 'utf16' to a contiguous char container (std::string, std::vector<char>...)
+template <typename ContainerT>
+void AppendUtf8(std::wstring_view utf16, ContainerT& utf8)
+{
+    const size_t offset = utf8.size();
+    utf8.resize(offset + GetUtf8MaxLength(utf16.size()));
+
+    const auto length = Utf16ToUtf8(utf16, reinterpret_cast<char*>(utf8.data()) + offset);
+    utf8.resize(offset + length);
+}
+
+}  // namespace Text
+}  // namespace Orc
@@ -20,6 +20,13 @@
 
 using namespace Orc;
 
+namespace {
+
+// Below this number of compression units a read is decompressed sequentially
+constexpr DWORD kMinParallelCompressionUnits = 4;
+
+}  // namespace
+
 UncompressNTFSStream::UncompressNTFSStream()
     : NTFSStream()
     , m_volume(nullptr)
@@ -176,88 +183,75 @@ HRESULT UncompressNTFSStream::ReadCompressionUnit(
         return hr;
     }
 
-    size_t uncomp_processed = 0;
     uncompressedData.ZeroMe();
 
+    // Fetch the data of all the compression units with a single read
+    const size_t cbRawData = static_cast<size_t>(dwNbCU) * m_dwCompressionUnit;
     CBinaryBuffer buffer(true);
-    for (size_t i = 0; i < dwNbCU; ++i)
+    hr = ReadRaw(buffer, cbRawData);
+    if (FAILED(hr))
     {
-        hr = ReadRaw(buffer, m_dwCompressionUnit);
-        if (FAILED(hr))
+        Log::Error(L"Failed to read {} bytes from chained stream [{}]", cbRawData, SystemError(hr));
+        return hr;
+    }
+
+    if (buffer.GetCount() < cbRawData)
+    {
+        const size_t cbRead = buffer.GetCount();
+        if (!buffer.SetCount(cbRawData))
         {
-            Log::Error(L"Failed to read {} bytes from chained stream [{}]", buffer.GetCount(), SystemError(hr));
-            return hr;
+            return E_OUTOFMEMORY;
         }
 
-        ULONGLONG ullRead = buffer.GetCount();
+        ZeroMemory(buffer.GetData() + cbRead, cbRawData - cbRead);
+    }
+
+    const size_t firstUnit = static_cast<size_t>(m_ullPosition / m_dwCompressionUnit);
 
-        size_t unitIndex = ((size_t)m_ullPosition / m_dwCompressionUnit) + i;
+    // Compression units are independent: each one is decompressed in its own slot of 'uncompressedData'
+    auto uncompressUnit = [&](DWORD i) {
+        const auto unitIndex = firstUnit + i;
+        const auto pRawData = buffer.GetData() + static_cast<size_t>(i) * m_dwCompressionUnit;
+        const auto pUncompressedData = uncompressedData.GetData() + static_cast<size_t>(i) * m_dwCompressionUnit;
 
-        if (!m_IsBlockCompressed.empty())
+        // Without compression status every unit is assumed compressed
+        const bool bCompressed = m_IsBlockCompressed.empty() || static_cast<bool>(m_IsBlockCompressed[unitIndex]);
+        if (!bCompressed)
         {
-            if (m_IsBlockCompressed[unitIndex])
-            {
-                // compression unit is compressed: proceed with decompression
-                NTFS_COMP_INFO info;
-                info.buf_size_b = m_dwCompressionUnit;
-                info.comp_buf = (char*)buffer.GetData();
-                info.comp_len = m_dwCompressionUnit;
-                info.uncomp_buf = (char*)uncompressedData.GetData() + uncomp_processed;
-                info.uncomp_idx = 0L;
-
-                if (FAILED(hr = ntfs_uncompress_compunit(&info)))
-                {
-                    Log::Warn(
-                        L"Failed to uncompress {} bytes from compressed unit, copying as raw data [{}]",
-                        info.comp_len,
-                        SystemError(hr));
-                    CopyMemory(
-                        (LPBYTE)uncompressedData.GetData() + uncomp_processed, buffer.GetData(), m_dwCompressionUnit);
-                    uncomp_processed += m_dwCompressionUnit;
-                }
-                else
-                {
-                    uncomp_processed += info.comp_len;
-                }
-            }
-            else
-            {
-                CopyMemory(
-                    (LPBYTE)uncompressedData.GetData() + uncomp_processed, buffer.GetData(), m_dwCompressionUnit);
-                uncomp_processed += m_dwCompressionUnit;
-            }
+            CopyMemory(pUncompressedData, pRawData, m_dwCompressionUnit);
+            return;
         }
-        else
+
+        // compression unit is compressed: proceed with decompression
+        if (HRESULT hrUnit =
+                ntfs_decompress(pUncompressedData, m_dwCompressionUnit, pRawData, m_dwCompressionUnit);
+            FAILED(hrUnit))
         {
-            // compression unit is compressed: proceed with decompression
-            NTFS_COMP_INFO info;
-            info.buf_size_b = m_dwCompressionUnit;
-            info.comp_buf = (char*)buffer.GetData();
-            info.comp_len = m_dwCompressionUnit;
-            info.uncomp_buf = (char*)uncompressedData.GetCount() + uncomp_processed;
-            info.uncomp_idx = 0L;
-
-            if (FAILED(hr = ntfs_uncompress_compunit(&info)))
-            {
-                // If decompression failed and CUs not compressed information is not available, we assume the CU was
-                // not compressed
-                Log::Warn(
-                    "Failed to uncompress {} bytes from compressed unit, copying as raw/uncompressed data [{}]",
-                    info.comp_len,
-                    SystemError(hr));
-                CopyMemory(
-                    (LPBYTE)uncompressedData.GetData() + uncomp_processed, buffer.GetData(), m_dwCompressionUnit);
-                uncomp_processed += m_dwCompressionUnit;
-            }
-            else
-            {
-                uncomp_processed += info.comp_len;
-            }
+            // If decompression failed and CUs not compressed information is not available, we assume the CU was
+            // not compressed
+            Log::Warn(
+                L"Failed to uncompress {} bytes from compressed unit #{}, copying as raw data [{}]",
+                m_dwCompressionUnit,
+                unitIndex,
+                SystemError(hrUnit));
+            CopyMemory(pUncompressedData, pRawData, m_dwCompressionUnit);
+        }
+    };
+
+    if (dwNbCU >= kMinParallelCompressionUnits)
+    {
+        Concurrency::parallel_for(0UL, dwNbCU, uncompressUnit);
+    }
+    else
+    {
+        for (DWORD i = 0; i < dwNbCU; ++i)
+        {
+            uncompressUnit(i);
         }
     }
 
     if (pcbBytesRead)
-        *pcbBytesRead = uncomp_processed;
+        *pcbBytesRead = cbRawData;
     return S_OK;
 }
 
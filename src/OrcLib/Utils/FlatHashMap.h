@@ -0,0 +1,261 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Orc {
+
+// Default hash for integral keys: a multiplicative mix which spreads dense keys (like MFT segment numbers) over the
+// table while their high bits (like sequence numbers) still count
+template <typename KeyT>
+struct FlatHash
+{
+    size_t operator()(const KeyT& key) const noexcept
+    {
+        const uint64_t hash = static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<size_t>(hash ^ (hash >> 32));
+    }
+};
+
+// Insert only hash map with open addressing.
+//
+// Entries are stored contiguously in insertion order and a linear probing table holds their indexes: there is no
+// allocation per entry, iteration is sequential and iterators, which are indexes, stay valid across insertions.
+// Entries cannot be erased, a value can be reset instead.
+template <typename KeyT, typename ValueT, typename HashT = FlatHash<KeyT>>
+class FlatHashMap
+{
+public:
+    using key_type = KeyT;
+    using mapped_type = ValueT;
+    using value_type = std::pair<KeyT, ValueT>;
+    using hasher = HashT;
+
+private:
+    using Entries = std::vector<value_type>;
+
+    template <bool bConst>
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename FlatHashMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<bConst, const value_type*, value_type*>;
+        using reference = std::conditional_t<bConst, const value_type&, value_type&>;
+
+        Iterator() = default;
+
+        Iterator(std::conditional_t<bConst, const Entries*, Entries*> pEntries, size_t index)
+            : m_pEntries(pEntries)
+            , m_index(index)
+        {
+        }
+
+        template <bool bOtherConst, typename = std::enable_if_t<bConst && !bOtherConst>>
+        Iterator(const Iterator<bOtherConst>& other)
+            : m_pEntries(other.m_pEntries)
+            , m_index(other.m_index)
+        {
+        }
+
+        reference operator*() const { return (*m_pEntries)[m_index]; }
+        pointer operator->() const { return &(*m_pEntries)[m_index]; }
+
+        Iterator& operator++()
+        {
+            ++m_index;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            auto previous = *this;
+            ++m_index;
+            return previous;
+        }
+
+        bool operator==(const Iterator& other) const { return m_index == other.m_index; }
+
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+    private:
+        template <bool>
+        friend class Iterator;
+
+        std::conditional_t<bConst, const Entries*, Entries*> m_pEntries = nullptr;
+        size_t m_index = 0;
+    };
+
+public:
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    explicit FlatHashMap(HashT hash = HashT())
+        : m_hash(std::move(hash))
+    {
+    }
+
+    size_t size() const { return m_entries.size(); }
+    bool empty() const { return m_entries.empty(); }
+
+    // Bytes allocated for the entries and the probing table
+    size_t GetMemoryUsage() const
+    {
+        return m_entries.capacity() * sizeof(value_type) + m_slots.capacity() * sizeof(uint32_t);
+    }
+
+    void reserve(size_t count)
+    {
+        m_entries.reserve(count);
+
+        const auto slotCount = GetSlotCount(count);
+        if (slotCount > m_slots.size())
+        {
+            Rehash(slotCount);
+        }
+    }
+
+    void clear()
+    {
+        m_entries.clear();
+        std::fill(std::begin(m_slots), std::end(m_slots), kEmptySlot);
+    }
+
+    iterator begin() { return iterator(&m_entries, 0); }
+    iterator end() { return iterator(&m_entries, m_entries.size()); }
+    const_iterator begin() const { return const_iterator(&m_entries, 0); }
+    const_iterator end() const { return const_iterator(&m_entries, m_entries.size()); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    iterator find(const KeyT& key)
+    {
+        if (m_slots.empty())
+        {
+            return end();
+        }
+
+        const auto slot = m_slots[FindSlot(key)];
+        return slot == kEmptySlot ? end() : iterator(&m_entries, slot - 1);
+    }
+
+    const_iterator find(const KeyT& key) const
+    {
+        if (m_slots.empty())
+        {
+            return end();
+        }
+
+        const auto slot = m_slots[FindSlot(key)];
+        return slot == kEmptySlot ? end() : const_iterator(&m_entries, slot - 1);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value)
+    {
+        GrowIfNeeded();
+
+        auto& slot = m_slots[FindSlot(value.first)];
+        if (slot != kEmptySlot)
+        {
+            return {iterator(&m_entries, slot - 1), false};
+        }
+
+        m_entries.push_back(std::move(value));
+        slot = static_cast<uint32_t>(m_entries.size());
+        return {iterator(&m_entries, m_entries.size() - 1), true};
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) { return insert(value_type(value)); }
+
+    ValueT& operator[](const KeyT& key)
+    {
+        GrowIfNeeded();
+
+        auto& slot = m_slots[FindSlot(key)];
+        if (slot == kEmptySlot)
+        {
+            m_entries.emplace_back(key, ValueT());
+            slot = static_cast<uint32_t>(m_entries.size());
+        }
+
+        return m_entries[slot - 1].second;
+    }
+
+private:
+    static constexpr uint32_t kEmptySlot = 0;  // other slots hold the entry index + 1
+    static constexpr size_t kMinSlotCount = 16;
+
+    // At most half of the slots are used so that probing for a missing key stays short
+    static size_t GetSlotCount(size_t count)
+    {
+        size_t slotCount = kMinSlotCount;
+        while (slotCount < count * 2)
+        {
+            slotCount *= 2;
+        }
+
+        return slotCount;
+    }
+
+    // Slot holding 'key' or the empty slot where it would be inserted, the table must not be empty
+    size_t FindSlot(const KeyT& key) const
+    {
+        const size_t mask = m_slots.size() - 1;
+
+        for (size_t i = m_hash(key) & mask;; i = (i + 1) & mask)
+        {
+            const auto slot = m_slots[i];
+            if (slot == kEmptySlot || m_entries[slot - 1].first == key)
+            {
+                return i;
+            }
+        }
+    }
+
+    void GrowIfNeeded()
+    {
+        if ((m_entries.size() + 1) * 2 > m_slots.size())
+        {
+            Rehash(GetSlotCount(m_entries.size() + 1));
+        }
+    }
+
+    void Rehash(size_t slotCount)
+    {
+        assert(m_entries.size() < (std::numeric_limits<uint32_t>::max)());
+
+        m_slots.assign(slotCount, kEmptySlot);
+
+        const size_t mask = slotCount - 1;
+        for (size_t index = 0; index < m_entries.size(); ++index)
+        {
+            size_t i = m_hash(m_entries[index].first) & mask;
+            while (m_slots[i] != kEmptySlot)
+            {
+                i = (i + 1) & mask;
+            }
+
+            m_slots[i] = static_cast<uint32_t>(index + 1);
+        }
+    }
+
+    Entries m_entries;
+    std::vector<uint32_t> m_slots;
+    HashT m_hash;
+};
+
+}  // namespace Orc
@@ -0,0 +1,76 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace Orc {
+
+// Append only storage for many small strings.
+//
+// Strings are packed in large blocks instead of being allocated one by one: there is no allocation nor header per
+// string. Returned views stay valid until the arena is cleared or destroyed.
+template <typename CharT>
+class BasicStringArena
+{
+public:
+    static constexpr size_t kDefaultBlockLength = 0x40000;
+
+    explicit BasicStringArena(size_t blockLength = kDefaultBlockLength)
+        : m_blockLength((std::max)(blockLength, size_t(1)))
+    {
+    }
+
+    std::basic_string_view<CharT> Add(std::basic_string_view<CharT> str)
+    {
+        if (str.empty())
+        {
+            return {};
+        }
+
+        if (m_blocks.empty() || m_blockUsed + str.size() > m_blockCapacity)
+        {
+            // Strings longer than a block get their own
+            m_blockCapacity = (std::max)(m_blockLength, str.size());
+            m_blocks.push_back(std::make_unique<CharT[]>(m_blockCapacity));
+            m_blockUsed = 0;
+            m_memoryUsage += m_blockCapacity * sizeof(CharT);
+        }
+
+        CharT* pStr = m_blocks.back().get() + m_blockUsed;
+        std::copy(std::cbegin(str), std::cend(str), pStr);
+        m_blockUsed += str.size();
+
+        return std::basic_string_view<CharT>(pStr, str.size());
+    }
+
+    void clear()
+    {
+        m_blocks.clear();
+        m_blockUsed = 0;
+        m_blockCapacity = 0;
+        m_memoryUsage = 0;
+    }
+
+    // Bytes allocated for the blocks
+    size_t GetMemoryUsage() const { return m_memoryUsage; }
+
+private:
+    size_t m_blockLength;
+    std::vector<std::unique_ptr<CharT[]>> m_blocks;
+    size_t m_blockUsed = 0;
+    size_t m_blockCapacity = 0;
+    size_t m_memoryUsage = 0;
+};
+
+using StringArena = BasicStringArena<wchar_t>;
+
+}  // namespace Orc
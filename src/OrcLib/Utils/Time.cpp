@@ -6,10 +6,10 @@
 // Author(s): fabienfl (ANSSI)
 //
 
-#include <fmt/format.h>
-
 #include "Utils/Time.h"
 
+#include "Text/FileTime.h"
+
 using namespace Orc::Traits;
 
 namespace Orc {
@@ -79,38 +79,36 @@ Result<TimeUtc<SYSTEMTIME>> ToSystemTime(const std::chrono::system_clock::time_p
 
 std::wstring ToStringIso8601(const Traits::TimeUtc<SYSTEMTIME>& time)
 {
-    const auto& st = time.value;
-    return fmt::format(
-        L"{}-{:02}-{:02}T{:02}:{:02}:{:02}Z", st.wYear, st.wMonth, st.wDay, st.wHour, st.wMinute, st.wSecond);
+    wchar_t text[Text::kMaxIso8601Length];
+    return std::wstring(text, Text::ToIso8601(time.value, text));
 }
 
 Result<std::wstring> ToStringIso8601(const std::chrono::system_clock::time_point& tp)
 {
-    const auto time = ToSystemTime(tp);
-    if (time.has_error())
+    Traits::TimeUtc<SYSTEMTIME> st;
+    if (!Text::FileTimeEncoder().ToSystemTime(ToFileTime(tp), st.value))
     {
-        return time.error();
+        return std::make_error_code(std::errc::invalid_argument);
     }
 
-    return ToStringIso8601(time.value());
+    return ToStringIso8601(st);
 }
 
 std::string ToAnsiStringIso8601(const Traits::TimeUtc<SYSTEMTIME>& time)
 {
-    const auto& st = time.value;
-    return fmt::format(
-        "{}-{:02}-{:02}T{:02}:{:02}:{:02}Z", st.wYear, st.wMonth, st.wDay, st.wHour, st.wMinute, st.wSecond);
+    char text[Text::kMaxIso8601Length];
+    return std::string(text, Text::ToIso8601(time.value, text));
 }
 
 Result<std::string> ToAnsiStringIso8601(const std::chrono::system_clock::time_point& tp)
 {
-    const auto time = ToSystemTime(tp);
-    if (time.has_error())
+    Traits::TimeUtc<SYSTEMTIME> st;
+    if (!Text::FileTimeEncoder().ToSystemTime(ToFileTime(tp), st.value))
     {
-        return time.error();
+        return std::make_error_code(std::errc::invalid_argument);
     }
 
-    return ToAnsiStringIso8601(time.value());
+    return ToAnsiStringIso8601(st);
 }
 
 }  // namespace Orc
@@ -0,0 +1,480 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+
+#include "Utils/Trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+#include <windows.h>
+
+#include <fmt/format.h>
+
+#include <rapidjson/document.h>
+
+#include "Utils/Guard.h"
+#include "Utils/Result.h"
+
+using namespace Orc;
+
+namespace {
+
+// Past this, spans of a thread are still aggregated but no longer exported as events
+constexpr size_t kMaxEventsPerThread = 1 << 20;
+
+constexpr size_t kWriteBufferSize = 1 << 20;
+
+struct Event
+{
+    const char* Category;
+    const char* Name;
+    int64_t Start;
+    int64_t Duration;  // ticks, -1 for counters
+    uint64_t Value;  // bytes of a span, value of a counter
+};
+
+struct Aggregate
+{
+    const char* Category;
+    uint64_t Count;
+    int64_t Duration;
+    uint64_t Bytes;
+};
+
+struct ThreadBuffer
+{
+    DWORD ThreadId = 0L;
+    std::mutex Lock;
+    std::vector<Event> Events;
+    size_t DroppedEvents = 0;
+    std::unordered_map<const char*, Aggregate> Aggregates;  // by name
+};
+
+struct Registry
+{
+    std::atomic<bool> Enabled = false;
+    int64_t Origin = 0;
+    int64_t Frequency = 1;
+
+    std::mutex Lock;
+    std::vector<std::shared_ptr<ThreadBuffer>> Buffers;  // kept after their thread exits
+};
+
+Registry& GetRegistry()
+{
+    static Registry registry;
+    return registry;
+}
+
+int64_t Now() noexcept
+{
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return counter.QuadPart;
+}
+
+ThreadBuffer& GetThreadBuffer()
+{
+    thread_local std::shared_ptr<ThreadBuffer> buffer;
+    if (buffer == nullptr)
+    {
+        buffer = std::make_shared<ThreadBuffer>();
+        buffer->ThreadId = GetCurrentThreadId();
+        buffer->Events.reserve(4096);
+
+        auto& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.Lock);
+        registry.Buffers.push_back(buffer);
+    }
+
+    return *buffer;
+}
+
+void Record(const Event& event) noexcept
+{
+    try
+    {
+        auto& buffer = GetThreadBuffer();
+        std::lock_guard<std::mutex> lock(buffer.Lock);
+
+        if (buffer.Events.size() < kMaxEventsPerThread)
+        {
+            buffer.Events.push_back(event);
+        }
+        else
+        {
+            ++buffer.DroppedEvents;
+        }
+
+        if (event.Duration >= 0)
+        {
+            auto& aggregate = buffer.Aggregates[event.Name];
+            aggregate.Category = event.Category;
+            ++aggregate.Count;
+            aggregate.Duration += event.Duration;
+            aggregate.Bytes += event.Value;
+        }
+    }
+    catch (...)
+    {
+        // Tracing must never fail the traced code
+    }
+}
+
+double ToMicroseconds(int64_t ticks, int64_t frequency)
+{
+    return static_cast<double>(ticks) * 1000000.0 / static_cast<double>(frequency);
+}
+
+void AppendJsonString(fmt::memory_buffer& out, std::string_view value)
+{
+    out.push_back('"');
+    for (const auto c : value)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out.push_back('\\');
+            out.push_back(c);
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            fmt::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<unsigned int>(c));
+        }
+        else
+        {
+            out.push_back(c);
+        }
+    }
+    out.push_back('"');
+}
+
+void SortByDuration(std::vector<Orc::Trace::Statistics>& statistics)
+{
+    std::sort(
+        std::begin(statistics),
+        std::end(statistics),
+        [](const Orc::Trace::Statistics& left, const Orc::Trace::Statistics& right) {
+            return left.Duration > right.Duration;
+        });
+}
+
+}  // namespace
+
+namespace Orc {
+namespace Trace {
+
+void Enable()
+{
+    auto& registry = GetRegistry();
+    if (registry.Enabled)
+    {
+        return;
+    }
+
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+    registry.Frequency = frequency.QuadPart;
+    registry.Origin = Now();
+    registry.Enabled = true;
+}
+
+bool IsEnabled() noexcept
+{
+    return GetRegistry().Enabled.load(std::memory_order_relaxed);
+}
+
+Span::Span(const char* category, const char* name) noexcept
+    : m_category(category)
+    , m_name(name)
+    , m_start(IsEnabled() ? Now() : 0)
+    , m_bytes(0)
+{
+}
+
+Span::~Span()
+{
+    if (m_start == 0)
+    {
+        return;
+    }
+
+    Record({m_category, m_name, m_start, Now() - m_start, m_bytes});
+}
+
+void Counter(const char* category, const char* name, int64_t value) noexcept
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+
+    Record({category, name, Now(), -1, static_cast<uint64_t>(value)});
+}
+
+std::vector<Statistics> GetStatistics(bool bReset)
+{
+    auto& registry = GetRegistry();
+
+    // The same literal may have different addresses in different translation units
+    std::map<std::pair<std::string_view, std::string_view>, Aggregate> merged;
+    {
+        std::lock_guard<std::mutex> lock(registry.Lock);
+        for (const auto& buffer : registry.Buffers)
+        {
+            std::lock_guard<std::mutex> bufferLock(buffer->Lock);
+            for (const auto& [name, aggregate] : buffer->Aggregates)
+            {
+                auto& total = merged[{aggregate.Category, name}];
+                total.Count += aggregate.Count;
+                total.Duration += aggregate.Duration;
+                total.Bytes += aggregate.Bytes;
+            }
+
+            if (bReset)
+            {
+                buffer->Aggregates.clear();
+            }
+        }
+    }
+
+    std::vector<Statistics> statistics;
+    statistics.reserve(merged.size());
+    for (const auto& [key, aggregate] : merged)
+    {
+        Statistics entry;
+        entry.Category = key.first;
+        entry.Name = key.second;
+        entry.Count = aggregate.Count;
+        entry.Duration = std::chrono::microseconds(
+            static_cast<int64_t>(ToMicroseconds(aggregate.Duration, registry.Frequency)));
+        entry.Bytes = aggregate.Bytes;
+        statistics.push_back(std::move(entry));
+    }
+
+    SortByDuration(statistics);
+    return statistics;
+}
+
+void WriteChromeTrace(const std::filesystem::path& path, std::error_code& ec)
+{
+    Guard::FileHandle file =
+        CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (!file.IsValid())
+    {
+        ec = LastWin32Error();
+        return;
+    }
+
+    fmt::memory_buffer out;
+    const auto flush = [&]() {
+        DWORD dwWritten = 0L;
+        if (!WriteFile(*file, out.data(), static_cast<DWORD>(out.size()), &dwWritten, NULL))
+        {
+            ec = LastWin32Error();
+        }
+
+        out.clear();
+    };
+
+    auto& registry = GetRegistry();
+    const auto pid = GetCurrentProcessId();
+    bool bFirst = true;
+
+    fmt::format_to(std::back_inserter(out), "{{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+    std::lock_guard<std::mutex> lock(registry.Lock);
+    for (const auto& buffer : registry.Buffers)
+    {
+        std::lock_guard<std::mutex> bufferLock(buffer->Lock);
+
+        for (const auto& event : buffer->Events)
+        {
+            out.append(std::string_view(bFirst ? "\n{\"name\":" : ",\n{\"name\":"));
+            bFirst = false;
+
+            AppendJsonString(out, event.Name);
+            out.append(std::string_view(",\"cat\":"));
+            AppendJsonString(out, event.Category);
+
+            const auto ts = ToMicroseconds(event.Start - registry.Origin, registry.Frequency);
+            if (event.Duration >= 0)
+            {
+                fmt::format_to(
+                    std::back_inserter(out),
+                    ",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":{},\"tid\":{},\"args\":{{\"bytes\":{}}}}}",
+                    ts,
+                    ToMicroseconds(event.Duration, registry.Frequency),
+                    pid,
+                    buffer->ThreadId,
+                    event.Value);
+            }
+            else
+            {
+                fmt::format_to(
+                    std::back_inserter(out),
+                    ",\"ph\":\"C\",\"ts\":{:.3f},\"pid\":{},\"tid\":{},\"args\":{{\"value\":{}}}}}",
+                    ts,
+                    pid,
+                    buffer->ThreadId,
+                    static_cast<int64_t>(event.Value));
+            }
+
+            if (out.size() >= kWriteBufferSize)
+            {
+                flush();
+                if (ec)
+                {
+                    return;
+                }
+            }
+        }
+
+        if (buffer->DroppedEvents)
+        {
+            fmt::format_to(
+                std::back_inserter(out),
+                "{}\n{{\"name\":\"dropped_events\",\"ph\":\"i\",\"s\":\"t\",\"ts\":0,\"pid\":{},\"tid\":{},"
+                "\"args\":{{\"count\":{}}}}}",
+                bFirst ? "" : ",",
+                pid,
+                buffer->ThreadId,
+                buffer->DroppedEvents);
+            bFirst = false;
+        }
+    }
+
+    fmt::format_to(std::back_inserter(out), "\n]}}\n");
+    flush();
+}
+
+std::filesystem::path GetStatisticsPath(const std::filesystem::path& tracePath)
+{
+    auto path = tracePath;
+    path.replace_extension(L".statistics.json");
+    return path;
+}
+
+void WriteStatistics(const std::filesystem::path& path, std::error_code& ec)
+{
+    fmt::memory_buffer out;
+    fmt::format_to(std::back_inserter(out), "{{\"statistics\":[");
+
+    bool bFirst = true;
+    for (const auto& item : GetStatistics())
+    {
+        out.append(std::string_view(bFirst ? "\n{\"cat\":" : ",\n{\"cat\":"));
+        bFirst = false;
+
+        AppendJsonString(out, item.Category);
+        out.append(std::string_view(",\"name\":"));
+        AppendJsonString(out, item.Name);
+        fmt::format_to(
+            std::back_inserter(out),
+            ",\"count\":{},\"dur\":{},\"bytes\":{}}}",
+            item.Count,
+            item.Duration.count(),
+            item.Bytes);
+    }
+
+    fmt::format_to(std::back_inserter(out), "\n]}}\n");
+
+    Guard::FileHandle file =
+        CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (!file.IsValid())
+    {
+        ec = LastWin32Error();
+        return;
+    }
+
+    DWORD dwWritten = 0L;
+    if (!WriteFile(*file, out.data(), static_cast<DWORD>(out.size()), &dwWritten, NULL))
+    {
+        ec = LastWin32Error();
+    }
+}
+
+std::vector<Statistics> ReadStatistics(const std::filesystem::path& path, std::error_code& ec)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        ec = std::make_error_code(std::errc::no_such_file_or_directory);
+        return {};
+    }
+
+    const std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    rapidjson::Document document;
+    document.Parse(content.c_str());
+    if (document.HasParseError() || !document.IsObject())
+    {
+        ec = std::make_error_code(std::errc::invalid_argument);
+        return {};
+    }
+
+    const auto items = document.FindMember("statistics");
+    if (items == document.MemberEnd() || !items->value.IsArray())
+    {
+        ec = std::make_error_code(std::errc::invalid_argument);
+        return {};
+    }
+
+    std::vector<Statistics> statistics;
+    for (const auto& item : items->value.GetArray())
+    {
+        if (!item.IsObject() || !item.HasMember("cat") || !item["cat"].IsString() || !item.HasMember("name")
+            || !item["name"].IsString() || !item.HasMember("count") || !item["count"].IsUint64()
+            || !item.HasMember("dur") || !item["dur"].IsInt64() || !item.HasMember("bytes")
+            || !item["bytes"].IsUint64())
+        {
+            ec = std::make_error_code(std::errc::invalid_argument);
+            return {};
+        }
+
+        Statistics entry;
+        entry.Category = item["cat"].GetString();
+        entry.Name = item["name"].GetString();
+        entry.Count = item["count"].GetUint64();
+        entry.Duration = std::chrono::microseconds(item["dur"].GetInt64());
+        entry.Bytes = item["bytes"].GetUint64();
+        statistics.push_back(std::move(entry));
+    }
+
+    return statistics;
+}
+
+void MergeStatistics(std::vector<Statistics>& statistics, const std::vector<Statistics>& other)
+{
+    for (const auto& item : other)
+    {
+        auto it = std::find_if(std::begin(statistics), std::end(statistics), [&item](const Statistics& existing) {
+            return existing.Category == item.Category && existing.Name == item.Name;
+        });
+
+        if (it == std::end(statistics))
+        {
+            statistics.push_back(item);
+            continue;
+        }
+
+        it->Count += item.Count;
+        it->Duration += item.Duration;
+        it->Bytes += item.Bytes;
+    }
+
+    SortByDuration(statistics);
+}
+
+}  // namespace Trace
+}  // namespace Orc
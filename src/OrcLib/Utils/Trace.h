@@ -0,0 +1,77 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace Orc {
+namespace Trace {
+
+// Performance trace of the current process.
+//
+// Spans and counters are only recorded once tracing is enabled, until then a span costs an atomic load. Each thread
+// records into its own buffer, which is only locked by the exports.
+
+void Enable();
+bool IsEnabled() noexcept;
+
+// Time spent in a scope, with the bytes it processed. 'category' and 'name' must be literals: only their addresses are
+// recorded.
+class Span
+{
+public:
+    Span(const char* category, const char* name) noexcept;
+    ~Span();
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+    void SetBytes(uint64_t bytes) noexcept { m_bytes = bytes; }
+
+private:
+    const char* m_category;
+    const char* m_name;
+    int64_t m_start;
+    uint64_t m_bytes;
+};
+
+// Sample of a value which changes over time (queue depth, memory...)
+void Counter(const char* category, const char* name, int64_t value) noexcept;
+
+struct Statistics
+{
+    std::string Category;
+    std::string Name;
+    uint64_t Count = 0;
+    std::chrono::microseconds Duration;
+    uint64_t Bytes = 0;
+};
+
+// Spans aggregated by category and name over every thread, by decreasing duration. With 'bReset', the next call only
+// returns the spans which ended after this one (the Chrome trace keeps every event).
+std::vector<Statistics> GetStatistics(bool bReset = false);
+
+// Trace event format as loaded by chrome://tracing or Perfetto
+void WriteChromeTrace(const std::filesystem::path& path, std::error_code& ec);
+
+// Aggregated spans of a process, written next to its Chrome trace so that a parent process (ex: WolfLauncher) can
+// merge them without loading every event
+std::filesystem::path GetStatisticsPath(const std::filesystem::path& tracePath);
+void WriteStatistics(const std::filesystem::path& path, std::error_code& ec);
+std::vector<Statistics> ReadStatistics(const std::filesystem::path& path, std::error_code& ec);
+
+// Adds 'other' spans to 'statistics', by category and name
+void MergeStatistics(std::vector<Statistics>& statistics, const std::vector<Statistics>& other);
+
+}  // namespace Trace
+}  // namespace Orc
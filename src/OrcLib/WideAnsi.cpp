@@ -14,6 +14,7 @@
 #include <boost/io/ios_state.hpp>
 
 #include "Log/Log.h"
+#include "Text/Utf16ToUtf8.h"
 
 using namespace std;
 
@@ -96,86 +97,13 @@ Orc::WideToAnsi(__in PCWSTR pwszSrc, __out_ecount(cchDest) PSTR pszDest, __in DW
 
 HRESULT Orc::WideToAnsi(__in const std::wstring& src, std::string& dest)
 {
-    boost::io::ios_flags_saver fs(std::cerr);
-    if (src.empty())
-    {
-        dest.clear();
-        return S_OK;
-    }
-
-    int cbNeeded = 0;
-    if (0
-        == (cbNeeded =
-                WideCharToMultiByte(CP_UTF8, 0, src.c_str(), static_cast<int>(src.size()), NULL, 0L, NULL, NULL)))
-    {
-        HRESULT hr = HRESULT_FROM_WIN32(GetLastError());
-        Log::Error("WideCharToMultiByte failed [{}]", SystemError(hr));
-        return hr;
-    }
-
-    std::vector<CHAR> buffer;
-
-    buffer.reserve(cbNeeded);
-    buffer.resize(cbNeeded);
-    if (0
-        == (cbNeeded = WideCharToMultiByte(
-                CP_UTF8,
-                0,
-                src.c_str(),
-                static_cast<int>(src.size()),
-                buffer.data(),
-                static_cast<int>(buffer.size()),
-                NULL,
-                NULL)))
-    {
-        HRESULT hr = HRESULT_FROM_WIN32(GetLastError());
-        Log::Error("WideCharToMultiByte failed [{}]", SystemError(hr));
-        return hr;
-    }
-
-    dest.assign(buffer.data(), buffer.size());
-    return S_OK;
+    return WideToAnsi(std::wstring_view(src), dest);
 }
 
 HRESULT Orc::WideToAnsi(__in std::wstring_view src, std::string& dest)
 {
-    boost::io::ios_flags_saver fs(std::cerr);
-    if (src.empty())
-    {
-        dest.clear();
-        return S_OK;
-    }
-
-    int cbNeeded = 0;
-    if (0
-        == (cbNeeded = WideCharToMultiByte(CP_UTF8, 0, src.data(), static_cast<int>(src.size()), NULL, 0L, NULL, NULL)))
-    {
-        HRESULT hr = HRESULT_FROM_WIN32(GetLastError());
-        Log::Error("WideCharToMultiByte failed [{}]", SystemError(hr));
-        return hr;
-    }
-
-    std::vector<CHAR> buffer;
-
-    buffer.reserve(cbNeeded);
-    buffer.resize(cbNeeded);
-    if (0
-        == (cbNeeded = WideCharToMultiByte(
-                CP_UTF8,
-                0,
-                src.data(),
-                static_cast<int>(src.size()),
-                buffer.data(),
-                static_cast<int>(buffer.size()),
-                NULL,
-                NULL)))
-    {
-        HRESULT hr = HRESULT_FROM_WIN32(GetLastError());
-        Log::Error("WideCharToMultiByte failed [{}]", SystemError(hr));
-        return hr;
-    }
-
-    dest.assign(buffer.data(), buffer.size());
+    dest.clear();
+    Text::AppendUtf8(src, dest);
     return S_OK;
 }
 
@@ -261,41 +189,8 @@ HRESULT Orc::WideToAnsi(PCWSTR pszSrc, std::string& dest)
 {
     if (pszSrc == nullptr)
         return E_INVALIDARG;
-    if (*pszSrc == L'\0')
-    {
-        dest.clear();
-        return S_OK;
-    }
-
-    boost::io::ios_flags_saver fs(std::cerr);
-    int cbNeeded = 0;
-    if (0 == (cbNeeded = WideCharToMultiByte(CP_UTF8, 0, pszSrc, -1, NULL, 0L, NULL, NULL)))
-    {
-        HRESULT hr = HRESULT_FROM_WIN32(GetLastError());
-        Log::Error("WideCharToMultiByte failed [{}]", SystemError(hr));
-        return hr;
-    }
 
-    CBinaryBuffer buffer;
-    buffer.SetCount(cbNeeded);
-    if (0
-        == (cbNeeded = WideCharToMultiByte(
-                CP_UTF8,
-                0,
-                pszSrc,
-                -1,
-                static_cast<LPSTR>((CHAR*)buffer.GetData()),
-                static_cast<int>(buffer.GetCount()),
-                NULL,
-                NULL)))
-    {
-        HRESULT hr = HRESULT_FROM_WIN32(GetLastError());
-        Log::Error("WideCharToMultiByte failed [{}]", SystemError(hr));
-        return hr;
-    }
-
-    dest.assign(buffer.GetP<CHAR>(), static_cast<int>(buffer.GetCount() - 1));
-    return S_OK;
+    return WideToAnsi(std::wstring_view(pszSrc), dest);
 }
 
 std::pair<HRESULT, std::string> Orc::WideToAnsi(PCWSTR pwszSrc)
@@ -14,6 +14,7 @@
 #include "XmlLiteExtension.h"
 #include "OutputSpec.h"
 #include "ByteStream.h"
+#include "AsyncWriteStream.h"
 #include "WideAnsi.h"
 
 #include <xmllite.h>
@@ -33,7 +34,15 @@ HRESULT Orc::StructuredOutput::XML::Writer::SetOutput(const std::shared_ptr<Byte
     HRESULT hr = E_FAIL;
     CComPtr<IStream> stream;
 
-    if (FAILED(hr = ByteStream::Get_IStream(pStream, &stream)))
+    auto pOutputStream = pStream;
+    if (auto options = dynamic_cast<Options*>(m_Options.get()); options && options->dwAsyncBufferCount && pStream)
+    {
+        // Stream is not closed by this writer, Close() only waits for pending writes
+        m_pAsyncStream = std::make_shared<AsyncWriteStream>(pStream, false, options->dwAsyncBufferCount + 1);
+        pOutputStream = m_pAsyncStream;
+    }
+
+    if (FAILED(hr = ByteStream::Get_IStream(pOutputStream, &stream)))
         return hr;
 
     CComPtr<IXmlWriter> pWriter;
@@ -114,6 +123,16 @@ HRESULT Orc::StructuredOutput::XML::Writer::Close()
         return hr;
     }
     m_pWriter.Release();
+
+    if (m_pAsyncStream)
+    {
+        if (FAILED(hr = m_pAsyncStream->Close()))
+        {
+            Log::Error(L"Failed to write xml output [{}]", SystemError(hr));
+            return hr;
+        }
+    }
+
     return S_OK;
 }
 
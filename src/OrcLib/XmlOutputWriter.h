@@ -22,6 +22,7 @@ struct IXmlWriter;
 namespace Orc {
 
 class ByteStream;
+class AsyncWriteStream;
 
 namespace StructuredOutput::XML {
 
@@ -30,6 +31,7 @@ class Writer : public StructuredOutput::Writer
 protected:
     std::shared_ptr<XmlLiteExtension> m_xmllite;
     CComPtr<IXmlWriter> m_pWriter;
+    std::shared_ptr<AsyncWriteStream> m_pAsyncStream;
     std::stack<std::wstring> m_collectionStack;
 
 public:
@@ -21,6 +21,8 @@
 #include "YaraStaticExtension.h"
 #include "yara.h"
 
+#include "Utils/Trace.h"
+
 #include <boost/algorithm/string.hpp>
 
 using namespace Orc;
@@ -473,6 +475,9 @@ HRESULT Orc::YaraScanner::Scan(const CBinaryBuffer& buffer, ULONG bytesToScan, M
     if (bytesToScan == 0)
         return S_OK;
 
+    Trace::Span span("yara", "YaraScanner::ScanBuffer");
+    span.SetBytes(bytesToScan);
+
     YR_RULES* pRules = GetRules();
 
     auto scan_details = std::make_pair(this, &matchingRules);
@@ -619,6 +624,9 @@ HRESULT YaraScanner::ScanBlocks(const std::shared_ptr<ByteStream>& stream, Match
 
 HRESULT Orc::YaraScanner::Scan(const std::shared_ptr<ByteStream>& stream, MatchingRuleCollection& matchingRules)
 {
+    Trace::Span span("yara", "YaraScanner::ScanStream");
+    span.SetBytes(stream->GetSize());
+
     if (m_config.ScanMethod() == YaraScanMethod::Blocks)
     {
         return ScanBlocks(stream, matchingRules);
@@ -32,6 +32,7 @@
 
 #include "CaseInsensitive.h"
 #include "Temporary.h"
+#include "Utils/Trace.h"
 
 using namespace std;
 using namespace lib7z;
@@ -208,6 +209,8 @@ STDMETHODIMP ZipCreate::Internal_FlushQueue(bool bFinal)
 {
     HRESULT hr = E_FAIL;
 
+    Trace::Span span("archive", "ZipCreate::FlushQueue");
+
     const auto pZipLib = ZipLibrary::GetZipLibrary();
     if (pZipLib == nullptr)
     {
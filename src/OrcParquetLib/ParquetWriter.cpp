@@ -17,6 +17,7 @@
 #include "WideAnsi.h"
 #include "Buffer.h"
 #include "Utils/Result.h"
+#include "Text/Utf16ToUtf8.h"
 
 #include <string>
 #include <string_view>
@@ -582,6 +583,15 @@ HRESULT Orc::TableOutput::Parquet::Writer::WriteEndOfLine()
     return S_OK;
 }
 
+size_t Orc::TableOutput::Parquet::Writer::TranscodeString(std::wstring_view svString)
+{
+    size_t cReplaced = 0;
+
+    m_utf8.resize(Text::GetUtf8MaxLength(svString.size()));
+    m_utf8.resize(Text::Utf16ToUtf8(svString, m_utf8.data(), &cReplaced));
+    return cReplaced;
+}
+
 STDMETHODIMP Orc::TableOutput::Parquet::Writer::WriteString(const std::wstring& strString)
 {
     return WriteString(std::wstring_view(strString));
@@ -621,9 +631,10 @@ STDMETHODIMP Orc::TableOutput::Parquet::Writer::WriteString(const std::wstring_v
 
                 if (utf8_builder)
                 {
-                    if (auto [hr, utf8] = WideToAnsi(svString); SUCCEEDED(hr))
+                    // Strings with lone surrogates are kept as raw utf16 when possible, not with replacement characters
+                    if (TranscodeString(svString) == 0 || raw_builder == nullptr)
                     {
-                        utf8_builder->Append(utf8);
+                        utf8_builder->Append(m_utf8.data(), static_cast<int32_t>(m_utf8.size()));
                         if (raw_builder)
                             raw_builder->AppendNull();
                         arg->Append(true);
@@ -631,23 +642,15 @@ STDMETHODIMP Orc::TableOutput::Parquet::Writer::WriteString(const std::wstring_v
                     else
                     {
                         raw_builder->Append((uint8_t*)svString.data(), svString.size() * sizeof(wchar_t));
-                        if (utf8_builder)
-                            utf8_builder->AppendNull();
+                        utf8_builder->AppendNull();
                         arg->Append(true);
                     }
                 }
             }
             else if constexpr (std::is_same_v<T, std::unique_ptr<arrow::StringBuilder>>)
             {
-                if (auto [hr, utf8] = WideToAnsi(svString); SUCCEEDED(hr))
-                {
-                    arg->Append(utf8);
-                }
-                else
-                {
-                    Log::Debug(L"Unicode to utf8 conversion failed");
-                    arg->AppendNull();
-                }
+                TranscodeString(svString);
+                arg->Append(m_utf8.data(), static_cast<int32_t>(m_utf8.size()));
             }
             else
                 throw Orc::Exception(Severity::Fatal, L"Not a valid arrow builder for a Unicode string");
@@ -193,6 +193,12 @@ protected:
 
     Builders GetBuilders();
 
+    // Transcoding buffer reused across string cells
+    std::string m_utf8;
+
+    // Transcode 'svString' into m_utf8, return the number of lone surrogates replaced
+    size_t TranscodeString(std::wstring_view svString);
+
     HRESULT AddColumnAndCheckNumbers();
 
     template <arrow::TimeUnit::type timeUnit = arrow::TimeUnit::MICRO>
@@ -0,0 +1,143 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include "Fixtures.h"
+
+#include <map>
+#include <mutex>
+
+#include <boost/algorithm/string/case_conv.hpp>
+
+#include "ArchiveExtract.h"
+#include "Utils/Result.h"
+
+using namespace Orc;
+
+namespace {
+
+struct FixtureRegistry
+{
+    std::mutex Lock;
+    std::filesystem::path DataDirectory = ORC_BENCHMARK_DATA_DIRECTORY;
+    std::optional<std::filesystem::path> HivePath;
+    std::filesystem::path ExtractDirectory;
+
+    // Extracted items (name in archive, path) of each archive
+    std::map<std::wstring, std::vector<std::pair<std::wstring, std::wstring>>> Archives;
+};
+
+FixtureRegistry& GetRegistry()
+{
+    static FixtureRegistry registry;
+    return registry;
+}
+
+}  // namespace
+
+namespace Orc::Benchmark {
+
+const std::filesystem::path& GetDataDirectory()
+{
+    return GetRegistry().DataDirectory;
+}
+
+void SetDataDirectory(const std::filesystem::path& directory)
+{
+    GetRegistry().DataDirectory = directory;
+}
+
+const std::optional<std::filesystem::path>& GetHivePath()
+{
+    return GetRegistry().HivePath;
+}
+
+void SetHivePath(const std::filesystem::path& path)
+{
+    GetRegistry().HivePath = path;
+}
+
+std::optional<std::filesystem::path> GetFixture(std::wstring_view archive, std::wstring_view nameFragment)
+{
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Lock);
+
+    auto it = registry.Archives.find(std::wstring(archive));
+    if (it == std::cend(registry.Archives))
+    {
+        const auto archivePath = registry.DataDirectory / archive;
+
+        std::error_code ec;
+        if (!std::filesystem::exists(archivePath, ec))
+        {
+            Log::Error(L"Missing fixture '{}'", archivePath.c_str());
+            return {};
+        }
+
+        if (registry.ExtractDirectory.empty())
+        {
+            registry.ExtractDirectory =
+                std::filesystem::temp_directory_path() / fmt::format(L"OrcLibBenchmark_{}", GetCurrentProcessId());
+        }
+
+        const auto directory = registry.ExtractDirectory / std::filesystem::path(archive).stem();
+        std::filesystem::create_directories(directory, ec);
+        if (ec)
+        {
+            Log::Error(L"Failed to create directory '{}' [{}]", directory.c_str(), ec);
+            return {};
+        }
+
+        auto extractor = ArchiveExtract::MakeExtractor(ArchiveFormat::SevenZip);
+        if (extractor == nullptr)
+        {
+            Log::Error(L"Failed to create extractor");
+            return {};
+        }
+
+        if (auto hr = extractor->Extract(archivePath.c_str(), directory.c_str(), nullptr); FAILED(hr))
+        {
+            Log::Error(L"Failed to extract fixture '{}' [{}]", archivePath.c_str(), SystemError(hr));
+            return {};
+        }
+
+        it = registry.Archives.emplace(std::wstring(archive), extractor->GetExtractedItems()).first;
+    }
+
+    const auto fragment = boost::algorithm::to_lower_copy(std::wstring(nameFragment));
+    for (const auto& [name, path] : it->second)
+    {
+        if (boost::algorithm::to_lower_copy(name).find(fragment) != std::wstring::npos)
+        {
+            return path;
+        }
+    }
+
+    Log::Error(L"No item matching '{}' in fixture '{}'", nameFragment, archive);
+    return {};
+}
+
+void RemoveFixtures()
+{
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.Lock);
+
+    if (!registry.ExtractDirectory.empty())
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(registry.ExtractDirectory, ec);
+        if (ec)
+        {
+            Log::Warn(L"Failed to remove extracted fixtures '{}' [{}]", registry.ExtractDirectory.c_str(), ec);
+        }
+    }
+
+    registry.Archives.clear();
+}
+
+}  // namespace Orc::Benchmark
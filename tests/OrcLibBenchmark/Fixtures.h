@@ -0,0 +1,31 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <string_view>
+
+namespace Orc::Benchmark {
+
+// Benchmarks run against the OrcLibTest fixtures (ntfs_images, fat_images, usn_journal, binaries)
+const std::filesystem::path& GetDataDirectory();
+void SetDataDirectory(const std::filesystem::path& directory);
+
+// Optional registry hive to walk, there is no hive among the fixtures
+const std::optional<std::filesystem::path>& GetHivePath();
+void SetHivePath(const std::filesystem::path& path);
+
+// Extracts the 7z 'archive' (relative to the data directory) once per run and returns the path of its extracted item
+// whose name contains 'nameFragment'
+std::optional<std::filesystem::path> GetFixture(std::wstring_view archive, std::wstring_view nameFragment);
+
+// Deletes the extracted fixtures
+void RemoveFixtures();
+
+}  // namespace Orc::Benchmark
@@ -0,0 +1,62 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include "Fixtures.h"
+
+// Google Benchmark options, plus:
+//   --data=<directory>   directory holding the OrcLibTest fixtures
+//   --hive=<file>        registry hive to walk
+//
+// Results are machine readable with '--benchmark_out=<file.json> --benchmark_out_format=json'
+int wmain(int argc, wchar_t* argv[])
+{
+    using namespace Orc::Benchmark;
+
+    // Benchmark arguments are ANSI, they do not hold paths
+    std::vector<std::string> ansiArgs;
+    for (int i = 0; i < argc; ++i)
+    {
+        if (!_wcsnicmp(argv[i], L"--data=", wcslen(L"--data=")))
+        {
+            SetDataDirectory(argv[i] + wcslen(L"--data="));
+        }
+        else if (!_wcsnicmp(argv[i], L"--hive=", wcslen(L"--hive=")))
+        {
+            SetHivePath(argv[i] + wcslen(L"--hive="));
+        }
+        else
+        {
+            const auto length = WideCharToMultiByte(CP_ACP, 0, argv[i], -1, nullptr, 0, nullptr, nullptr);
+            std::string arg((std::max)(length, 1), '\0');
+            WideCharToMultiByte(CP_ACP, 0, argv[i], -1, arg.data(), length, nullptr, nullptr);
+            arg.resize(arg.size() - 1);
+            ansiArgs.push_back(std::move(arg));
+        }
+    }
+
+    std::vector<char*> args;
+    for (auto& arg : ansiArgs)
+    {
+        args.push_back(arg.data());
+    }
+
+    int benchmarkArgc = static_cast<int>(args.size());
+    benchmark::Initialize(&benchmarkArgc, args.data());
+    if (benchmark::ReportUnrecognizedArguments(benchmarkArgc, args.data()))
+    {
+        return 1;
+    }
+
+    benchmark::AddCustomContext("data", GetDataDirectory().string());
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    RemoveFixtures();
+    return 0;
+}
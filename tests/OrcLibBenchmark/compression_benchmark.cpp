@@ -0,0 +1,214 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include "Fixtures.h"
+
+#include <fstream>
+
+#include "MemoryStream.h"
+#include "NTFSCompression.h"
+#include "UncompressWofStream.h"
+#include "Filesystem/Ntfs/Compression/Engine/Nt/NtAlgorithm.h"
+#include "Filesystem/Ntfs/Compression/Engine/Nt/NtApi.h"
+
+using namespace Orc;
+using namespace Orc::Benchmark;
+
+namespace {
+
+constexpr size_t kCompressionUnitSize = 0x10000;
+constexpr size_t kWofChunkSize = 4096;
+
+std::vector<uint8_t> ReadBinaryFixture()
+{
+    const auto path = GetDataDirectory() / L"binaries" / L"ntfsinfo.exe";
+
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<uint8_t>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+std::vector<uint8_t> Compress(NtAlgorithm algorithm, const uint8_t* data, size_t size, ULONG chunkSize)
+{
+    const auto format = static_cast<USHORT>(algorithm);
+
+    std::error_code ec;
+    ULONG workspaceSize = 0, fragmentWorkspaceSize = 0;
+    RtlGetCompressionWorkSpaceSize(format, &workspaceSize, &fragmentWorkspaceSize, ec);
+    if (ec)
+    {
+        return {};
+    }
+
+    std::vector<uint8_t> workspace(workspaceSize);
+    std::vector<uint8_t> compressed(size * 2);
+
+    ULONG compressedSize = 0;
+    RtlCompressBuffer(
+        format,
+        const_cast<uint8_t*>(data),
+        static_cast<ULONG>(size),
+        compressed.data(),
+        static_cast<ULONG>(compressed.size()),
+        chunkSize,
+        &compressedSize,
+        workspace.data(),
+        ec);
+    if (ec || compressedSize >= size)
+    {
+        return {};
+    }
+
+    compressed.resize(compressedSize);
+    return compressed;
+}
+
+// Compression units of ntfsinfo.exe padded with zeroes as read from the volume, incompressible units are skipped as
+// NTFS stores them as is
+std::vector<std::vector<uint8_t>> GetLZNT1Units()
+{
+    const auto data = ReadBinaryFixture();
+
+    std::vector<std::vector<uint8_t>> units;
+    for (size_t offset = 0; offset + kCompressionUnitSize <= data.size(); offset += kCompressionUnitSize)
+    {
+        auto unit = Compress(NtAlgorithm::kLznt1, data.data() + offset, kCompressionUnitSize, 4096);
+        if (!unit.empty())
+        {
+            unit.resize(kCompressionUnitSize, 0);
+            units.push_back(std::move(unit));
+        }
+    }
+
+    return units;
+}
+
+template <typename DecompressT>
+void DecompressLZNT1(benchmark::State& state, DecompressT decompress)
+{
+    auto units = GetLZNT1Units();
+    if (units.empty())
+    {
+        state.SkipWithError("Missing binaries\\ntfsinfo.exe");
+        return;
+    }
+
+    std::vector<uint8_t> output(kCompressionUnitSize);
+    for (auto _ : state)
+    {
+        for (auto& unit : units)
+        {
+            decompress(unit, output);
+            benchmark::DoNotOptimize(output.data());
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * units.size() * kCompressionUnitSize);
+}
+
+void BM_LZNT1Decompression(benchmark::State& state)
+{
+    DecompressLZNT1(state, [](std::vector<uint8_t>& unit, std::vector<uint8_t>& output) {
+        ntfs_decompress(output.data(), output.size(), unit.data(), unit.size());
+    });
+}
+
+// Previous decoder, for comparison
+void BM_LZNT1DecompressionCompunit(benchmark::State& state)
+{
+    DecompressLZNT1(state, [](std::vector<uint8_t>& unit, std::vector<uint8_t>& output) {
+        NTFS_COMP_INFO info;
+        info.buf_size_b = output.size();
+        info.comp_buf = reinterpret_cast<char*>(unit.data());
+        info.comp_len = unit.size();
+        info.uncomp_buf = reinterpret_cast<char*>(output.data());
+        info.uncomp_idx = 0L;
+        ntfs_uncompress_compunit(&info);
+    });
+}
+
+void BM_LZNT1DecompressionRtl(benchmark::State& state)
+{
+    DecompressLZNT1(state, [](std::vector<uint8_t>& unit, std::vector<uint8_t>& output) {
+        std::error_code ec;
+        ULONG processed = 0;
+        RtlDecompressBuffer(
+            static_cast<USHORT>(NtAlgorithm::kLznt1),
+            output.data(),
+            static_cast<ULONG>(output.size()),
+            unit.data(),
+            static_cast<ULONG>(unit.size()),
+            &processed,
+            ec);
+    });
+}
+
+BENCHMARK(BM_LZNT1Decompression);
+BENCHMARK(BM_LZNT1DecompressionCompunit);
+BENCHMARK(BM_LZNT1DecompressionRtl);
+
+// WofCompressedData stream of ntfsinfo.exe: chunk offsets table followed by the chunks
+void BM_WofDecompression(benchmark::State& state)
+{
+    const auto data = ReadBinaryFixture();
+    if (data.empty())
+    {
+        state.SkipWithError("Missing binaries\\ntfsinfo.exe");
+        return;
+    }
+
+    std::vector<uint32_t> table;
+    std::vector<uint8_t> chunks;
+    for (size_t offset = 0; offset < data.size(); offset += kWofChunkSize)
+    {
+        const auto size = (std::min)(kWofChunkSize, data.size() - offset);
+
+        auto chunk = Compress(NtAlgorithm::kXpressHuffman, data.data() + offset, size, kWofChunkSize);
+        if (chunk.empty())
+        {
+            chunk.assign(data.data() + offset, data.data() + offset + size);
+        }
+
+        chunks.insert(std::end(chunks), std::cbegin(chunk), std::cend(chunk));
+        table.push_back(static_cast<uint32_t>(chunks.size()));
+    }
+    table.pop_back();
+
+    auto rawStream = std::make_shared<MemoryStream>();
+    ULONGLONG written = 0;
+    if (FAILED(rawStream->OpenForReadWrite())
+        || FAILED(rawStream->Write(table.data(), table.size() * sizeof(uint32_t), &written))
+        || FAILED(rawStream->Write(chunks.data(), chunks.size(), &written)))
+    {
+        state.SkipWithError("Failed to build WofCompressedData stream");
+        return;
+    }
+
+    std::vector<uint8_t> output(data.size());
+    for (auto _ : state)
+    {
+        rawStream->SetFilePointer(0LL, FILE_BEGIN, nullptr);
+
+        auto wofStream = std::make_shared<UncompressWofStream>();
+        ULONGLONG read = 0;
+        if (FAILED(wofStream->Open(rawStream, Ntfs::WofAlgorithm::kXpress4k, data.size()))
+            || FAILED(wofStream->Read(output.data(), output.size(), &read)))
+        {
+            state.SkipWithError("WOF decompression failed");
+            return;
+        }
+
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+BENCHMARK(BM_WofDecompression)->Unit(benchmark::kMillisecond);
+
+}  // namespace
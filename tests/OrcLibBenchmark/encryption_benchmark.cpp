@@ -0,0 +1,135 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include <random>
+
+#include "AeadStream.h"
+#include "DevNullStream.h"
+#include "EncodeMessageStream.h"
+
+using namespace Orc;
+
+namespace {
+
+constexpr size_t kEncryptedSize = 64 * 1024 * 1024;
+constexpr size_t kWriteSize = 1024 * 1024;
+constexpr auto kContainer = L"OrcLibBenchmark_Encryption";
+
+const std::vector<uint8_t>& GetPlainData()
+{
+    static const std::vector<uint8_t> data = []() {
+        std::vector<uint8_t> data(kEncryptedSize);
+        std::mt19937 random(42);
+        std::generate(std::begin(data), std::end(data), [&random]() { return static_cast<uint8_t>(random()); });
+        return data;
+    }();
+
+    return data;
+}
+
+// DER encoded self signed recipient, only its public key is used to wrap content keys
+const CBinaryBuffer& GetRecipient()
+{
+    static const CBinaryBuffer certificate = []() {
+        CBinaryBuffer certificate;
+
+        HCRYPTPROV hProv = NULL;
+        CryptAcquireContextW(&hProv, kContainer, MS_ENH_RSA_AES_PROV_W, PROV_RSA_AES, CRYPT_DELETEKEYSET);
+        if (!CryptAcquireContextW(&hProv, kContainer, MS_ENH_RSA_AES_PROV_W, PROV_RSA_AES, CRYPT_NEWKEYSET))
+            return certificate;
+
+        HCRYPTKEY hKey = NULL;
+        if (CryptGenKey(hProv, AT_KEYEXCHANGE, 2048 << 16, &hKey))
+        {
+            CryptDestroyKey(hKey);
+
+            BYTE name[256];
+            CERT_NAME_BLOB subject = {sizeof(name), name};
+            CertStrToNameW(
+                X509_ASN_ENCODING,
+                L"CN=OrcLibBenchmark",
+                CERT_X500_NAME_STR,
+                NULL,
+                subject.pbData,
+                &subject.cbData,
+                NULL);
+
+            if (auto pCertContext = CertCreateSelfSignCertificate(hProv, &subject, 0L, NULL, NULL, NULL, NULL, NULL))
+            {
+                certificate.SetData(pCertContext->pbCertEncoded, pCertContext->cbCertEncoded);
+                CertFreeCertificateContext(pCertContext);
+            }
+        }
+
+        CryptReleaseContext(hProv, 0L);
+        CryptAcquireContextW(&hProv, kContainer, MS_ENH_RSA_AES_PROV_W, PROV_RSA_AES, CRYPT_DELETEKEYSET);
+        return certificate;
+    }();
+
+    return certificate;
+}
+
+// Archive encryption as done by WolfLauncher: writes of 'kWriteSize' bytes in a stream chained to a sink
+template <typename StreamT, typename... Args>
+void EncryptStream(benchmark::State& state, Args&&... args)
+{
+    const auto& data = GetPlainData();
+    const auto& recipient = GetRecipient();
+    if (recipient.empty())
+    {
+        state.SkipWithError("Failed to create recipient certificate");
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        auto sink = std::make_shared<DevNullStream>();
+        sink->Open();
+
+        auto stream = std::make_shared<StreamT>(std::forward<Args>(args)...);
+        if (FAILED(stream->AddRecipient(recipient)) || FAILED(stream->Initialize(sink)))
+        {
+            state.SkipWithError("Failed to initialize encryption stream");
+            return;
+        }
+
+        for (size_t offset = 0; offset < data.size(); offset += kWriteSize)
+        {
+            ULONGLONG written = 0;
+            const auto size = (std::min)(kWriteSize, data.size() - offset);
+            stream->Write(const_cast<uint8_t*>(data.data()) + offset, size, &written);
+        }
+
+        benchmark::DoNotOptimize(stream->Close());
+    }
+
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+void BM_EncryptCMS(benchmark::State& state)
+{
+    EncryptStream<EncodeMessageStream>(state);
+}
+
+void BM_EncryptAES256GCM(benchmark::State& state)
+{
+    EncryptStream<AeadEncryptStream>(state, AeadStream::Algorithm::AES256GCM, static_cast<ULONG>(state.range(0)));
+}
+
+void BM_EncryptChaCha20Poly1305(benchmark::State& state)
+{
+    EncryptStream<AeadEncryptStream>(
+        state, AeadStream::Algorithm::ChaCha20Poly1305, static_cast<ULONG>(state.range(0)));
+}
+
+BENCHMARK(BM_EncryptCMS)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_EncryptAES256GCM)->Arg(64 * 1024)->Arg(256 * 1024)->Arg(1024 * 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_EncryptChaCha20Poly1305)->Arg(256 * 1024)->Unit(benchmark::kMillisecond);
+
+}  // namespace
@@ -0,0 +1,237 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include "Fixtures.h"
+
+#include "Location.h"
+#include "VolumeReader.h"
+#include "MFTWalker.h"
+#include "FileFind.h"
+#include "FatWalker.h"
+
+using namespace Orc;
+using namespace Orc::Benchmark;
+
+namespace {
+
+// First partition of a disk image fixture
+std::shared_ptr<Location> GetImageLocation(std::wstring_view archive)
+{
+    const auto image = GetFixture(archive, L"");
+    if (!image)
+    {
+        return nullptr;
+    }
+
+    auto location = std::make_shared<Location>(image->wstring() + L",part=1", Location::Type::ImageFileDisk);
+    if (FAILED(location->GetReader()->LoadDiskProperties()))
+    {
+        return nullptr;
+    }
+
+    return location;
+}
+
+// Records only, without names
+void BM_MFTEnumeration(benchmark::State& state)
+{
+    const auto location = GetImageLocation(L"ntfs_images\\ntfs.7z");
+    if (location == nullptr)
+    {
+        state.SkipWithError("Missing NTFS image");
+        return;
+    }
+
+    uint64_t records = 0;
+    for (auto _ : state)
+    {
+        MFTWalker walker;
+        MFTWalker::Callbacks callbacks;
+        callbacks.ElementCallback = [&records](const std::shared_ptr<VolumeReader>& volreader, MFTRecord* pElt) {
+            ++records;
+        };
+
+        if (FAILED(walker.Initialize(location, ResurrectRecordsMode::kNo)) || FAILED(walker.Walk(callbacks)))
+        {
+            state.SkipWithError("MFT walk failed");
+            return;
+        }
+    }
+
+    state.counters["records"] = benchmark::Counter(static_cast<double>(records), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_MFTEnumeration)->Unit(benchmark::kMillisecond);
+
+// Records, file names and data attributes, with the full name of every file as NTFSInfo does
+// Argument: memory limit of the walk (0: none), a small one makes pending records spill and paths be rebuilt
+void BM_MFTWalk(benchmark::State& state)
+{
+    const auto location = GetImageLocation(L"ntfs_images\\ntfs.7z");
+    if (location == nullptr)
+    {
+        state.SkipWithError("Missing NTFS image");
+        return;
+    }
+
+    uint64_t files = 0;
+    for (auto _ : state)
+    {
+        MFTWalker walker;
+        MFTWalker::Callbacks callbacks;
+        callbacks.FileNameAndDataCallback = [&walker, &files](
+                                                const std::shared_ptr<VolumeReader>& volreader,
+                                                MFTRecord* pElt,
+                                                const PFILE_NAME pFileName,
+                                                const std::shared_ptr<DataAttribute>& pDataAttr) {
+            benchmark::DoNotOptimize(walker.GetFullNameBuilder()(pFileName, pDataAttr));
+            ++files;
+        };
+        callbacks.DirectoryCallback = [&walker, &files](
+                                          const std::shared_ptr<VolumeReader>& volreader,
+                                          MFTRecord* pElt,
+                                          const PFILE_NAME pFileName,
+                                          const std::shared_ptr<IndexAllocationAttribute>& pAttr) {
+            benchmark::DoNotOptimize(walker.GetFullNameBuilder()(pFileName, nullptr));
+            ++files;
+        };
+
+        walker.SetMemoryLimit(state.range(0));
+        if (FAILED(walker.Initialize(location, ResurrectRecordsMode::kNo)) || FAILED(walker.Walk(callbacks)))
+        {
+            state.SkipWithError("MFT walk failed");
+            return;
+        }
+    }
+
+    state.counters["files"] = benchmark::Counter(static_cast<double>(files), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_MFTWalk)->Arg(0)->Arg(64 * 1024)->Unit(benchmark::kMillisecond);
+
+// Directory walk with NTFSInfo's I30 output: index entries and slack carving of every directory
+void BM_MFTWalkI30(benchmark::State& state)
+{
+    const auto location = GetImageLocation(L"ntfs_images\\ntfs.7z");
+    if (location == nullptr)
+    {
+        state.SkipWithError("Missing NTFS image");
+        return;
+    }
+
+    uint64_t entries = 0;
+    for (auto _ : state)
+    {
+        MFTWalker walker;
+        MFTWalker::Callbacks callbacks;
+        callbacks.DirectoryCallback = [&walker](
+                                          const std::shared_ptr<VolumeReader>& volreader,
+                                          MFTRecord* pElt,
+                                          const PFILE_NAME pFileName,
+                                          const std::shared_ptr<IndexAllocationAttribute>& pAttr) {
+            benchmark::DoNotOptimize(walker.GetFullNameBuilder()(pFileName, nullptr));
+        };
+        callbacks.I30Callback = [&entries](
+                                    const std::shared_ptr<VolumeReader>& volreader,
+                                    MFTRecord* pElt,
+                                    const PINDEX_ENTRY pEntry,
+                                    const PFILE_NAME pFileName,
+                                    bool bCarvedEntry) {
+            benchmark::DoNotOptimize(pFileName->FileNameLength);
+            ++entries;
+        };
+
+        if (FAILED(walker.Initialize(location, ResurrectRecordsMode::kNo)) || FAILED(walker.Walk(callbacks)))
+        {
+            state.SkipWithError("MFT walk failed");
+            return;
+        }
+    }
+
+    state.counters["entries"] = benchmark::Counter(static_cast<double>(entries), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_MFTWalkI30)->Unit(benchmark::kMillisecond);
+
+// Name, size and path terms as found in the usual GetThis configurations
+void BM_FileFindMatch(benchmark::State& state)
+{
+    const auto location = GetImageLocation(L"ntfs_images\\ntfs.7z");
+    if (location == nullptr)
+    {
+        state.SkipWithError("Missing NTFS image");
+        return;
+    }
+
+    uint64_t matches = 0;
+    for (auto _ : state)
+    {
+        FileFind finder(false, CryptoHashStream::Algorithm::Undefined, false);
+
+        finder.AddTerm(std::make_shared<FileFind::SearchTerm>(L"notepad.exe"));
+
+        auto sizeTerm = std::make_shared<FileFind::SearchTerm>();
+        sizeTerm->Required = FileFind::SearchTerm::Criteria::SIZE_GT;
+        sizeTerm->SizeG = 100000;
+        finder.AddTerm(sizeTerm);
+
+        auto pathTerm = std::make_shared<FileFind::SearchTerm>();
+        pathTerm->Required = FileFind::SearchTerm::Criteria::PATH_MATCH;
+        pathTerm->Path = L"\\*\\*.txt";
+        finder.AddTerm(pathTerm);
+
+        const auto hr = finder.Find(
+            location,
+            [&matches](const std::shared_ptr<FileFind::Match>& aMatch, bool& bStop) { ++matches; },
+            false,
+            ResurrectRecordsMode::kNo);
+        if (FAILED(hr))
+        {
+            state.SkipWithError("FileFind failed");
+            return;
+        }
+    }
+
+    state.counters["matches"] = benchmark::Counter(static_cast<double>(matches), benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK(BM_FileFindMatch)->Unit(benchmark::kMillisecond);
+
+void BM_FatWalk(benchmark::State& state)
+{
+    const auto location = GetImageLocation(L"fat_images\\FAT32.7z");
+    if (location == nullptr)
+    {
+        state.SkipWithError("Missing FAT32 image");
+        return;
+    }
+
+    uint64_t entries = 0;
+    for (auto _ : state)
+    {
+        FatWalker::Callbacks callbacks;
+        callbacks.m_FileEntryCall = [&entries](
+                                        const std::shared_ptr<VolumeReader>& volreader,
+                                        const WCHAR* szFullName,
+                                        const std::shared_ptr<FatFileEntry>& fileEntry) { ++entries; };
+
+        FatWalker walker;
+        if (FAILED(walker.Init(location, false)) || FAILED(walker.Process(callbacks)))
+        {
+            state.SkipWithError("FAT walk failed");
+            return;
+        }
+    }
+
+    state.counters["entries"] = benchmark::Counter(static_cast<double>(entries), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_FatWalk)->Unit(benchmark::kMillisecond);
+
+}  // namespace
@@ -0,0 +1,171 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include <random>
+#include <unordered_map>
+
+#include "Utils/FlatHashMap.h"
+
+using namespace Orc;
+
+namespace {
+
+constexpr size_t kRecordCount = 5000000;
+
+size_t g_allocatedBytes = 0;
+
+// Tracks the memory allocated by std::unordered_map nodes and buckets
+template <typename T>
+struct CountingAllocator
+{
+    using value_type = T;
+
+    CountingAllocator() = default;
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&)
+    {
+    }
+
+    T* allocate(size_t count)
+    {
+        g_allocatedBytes += count * sizeof(T);
+        return std::allocator<T>().allocate(count);
+    }
+
+    void deallocate(T* p, size_t count)
+    {
+        g_allocatedBytes -= count * sizeof(T);
+        std::allocator<T>().deallocate(p, count);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U>&) const
+    {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const CountingAllocator<U>&) const
+    {
+        return false;
+    }
+};
+
+using UnorderedMap = std::unordered_map<
+    ULONGLONG,
+    void*,
+    std::hash<ULONGLONG>,
+    std::equal_to<ULONGLONG>,
+    CountingAllocator<std::pair<const ULONGLONG, void*>>>;
+
+using FlatMap = FlatHashMap<ULONGLONG, void*>;
+
+size_t GetMemoryUsage(const UnorderedMap&)
+{
+    return g_allocatedBytes;
+}
+
+size_t GetMemoryUsage(const FlatMap& map)
+{
+    return map.GetMemoryUsage();
+}
+
+// File reference numbers of a synthetic MFT: dense segment numbers with their sequence number in the high bits
+const std::vector<ULONGLONG>& GetFileReferences()
+{
+    static const std::vector<ULONGLONG> references = []() {
+        std::mt19937_64 random(42);
+
+        std::vector<ULONGLONG> references;
+        references.reserve(kRecordCount);
+        for (ULONGLONG segment = 0; segment < kRecordCount; ++segment)
+        {
+            references.push_back(segment | ((1 + random() % 64) << 48));
+        }
+
+        return references;
+    }();
+
+    return references;
+}
+
+// Parent lookups of a directory walk: mostly recent directories, some missing references
+const std::vector<ULONGLONG>& GetLookups()
+{
+    static const std::vector<ULONGLONG> lookups = []() {
+        const auto& references = GetFileReferences();
+        std::mt19937_64 random(7);
+
+        std::vector<ULONGLONG> lookups;
+        lookups.reserve(kRecordCount);
+        for (size_t i = 0; i < kRecordCount; ++i)
+        {
+            lookups.push_back(i % 16 ? references[random() % kRecordCount] : references[i] + (1ULL << 48));
+        }
+
+        return lookups;
+    }();
+
+    return lookups;
+}
+
+template <typename MapT>
+void BM_MFTMapInsert(benchmark::State& state)
+{
+    const auto& references = GetFileReferences();
+
+    size_t memory = 0;
+    for (auto _ : state)
+    {
+        g_allocatedBytes = 0;
+
+        MapT map;
+        for (const auto reference : references)
+        {
+            map.insert({reference, nullptr});
+        }
+
+        memory = GetMemoryUsage(map);
+    }
+
+    state.counters["memory"] = static_cast<double>(memory);
+    state.SetItemsProcessed(state.iterations() * references.size());
+}
+
+template <typename MapT>
+void BM_MFTMapFind(benchmark::State& state)
+{
+    const auto& lookups = GetLookups();
+
+    MapT map;
+    for (const auto reference : GetFileReferences())
+    {
+        map.insert({reference, nullptr});
+    }
+
+    for (auto _ : state)
+    {
+        size_t found = 0;
+        for (const auto reference : lookups)
+        {
+            found += map.find(reference) != std::end(map) ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(found);
+    }
+
+    state.SetItemsProcessed(state.iterations() * lookups.size());
+}
+
+BENCHMARK_TEMPLATE(BM_MFTMapInsert, UnorderedMap)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_MFTMapInsert, FlatMap)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_MFTMapFind, UnorderedMap)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_MFTMapFind, FlatMap)->Unit(benchmark::kMillisecond);
+
+}  // namespace
@@ -0,0 +1,98 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include <random>
+
+#include "CryptoHashStream.h"
+#include "FuzzyHashStream.h"
+
+using namespace Orc;
+
+namespace {
+
+constexpr size_t kHashedSize = 16 * 1024 * 1024;
+
+const std::vector<uint8_t>& GetHashedData()
+{
+    static const std::vector<uint8_t> data = []() {
+        std::vector<uint8_t> data(kHashedSize);
+        std::mt19937 random(42);
+        std::generate(std::begin(data), std::end(data), [&random]() { return static_cast<uint8_t>(random()); });
+        return data;
+    }();
+
+    return data;
+}
+
+// Writes of 'range(0)' bytes, as done by the hash streams chained behind the file readers, then gets the 'result' hash
+template <typename HashStreamT, typename AlgorithmT>
+void HashStream(benchmark::State& state, AlgorithmT algorithms, AlgorithmT result)
+{
+    const auto& data = GetHashedData();
+    const auto writeSize = static_cast<size_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        auto stream = std::make_shared<HashStreamT>();
+        if (FAILED(stream->OpenToWrite(algorithms, nullptr)))
+        {
+            state.SkipWithError("Failed to open hash stream");
+            return;
+        }
+
+        for (size_t offset = 0; offset < data.size(); offset += writeSize)
+        {
+            ULONGLONG written = 0;
+            const auto size = (std::min)(writeSize, data.size() - offset);
+            stream->Write(const_cast<uint8_t*>(data.data()) + offset, size, &written);
+        }
+
+        CBinaryBuffer hash;
+        benchmark::DoNotOptimize(stream->GetHash(result, hash));
+    }
+
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+void BM_HashMD5(benchmark::State& state)
+{
+    HashStream<CryptoHashStream>(state, CryptoHashStream::Algorithm::MD5, CryptoHashStream::Algorithm::MD5);
+}
+
+void BM_HashSHA1(benchmark::State& state)
+{
+    HashStream<CryptoHashStream>(state, CryptoHashStream::Algorithm::SHA1, CryptoHashStream::Algorithm::SHA1);
+}
+
+void BM_HashSHA256(benchmark::State& state)
+{
+    HashStream<CryptoHashStream>(state, CryptoHashStream::Algorithm::SHA256, CryptoHashStream::Algorithm::SHA256);
+}
+
+// GetThis and NTFSInfo default: every crypto hash at once
+void BM_HashAll(benchmark::State& state)
+{
+    HashStream<CryptoHashStream>(
+        state,
+        CryptoHashStream::Algorithm::MD5 | CryptoHashStream::Algorithm::SHA1 | CryptoHashStream::Algorithm::SHA256,
+        CryptoHashStream::Algorithm::SHA256);
+}
+
+void BM_HashTLSH(benchmark::State& state)
+{
+    HashStream<FuzzyHashStream>(state, FuzzyHashStream::Algorithm::TLSH, FuzzyHashStream::Algorithm::TLSH);
+}
+
+BENCHMARK(BM_HashMD5)->Arg(4096)->Arg(1024 * 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_HashSHA1)->Arg(4096)->Arg(1024 * 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_HashSHA256)->Arg(4096)->Arg(1024 * 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_HashAll)->Arg(4096)->Arg(1024 * 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_HashTLSH)->Arg(1024 * 1024)->Unit(benchmark::kMillisecond);
+
+}  // namespace
@@ -0,0 +1,68 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include "Fixtures.h"
+
+#include "FileStream.h"
+#include "RegistryWalker.h"
+
+using namespace Orc;
+using namespace Orc::Benchmark;
+
+namespace {
+
+// Walk of every key and value of the hive given with '--hive=<file>' (ex: a copy of a SOFTWARE hive), as RegInfo does
+void BM_RegistryHiveWalk(benchmark::State& state)
+{
+    const auto& hivePath = GetHivePath();
+    if (!hivePath)
+    {
+        state.SkipWithError("No hive given with --hive=<file>");
+        return;
+    }
+
+    uint64_t keys = 0;
+    uint64_t values = 0;
+    for (auto _ : state)
+    {
+        FileStream stream;
+        if (FAILED(stream.ReadFrom(hivePath->c_str())))
+        {
+            state.SkipWithError("Failed to open hive");
+            return;
+        }
+
+        RegistryHive hive;
+        if (FAILED(hive.LoadHive(stream)))
+        {
+            state.SkipWithError("Failed to load hive");
+            return;
+        }
+
+        const auto hr = hive.Walk(
+            [&keys](const RegistryKey* const pKey) { ++keys; },
+            [&values](const RegistryValue* const pValue) {
+                const BYTE* pDatas = nullptr;
+                benchmark::DoNotOptimize(pValue->GetDatas(&pDatas));
+                ++values;
+            });
+        if (FAILED(hr))
+        {
+            state.SkipWithError("Failed to walk hive");
+            return;
+        }
+    }
+
+    state.counters["keys"] = benchmark::Counter(static_cast<double>(keys), benchmark::Counter::kIsRate);
+    state.counters["values"] = benchmark::Counter(static_cast<double>(values), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_RegistryHiveWalk)->Unit(benchmark::kMillisecond);
+
+}  // namespace
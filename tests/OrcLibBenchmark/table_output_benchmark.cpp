@@ -0,0 +1,156 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include "TableOutput.h"
+#include "TableOutputWriter.h"
+#include "DevNullStream.h"
+
+using namespace std::string_view_literals;
+
+using namespace Orc;
+using namespace Orc::TableOutput;
+
+namespace {
+
+constexpr UINT kRows = 50000;
+
+// Subset of NTFSInfo's 'fileinfo' table with its column types and formats
+Schema GetFileInfoSchema()
+{
+    return Schema {
+        {ColumnType::UTF8Type, L"ComputerName"},
+        {ColumnType::UInt64Type, L"VolumeID", std::nullopt, L"0x{:016X}"},
+        {ColumnType::UTF16Type, L"File"},
+        {ColumnType::UTF16Type, L"ParentName"},
+        {ColumnType::UTF16Type, L"FullName"},
+        {ColumnType::UInt64Type, L"SizeInBytes"},
+        {ColumnType::UTF8Type, L"Attributes"},
+        {ColumnType::TimeStampType, L"CreationDate"},
+        {ColumnType::TimeStampType, L"LastModificationDate"},
+        {ColumnType::TimeStampType, L"LastAccessDate"},
+        {ColumnType::TimeStampType, L"LastAttrChangeDate"},
+        {ColumnType::UInt64Type, L"USN", std::nullopt, L"0x{:016X}"},
+        {ColumnType::UInt64Type, L"FRN", std::nullopt, L"0x{:016X}"},
+        {ColumnType::UInt64Type, L"ParentFRN", std::nullopt, L"0x{:016X}"},
+        {ColumnType::BoolType, L"RecordInUse"},
+        {ColumnType::BinaryType, L"MD5", std::nullopt, L"{:02X}"},
+        {ColumnType::BinaryType, L"SHA1", std::nullopt, L"{:02X}"}};
+}
+
+void WriteRows(IWriter& output)
+{
+    FILETIME now {0};
+    GetSystemTimeAsFileTime(&now);
+
+    const BYTE hash[20] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF, 0x10, 0x32,
+                           0x54, 0x76, 0x98, 0xBA, 0xDC, 0xFE, 0x00, 0x11, 0x22, 0x33};
+
+    for (UINT i = 0; i < kRows; i++)
+    {
+        output.WriteString("WORKSTATION"sv);
+        output.WriteInteger((ULONGLONG)0x1234567890ABCDEFULL);
+        output.WriteString(L"msvcp140.dll"sv);
+        output.WriteString(L"\\Windows\\WinSxS\\amd64_microsoft-windows-servicingstack_31bf3856ad364e35"sv);
+        output.WriteString(
+            L"\\Windows\\WinSxS\\amd64_microsoft-windows-servicingstack_31bf3856ad364e35\\msvcp140.dll"sv);
+        output.WriteFileSize((ULONGLONG)i * 4096);
+        output.WriteAttributes(FILE_ATTRIBUTE_ARCHIVE);
+        for (UINT j = 0; j < 4; j++)
+        {
+            output.WriteFileTime(now);
+        }
+        output.WriteInteger((ULONGLONG)i * 7);
+        output.WriteInteger((ULONGLONG)i);
+        output.WriteInteger((ULONGLONG)5);
+        output.WriteBool(true);
+        output.WriteBytes(hash, 16);
+        output.WriteBytes(hash, 20);
+        output.WriteEndOfLine();
+    }
+}
+
+template <typename MakeWriterT>
+void WriteTable(benchmark::State& state, MakeWriterT makeWriter)
+{
+    const auto path = std::filesystem::temp_directory_path()
+        / fmt::format(L"OrcLibBenchmark_{}_{}.out", GetCurrentProcessId(), state.thread_index());
+
+    for (auto _ : state)
+    {
+        auto writer = makeWriter();
+        if (writer == nullptr)
+        {
+            state.SkipWithError("Table format is not available");
+            return;
+        }
+
+        if (FAILED(writer->SetSchema(GetFileInfoSchema())) || FAILED(writer->WriteToFile(path)))
+        {
+            state.SkipWithError("Failed to create table file");
+            return;
+        }
+
+        WriteRows(*writer);
+        writer->Close();
+    }
+
+    std::error_code ec;
+    state.counters["file_size"] = static_cast<double>(std::filesystem::file_size(path, ec));
+    std::filesystem::remove(path, ec);
+
+    state.SetItemsProcessed(state.iterations() * kRows);
+}
+
+// Argument: buffers written by a background I/O thread (0: writes from the caller thread)
+void BM_TableOutputCSV(benchmark::State& state)
+{
+    WriteTable(state, [&state]() {
+        auto options = std::make_unique<CSV::Options>();
+        options->dwAsyncBufferCount = static_cast<DWORD>(state.range(0));
+        return GetCSVWriter(std::move(options));
+    });
+}
+
+// Formatting only: rows are written to a null stream
+void BM_TableOutputCSVFormatting(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        auto writer = GetCSVWriter(std::make_unique<CSV::Options>());
+        if (FAILED(writer->SetSchema(GetFileInfoSchema()))
+            || FAILED(writer->WriteToStream(std::make_shared<DevNullStream>())))
+        {
+            state.SkipWithError("Failed to create table");
+            return;
+        }
+
+        WriteRows(*writer);
+        writer->Close();
+    }
+
+    state.SetItemsProcessed(state.iterations() * kRows);
+}
+
+// Parquet and ORC writers live in extension libraries which may not be built
+void BM_TableOutputParquet(benchmark::State& state)
+{
+    WriteTable(state, []() { return GetParquetWriter(std::make_unique<Parquet::Options>()); });
+}
+
+void BM_TableOutputApacheOrc(benchmark::State& state)
+{
+    WriteTable(state, []() { return GetApacheOrcWriter(std::make_unique<ApacheOrc::Options>()); });
+}
+
+BENCHMARK(BM_TableOutputCSV)->Arg(0)->Arg(2)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TableOutputCSVFormatting)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TableOutputParquet)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TableOutputApacheOrc)->Unit(benchmark::kMillisecond);
+
+}  // namespace
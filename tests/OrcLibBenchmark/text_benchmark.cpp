@@ -0,0 +1,197 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include <random>
+
+#include "Text/FileTime.h"
+#include "Text/Utf16ToUtf8.h"
+
+using namespace Orc;
+
+namespace {
+
+constexpr size_t kTimestampRows = 200000;
+
+// Timestamps of an NTFSInfo row: $STANDARD_INFORMATION and $FILE_NAME dates, mostly within the same few days
+const std::vector<FILETIME>& GetNTFSInfoTimestamps()
+{
+    static const std::vector<FILETIME> timestamps = []() {
+        std::mt19937_64 random(42);
+
+        FILETIME now;
+        GetSystemTimeAsFileTime(&now);
+        const ULONGLONG ullNow = (static_cast<ULONGLONG>(now.dwHighDateTime) << 32) | now.dwLowDateTime;
+        constexpr ULONGLONG kDay = 24ULL * 3600ULL * 10000000ULL;
+
+        std::vector<FILETIME> timestamps;
+        timestamps.reserve(kTimestampRows * 8);
+
+        for (size_t i = 0; i < kTimestampRows; ++i)
+        {
+            const ULONGLONG created = ullNow - (random() % (3 * 365)) * kDay - random() % kDay;
+            for (size_t j = 0; j < 8; ++j)
+            {
+                const ULONGLONG value = created + (j % 4) * (random() % 600) * 10000000ULL;
+
+                FILETIME ft;
+                ft.dwLowDateTime = static_cast<DWORD>(value);
+                ft.dwHighDateTime = static_cast<DWORD>(value >> 32);
+                timestamps.push_back(ft);
+            }
+        }
+
+        return timestamps;
+    }();
+
+    return timestamps;
+}
+
+// Previous timestamp formatting, for comparison
+void BM_FileTimeToTextFmt(benchmark::State& state)
+{
+    const auto& timestamps = GetNTFSInfoTimestamps();
+
+    fmt::memory_buffer buffer;
+    buffer.reserve(timestamps.size() * Text::kMaxTimeStampLength);
+
+    for (auto _ : state)
+    {
+        buffer.clear();
+        for (const auto& ft : timestamps)
+        {
+            SYSTEMTIME st;
+            FileTimeToSystemTime(&ft, &st);
+            fmt::format_to(
+                std::back_inserter(buffer),
+                "{}-{:02}-{:02} {:02}:{:02}:{:02}.{:03}",
+                st.wYear,
+                st.wMonth,
+                st.wDay,
+                st.wHour,
+                st.wMinute,
+                st.wSecond,
+                st.wMilliseconds);
+        }
+        benchmark::DoNotOptimize(buffer.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * timestamps.size());
+}
+
+void BM_FileTimeToTextEncoder(benchmark::State& state)
+{
+    const auto& timestamps = GetNTFSInfoTimestamps();
+
+    fmt::memory_buffer buffer;
+    buffer.reserve(timestamps.size() * Text::kMaxTimeStampLength);
+
+    Text::FileTimeEncoder encoder;
+    for (auto _ : state)
+    {
+        buffer.clear();
+        for (const auto& ft : timestamps)
+        {
+            SYSTEMTIME st;
+            encoder.ToSystemTime(ft, st);
+
+            char text[Text::kMaxTimeStampLength];
+            buffer.append(text, text + Text::ToTimeStamp(st, text));
+        }
+        benchmark::DoNotOptimize(buffer.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * timestamps.size());
+}
+
+BENCHMARK(BM_FileTimeToTextFmt)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FileTimeToTextEncoder)->Unit(benchmark::kMillisecond);
+
+// Paths of a file system walk: mostly ASCII, some with accented, CJK, surrogate pairs and lone surrogates
+const std::vector<std::wstring>& GetPaths()
+{
+    static const std::vector<std::wstring> paths = []() {
+        std::mt19937 random(42);
+
+        std::vector<std::wstring> paths;
+        for (size_t i = 0; i < 100000; ++i)
+        {
+            std::wstring path(16 + random() % 100, L'\0');
+            const bool bAsciiOnly = i % 10 != 0;
+            for (auto& c : path)
+            {
+                const auto kind = random() % 100;
+                if (bAsciiOnly || kind < 70)
+                    c = static_cast<wchar_t>(0x20 + random() % 0x5F);
+                else if (kind < 80)
+                    c = static_cast<wchar_t>(0x80 + random() % 0x780);
+                else if (kind < 88)
+                    c = static_cast<wchar_t>(0x800 + random() % 0xC000);
+                else if (kind < 95)
+                    c = static_cast<wchar_t>(0xD800 + random() % 0x800);
+                else
+                    c = static_cast<wchar_t>(0xE000 + random() % 0x2000);
+            }
+            paths.push_back(std::move(path));
+        }
+
+        return paths;
+    }();
+
+    return paths;
+}
+
+template <typename TranscodeT>
+void TranscodePaths(benchmark::State& state, TranscodeT transcode)
+{
+    const auto& paths = GetPaths();
+
+    size_t cchTotal = 0;
+    for (const auto& path : paths)
+    {
+        cchTotal += path.size();
+    }
+
+    std::string utf8;
+    for (auto _ : state)
+    {
+        for (const auto& path : paths)
+        {
+            utf8.resize(Text::GetUtf8MaxLength(path.size()));
+            transcode(path, utf8);
+            benchmark::DoNotOptimize(utf8.data());
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * cchTotal * sizeof(wchar_t));
+}
+
+void BM_Utf16ToUtf8Win32(benchmark::State& state)
+{
+    TranscodePaths(state, [](const std::wstring& path, std::string& utf8) {
+        WideCharToMultiByte(
+            CP_UTF8,
+            0,
+            path.data(),
+            static_cast<int>(path.size()),
+            utf8.data(),
+            static_cast<int>(utf8.size()),
+            nullptr,
+            nullptr);
+    });
+}
+
+void BM_Utf16ToUtf8(benchmark::State& state)
+{
+    TranscodePaths(state, [](const std::wstring& path, std::string& utf8) { Text::Utf16ToUtf8(path, utf8.data()); });
+}
+
+BENCHMARK(BM_Utf16ToUtf8Win32)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Utf16ToUtf8)->Unit(benchmark::kMillisecond);
+
+}  // namespace
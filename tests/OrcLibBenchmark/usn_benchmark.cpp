@@ -0,0 +1,102 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include "Fixtures.h"
+
+#include "BinaryBuffer.h"
+#include "FileStream.h"
+#include "Location.h"
+#include "NtfsDataStructures.h"
+#include "OfflineMFTReader.h"
+#include "USNJournalWalkerOffline.h"
+
+using namespace Orc;
+using namespace Orc::Benchmark;
+
+namespace {
+
+// Fixtures hold the volume boot record, the $MFT and the $UsnJrnl:$J of a volume
+void BM_USNJournal(benchmark::State& state, std::wstring_view archive)
+{
+    const auto vbr = GetFixture(archive, L"vbr");
+    const auto mft = GetFixture(archive, L"mft");
+    const auto usn = GetFixture(archive, L"usn");
+    if (!vbr || !mft || !usn)
+    {
+        state.SkipWithError("Missing USN journal fixture");
+        return;
+    }
+
+    CBinaryBuffer buffer;
+    buffer.SetCount(sizeof(PackedGenBootSector));
+
+    FileStream vbrStream;
+    ULONGLONG ullBytesRead = 0;
+    if (FAILED(vbrStream.ReadFrom(vbr->c_str()))
+        || FAILED(vbrStream.Read(buffer.GetData(), sizeof(PackedGenBootSector), &ullBytesRead)))
+    {
+        state.SkipWithError("Failed to read volume boot record");
+        return;
+    }
+
+    uint64_t records = 0;
+    for (auto _ : state)
+    {
+        auto location = std::make_shared<Location>(mft->wstring(), Location::Type::OfflineMFT);
+        auto volReader = location->GetReader();
+        if (FAILED(volReader->LoadDiskProperties()))
+        {
+            state.SkipWithError("Failed to load $MFT");
+            return;
+        }
+        std::dynamic_pointer_cast<OfflineMFTReader>(volReader)->SetCharacteristics(buffer);
+
+        USNJournalWalkerOffline walker;
+        if (FAILED(walker.Initialize(location)))
+        {
+            state.SkipWithError("Failed to initialize USN walker");
+            return;
+        }
+
+        // Names of the records are resolved from the $MFT
+        IUSNJournalWalker::Callbacks callbacks;
+        callbacks.RecordCallback = [](const std::shared_ptr<VolumeReader>&, WCHAR*, USN_RECORD*) {};
+        if (FAILED(walker.EnumJournal(callbacks)))
+        {
+            state.SkipWithError("Failed to enumerate $MFT");
+            return;
+        }
+
+        auto usnStream = std::make_shared<FileStream>();
+        if (FAILED(usnStream->ReadFrom(usn->c_str())))
+        {
+            state.SkipWithError("Failed to open $UsnJrnl");
+            return;
+        }
+        walker.SetUsnJournal(usnStream);
+
+        callbacks.RecordCallback = [&records](const std::shared_ptr<VolumeReader>&, WCHAR* szFullName, USN_RECORD*) {
+            benchmark::DoNotOptimize(szFullName);
+            ++records;
+        };
+
+        if (FAILED(walker.ReadJournal(callbacks)))
+        {
+            state.SkipWithError("Failed to read $UsnJrnl");
+            return;
+        }
+    }
+
+    state.counters["records"] = benchmark::Counter(static_cast<double>(records), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK_CAPTURE(BM_USNJournal, win7, L"usn_journal\\win7.7z")->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_USNJournal, win10, L"usn_journal\\win10.7z")->Unit(benchmark::kMillisecond);
+
+}  // namespace
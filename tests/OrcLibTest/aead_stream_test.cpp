@@ -0,0 +1,177 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include "AeadStream.h"
+#include "MemoryStream.h"
+
+#include <random>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Orc;
+using namespace Orc::Test;
+
+namespace {
+
+constexpr auto kContainer = L"OrcLibTest_AeadStream";
+
+// Self signed recipient whose private key lives in the 'kContainer' key container
+PCCERT_CONTEXT CreateRecipient()
+{
+    HCRYPTPROV hProv = NULL;
+    CryptAcquireContextW(&hProv, kContainer, MS_ENH_RSA_AES_PROV_W, PROV_RSA_AES, CRYPT_DELETEKEYSET);
+    if (!CryptAcquireContextW(&hProv, kContainer, MS_ENH_RSA_AES_PROV_W, PROV_RSA_AES, CRYPT_NEWKEYSET))
+        return NULL;
+
+    HCRYPTKEY hKey = NULL;
+    if (!CryptGenKey(hProv, AT_KEYEXCHANGE, (2048 << 16) | CRYPT_EXPORTABLE, &hKey))
+    {
+        CryptReleaseContext(hProv, 0L);
+        return NULL;
+    }
+    CryptDestroyKey(hKey);
+
+    BYTE name[256];
+    CERT_NAME_BLOB subject = {sizeof(name), name};
+    CertStrToNameW(
+        X509_ASN_ENCODING, L"CN=OrcLibTest", CERT_X500_NAME_STR, NULL, subject.pbData, &subject.cbData, NULL);
+
+    CRYPT_KEY_PROV_INFO keyProvInfo = {};
+    keyProvInfo.pwszContainerName = const_cast<LPWSTR>(kContainer);
+    keyProvInfo.pwszProvName = const_cast<LPWSTR>(MS_ENH_RSA_AES_PROV_W);
+    keyProvInfo.dwProvType = PROV_RSA_AES;
+    keyProvInfo.dwKeySpec = AT_KEYEXCHANGE;
+
+    auto pCertContext = CertCreateSelfSignCertificate(hProv, &subject, 0L, &keyProvInfo, NULL, NULL, NULL, NULL);
+    CryptReleaseContext(hProv, 0L);
+    return pCertContext;
+}
+
+void DeleteRecipient()
+{
+    HCRYPTPROV hProv = NULL;
+    CryptAcquireContextW(&hProv, kContainer, MS_ENH_RSA_AES_PROV_W, PROV_RSA_AES, CRYPT_DELETEKEYSET);
+}
+
+std::vector<BYTE> GetBytes(MemoryStream& stream)
+{
+    const auto buffer = stream.GetConstBuffer();
+    return std::vector<BYTE>(buffer.GetData(), buffer.GetData() + stream.GetSize());
+}
+
+}  // namespace
+
+namespace Orc::Test {
+TEST_CLASS(AeadStreamTest)
+{
+private:
+    UnitTestHelper helper;
+    PCCERT_CONTEXT m_recipient = NULL;
+    HCERTSTORE m_keyStore = NULL;
+
+    std::vector<BYTE> Encrypt(const std::vector<BYTE>& data, size_t writeSize)
+    {
+        auto output = std::make_shared<MemoryStream>();
+        Assert::IsTrue(S_OK == output->OpenForReadWrite());
+
+        auto stream = std::make_shared<AeadEncryptStream>(AeadStream::Algorithm::AES256GCM, AeadStream::kMinChunkSize);
+        CBinaryBuffer certificate(m_recipient->pbCertEncoded, m_recipient->cbCertEncoded);
+        Assert::IsTrue(S_OK == stream->AddRecipient(certificate));
+        Assert::IsTrue(S_OK == stream->Initialize(output));
+
+        for (size_t offset = 0; offset < data.size(); offset += writeSize)
+        {
+            ULONGLONG written = 0;
+            const auto size = (std::min)(writeSize, data.size() - offset);
+            Assert::IsTrue(S_OK == stream->Write(const_cast<BYTE*>(data.data()) + offset, size, &written));
+        }
+
+        Assert::IsTrue(S_OK == stream->Close());
+        return GetBytes(*output);
+    }
+
+    HRESULT Decrypt(const std::vector<BYTE>& encrypted, std::vector<BYTE>& data)
+    {
+        auto output = std::make_shared<MemoryStream>();
+        Assert::IsTrue(S_OK == output->OpenForReadWrite());
+
+        auto stream = std::make_shared<AeadDecryptStream>();
+        Assert::IsTrue(S_OK == stream->Initialize(m_keyStore, output));
+
+        // Odd write size to split headers, chunks and tags
+        constexpr size_t kWriteSize = 1000;
+        for (size_t offset = 0; offset < encrypted.size(); offset += kWriteSize)
+        {
+            ULONGLONG written = 0;
+            const auto size = (std::min)(kWriteSize, encrypted.size() - offset);
+            if (auto hr = stream->Write(const_cast<BYTE*>(encrypted.data()) + offset, size, &written); FAILED(hr))
+                return hr;
+        }
+
+        if (auto hr = stream->Close(); FAILED(hr))
+            return hr;
+
+        data = GetBytes(*output);
+        return S_OK;
+    }
+
+public:
+    TEST_METHOD_INITIALIZE(Initialize)
+    {
+        m_recipient = CreateRecipient();
+        Assert::IsTrue(m_recipient != NULL);
+
+        m_keyStore = CertOpenStore(CERT_STORE_PROV_MEMORY, 0L, NULL, CERT_STORE_CREATE_NEW_FLAG, NULL);
+        Assert::IsTrue(m_keyStore != NULL);
+        Assert::IsTrue((bool)CertAddCertificateContextToStore(m_keyStore, m_recipient, CERT_STORE_ADD_NEW, NULL));
+    }
+
+    TEST_METHOD_CLEANUP(Finalize)
+    {
+        CertCloseStore(m_keyStore, 0L);
+        CertFreeCertificateContext(m_recipient);
+        DeleteRecipient();
+    }
+
+    TEST_METHOD(AeadStreamRoundTrip)
+    {
+        std::mt19937 random(42);
+
+        // Empty, sub chunk, chunk aligned and multi batch payloads
+        for (const size_t size : {0, 100, 4096, 3 * 4096, 1024 * 1024 + 17})
+        {
+            std::vector<BYTE> data(size);
+            std::generate(std::begin(data), std::end(data), [&random]() { return static_cast<BYTE>(random()); });
+
+            const auto encrypted = Encrypt(data, 777);
+            Assert::IsTrue(encrypted.size() > data.size());
+
+            std::vector<BYTE> decrypted;
+            Assert::IsTrue(S_OK == Decrypt(encrypted, decrypted));
+            Assert::IsTrue(data == decrypted);
+        }
+    }
+
+    TEST_METHOD(AeadStreamTampering)
+    {
+        std::vector<BYTE> data(5 * 4096, 0x42);
+        const auto encrypted = Encrypt(data, data.size());
+
+        std::vector<BYTE> decrypted;
+
+        auto modified = encrypted;
+        modified[modified.size() / 2] ^= 0x01;
+        Assert::IsTrue(FAILED(Decrypt(modified, decrypted)));
+
+        // Dropping the empty final chunk truncates on a chunk boundary, detected with the final chunk flag
+        auto truncated = encrypted;
+        truncated.resize(encrypted.size() - AeadStream::kTagSize);
+        Assert::IsTrue(FAILED(Decrypt(truncated, decrypted)));
+    }
+};
+}  // namespace Orc::Test
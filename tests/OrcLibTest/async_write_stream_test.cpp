@@ -0,0 +1,110 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+
+#include "stdafx.h"
+
+#include "AsyncWriteStream.h"
+#include "MemoryStream.h"
+#include "BinaryBuffer.h"
+
+#include <numeric>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace Orc;
+using namespace Orc::Test;
+
+namespace Orc::Test {
+TEST_CLASS(AsyncWriteStreamTest)
+{
+private:
+    UnitTestHelper helper;
+
+public:
+    TEST_METHOD_INITIALIZE(Initialize) {}
+
+    TEST_METHOD_CLEANUP(Finalize) {}
+
+    TEST_METHOD(Basic)
+    {
+        auto mem_stream = std::make_shared<MemoryStream>();
+        Assert::IsTrue(S_OK == mem_stream->OpenForReadWrite());
+
+        // Small buffers to force many hand-offs to the writer thread
+        auto async_stream = std::make_shared<AsyncWriteStream>(mem_stream, false, 2, 4096);
+
+        std::vector<BYTE> bytes(1000);
+        std::iota(std::begin(bytes), std::end(bytes), static_cast<BYTE>(0));
+
+        ULONGLONG ullExpected = 0LLU;
+        for (int i = 1; i < 200; ++i)
+        {
+            ULONGLONG bytesWritten = 0LLU;
+            const auto toWrite = static_cast<ULONGLONG>(bytes.size() * i / 200);
+            Assert::IsTrue(S_OK == async_stream->Write(bytes.data(), toWrite, &bytesWritten));
+            Assert::AreEqual(toWrite, bytesWritten);
+            ullExpected += toWrite;
+        }
+
+        ULONG64 ullPosition = 0LLU;
+        Assert::IsTrue(S_OK == async_stream->SetFilePointer(0LL, FILE_CURRENT, &ullPosition));
+        Assert::AreEqual(ullExpected, ullPosition);
+
+        Assert::IsTrue(S_OK == async_stream->Flush());
+        Assert::AreEqual(ullExpected, mem_stream->GetSize());
+
+        Assert::IsTrue(S_OK == async_stream->Close());
+        Assert::IsTrue(S_OK == mem_stream->IsOpen(), L"Underlying stream should not be closed");
+
+        const auto buffer = mem_stream->GetConstBuffer();
+        ULONGLONG ullOffset = 0LLU;
+        for (int i = 1; i < 200; ++i)
+        {
+            const auto written = bytes.size() * i / 200;
+            Assert::IsTrue(0 == memcmp(buffer.GetData() + ullOffset, bytes.data(), written));
+            ullOffset += written;
+        }
+    }
+
+    TEST_METHOD(TwoStages)
+    {
+        auto mem_stream = std::make_shared<MemoryStream>();
+        Assert::IsTrue(S_OK == mem_stream->OpenForReadWrite());
+
+        // Small buffers to force many hand-offs between stages
+        auto last_stage = std::make_shared<AsyncWriteStream>(mem_stream, true, 2, 4096);
+        auto first_stage = std::make_shared<AsyncWriteStream>(last_stage, true, 3, 6000);
+
+        std::vector<BYTE> bytes(1000);
+        std::iota(std::begin(bytes), std::end(bytes), static_cast<BYTE>(0));
+
+        ULONGLONG ullExpected = 0LLU;
+        for (int i = 1; i < 200; ++i)
+        {
+            ULONGLONG bytesWritten = 0LLU;
+            const auto toWrite = static_cast<ULONGLONG>(bytes.size() * i / 200);
+            Assert::IsTrue(S_OK == first_stage->Write(bytes.data(), toWrite, &bytesWritten));
+            Assert::AreEqual(toWrite, bytesWritten);
+            ullExpected += toWrite;
+        }
+
+        // Closing the first stage drains and closes the whole chain
+        Assert::IsTrue(S_OK == first_stage->Close());
+        Assert::AreEqual(ullExpected, mem_stream->GetSize());
+
+        const auto buffer = mem_stream->GetConstBuffer();
+        ULONGLONG ullOffset = 0LLU;
+        for (int i = 1; i < 200; ++i)
+        {
+            const auto written = bytes.size() * i / 200;
+            Assert::IsTrue(0 == memcmp(buffer.GetData() + ullOffset, bytes.data(), written));
+            ullOffset += written;
+        }
+    }
+};
+}  // namespace Orc::Test
@@ -0,0 +1,108 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include "CatalogIndex.h"
+
+#include <string>
+
+using namespace std::string_literals;
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Orc;
+using namespace Orc::Test;
+
+namespace {
+
+std::string Der(uint8_t tag, const std::string& content)
+{
+    std::string element(1, static_cast<char>(tag));
+    if (content.size() < 0x80)
+    {
+        element.push_back(static_cast<char>(content.size()));
+    }
+    else
+    {
+        element.push_back(static_cast<char>(0x82));
+        element.push_back(static_cast<char>(content.size() >> 8));
+        element.push_back(static_cast<char>(content.size() & 0xFF));
+    }
+
+    return element + content;
+}
+
+// Catalog with the single member 'digest', without any signer
+std::string MakeCatalog(const std::string& digest)
+{
+    const auto kOidSha1 = Der(0x06, "\x2B\x0E\x03\x02\x1A"s);
+    const auto kOidIndirectData = Der(0x06, "\x2B\x06\x01\x04\x01\x82\x37\x02\x01\x04"s);
+    const auto kOidCatalogListMember = Der(0x06, "\x2B\x06\x01\x04\x01\x82\x37\x0C\x01\x02"s);
+    const auto kOidPeImageData = Der(0x06, "\x2B\x06\x01\x04\x01\x82\x37\x02\x01\x0F"s);
+
+    const auto digestInfo = Der(0x30, Der(0x30, kOidSha1) + Der(0x04, digest));
+    const auto indirectData = Der(0x30, Der(0x30, kOidPeImageData) + digestInfo);
+    const auto attribute = Der(0x30, kOidIndirectData + Der(0x31, indirectData));
+    const auto member = Der(0x30, Der(0x04, "member"s) + Der(0x31, attribute));
+
+    const auto ctl = Der(
+        0x30,
+        Der(0x30, Der(0x06, "\x2B\x06\x01\x04\x01\x82\x37\x0C\x01\x01"s)) + Der(0x04, "listIdentifier"s)
+            + Der(0x17, "190101000000Z"s) + Der(0x30, kOidCatalogListMember + Der(0x05, ""s)) + Der(0x30, member));
+
+    const auto encapContentInfo = Der(0x30, Der(0x06, "\x2B\x06\x01\x04\x01\x82\x37\x0A\x01"s) + Der(0xA0, ctl));
+    const auto signedData = Der(0x30, Der(0x02, "\x01"s) + Der(0x31, ""s) + encapContentInfo + Der(0x31, ""s));
+    return Der(0x30, Der(0x06, "\x2A\x86\x48\x86\xF7\x0D\x01\x07\x02"s) + Der(0xA0, signedData));
+}
+
+}  // namespace
+
+namespace Orc::Test {
+TEST_CLASS(CatalogIndexTest)
+{
+private:
+    UnitTestHelper helper;
+
+public:
+    TEST_METHOD_INITIALIZE(Initialize) {}
+
+    TEST_METHOD_CLEANUP(Finalize) {}
+
+    TEST_METHOD(CatalogIndexMembers)
+    {
+        const auto digest = "\x01\x23\x45\x67\x89\xAB\xCD\xEF\x00\x11\x22\x33\x44\x55\x66\x77\x88\x99\xAA\xBB"s;
+
+        CatalogIndex index;
+        Assert::IsFalse(index.Add(L"c:\\catroot\\test.cat", MakeCatalog(digest)).has_error());
+        Assert::IsTrue(index.Add(L"c:\\catroot\\invalid.cat", "not a catalog").has_error());
+
+        Assert::AreEqual(static_cast<size_t>(1), index.CatalogCount());
+        Assert::AreEqual(static_cast<size_t>(1), index.HashCount());
+
+        const auto catalog = index.Find(digest);
+        Assert::IsTrue(catalog.has_value());
+        Assert::AreEqual(L"c:\\catroot\\test.cat", std::wstring(*catalog).c_str());
+
+        Assert::IsFalse(index.Find(std::string(digest.size(), '\0')).has_value());
+    }
+
+    TEST_METHOD(CatalogIndexCatRoot)
+    {
+        std::error_code ec;
+        const std::filesystem::path catroot(LR"(c:\windows\system32\CatRoot)");
+        if (!std::filesystem::exists(catroot, ec))
+        {
+            return;
+        }
+
+        CatalogIndex index;
+        Assert::IsFalse(index.Load(catroot).has_error());
+        Assert::IsTrue(index.CatalogCount() > 0);
+        Assert::IsTrue(index.HashCount() > 0);
+    }
+};
+}  // namespace Orc::Test
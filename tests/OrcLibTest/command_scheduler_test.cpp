@@ -0,0 +1,88 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+
+#include "stdafx.h"
+
+#include "CommandScheduler.h"
+#include "CommandExecute.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+using namespace Orc;
+using namespace Orc::Test;
+
+namespace Orc::Test {
+TEST_CLASS(CommandSchedulerTest)
+{
+private:
+    UnitTestHelper helper;
+
+    static std::shared_ptr<CommandExecute> MakeCommand(
+        const std::wstring& keyword,
+        LONG priority = 0L,
+        std::optional<std::chrono::milliseconds> duration = std::nullopt,
+        CommandProfile profile = CommandProfile::Undefined)
+    {
+        auto command = std::make_shared<CommandExecute>(keyword);
+        command->SetPriority(priority);
+        command->SetExpectedDuration(duration);
+        command->SetProfile(profile);
+        return command;
+    }
+
+public:
+    TEST_METHOD_INITIALIZE(Initialize) {}
+    TEST_METHOD_CLEANUP(Finalize) {}
+
+    TEST_METHOD(Ordering)
+    {
+        using namespace std::chrono_literals;
+
+        CommandScheduler scheduler;
+        scheduler.Push(MakeCommand(L"first"));
+        scheduler.Push(MakeCommand(L"short", 0L, 10s));
+        scheduler.Push(MakeCommand(L"long", 0L, 10min));
+        scheduler.Push(MakeCommand(L"second"));
+        scheduler.Push(MakeCommand(L"urgent", 1L));
+
+        // Nothing is running: commands are always admitted, in scheduling order
+        const std::vector<std::shared_ptr<CommandExecute>> running;
+        for (const auto& expected : {L"urgent", L"long", L"short", L"first", L"second"})
+        {
+            auto command = scheduler.Pop(running);
+            Assert::IsTrue(command != nullptr);
+            Assert::AreEqual(expected, command->GetKeyword().c_str());
+        }
+
+        Assert::IsTrue(scheduler.Empty());
+        Assert::IsTrue(scheduler.Pop(running) == nullptr);
+    }
+
+    TEST_METHOD(ConcurrentIo)
+    {
+        CommandScheduler scheduler(100, 1);
+        scheduler.Push(MakeCommand(L"io", 0L, std::nullopt, CommandProfile::Io));
+        scheduler.Push(MakeCommand(L"cpu", 0L, std::nullopt, CommandProfile::Cpu));
+
+        // An I/O bound command is already running: the next I/O bound one must wait
+        const std::vector<std::shared_ptr<CommandExecute>> running = {
+            MakeCommand(L"running", 0L, std::nullopt, CommandProfile::Io)};
+
+        auto command = scheduler.Pop(running);
+        Assert::IsTrue(command != nullptr);
+        Assert::AreEqual(L"cpu", command->GetKeyword().c_str());
+
+        Assert::IsTrue(scheduler.Pop(running) == nullptr);
+        Assert::AreEqual(static_cast<size_t>(1), scheduler.Size());
+
+        command = scheduler.Pop({});
+        Assert::IsTrue(command != nullptr);
+        Assert::AreEqual(L"io", command->GetKeyword().c_str());
+    }
+};
+}  // namespace Orc::Test
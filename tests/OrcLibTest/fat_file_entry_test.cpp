@@ -69,8 +69,9 @@ public:
         f2.m_ulSize = g_TestFileSize;
         f2.FillSegmentDetailsMap(0x1000, 0x200);
 
-        // when segment merging is implemented (for contiguous segments) update the number used in this assert
-        Assert::IsTrue(20 == f2.m_SegmentDetailsMap.size());
+        // the 20 clusters are contiguous: a single segment
+        Assert::IsTrue(1 == f2.m_SegmentDetailsMap.size());
+        Assert::IsTrue(0x1000 + (7 - 2) * 0x200 == f2.m_SegmentDetailsMap.begin()->second.mStartOffset);
 
         DWORD size = 0;
         std::for_each(
@@ -74,6 +74,16 @@ public:
             FatTable::ClusterChain clusterChain;
             fatTable.FillClusterChain(7, clusterChain);
             Assert::IsTrue(20 == clusterChain.size());
+
+            // the chain spans both chunks but is a single run
+            FatTable::ClusterRuns clusterRuns;
+            Assert::IsTrue(S_OK == fatTable.FillClusterRuns(7, clusterRuns));
+            Assert::IsTrue(1 == clusterRuns.size());
+            Assert::IsTrue(7 == clusterRuns[0].ulFirstCluster && 20 == clusterRuns[0].ulCount);
+
+            FatTable::GetClusterRuns(clusterChain, clusterRuns);
+            Assert::IsTrue(1 == clusterRuns.size());
+            Assert::IsTrue(7 == clusterRuns[0].ulFirstCluster && 20 == clusterRuns[0].ulCount);
         }
 
         {
@@ -83,5 +93,45 @@ public:
             Assert::IsTrue(true == entry.IsFree());
         }
     }
+
+    TEST_METHOD(Fat12TableClusterRunsTest)
+    {
+        // fat12 table: 2 -> 3 -> 4 -> 8 -> 9 -> EOF, 5 -> EOF, 6 -> 7 -> 6 (corrupted, loops)
+        // entries are packed by two over three bytes, the second chunk starts in the middle of entry 5
+        FatTable fatTable(FatTable::FAT12);
+
+        unsigned char data1[8] = {0xF8, 0xFF, 0xFF, 0x03, 0x40, 0x00, 0x08, 0xF0};
+        fatTable.AddChunk(std::make_shared<CBinaryBuffer>(CBinaryBuffer(data1, sizeof(data1))));
+
+        unsigned char data2[7] = {0xFF, 0x07, 0x60, 0x00, 0x09, 0xF0, 0xFF};
+        fatTable.AddChunk(std::make_shared<CBinaryBuffer>(CBinaryBuffer(data2, sizeof(data2))));
+
+        Assert::IsTrue(10 == fatTable.GetEntryCount());
+
+        FatTableEntry entry;
+        Assert::IsTrue(S_OK == fatTable.GetEntry(5, entry));
+        Assert::IsTrue(true == entry.IsEOFEntry());
+        Assert::IsTrue(S_OK == fatTable.GetEntry(4, entry));
+        Assert::IsTrue(8 == entry.GetValue());
+        Assert::IsTrue(S_OK != fatTable.GetEntry(10, entry));
+
+        FatTable::ClusterRuns clusterRuns;
+        Assert::IsTrue(S_OK == fatTable.FillClusterRuns(2, clusterRuns));
+        Assert::IsTrue(2 == clusterRuns.size());
+        Assert::IsTrue(2 == clusterRuns[0].ulFirstCluster && 3 == clusterRuns[0].ulCount);
+        Assert::IsTrue(8 == clusterRuns[1].ulFirstCluster && 2 == clusterRuns[1].ulCount);
+
+        FatTable::ClusterChain clusterChain;
+        Assert::IsTrue(S_OK == fatTable.FillClusterChain(2, clusterChain));
+        Assert::IsTrue(5 == clusterChain.size());
+        Assert::IsTrue(9 == clusterChain.back().GetValue());
+
+        // starting in the middle of a run
+        Assert::IsTrue(S_OK == fatTable.FillClusterRuns(3, clusterRuns));
+        Assert::IsTrue(2 == clusterRuns.size());
+        Assert::IsTrue(3 == clusterRuns[0].ulFirstCluster && 2 == clusterRuns[0].ulCount);
+
+        Assert::IsTrue(S_OK != fatTable.FillClusterRuns(6, clusterRuns));
+    }
 };
 }  // namespace Orc::Test
@@ -0,0 +1,151 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include "FileInfo.h"
+#include "Authenticode.h"
+#include "TableOutputWriter.h"
+#include "MemoryStream.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Orc;
+using namespace Orc::Test;
+
+namespace {
+
+// Binary name of a regular file without data stream: PE predicates are false and count their queries of the details
+class TestFileInfo : public FileInfo
+{
+public:
+    TestFileInfo(const std::vector<Filter>& filters, Authenticode& authenticode)
+        : FileInfo(
+            L"Test",
+            nullptr,
+            Intentions::FILEINFO_NONE,
+            filters,
+            L"\\Windows\\System32\\kernel32.dll",
+            static_cast<DWORD>(wcslen(L"\\Windows\\System32\\kernel32.dll")),
+            authenticode)
+    {
+    }
+
+    bool IsDirectory() override { return false; }
+    std::shared_ptr<ByteStream> GetFileStream() override { return nullptr; }
+    bool ExceedsFileThreshold(DWORD nFileSizeHigh, DWORD nFileSizeLow) override { return false; }
+
+    const std::unique_ptr<DataDetails>& GetDetails() override
+    {
+        m_DetailsQueries++;
+        return m_Details;
+    }
+
+    HRESULT HandleIntentions(const Intentions& intention, ITableOutput& output) override
+    {
+        return output.WriteNothing();
+    }
+
+    Intentions RowIntentions() const { return m_RowIntentions.value_or(Intentions::FILEINFO_NONE); }
+
+    size_t m_DetailsQueries = 0;
+
+protected:
+    HRESULT Open() override { return S_OK; }
+
+    HRESULT WriteShortName(ITableOutput& output) override { return output.WriteNothing(); }
+    HRESULT WriteAttributes(ITableOutput& output) override { return output.WriteNothing(); }
+    HRESULT WriteSizeInBytes(ITableOutput& output) override { return output.WriteNothing(); }
+    HRESULT WriteRecordInUse(ITableOutput& output) override { return output.WriteNothing(); }
+    HRESULT WriteCreationDate(ITableOutput& output) override { return output.WriteNothing(); }
+    HRESULT WriteLastModificationDate(ITableOutput& output) override { return output.WriteNothing(); }
+    HRESULT WriteLastAccessDate(ITableOutput& output) override { return output.WriteNothing(); }
+
+private:
+    std::unique_ptr<DataDetails> m_Details;
+};
+
+Filter MakeFilter(FilterType type, bool bInclude, Intentions intent)
+{
+    Filter filter {};
+    filter.type = type;
+    filter.bInclude = bInclude;
+    filter.intent = intent;
+    return filter;
+}
+
+}  // namespace
+
+namespace Orc::Test {
+TEST_CLASS(FileInfoTest)
+{
+private:
+    UnitTestHelper helper;
+
+    static constexpr ColumnNameDef kColumns[] = {
+        {Intentions::FILEINFO_MD5, L"MD5", L"MD5 of the file", 0},
+        {Intentions::FILEINFO_NONE, nullptr, nullptr, 0}};
+
+    Intentions WriteRow(const std::vector<Filter>& filters, size_t& detailsQueries)
+    {
+        auto stream = std::make_shared<MemoryStream>();
+        Assert::IsTrue(SUCCEEDED(stream->OpenForReadWrite()));
+
+        auto writer = TableOutput::GetCSVWriter(std::make_unique<TableOutput::CSV::Options>());
+        Assert::IsTrue((bool)writer);
+        Assert::IsTrue(SUCCEEDED(writer->WriteToStream(stream, false)));
+
+        TableOutput::Schema schema {{TableOutput::ColumnType::UTF16Type, L"MD5"}};
+        Assert::IsTrue(SUCCEEDED(writer->SetSchema(schema)));
+
+        Authenticode authenticode;
+        TestFileInfo fi(filters, authenticode);
+        Assert::IsTrue(SUCCEEDED(fi.WriteFileInformation(kColumns, *writer, filters)));
+        Assert::IsTrue(SUCCEEDED(writer->Close()));
+
+        detailsQueries = fi.m_DetailsQueries;
+        return fi.RowIntentions();
+    }
+
+public:
+    TEST_METHOD_INITIALIZE(Initialize) {}
+
+    TEST_METHOD_CLEANUP(Finalize) {}
+
+    TEST_METHOD(ResolveIntentionsCheapFirst)
+    {
+        size_t detailsQueries = 0;
+
+        // A later name predicate decides: the PE header of the file is not read
+        const std::vector<Filter> decidedByName = {
+            MakeFilter(FILEFILTER_PEHEADER, false, Intentions::FILEINFO_MD5),
+            MakeFilter(FILEFILTER_EXTBINARY, true, Intentions::FILEINFO_MD5)};
+        Assert::IsTrue(HasFlag(WriteRow(decidedByName, detailsQueries), Intentions::FILEINFO_MD5));
+        Assert::AreEqual(size_t(0), detailsQueries);
+
+        // A later PE predicate which would not change the outcome of the name predicate is not evaluated either
+        const std::vector<Filter> unchangedByPE = {
+            MakeFilter(FILEFILTER_EXTBINARY, true, Intentions::FILEINFO_MD5),
+            MakeFilter(FILEFILTER_PEHEADER, true, Intentions::FILEINFO_MD5)};
+        Assert::IsTrue(HasFlag(WriteRow(unchangedByPE, detailsQueries), Intentions::FILEINFO_MD5));
+        Assert::AreEqual(size_t(0), detailsQueries);
+
+        // It is evaluated when it could: without a PE header the exclusion does not apply
+        const std::vector<Filter> excludedByPE = {
+            MakeFilter(FILEFILTER_EXTBINARY, true, Intentions::FILEINFO_MD5),
+            MakeFilter(FILEFILTER_PEHEADER, false, Intentions::FILEINFO_MD5)};
+        Assert::IsTrue(HasFlag(WriteRow(excludedByPE, detailsQueries), Intentions::FILEINFO_MD5));
+        Assert::AreNotEqual(size_t(0), detailsQueries);
+
+        // Same filter types as the previous row with other decisions: the cached plan only depends on the types
+        const std::vector<Filter> excludedByName = {
+            MakeFilter(FILEFILTER_EXTBINARY, false, Intentions::FILEINFO_MD5),
+            MakeFilter(FILEFILTER_PEHEADER, true, Intentions::FILEINFO_MD5)};
+        Assert::IsFalse(HasFlag(WriteRow(excludedByName, detailsQueries), Intentions::FILEINFO_MD5));
+        Assert::AreNotEqual(size_t(0), detailsQueries);
+    }
+};
+}  // namespace Orc::Test
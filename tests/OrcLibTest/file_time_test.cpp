@@ -0,0 +1,86 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include "Text/FileTime.h"
+
+#include <random>
+
+#include <fmt/format.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Orc;
+using namespace Orc::Test;
+
+namespace {
+
+FILETIME ToFileTime(ULONGLONG value)
+{
+    FILETIME ft;
+    ft.dwLowDateTime = static_cast<DWORD>(value);
+    ft.dwHighDateTime = static_cast<DWORD>(value >> 32);
+    return ft;
+}
+
+}  // namespace
+
+namespace Orc::Test {
+TEST_CLASS(FileTimeTest)
+{
+private:
+    UnitTestHelper helper;
+
+public:
+    TEST_METHOD_INITIALIZE(Initialize) {}
+
+    TEST_METHOD_CLEANUP(Finalize) {}
+
+    TEST_METHOD(FileTimeEncoderMatchesFileTimeToSystemTime)
+    {
+        Text::FileTimeEncoder encoder;
+        std::mt19937_64 random(1);
+
+        std::vector<ULONGLONG> values = {
+            0ULL, 1ULL, 116444736000000000ULL, 125911584000000000ULL, 0x7FFFFFFFFFFFFFFFULL};
+        for (size_t i = 0; i < 100000; ++i)
+        {
+            values.push_back(random() & 0x7FFFFFFFFFFFFFFFULL);
+        }
+
+        for (auto value : values)
+        {
+            const auto ft = ToFileTime(value);
+
+            SYSTEMTIME expected, st;
+            Assert::IsTrue(FileTimeToSystemTime(&ft, &expected));
+            Assert::IsTrue(encoder.ToSystemTime(ft, st));
+            Assert::IsTrue(memcmp(&expected, &st, sizeof(SYSTEMTIME)) == 0, L"Unexpected conversion");
+
+            char text[Text::kMaxTimeStampLength];
+            const auto length = Text::ToTimeStamp(st, text);
+            const auto expectedText = fmt::format(
+                "{}-{:02}-{:02} {:02}:{:02}:{:02}.{:03}",
+                st.wYear,
+                st.wMonth,
+                st.wDay,
+                st.wHour,
+                st.wMinute,
+                st.wSecond,
+                st.wMilliseconds);
+            Assert::IsTrue(expectedText == std::string_view(text, length), L"Unexpected timestamp text");
+        }
+
+        SYSTEMTIME st;
+        Assert::IsFalse(encoder.ToSystemTime(0x8000000000000000ULL, st));
+
+        st = {2021, 3, 0, 14, 15, 9, 26, 535};
+        wchar_t iso[Text::kMaxIso8601Length];
+        Assert::IsTrue(std::wstring_view(iso, Text::ToIso8601(st, iso)) == L"2021-03-14T15:09:26Z");
+    }
+};
+}  // namespace Orc::Test
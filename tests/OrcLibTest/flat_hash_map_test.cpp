@@ -0,0 +1,83 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include "Utils/FlatHashMap.h"
+
+#include <random>
+#include <unordered_map>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Orc;
+using namespace Orc::Test;
+
+namespace Orc::Test {
+TEST_CLASS(FlatHashMapTest)
+{
+private:
+    UnitTestHelper helper;
+
+public:
+    TEST_METHOD_INITIALIZE(Initialize) {}
+
+    TEST_METHOD_CLEANUP(Finalize) {}
+
+    TEST_METHOD(FlatHashMapMatchesUnorderedMap)
+    {
+        std::mt19937_64 random(1);
+
+        FlatHashMap<ULONGLONG, ULONGLONG> map;
+        std::unordered_map<ULONGLONG, ULONGLONG> expected;
+
+        for (size_t i = 0; i < 200000; ++i)
+        {
+            const ULONGLONG key = (random() % 50000) | ((random() % 3) << 48);
+            const ULONGLONG value = random();
+
+            switch (random() % 3)
+            {
+                case 0: {
+                    const auto [it, inserted] = map.insert({key, value});
+                    const auto [expectedIt, expectedInserted] = expected.insert({key, value});
+                    Assert::AreEqual(expectedInserted, inserted);
+                    Assert::AreEqual(expectedIt->second, it->second);
+                    break;
+                }
+                case 1:
+                    map[key] = value;
+                    expected[key] = value;
+                    break;
+                default: {
+                    const auto it = map.find(key);
+                    const auto expectedIt = expected.find(key);
+                    Assert::AreEqual(expectedIt == std::end(expected), it == std::end(map));
+                    if (it != std::end(map))
+                    {
+                        Assert::AreEqual(expectedIt->second, it->second);
+                    }
+                }
+            }
+        }
+
+        Assert::AreEqual(expected.size(), map.size());
+        for (const auto& [key, value] : map)
+        {
+            Assert::AreEqual(expected.at(key), value);
+        }
+
+        // Iterators are indexes: they stay valid while new entries are inserted
+        auto first = std::begin(map);
+        const auto firstKey = first->first;
+        for (ULONGLONG key = 1ULL << 40; key < (1ULL << 40) + 100000; ++key)
+        {
+            map[key] = key;
+        }
+        Assert::AreEqual(firstKey, first->first);
+    }
+};
+}  // namespace Orc::Test
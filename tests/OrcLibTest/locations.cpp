@@ -107,6 +107,22 @@ public:
         Assert::IsTrue(S_OK == aSet.PrintLocationsByVolume(false));
     }
 
+    TEST_METHOD(GroupByPhysicalDrive)
+    {
+        std::vector<std::shared_ptr<Location>> locations = {
+            std::make_shared<Location>(L"c:\\disk1.dd,offset=1048576,size=1048576", Location::Type::ImageFileVolume),
+            std::make_shared<Location>(L"c:\\disk2.dd,offset=1048576,size=1048576", Location::Type::ImageFileVolume),
+            std::make_shared<Location>(L"c:\\DISK1.dd,offset=2097152,size=1048576", Location::Type::ImageFileVolume),
+            std::make_shared<Location>(L"c:\\disk3.dd", Location::Type::ImageFileDisk)};
+
+        const auto groups = LocationSet::GroupByPhysicalDrive(locations);
+
+        Assert::AreEqual(size_t(3), groups.size());
+        Assert::IsTrue(groups[0] == std::vector<size_t> {0, 2});
+        Assert::IsTrue(groups[1] == std::vector<size_t> {1});
+        Assert::IsTrue(groups[2] == std::vector<size_t> {3});
+    }
+
 private:
 };
 }  // namespace Orc::Test
@@ -0,0 +1,269 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include "MFTIndex.h"
+
+#include <filesystem>
+#include <random>
+
+#include <fmt/format.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Orc;
+using namespace Orc::Test;
+
+namespace {
+
+constexpr ULONGLONG kRoot = 0x0005000000000005ULL;
+constexpr ULONGLONG kWindows = 0x0001000000000064ULL;
+constexpr ULONGLONG kSystem32 = 0x0002000000000065ULL;
+constexpr ULONGLONG kUsers = 0x0001000000000066ULL;
+constexpr ULONGLONG kNtdll = 0x00030000000000C8ULL;
+constexpr ULONGLONG kKernel32 = 0x00010000000000C9ULL;
+constexpr ULONGLONG kNotes = 0x000100000000012CULL;
+
+MFTIndex::Record MakeRecord(ULONGLONG frn, ULONGLONG dataSize, bool bDirectory)
+{
+    MFTIndex::Record record = {};
+    record.FRN = frn;
+    record.DataSize = dataSize;
+    record.AllocatedSize = (dataSize + 4095) & ~4095ULL;
+    record.Flags = MFTIndex::kInUse | (bDirectory ? MFTIndex::kDirectory : 0);
+    record.Usn = static_cast<USN>(frn & 0xFFFF) * 128;
+    return record;
+}
+
+// Small tree added out of order, along with thousands of unrelated files
+void AddVolume(MFTIndex::Builder& builder)
+{
+    std::mt19937_64 random(3);
+
+    builder.Add(MakeRecord(kNotes, 1234, false), {{kUsers, L"notes.txt", FILE_NAME_WIN32}}, {1234, 42});
+    builder.Add(MakeRecord(kSystem32, 0, true), {{kWindows, L"System32", FILE_NAME_WIN32}}, {});
+
+    for (ULONGLONG segment = 1000; segment < 20000; ++segment)
+    {
+        const auto name = fmt::format(L"file{}.bin", segment);
+        builder.Add(MakeRecord(segment, 2000000 + random() % 1000, false), {{kSystem32, name, FILE_NAME_WIN32}}, {});
+    }
+
+    builder.Add(
+        MakeRecord(kNtdll, 1500000, false),
+        {{kSystem32, L"ntdll.dll", FILE_NAME_WIN32}, {kWindows, L"ntdll.dll", FILE_NAME_WIN32}},
+        {1500000});
+    builder.Add(
+        MakeRecord(kKernel32, 700000, false),
+        {{kSystem32, L"KERNEL~1.DLL", FILE_NAME_DOS83}, {kSystem32, L"kernel32.dll", FILE_NAME_WIN32}},
+        {700000});
+    builder.Add(MakeRecord(kUsers, 0, true), {{kRoot, L"Users", FILE_NAME_WIN32}}, {});
+    builder.Add(MakeRecord(kWindows, 0, true), {{kRoot, L"Windows", FILE_NAME_WIN32}}, {});
+    builder.Add(MakeRecord(kRoot, 0, true), {{kRoot, L".", FILE_NAME_WIN32}}, {});
+}
+
+std::filesystem::path GetIndexPath(std::wstring_view name)
+{
+    return std::filesystem::temp_directory_path() / name;
+}
+
+}  // namespace
+
+namespace Orc::Test {
+TEST_CLASS(MFTIndexTest)
+{
+private:
+    UnitTestHelper helper;
+
+public:
+    TEST_METHOD_INITIALIZE(Initialize) {}
+
+    TEST_METHOD_CLEANUP(Finalize) {}
+
+    TEST_METHOD(MFTIndexLookups)
+    {
+        const auto path = GetIndexPath(L"mft_index_lookups.idx");
+
+        MFTIndex::VolumeState state;
+        state.VolumeSerialNumber = 0x1234ABCD;
+        state.MFTRecordCount = 20000;
+        state.LogFileLsn = 0x10000;
+
+        MFTIndex::Builder builder;
+        AddVolume(builder);
+        Assert::IsTrue(SUCCEEDED(builder.Write(path, state)));
+
+        std::unique_ptr<MFTIndex> index;
+        Assert::IsTrue(SUCCEEDED(MFTIndex::Open(path, index)));
+        Assert::AreEqual(builder.RecordCount(), index->RecordCount());
+
+        // Case insensitive names, hard links are returned once
+        auto found = index->FindByName(L"NTDLL.DLL");
+        Assert::AreEqual(static_cast<size_t>(1), found.size());
+        Assert::AreEqual(kNtdll, found[0]->FRN);
+        Assert::AreEqual(static_cast<USHORT>(2), found[0]->LinkCount);
+
+        found = index->FindByName(L"KERNEL~1.DLL");
+        Assert::AreEqual(static_cast<size_t>(1), found.size());
+        Assert::AreEqual(kKernel32, found[0]->FRN);
+
+        found = index->FindByName(L"file12345.bin");
+        Assert::AreEqual(static_cast<size_t>(1), found.size());
+        Assert::AreEqual(12345ULL, found[0]->FRN);
+        Assert::IsTrue(index->FindByName(L"file12345.bi").empty());
+
+        // Sizes of named streams are indexed too
+        found = index->FindBySize(42);
+        Assert::AreEqual(static_cast<size_t>(1), found.size());
+        Assert::AreEqual(kNotes, found[0]->FRN);
+        Assert::AreEqual(1234ULL, found[0]->DataSize);
+        Assert::AreEqual(static_cast<ULONG>(2), found[0]->DataStreamCount);
+        Assert::IsTrue(index->FindBySize(43).empty());
+
+        // Records are found by segment number, whatever their sequence number
+        const auto pRecord = index->FindRecord(MFTIndex::SegmentNumber(kSystem32));
+        Assert::IsNotNull(pRecord);
+        Assert::AreEqual(kSystem32, pRecord->FRN);
+        Assert::IsTrue((pRecord->Flags & MFTIndex::kDirectory) != 0);
+        Assert::IsNull(index->FindRecord(999));
+
+        const auto [first, last] = index->GetLinks(*pRecord);
+        Assert::AreEqual(1LL, static_cast<long long>(last - first));
+        Assert::IsTrue(index->GetName(*first) == L"System32");
+
+        std::unordered_set<ULONGLONG> directories;
+        index->AddAncestors(kSystem32, {}, directories);
+        Assert::IsTrue(
+            directories
+            == std::unordered_set<ULONGLONG> {
+                MFTIndex::SegmentNumber(kSystem32),
+                MFTIndex::SegmentNumber(kWindows),
+                MFTIndex::SegmentNumber(kRoot)});
+
+        // System32 moved below Users since the snapshot
+        directories.clear();
+        index->AddAncestors(kSystem32, {{MFTIndex::SegmentNumber(kSystem32), kUsers}}, directories);
+        Assert::IsTrue(
+            directories
+            == std::unordered_set<ULONGLONG> {
+                MFTIndex::SegmentNumber(kSystem32), MFTIndex::SegmentNumber(kUsers), MFTIndex::SegmentNumber(kRoot)});
+
+        index.reset();
+        std::filesystem::remove(path);
+    }
+
+    TEST_METHOD(MFTIndexMerge)
+    {
+        const auto path = GetIndexPath(L"mft_index_merge.idx");
+        const auto mergedPath = GetIndexPath(L"mft_index_merged.idx");
+
+        MFTIndex::VolumeState state;
+        state.VolumeSerialNumber = 0x1234ABCD;
+        state.MFTRecordCount = 20000;
+        state.Journal = MFTIndex::JournalPosition {7, 500, 1000};
+
+        MFTIndex::Builder builder;
+        AddVolume(builder);
+        Assert::IsTrue(SUCCEEDED(builder.Write(path, state)));
+
+        std::unique_ptr<MFTIndex> previous;
+        Assert::IsTrue(SUCCEEDED(MFTIndex::Open(path, previous)));
+
+        // notes.txt was renamed and ntdll.dll deleted, their segments were walked again
+        MFTIndex::Builder merged;
+        merged.Add(MakeRecord(kNotes + (1ULL << 48), 99, false), {{kUsers, L"renamed.txt", FILE_NAME_WIN32}}, {99});
+        merged.Add(*previous, {MFTIndex::SegmentNumber(kNotes), MFTIndex::SegmentNumber(kNtdll)});
+
+        state.Journal->NextUsn = 2000;
+        Assert::IsTrue(SUCCEEDED(merged.Write(mergedPath, state)));
+
+        std::unique_ptr<MFTIndex> index;
+        Assert::IsTrue(SUCCEEDED(MFTIndex::Open(mergedPath, index)));
+        Assert::AreEqual(previous->RecordCount() - 1, index->RecordCount());
+        Assert::AreEqual(2000LL, index->State().Journal->NextUsn);
+
+        Assert::IsTrue(index->FindByName(L"ntdll.dll").empty());
+        Assert::IsTrue(index->FindByName(L"notes.txt").empty());
+        Assert::IsTrue(index->FindBySize(42).empty());
+
+        auto found = index->FindByName(L"renamed.txt");
+        Assert::AreEqual(static_cast<size_t>(1), found.size());
+        Assert::AreEqual(kNotes + (1ULL << 48), found[0]->FRN);
+
+        // Carried over records keep their names and all their stream sizes
+        found = index->FindByName(L"kernel~1.dll");
+        Assert::AreEqual(static_cast<size_t>(1), found.size());
+        Assert::AreEqual(static_cast<USHORT>(2), found[0]->LinkCount);
+        Assert::AreEqual(static_cast<size_t>(1), index->FindBySize(700000).size());
+        Assert::AreEqual(static_cast<size_t>(1), index->FindByName(L"file19999.bin").size());
+
+        index.reset();
+        previous.reset();
+        std::filesystem::remove(path);
+        std::filesystem::remove(mergedPath);
+    }
+
+    TEST_METHOD(MFTIndexValidation)
+    {
+        const auto path = GetIndexPath(L"mft_index_validation.idx");
+
+        MFTIndex::VolumeState state;
+        state.VolumeSerialNumber = 0x1234ABCD;
+        state.MFTRecordCount = 20000;
+        state.Journal = MFTIndex::JournalPosition {7, 500, 1000};
+
+        MFTIndex::Builder builder;
+        AddVolume(builder);
+        Assert::IsTrue(SUCCEEDED(builder.Write(path, state)));
+
+        std::unique_ptr<MFTIndex> index;
+        Assert::IsTrue(SUCCEEDED(MFTIndex::Open(path, index)));
+
+        // The journal moved on and still holds the changes since the snapshot
+        auto current = state;
+        current.MFTRecordCount = 20480;
+        current.Journal = MFTIndex::JournalPosition {7, 800, 5000};
+        Assert::IsTrue(index->IsValidFor(current));
+
+        current.Journal->FirstUsn = 1200;
+        Assert::IsFalse(index->IsValidFor(current), L"Journal wrapped");
+
+        current.Journal = MFTIndex::JournalPosition {8, 0, 5000};
+        Assert::IsFalse(index->IsValidFor(current), L"Journal recreated");
+
+        current = state;
+        current.ResurrectMode = ResurrectRecordsMode::kYes;
+        Assert::IsFalse(index->IsValidFor(current), L"Deleted records were not indexed");
+
+        current = state;
+        current.VolumeSerialNumber = 0x4321;
+        Assert::IsFalse(index->IsValidFor(current), L"Other volume");
+
+        // Images are only valid while their $LogFile did not move
+        index.reset();
+        state.Journal.reset();
+        state.LogFileLsn = 0x10000;
+        MFTIndex::Builder imageBuilder;
+        AddVolume(imageBuilder);
+        Assert::IsTrue(SUCCEEDED(imageBuilder.Write(path, state)));
+        Assert::IsTrue(SUCCEEDED(MFTIndex::Open(path, index)));
+
+        current = state;
+        Assert::IsTrue(index->IsValidFor(current));
+        current.LogFileLsn = 0x10040;
+        Assert::IsFalse(index->IsValidFor(current), L"Volume modified");
+
+        // A truncated index is rejected
+        index.reset();
+        const auto size = std::filesystem::file_size(path);
+        std::filesystem::resize_file(path, size - 2);
+        Assert::IsFalse(SUCCEEDED(MFTIndex::Open(path, index)));
+
+        std::filesystem::remove(path);
+    }
+};
+}  // namespace Orc::Test
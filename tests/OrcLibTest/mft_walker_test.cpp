@@ -17,6 +17,8 @@
 #include "MFTRecordFileInfo.h"
 #include "BinaryBuffer.h"
 
+#include <set>
+
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 using namespace Orc;
 using namespace Orc::Test;
@@ -36,17 +38,22 @@ public:
     {
         m_NbFiles = 0;
         m_NbFolders = 0;
+        m_I30Entries.clear();
         ProcessArchive(helper.GetDirectoryName(__WFILE__) + L"\\ntfs_images\\ntfs.7z");
 
         Assert::IsTrue(m_NbFiles == 0x16);
         Assert::IsTrue(m_NbFolders == 0x9);
 
+        // Batched $I30 pass reports each index entry once, even for directories with several names
+        Assert::IsFalse(m_I30Entries.empty());
+
         DeleteFile(m_ArchiveItem.Path.c_str());
     };
 
 private:
     DWORD64 m_NbFiles;
     DWORD64 m_NbFolders;
+    std::set<std::pair<ULONGLONG, std::wstring>> m_I30Entries;
     OrcArchive::ArchiveItem m_ArchiveItem;
 
     void ProcessArchive(const std::wstring& archive)
@@ -117,9 +124,31 @@ private:
                                           const PFILE_NAME pFileName,
                                           const std::shared_ptr<IndexAllocationAttribute>& pAttr) { m_NbFolders++; };
 
+        callBacks.I30Callback = [this](
+                                    const std::shared_ptr<VolumeReader>& volreader,
+                                    MFTRecord* pElt,
+                                    const PINDEX_ENTRY pEntry,
+                                    const PFILE_NAME pFileName,
+                                    bool bCarvedEntry) {
+            const auto directory = NtfsFullSegmentNumber(&pFileName->ParentDirectory);
+            Assert::IsTrue(directory == NtfsFullSegmentNumber(&pElt->GetFileReferenceNumber()));
+
+            if (!bCarvedEntry)
+            {
+                std::wstring name(pFileName->FileName, pFileName->FileNameLength);
+                Assert::IsTrue(m_I30Entries.emplace(directory, std::move(name)).second);
+            }
+        };
+
         Assert::IsTrue(S_OK == walker.Initialize(loc, ResurrectRecordsMode::kNo));
+        walker.LoadSecurityDescriptors(true);
         Assert::IsTrue(S_OK == walker.Walk(callBacks));
 
+        // $SDS is indexed once for the whole walk
+        const auto& securityDescriptors = walker.GetSecurityDescriptors();
+        Assert::IsTrue(securityDescriptors != nullptr);
+        Assert::IsTrue(securityDescriptors->Count() > 0);
+
         ntfsImageStream->Close();
     }
 
@@ -0,0 +1,156 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include "NTFSCompression.h"
+#include "Filesystem/Ntfs/Compression/Engine/Nt/NtAlgorithm.h"
+#include "Filesystem/Ntfs/Compression/Engine/Nt/NtApi.h"
+
+#include <filesystem>
+#include <fstream>
+
+#include <fmt/format.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Orc;
+using namespace Orc::Test;
+
+namespace {
+
+constexpr size_t kCompressionUnitSize = 0x10000;
+
+struct CompressionUnit
+{
+    std::vector<uint8_t> compressed;  // padded with zeroes to the compression unit size, as read from the volume
+    std::vector<uint8_t> uncompressed;
+};
+
+std::vector<uint8_t> MakeLogLikeData(size_t size)
+{
+    std::vector<uint8_t> data;
+    data.reserve(size + 128);
+
+    for (size_t i = 0; data.size() < size; ++i)
+    {
+        const auto line = fmt::format(
+            "2021-03-{:02} 12:{:02}:{:02}.{:03} [{}] Request #{} processed in {} ms\r\n",
+            1 + i % 28,
+            (i / 60) % 60,
+            i % 60,
+            (i * 7) % 1000,
+            i % 5 ? "info" : "warning",
+            i,
+            (i * 13) % 250);
+        data.insert(std::end(data), std::cbegin(line), std::cend(line));
+    }
+
+    data.resize(size);
+    return data;
+}
+
+// Split 'data' in compression units and compress them like NTFS does, incompressible units are skipped as they would
+// be stored as is
+void AddCompressionUnits(const std::vector<uint8_t>& data, std::vector<CompressionUnit>& units)
+{
+    const auto format = static_cast<USHORT>(NtAlgorithm::kLznt1);
+
+    std::error_code ec;
+    ULONG workspaceSize = 0, fragmentWorkspaceSize = 0;
+    RtlGetCompressionWorkSpaceSize(format, &workspaceSize, &fragmentWorkspaceSize, ec);
+    Assert::IsFalse((bool)ec);
+    std::vector<uint8_t> workspace(workspaceSize);
+
+    for (size_t offset = 0; offset + kCompressionUnitSize <= data.size(); offset += kCompressionUnitSize)
+    {
+        CompressionUnit unit;
+        unit.uncompressed.assign(std::cbegin(data) + offset, std::cbegin(data) + offset + kCompressionUnitSize);
+        unit.compressed.resize(kCompressionUnitSize * 2);
+
+        ULONG compressedSize = 0;
+        RtlCompressBuffer(
+            format,
+            unit.uncompressed.data(),
+            static_cast<ULONG>(unit.uncompressed.size()),
+            unit.compressed.data(),
+            static_cast<ULONG>(unit.compressed.size()),
+            4096,
+            &compressedSize,
+            workspace.data(),
+            ec);
+        Assert::IsFalse((bool)ec);
+
+        if (compressedSize >= kCompressionUnitSize)
+        {
+            continue;
+        }
+
+        std::fill(std::begin(unit.compressed) + compressedSize, std::end(unit.compressed), 0);
+        unit.compressed.resize(kCompressionUnitSize);
+        units.push_back(std::move(unit));
+    }
+}
+
+}  // namespace
+
+namespace Orc::Test {
+TEST_CLASS(NTFSCompressionTest)
+{
+private:
+    UnitTestHelper helper;
+    std::vector<CompressionUnit> m_units;
+
+    // Compression units of a binary, of text logs and of a mostly empty file
+    void BuildCorpus()
+    {
+        m_units.clear();
+
+        const auto binary = std::filesystem::path(helper.GetDirectoryName(__WFILE__) + L"\\binaries\\ntfsinfo.exe");
+        Assert::IsTrue(std::filesystem::exists(binary), L"Sample file \\binaries\\ntfsinfo.exe does not exist");
+
+        std::ifstream file(binary, std::ios::binary);
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        AddCompressionUnits(data, m_units);
+
+        AddCompressionUnits(MakeLogLikeData(kCompressionUnitSize * 32), m_units);
+
+        std::vector<uint8_t> sparse(kCompressionUnitSize * 8);
+        for (size_t i = 0; i < sparse.size(); i += 1021)
+        {
+            sparse[i] = static_cast<uint8_t>(i);
+        }
+        AddCompressionUnits(sparse, m_units);
+
+        Assert::IsFalse(m_units.empty());
+    }
+
+public:
+    TEST_METHOD_INITIALIZE(Initialize) {}
+
+    TEST_METHOD_CLEANUP(Finalize) {}
+
+    TEST_METHOD(LZNT1Decompression)
+    {
+        BuildCorpus();
+
+        std::vector<uint8_t> output(kCompressionUnitSize);
+        for (auto& unit : m_units)
+        {
+            std::fill(std::begin(output), std::end(output), 0xCC);
+            Assert::IsTrue(SUCCEEDED(
+                ntfs_decompress(output.data(), output.size(), unit.compressed.data(), unit.compressed.size())));
+            Assert::IsTrue(output == unit.uncompressed, L"Unexpected ntfs_decompress output");
+        }
+
+        // A truncated sub-block must be rejected
+        auto truncated = m_units.front().compressed;
+        const size_t subBlockSize = ((truncated[0] | (truncated[1] << 8)) & 0x0fff) + 3;
+        truncated.resize(subBlockSize - 1);
+        Assert::IsTrue(FAILED(ntfs_decompress(output.data(), output.size(), truncated.data(), truncated.size())));
+    }
+};
+}  // namespace Orc::Test
@@ -0,0 +1,110 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include "SecurityDescriptorTable.h"
+#include "MemoryStream.h"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Orc;
+using namespace Orc::Test;
+
+namespace {
+
+constexpr ULONG kHeaderSize = offsetof(SECURITY_DESCRIPTOR_ENTRY, SecurityDescriptor);
+
+std::vector<BYTE> GetDescriptor(LPCWSTR szSDDL)
+{
+    PSECURITY_DESCRIPTOR pSD = nullptr;
+    ULONG ulLength = 0L;
+    Assert::IsTrue(
+        (bool)ConvertStringSecurityDescriptorToSecurityDescriptorW(szSDDL, SDDL_REVISION_1, &pSD, &ulLength));
+
+    std::vector<BYTE> descriptor(reinterpret_cast<BYTE*>(pSD), reinterpret_cast<BYTE*>(pSD) + ulLength);
+    LocalFree(pSD);
+    return descriptor;
+}
+
+// Writes an $SDS entry at 'ulOffset' and returns the offset of the next one
+ULONG AddEntry(std::vector<BYTE>& sds, ULONG ulOffset, UINT32 securityId, const std::vector<BYTE>& descriptor)
+{
+    SECURITY_DESCRIPTOR_ENTRY entry = {};
+    entry.Hash = SecurityDescriptorTable::Hash(descriptor.data(), static_cast<ULONG>(descriptor.size()));
+    entry.SecID = securityId;
+    entry.OffsetEntry = ulOffset;
+    entry.SizeEntry = kHeaderSize + static_cast<UINT32>(descriptor.size());
+
+    memcpy(sds.data() + ulOffset, &entry, kHeaderSize);
+    memcpy(sds.data() + ulOffset + kHeaderSize, descriptor.data(), descriptor.size());
+    return (ulOffset + entry.SizeEntry + 15) & ~15;
+}
+
+}  // namespace
+
+namespace Orc::Test {
+TEST_CLASS(SecurityDescriptorTableTest)
+{
+private:
+    UnitTestHelper helper;
+
+public:
+    TEST_METHOD_INITIALIZE(Initialize) {}
+    TEST_METHOD_CLEANUP(Finalize) {}
+
+    TEST_METHOD(SecurityDescriptorTableLoad)
+    {
+        const auto system = GetDescriptor(L"O:SYG:SYD:(A;;FA;;;SY)");
+        const auto admins = GetDescriptor(L"O:BAG:SYD:(A;;FA;;;BA)(A;;FR;;;WD)");
+
+        constexpr ULONG kBlockSize = SecurityDescriptorTable::kBlockSize;
+        std::vector<BYTE> sds(3 * kBlockSize);
+
+        ULONG ulOffset = AddEntry(sds, 0L, 0x100, system);
+        AddEntry(sds, ulOffset, 0x101, admins);
+
+        // Mirror block
+        std::copy_n(std::cbegin(sds), kBlockSize, std::begin(sds) + kBlockSize);
+
+        // Next primary block: a copy of a known security ID and an entry whose hash does not match
+        ulOffset = AddEntry(sds, 2 * kBlockSize, 0x100, admins);
+        AddEntry(sds, ulOffset, 0x102, system);
+        reinterpret_cast<SECURITY_DESCRIPTOR_ENTRY*>(sds.data() + ulOffset)->Hash ^= 1;
+
+        auto stream = std::make_shared<MemoryStream>();
+        Assert::IsTrue(S_OK == stream->OpenForReadWrite());
+        ULONGLONG ullWritten = 0LL;
+        Assert::IsTrue(S_OK == stream->Write(sds.data(), sds.size(), &ullWritten));
+
+        SecurityDescriptorTable table;
+        Assert::IsTrue(S_OK == table.Load(stream));
+        Assert::IsTrue(table.Count() == 2);
+        Assert::IsTrue(table.Find(0x102) == nullptr);
+
+        const auto pEntry = table.Find(0x100);
+        Assert::IsTrue(pEntry != nullptr);
+        Assert::IsTrue(pEntry->SizeEntry == kHeaderSize + static_cast<UINT32>(system.size()));
+        Assert::IsTrue(!memcmp(&pEntry->SecurityDescriptor, system.data(), system.size()));
+
+        std::vector<UINT32> securityIds;
+        table.ForEach([&securityIds](const SECURITY_DESCRIPTOR_ENTRY& entry) { securityIds.push_back(entry.SecID); });
+        Assert::IsTrue(securityIds == std::vector<UINT32>({0x100, 0x101}));
+
+        const auto pSystem = table.GetOwner(0x100);
+        Assert::IsTrue(pSystem != nullptr);
+        Assert::IsTrue(pSystem->Sid == L"S-1-5-18");
+        Assert::IsFalse(pSystem->Name.empty());
+        Assert::IsTrue(table.GetOwner(0x100) == pSystem);
+
+        const auto pAdmins = table.GetOwner(0x101);
+        Assert::IsTrue(pAdmins != nullptr);
+        Assert::IsTrue(pAdmins->Sid == L"S-1-5-32-544");
+
+        Assert::IsTrue(table.GetOwner(0x102) == nullptr);
+    }
+};
+}  // namespace Orc::Test
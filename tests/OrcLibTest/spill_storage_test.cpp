@@ -0,0 +1,119 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include "SpillStorage.h"
+
+#include <set>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Orc;
+using namespace Orc::Test;
+
+namespace Orc::Test {
+TEST_CLASS(SpillStorageTest)
+{
+private:
+    UnitTestHelper helper;
+
+public:
+    TEST_METHOD_INITIALIZE(Initialize) {}
+
+    TEST_METHOD_CLEANUP(Finalize) {}
+
+    TEST_METHOD(SpillStorageSpillsBeyondBudget)
+    {
+        constexpr DWORD kCellSize = 1024 + 256;
+        constexpr size_t kHeapCells = 16;
+        const size_t kCellsPerView = SpillStorage::kViewSize / kCellSize;
+
+        SpillStorage store(L"SpillStorageTest");
+        Assert::IsTrue(S_OK == store.InitializeStore(kCellSize, kHeapCells * kCellSize));
+
+        // Enough cells to fill the heap budget and more than one view of the spill file
+        std::vector<BYTE*> cells;
+        for (size_t i = 0; i < kHeapCells + kCellsPerView + 10; ++i)
+        {
+            const auto cell = static_cast<BYTE*>(store.GetNewCell());
+            Assert::IsTrue(cell != nullptr);
+            memset(cell, static_cast<int>(i % 251), kCellSize);
+            cells.push_back(cell);
+        }
+
+        Assert::AreEqual(cells.size(), store.AllocatedCells());
+        Assert::AreEqual(cells.size() - kHeapCells, store.SpilledCells());
+
+        // Pages of filled views are read back from the file
+        for (size_t i = 0; i < cells.size(); ++i)
+        {
+            Assert::AreEqual(static_cast<BYTE>(i % 251), cells[i][kCellSize - 1]);
+        }
+
+        // A freed spilled cell is reused and zeroed
+        const auto freed = cells.back();
+        cells.pop_back();
+        store.FreeCell(freed);
+        Assert::AreEqual(cells.size(), store.AllocatedCells());
+
+        const auto reused = static_cast<BYTE*>(store.GetNewCell());
+        Assert::IsTrue(reused == freed);
+        Assert::AreEqual(BYTE(0), reused[0]);
+        cells.push_back(reused);
+
+        // A freed heap cell makes room in the heap again
+        store.FreeCell(cells.front());
+        cells.erase(std::begin(cells));
+        Assert::AreEqual(cells.size() - kHeapCells + 1, store.SpilledCells());
+
+        const auto heapCell = static_cast<BYTE*>(store.GetNewCell());
+        Assert::IsTrue(heapCell != nullptr);
+        Assert::AreEqual(cells.size() - kHeapCells + 1, store.SpilledCells());
+        cells.push_back(heapCell);
+
+        std::set<void*> enumerated;
+        Assert::IsTrue(S_OK == store.EnumCells([&enumerated](void* pData) { enumerated.insert(pData); }));
+        Assert::AreEqual(cells.size(), enumerated.size());
+        for (const auto cell : cells)
+        {
+            Assert::IsTrue(enumerated.find(cell) != std::cend(enumerated));
+        }
+    }
+
+    TEST_METHOD(SpillStorageChurnStaysWithinBudget)
+    {
+        constexpr DWORD kCellSize = 1024 + 256;
+        constexpr size_t kHeapCells = 16;
+
+        SpillStorage store(L"SpillStorageTest");
+        Assert::IsTrue(S_OK == store.InitializeStore(kCellSize, kHeapCells * kCellSize));
+
+        std::vector<LPVOID> cells;
+        for (size_t i = 0; i < kHeapCells; ++i)
+        {
+            cells.push_back(store.GetNewCell());
+            Assert::IsTrue(cells.back() != nullptr);
+        }
+
+        // Records are freed as soon as they are processed: the heap must give the memory back, in release builds too
+        for (size_t i = 0; i < 10000; ++i)
+        {
+            store.FreeCell(cells[i % kHeapCells]);
+            cells[i % kHeapCells] = store.GetNewCell();
+            Assert::IsTrue(cells[i % kHeapCells] != nullptr);
+        }
+
+        Assert::AreEqual(kHeapCells, store.AllocatedCells());
+        Assert::AreEqual(size_t(0), store.SpilledCells());
+
+        // Cells leaked by the heap would still be walked as busy entries
+        size_t enumerated = 0;
+        Assert::IsTrue(S_OK == store.EnumCells([&enumerated](void*) { enumerated++; }));
+        Assert::AreEqual(kHeapCells, enumerated);
+    }
+};
+}  // namespace Orc::Test
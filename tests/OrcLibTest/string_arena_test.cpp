@@ -0,0 +1,61 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include "Utils/StringArena.h"
+
+#include <fmt/format.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Orc;
+using namespace Orc::Test;
+
+namespace Orc::Test {
+TEST_CLASS(StringArenaTest)
+{
+private:
+    UnitTestHelper helper;
+
+public:
+    TEST_METHOD_INITIALIZE(Initialize) {}
+
+    TEST_METHOD_CLEANUP(Finalize) {}
+
+    TEST_METHOD(StringArenaViewsStayValid)
+    {
+        StringArena arena(64);
+
+        std::vector<std::wstring> expected;
+        std::vector<std::wstring_view> views;
+        for (size_t i = 0; i < 1000; ++i)
+        {
+            expected.push_back(fmt::format(L"directory_{}", i));
+            views.push_back(arena.Add(expected.back()));
+        }
+
+        // Views must not move when new blocks are allocated
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            Assert::IsTrue(views[i] == expected[i]);
+        }
+
+        Assert::IsTrue(arena.Add(L"").empty());
+
+        // Strings longer than a block get their own
+        const std::wstring longName(200, L'x');
+        const auto longView = arena.Add(longName);
+        Assert::IsTrue(longView == longName);
+        Assert::IsTrue(views.back() == expected.back());
+        Assert::IsTrue(arena.GetMemoryUsage() >= 200 * sizeof(wchar_t));
+
+        arena.clear();
+        Assert::AreEqual(size_t(0), arena.GetMemoryUsage());
+        Assert::IsTrue(arena.Add(L"root") == L"root");
+    }
+};
+}  // namespace Orc::Test
@@ -0,0 +1,86 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include "Log/Syslog/SyslogSink.h"
+#include "Utils/Guard/Winsock.h"
+
+#include <spdlog/logger.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Orc;
+using namespace Orc::Test;
+
+namespace Orc::Test {
+TEST_CLASS(SyslogSinkTest)
+{
+private:
+    UnitTestHelper helper;
+
+public:
+    TEST_METHOD_INITIALIZE(Initialize) {}
+
+    TEST_METHOD_CLEANUP(Finalize) {}
+
+    TEST_METHOD(SyslogSinkLocalListener)
+    {
+        constexpr int kRecords = 200;
+
+        std::error_code ec;
+        auto winsock = Guard::Winsock::Create(2, 2, ec);
+        Assert::IsFalse((bool)ec);
+
+        // Local listener on an ephemeral port
+        Guard::Socket listener(::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP));
+        Assert::IsTrue(listener.value() != INVALID_SOCKET);
+
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        Assert::AreNotEqual(SOCKET_ERROR, ::bind(*listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)));
+
+        int addressLength = sizeof(address);
+        Assert::AreNotEqual(
+            SOCKET_ERROR, ::getsockname(*listener, reinterpret_cast<sockaddr*>(&address), &addressLength));
+
+        DWORD timeout = 5000;
+        ::setsockopt(*listener, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+
+        int bufferSize = 1024 * 1024;
+        ::setsockopt(*listener, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char*>(&bufferSize), sizeof(bufferSize));
+
+        auto sink = std::make_shared<Log::SyslogSink<std::mutex>>(
+            1024, 16, std::chrono::milliseconds(50), Log::SyslogSink<std::mutex>::OverflowPolicy::kBlock);
+        sink->AddEndpoint("127.0.0.1", std::to_string(ntohs(address.sin_port)), ec);
+        Assert::IsFalse((bool)ec);
+
+        spdlog::logger logger("syslog_test", sink);
+        for (int i = 0; i < kRecords; ++i)
+        {
+            logger.info("record {}", i);
+        }
+        logger.flush();
+
+        // Each record is a datagram, sent in order
+        char buffer[2048];
+        for (int i = 0; i < kRecords; ++i)
+        {
+            const auto received = ::recv(*listener, buffer, sizeof(buffer), 0);
+            Assert::IsTrue(received > 0);
+
+            const auto expected = fmt::format("record {}", i);
+            const std::string_view datagram(buffer, received);
+            Assert::IsTrue(datagram.size() >= expected.size());
+            Assert::AreEqual(expected, std::string(datagram.substr(datagram.size() - expected.size())));
+        }
+
+        Assert::AreEqual(static_cast<uint64_t>(0), sink->DroppedCount());
+    }
+};
+}  // namespace Orc::Test
@@ -197,6 +197,95 @@ public:
         }
     }
 
+    TEST_METHOD(CsvCompiledFormatters)
+    {
+        using namespace Orc::TableOutput;
+
+        auto options = std::make_unique<CSV::Options>();
+        options->bBOM = false;
+
+        auto stream_writer = Orc::TableOutput::GetCSVWriter(std::move(options));
+        Assert::IsTrue((bool)stream_writer, L"Failed to instantiate csv writer");
+
+        auto mem_stream = std::make_shared<MemoryStream>();
+        Assert::IsTrue(SUCCEEDED(mem_stream->OpenForReadWrite()), L"Failed to open memory stream");
+        stream_writer->WriteToStream(mem_stream, false);
+
+        Schema schema {{ColumnType::UTF16Type, L"Name"},
+                       {ColumnType::UTF8Type, L"ShortName"},
+                       {ColumnType::UInt64Type, L"Size"},
+                       {ColumnType::Int64Type, L"Delta"},
+                       {ColumnType::UInt64Type, L"FRN", std::nullopt, L"0x{:016X}"},
+                       {ColumnType::TimeStampType, L"Created"},
+                       {ColumnType::BinaryType, L"MD5", std::nullopt, L"{:02X}"},
+                       {ColumnType::UInt32Type, L"Custom", std::nullopt, L"[{:>4}]"}};
+
+        stream_writer->SetSchema(schema);
+
+        auto& output = *stream_writer;
+
+        output.WriteString(L"a \"quoted\" \u00e9\u20ac\U0001F600"sv);
+        output.WriteString("short"sv);
+        output.WriteInteger((ULONGLONG)1234567890123ULL);
+        output.WriteInteger((LONGLONG)-42LL);
+        output.WriteInteger((ULONGLONG)0x1000000000ABCULL);
+
+        SYSTEMTIME st {2021, 3, 0, 14, 15, 9, 26, 535};
+        FILETIME ft;
+        Assert::IsTrue(SystemTimeToFileTime(&st, &ft));
+        output.WriteFileTime(ft);
+
+        const BYTE bytes[] = {0x00, 0x1F, 0xA0, 0xFF};
+        output.WriteBytes(bytes, sizeof(bytes));
+
+        output.WriteInteger((DWORD)7);
+        output.WriteEndOfLine();
+
+        stream_writer->Close();
+
+        auto buffer = mem_stream->GetConstBuffer();
+        std::string_view csv(reinterpret_cast<const char*>(buffer.GetData()), buffer.GetCount());
+
+        Assert::AreEqual(
+            "Name,ShortName,Size,Delta,FRN,Created,MD5,Custom\r\n"
+            "\"a \"\"quoted\"\" \xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80\",\"short\",1234567890123,-42,"
+            "0x0001000000000ABC,2021-03-14 15:09:26.535,001FA0FF,[   7]\r\n",
+            std::string(csv).c_str());
+    }
+
+    TEST_METHOD(CsvHexFormatterNegativeValue)
+    {
+        using namespace Orc::TableOutput;
+
+        auto options = std::make_unique<CSV::Options>();
+        options->bBOM = false;
+
+        auto stream_writer = Orc::TableOutput::GetCSVWriter(std::move(options));
+        Assert::IsTrue((bool)stream_writer, L"Failed to instantiate csv writer");
+
+        auto mem_stream = std::make_shared<MemoryStream>();
+        Assert::IsTrue(SUCCEEDED(mem_stream->OpenForReadWrite()), L"Failed to open memory stream");
+        stream_writer->WriteToStream(mem_stream, false);
+
+        Schema schema {{ColumnType::Int64Type, L"Offset", std::nullopt, L"0x{:04X}h"}};
+        stream_writer->SetSchema(schema);
+
+        auto& output = *stream_writer;
+
+        // Negative values are left to fmt: literal text of the format must still be written once
+        output.WriteInteger((LONGLONG)26LL);
+        output.WriteEndOfLine();
+        output.WriteInteger((LONGLONG)-26LL);
+        output.WriteEndOfLine();
+
+        stream_writer->Close();
+
+        auto buffer = mem_stream->GetConstBuffer();
+        std::string_view csv(reinterpret_cast<const char*>(buffer.GetData()), buffer.GetCount());
+
+        Assert::AreEqual("Offset\r\n0x001Ah\r\n0x-01Ah\r\n", std::string(csv).c_str());
+    }
+
     std::wstring GetFilePath(const std::wstring& strFileName)
     {
         std::wstring retval;
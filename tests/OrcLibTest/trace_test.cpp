@@ -0,0 +1,135 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include "Utils/Trace.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Orc;
+using namespace Orc::Test;
+
+namespace Orc::Test {
+TEST_CLASS(TraceTest)
+{
+private:
+    UnitTestHelper helper;
+
+public:
+    TEST_METHOD_INITIALIZE(Initialize) {}
+
+    TEST_METHOD_CLEANUP(Finalize) {}
+
+    TEST_METHOD(TraceSpans)
+    {
+        Trace::Enable();
+        Assert::IsTrue(Trace::IsEnabled());
+
+        // Forget the spans of the other tests
+        Trace::GetStatistics(true);
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i)
+        {
+            threads.emplace_back([]() {
+                for (int j = 0; j < 100; ++j)
+                {
+                    Trace::Span span("test", "TraceTest::Read");
+                    span.SetBytes(512);
+                }
+
+                Trace::Counter("test", "TraceTest::Queue", 3);
+            });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        {
+            Trace::Span span("test", "TraceTest::\"Quoted\"");
+        }
+
+        const auto statistics = Trace::GetStatistics(true);
+        const auto read = std::find_if(std::cbegin(statistics), std::cend(statistics), [](const auto& item) {
+            return item.Name == "TraceTest::Read";
+        });
+
+        Assert::IsTrue(read != std::cend(statistics));
+        Assert::IsTrue(read->Category == "test");
+        Assert::AreEqual(400ULL, read->Count);
+        Assert::AreEqual(400ULL * 512, read->Bytes);
+
+        // Counters are exported but not aggregated
+        Assert::IsTrue(std::none_of(std::cbegin(statistics), std::cend(statistics), [](const auto& item) {
+            return item.Name == "TraceTest::Queue";
+        }));
+
+        Assert::IsTrue(Trace::GetStatistics().empty());
+
+        const auto path = std::filesystem::temp_directory_path() / L"trace_test.json";
+        std::error_code ec;
+        Trace::WriteChromeTrace(path, ec);
+        Assert::IsFalse(static_cast<bool>(ec));
+
+        std::ifstream file(path, std::ios::binary);
+        const std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        file.close();
+        std::filesystem::remove(path);
+
+        Assert::IsTrue(json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[") == 0);
+        Assert::IsTrue(json.find("\"name\":\"TraceTest::Read\",\"cat\":\"test\",\"ph\":\"X\"") != std::string::npos);
+        Assert::IsTrue(json.find("\"name\":\"TraceTest::Queue\",\"cat\":\"test\",\"ph\":\"C\"") != std::string::npos);
+        Assert::IsTrue(json.find("TraceTest::\\\"Quoted\\\"") != std::string::npos);
+        Assert::IsTrue(json.rfind("]}") != std::string::npos);
+    }
+
+    TEST_METHOD(TraceStatisticsMerge)
+    {
+        Trace::Enable();
+        Trace::GetStatistics(true);
+
+        for (int i = 0; i < 10; ++i)
+        {
+            Trace::Span span("test", "TraceTest::\"Child\"");
+            span.SetBytes(4096);
+        }
+
+        const auto path = Trace::GetStatisticsPath(std::filesystem::temp_directory_path() / L"trace_test_child.json");
+        Assert::IsTrue(path.filename() == L"trace_test_child.statistics.json");
+
+        std::error_code ec;
+        Trace::WriteStatistics(path, ec);
+        Assert::IsFalse(static_cast<bool>(ec));
+
+        auto child = Trace::ReadStatistics(path, ec);
+        std::filesystem::remove(path);
+        Assert::IsFalse(static_cast<bool>(ec));
+        Assert::AreEqual(Trace::GetStatistics(true).size(), child.size());
+
+        std::vector<Trace::Statistics> statistics;
+        Trace::MergeStatistics(statistics, child);
+        Trace::MergeStatistics(statistics, child);
+
+        Assert::AreEqual(static_cast<size_t>(1), statistics.size());
+        Assert::IsTrue(statistics[0].Name == "TraceTest::\"Child\"");
+        Assert::AreEqual(20ULL, statistics[0].Count);
+        Assert::AreEqual(20ULL * 4096, statistics[0].Bytes);
+        Assert::IsTrue(statistics[0].Duration == child[0].Duration * 2);
+
+        Trace::ReadStatistics(path, ec);
+        Assert::IsTrue(static_cast<bool>(ec));
+    }
+};
+}  // namespace Orc::Test
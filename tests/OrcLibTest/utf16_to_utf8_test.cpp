@@ -0,0 +1,102 @@
+//
+// SPDX-License-Identifier: LGPL-2.1-or-later
+//
+// Copyright © 2026 ANSSI. All Rights Reserved.
+//
+// Author(s): agent
+//
+#include "stdafx.h"
+
+#include "Text/Utf16ToUtf8.h"
+
+#include <random>
+
+#include <fmt/format.h>
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+using namespace Orc;
+using namespace Orc::Test;
+
+namespace {
+
+std::string ToUtf8WithWin32(std::wstring_view utf16)
+{
+    if (utf16.empty())
+    {
+        return {};
+    }
+
+    const auto size =
+        WideCharToMultiByte(CP_UTF8, 0, utf16.data(), static_cast<int>(utf16.size()), nullptr, 0, nullptr, nullptr);
+
+    std::string utf8(size, '\0');
+    WideCharToMultiByte(
+        CP_UTF8, 0, utf16.data(), static_cast<int>(utf16.size()), utf8.data(), size, nullptr, nullptr);
+    return utf8;
+}
+
+// Mostly ASCII paths with some accented, CJK, surrogate pairs and lone surrogates
+std::wstring MakeString(std::mt19937& random, size_t length, bool bAsciiOnly)
+{
+    std::wstring value(length, L'\0');
+    for (auto& c : value)
+    {
+        const auto kind = random() % 100;
+        if (bAsciiOnly || kind < 70)
+            c = static_cast<wchar_t>(0x20 + random() % 0x5F);
+        else if (kind < 80)
+            c = static_cast<wchar_t>(0x80 + random() % 0x780);
+        else if (kind < 88)
+            c = static_cast<wchar_t>(0x800 + random() % 0xC000);
+        else if (kind < 95)
+            c = static_cast<wchar_t>(0xD800 + random() % 0x800);
+        else
+            c = static_cast<wchar_t>(0xE000 + random() % 0x2000);
+    }
+
+    return value;
+}
+
+}  // namespace
+
+namespace Orc::Test {
+TEST_CLASS(Utf16ToUtf8Test)
+{
+private:
+    UnitTestHelper helper;
+
+public:
+    TEST_METHOD_INITIALIZE(Initialize) {}
+
+    TEST_METHOD_CLEANUP(Finalize) {}
+
+    TEST_METHOD(Utf16ToUtf8MatchesWideCharToMultiByte)
+    {
+        std::mt19937 random(7);
+
+        for (size_t i = 0; i < 100000; ++i)
+        {
+            const auto value = MakeString(random, random() % 80, i % 4 == 0);
+
+            std::string utf8(Text::GetUtf8MaxLength(value.size()) + 1, '\xAA');
+            const auto length = Text::Utf16ToUtf8(value, utf8.data());
+
+            Assert::IsTrue(utf8.back() == '\xAA', L"Output overflow");
+            Assert::IsTrue(ToUtf8WithWin32(value) == std::string_view(utf8.data(), length), L"Unexpected utf8");
+        }
+
+        // Surrogate pair, lone high surrogate before ASCII, lone low surrogate at the end
+        const std::wstring_view surrogates(L"\xD83D\xDE00-\xD83Dx\xDE00", 5);
+        std::string utf8;
+        size_t cReplaced = 0;
+        utf8.resize(Text::GetUtf8MaxLength(surrogates.size()));
+        utf8.resize(Text::Utf16ToUtf8(surrogates, utf8.data(), &cReplaced));
+        Assert::AreEqual(static_cast<size_t>(2), cReplaced);
+        Assert::IsTrue(utf8 == "\xF0\x9F\x98\x80-\xEF\xBF\xBDx\xEF\xBF\xBD");
+
+        utf8 = "prefix ";
+        Text::AppendUtf8(L"C:\\Windows\\System32\\ntdll.dll", utf8);
+        Assert::IsTrue(utf8 == "prefix C:\\Windows\\System32\\ntdll.dll");
+    }
+};
+}  // namespace Orc::Test
@@ -12,6 +12,9 @@
 #include "MemoryStream.h"
 
 #include "CompressAPIExtension.h"
+#include "UncompressWofStream.h"
+#include "Filesystem/Ntfs/Compression/Engine/Nt/NtAlgorithm.h"
+#include "Filesystem/Ntfs/Compression/Engine/Nt/NtApi.h"
 
 #include <filesystem>
 
@@ -90,6 +93,87 @@ public:
             Assert::IsTrue(strMessage._Equal(expandBuffer.GetP<WCHAR>()), L"Note the expected message");
         }
     }
+
+    TEST_METHOD(ConcurrentChunkDecompression)
+    {
+        constexpr size_t kChunkSize = 4096;
+        const auto format = std::underlying_type_t<NtAlgorithm>(NtAlgorithm::kXpressHuffman);
+
+        // Last chunk is incomplete
+        std::vector<uint8_t> expected(kChunkSize * 64 - 100);
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            expected[i] = static_cast<uint8_t>((i / 7) ^ (i / kChunkSize));
+        }
+
+        std::error_code ec;
+        ULONG workspaceSize = 0, fragmentWorkspaceSize = 0;
+        RtlGetCompressionWorkSpaceSize(format, &workspaceSize, &fragmentWorkspaceSize, ec);
+        Assert::IsFalse((bool)ec);
+        std::vector<uint8_t> workspace(workspaceSize);
+
+        // Chunk table holds the end offset of each chunk but the last one, followed by the compressed chunks
+        std::vector<uint32_t> table;
+        std::vector<uint8_t> chunks;
+        for (size_t offset = 0; offset < expected.size(); offset += kChunkSize)
+        {
+            const auto size = std::min(kChunkSize, expected.size() - offset);
+
+            std::vector<uint8_t> chunk(kChunkSize * 2);
+            ULONG compressedSize = 0;
+            RtlCompressBuffer(
+                format,
+                expected.data() + offset,
+                static_cast<ULONG>(size),
+                chunk.data(),
+                static_cast<ULONG>(chunk.size()),
+                kChunkSize,
+                &compressedSize,
+                workspace.data(),
+                ec);
+            Assert::IsFalse((bool)ec);
+
+            if (compressedSize >= size)
+            {
+                chunk.assign(expected.data() + offset, expected.data() + offset + size);
+                compressedSize = static_cast<ULONG>(size);
+            }
+
+            chunks.insert(std::end(chunks), std::cbegin(chunk), std::cbegin(chunk) + compressedSize);
+            table.push_back(static_cast<uint32_t>(chunks.size()));
+        }
+        table.pop_back();
+
+        auto rawStream = std::make_shared<MemoryStream>();
+        Assert::IsTrue(SUCCEEDED(rawStream->OpenForReadWrite()));
+
+        ULONGLONG written = 0;
+        Assert::IsTrue(SUCCEEDED(rawStream->Write(table.data(), table.size() * sizeof(uint32_t), &written)));
+        Assert::IsTrue(SUCCEEDED(rawStream->Write(chunks.data(), chunks.size(), &written)));
+        Assert::IsTrue(SUCCEEDED(rawStream->SetFilePointer(0LL, FILE_BEGIN, nullptr)));
+
+        auto wofStream = std::make_shared<UncompressWofStream>();
+        Assert::IsTrue(SUCCEEDED(wofStream->Open(rawStream, Ntfs::WofAlgorithm::kXpress4k, expected.size())));
+
+        // A single read covering every chunk is decompressed concurrently
+        std::vector<uint8_t> output(expected.size());
+        ULONGLONG read = 0;
+        Assert::IsTrue(SUCCEEDED(wofStream->Read(output.data(), output.size(), &read)));
+        Assert::AreEqual(static_cast<ULONGLONG>(expected.size()), read);
+        Assert::IsTrue(output == expected, L"Unexpected concurrently decompressed data");
+
+        // Unaligned small reads are decompressed sequentially
+        std::fill(std::begin(output), std::end(output), 0);
+        Assert::IsTrue(SUCCEEDED(wofStream->SetFilePointer(0LL, FILE_BEGIN, nullptr)));
+        for (size_t offset = 0; offset < output.size(); offset += read)
+        {
+            const auto size = std::min<size_t>(3000, output.size() - offset);
+            Assert::IsTrue(SUCCEEDED(wofStream->Read(output.data() + offset, size, &read)));
+            Assert::IsTrue(read > 0);
+        }
+        Assert::IsTrue(output == expected, L"Unexpected sequentially decompressed data");
+    }
+
 #ifdef BASIC_WOLF_DECOMPRESSION
     TEST_METHOD(BasicWofDecompression)
     {